@@ -199,6 +199,14 @@ typedef struct CassBatch_ CassBatch;
  */
 typedef struct CassFuture_ CassFuture;
 
+/**
+ * An automatic pager for a statement. It requests the next page of a
+ * statement's result while the current page is being consumed.
+ *
+ * @struct CassPager
+ */
+typedef struct CassPager_ CassPager;
+
 /**
  * A statement that has been prepared cluster-side (It has been pre-parsed
  * and cached).
@@ -391,6 +399,14 @@ typedef struct CassRetryPolicy_ CassRetryPolicy;
  */
 typedef struct CassCustomPayload_ CassCustomPayload;
 
+/**
+ * A copy of one of the session's latency histograms that keeps the recorded
+ * values so that it can be exported and merged with other histograms.
+ *
+ * @struct CassHistogramSnapshot
+ */
+typedef struct CassHistogramSnapshot_ CassHistogramSnapshot;
+
 /**
  * A snapshot of the session's performance/diagnostic metrics.
  *
@@ -443,6 +459,85 @@ typedef struct CassSpeculativeExecutionMetrics_ {
   cass_double_t percentage; /**< Fraction of requests that are aborted speculative retries */
 } CassSpeculativeExecutionMetrics;
 
+/**
+ * Monotonic timestamps, in nanoseconds, recorded at each stage of a request.
+ * The timestamps use the same clock as uv_hrtime() and are only meaningful
+ * relative to each other. A timestamp of zero means the request didn't reach
+ * that stage e.g. the request failed before it was written.
+ *
+ * @see cass_future_get_timings()
+ */
+typedef struct CassRequestTimings_ {
+  cass_uint64_t enqueued; /**< Added to an I/O thread's request queue */
+  cass_uint64_t dequeued; /**< Removed from the request queue by the I/O thread */
+  cass_uint64_t query_plan; /**< Query plan computed */
+  cass_uint64_t written; /**< Written to the socket */
+  cass_uint64_t first_byte; /**< First byte of the response read from the socket */
+  cass_uint64_t decoded; /**< Response decoded */
+  cass_uint64_t future_set; /**< Future set */
+  cass_uint64_t callback_start; /**< Future callback invoked */
+  cass_uint64_t callback_end; /**< Future callback returned */
+} CassRequestTimings;
+
+/**
+ * The stages of a request that are aggregated into histograms. Each stage is
+ * the time between two of the timestamps in CassRequestTimings.
+ *
+ * @see cass_session_get_request_stage_metrics()
+ */
+typedef enum CassRequestStage_ {
+  CASS_REQUEST_STAGE_QUEUE, /**< enqueued to dequeued */
+  CASS_REQUEST_STAGE_QUERY_PLAN, /**< dequeued to query_plan */
+  CASS_REQUEST_STAGE_WRITE, /**< query_plan to written (includes encoding and write coalescing) */
+  CASS_REQUEST_STAGE_NETWORK, /**< written to first_byte (includes server time) */
+  CASS_REQUEST_STAGE_DECODE, /**< first_byte to decoded */
+  CASS_REQUEST_STAGE_COMPLETE, /**< decoded to future_set */
+  CASS_REQUEST_STAGE_CALLBACK, /**< callback_start to callback_end */
+  CASS_REQUEST_STAGE_LAST_ENTRY
+} CassRequestStage;
+
+typedef struct CassRequestStageMetrics_ {
+  cass_uint64_t min; /**< Minimum in microseconds */
+  cass_uint64_t max; /**< Maximum in microseconds */
+  cass_uint64_t mean; /**< Mean in microseconds */
+  cass_uint64_t stddev; /**< Standard deviation in microseconds */
+  cass_uint64_t median; /**< Median in microseconds */
+  cass_uint64_t percentile_75th; /**< 75th percentile in microseconds */
+  cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+  cass_uint64_t percentile_98th; /**< 98th percentile in microseconds */
+  cass_uint64_t percentile_99th; /**< 99the percentile in microseconds */
+  cass_uint64_t percentile_999th; /**< 99.9th percentile in microseconds */
+} CassRequestStageMetrics;
+
+/**
+ * The saturation stats of one of the session's I/O threads (event loops).
+ * They're measured by a probe that runs periodically on each event loop.
+ *
+ * @see cass_session_get_event_loop_metrics()
+ */
+typedef struct CassEventLoopMetrics_ {
+  cass_double_t utilization; /**< Fraction of the last probe interval spent processing rather than waiting for I/O (0.0 to 1.0) */
+  cass_uint64_t lag; /**< How late the last probe ran compared to when it was scheduled in microseconds */
+  cass_uint64_t callback_time; /**< Time spent running future callbacks during the last probe interval in microseconds */
+} CassEventLoopMetrics;
+
+/**
+ * The stats of one of the session's connections.
+ *
+ * @see cass_session_get_connection_metrics()
+ */
+typedef struct CassConnectionMetrics_ {
+  CassInet host; /**< The host the connection is connected to */
+  cass_uint64_t streams_in_use; /**< Stream IDs used by requests waiting for a response */
+  cass_uint64_t max_streams_in_use; /**< The high-water mark of streams in use */
+  cass_uint64_t bytes_read; /**< Bytes read from the socket (encrypted bytes when using SSL) */
+  cass_uint64_t bytes_written; /**< Bytes written to the socket (encrypted bytes when using SSL) */
+  cass_uint64_t pending_writes; /**< Coalesced writes waiting to be flushed or to finish flushing */
+  cass_uint64_t write_queue_size; /**< Bytes queued because the socket isn't writable */
+  cass_uint64_t write_blocked_time; /**< Total time bytes have been queued because the socket wasn't writable in microseconds */
+  cass_uint64_t heartbeat_rtt; /**< Round trip time of the last heartbeat in microseconds (0 if none) */
+} CassConnectionMetrics;
+
 typedef enum CassConsistency_ {
   CASS_CONSISTENCY_UNKNOWN      = 0xFFFF,
   CASS_CONSISTENCY_ANY          = 0x0000,
@@ -731,6 +826,19 @@ typedef enum CassError_ {
 typedef void (*CassFutureCallback)(CassFuture* future,
                                    void* data);
 
+/**
+ * A callback that's notified as each row of a result is received.
+ *
+ * @param[in] row The row. The row and its values are only valid for the
+ * duration of the callback.
+ * @param[in] data user defined data provided when the callback
+ * was registered.
+ *
+ * @see cass_statement_set_row_callback()
+ */
+typedef void (*CassRowCallback)(const CassRow* row,
+                                void* data);
+
 /**
  * Maximum size of a log message
  */
@@ -905,6 +1013,96 @@ typedef void(*CassHostListenerCallback)(CassHostListenerEvent event,
                                         const CassInet address,
                                         void* data);
 
+typedef enum CassSpanKind_ {
+  CASS_SPAN_KIND_REQUEST, /**< A request including all of its attempts */
+  CASS_SPAN_KIND_ATTEMPT  /**< A single attempt of a request on a host */
+} CassSpanKind;
+
+/**
+ * The attributes of a tracing span. The pointers are only valid for the
+ * duration of the callback.
+ *
+ * @see cass_cluster_set_tracer_callbacks()
+ */
+typedef struct CassSpanAttributes_ {
+  CassSpanKind kind; /**< The kind of span */
+  const char* keyspace; /**< The request's keyspace (may be empty) */
+  size_t keyspace_length;
+  const char* statement; /**< The query string (empty for batches) */
+  size_t statement_length;
+  const cass_byte_t* prepared_id; /**< The prepared ID of a bound statement */
+  size_t prepared_id_length;
+  CassInet host; /**< The host of an attempt */
+  int attempt; /**< The attempt number starting at 1 (request spans: number of attempts when ended) */
+  cass_bool_t is_speculative; /**< The attempt is a speculative execution */
+  int stream; /**< The stream ID of an attempt */
+  size_t request_bytes; /**< Bytes written for an attempt (set when ended) */
+  size_t response_bytes; /**< Bytes read for an attempt (set when ended) */
+  CassError error; /**< The outcome of the span (set when ended) */
+} CassSpanAttributes;
+
+/**
+ * A callback used to start a tracing span.
+ *
+ * @param[in] parent The parent span returned by a previous start callback or
+ * NULL for request spans.
+ * @param[in] attributes
+ * @param[in] data
+ * @return A span that is passed to the other tracer callbacks.
+ */
+typedef void* (*CassTracerStartCallback)(void* parent,
+                                         const CassSpanAttributes* attributes,
+                                         void* data);
+
+/**
+ * A callback used to end a tracing span. An attempt span can end after its
+ * request span e.g. an aborted speculative execution.
+ *
+ * @param[in] span
+ * @param[in] attributes
+ * @param[in] data
+ */
+typedef void (*CassTracerEndCallback)(void* span,
+                                      const CassSpanAttributes* attributes,
+                                      void* data);
+
+/**
+ * A callback used to get the trace context of an attempt span e.g. a
+ * W3C "traceparent" header. The context is sent to the server in the
+ * request's custom payload using the name "traceparent" (protocol v4+).
+ *
+ * @param[in] span
+ * @param[out] context A buffer for the context.
+ * @param[in] context_size The size of the buffer.
+ * @param[in] data
+ * @return The length of the context written or 0 for no context.
+ */
+typedef size_t (*CassTracerContextCallback)(void* span,
+                                            char* context,
+                                            size_t context_size,
+                                            void* data);
+
+/**
+ * Tracer callbacks
+ */
+typedef struct CassTracerCallbacks_ {
+  CassTracerStartCallback start_callback;
+  CassTracerEndCallback end_callback;
+  CassTracerContextCallback context_callback; /**< Optional (may be NULL) */
+} CassTracerCallbacks;
+
+/**
+ * A callback used to warn that a future callback blocked an I/O thread for
+ * longer than the configured threshold.
+ *
+ * @param[in] elapsed_us The time the callback ran in microseconds.
+ * @param[in] data
+ *
+ * @see cass_cluster_set_blocked_callback_warning()
+ */
+typedef void (*CassBlockedCallbackWarning)(cass_uint64_t elapsed_us,
+                                           void* data);
+
 /***********************************************************************************
  *
  * Execution Profile
@@ -1714,6 +1912,34 @@ CASS_EXPORT CassError
 cass_cluster_set_core_connections_per_host(CassCluster* cluster,
                                            unsigned num_connections);
 
+/**
+ * Sets how connection pools are warmed up when a session connects. Each IO
+ * thread connects its pools, local data center hosts first, with at most
+ * the given number of pools connecting at a time. The session is connected as
+ * soon as the given fraction of local data center pools are ready on every IO
+ * thread, or the time budget expires, instead of waiting for every pool. The
+ * remaining pools continue to connect in the background.
+ *
+ * <b>Default:</b> No limit on concurrent connects, 0.0 (disabled) and 0
+ * milliseconds (disabled). The session waits for every pool.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] max_concurrent_connects The maximum number of pools an IO thread
+ * connects at a time. A value of 0 connects all pools at once.
+ * @param[in] local_dc_ready_ratio The fraction of local data center pools that
+ * must be ready, between 0.0 and 1.0. A value of 0.0 disables this check.
+ * @param[in] timeout_ms The maximum amount of time to wait for pools once at
+ * least one pool is ready. A value of 0 disables the time budget.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_connection_warm_up(CassCluster* cluster,
+                                    unsigned max_concurrent_connects,
+                                    cass_double_t local_dc_ready_ratio,
+                                    unsigned timeout_ms);
+
 /**
  * Sets the maximum number of connections made to each server in each
  * IO thread.
@@ -2554,6 +2780,138 @@ CASS_EXPORT void
 cass_cluster_set_use_schema(CassCluster* cluster,
                             cass_bool_t enabled);
 
+/**
+ * Restricts schema metadata (tables, views, user types, functions and
+ * aggregates) to a set of keyspaces. This can greatly reduce the startup
+ * overhead and memory used for schema metadata on clusters with a large
+ * number of tables. The replication settings of all keyspaces are still
+ * loaded for token-aware routing.
+ *
+ * Examples: "keyspace1" "keyspace1,keyspace2"
+ *
+ * <b>Default:</b> An empty string (all keyspaces)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] keyspaces A comma delimited list of keyspace names. An empty
+ * string will clear the filter.
+ *
+ * @see cass_cluster_set_use_lazy_schema()
+ */
+CASS_EXPORT void
+cass_cluster_set_schema_keyspace_filter(CassCluster* cluster,
+                                        const char* keyspaces);
+
+/**
+ * Same as cass_cluster_set_schema_keyspace_filter(), but with lengths for
+ * string parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] keyspaces
+ * @param[in] keyspaces_length
+ *
+ * @see cass_cluster_set_schema_keyspace_filter()
+ */
+CASS_EXPORT void
+cass_cluster_set_schema_keyspace_filter_n(CassCluster* cluster,
+                                          const char* keyspaces,
+                                          size_t keyspaces_length);
+
+/**
+ * Enable/Disable lazy schema metadata. If enabled, only the keyspaces' metadata
+ * (including replication settings) is loaded when connecting and the rest of a
+ * keyspace's schema metadata is loaded the first time it's requested using
+ * cass_session_load_schema_keyspace(). Loaded keyspaces are kept up-to-date.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ *
+ * @see cass_session_load_schema_keyspace()
+ * @see cass_cluster_set_schema_keyspace_filter()
+ */
+CASS_EXPORT void
+cass_cluster_set_use_lazy_schema(CassCluster* cluster,
+                                 cass_bool_t enabled);
+
+/**
+ * Sets the debounce window for schema, topology and status events. Instead of
+ * refreshing metadata as soon as an event is received the control connection
+ * waits for more events and coalesces them: all the keyspaces, tables, types
+ * and nodes that changed are refreshed together and the token map is rebuilt
+ * once. This greatly reduces the overhead of large schema migrations and
+ * rolling restarts. Events are never delayed longer than the maximum delay even
+ * if they continue to arrive.
+ *
+ * <b>Default:</b> 0 milliseconds (disabled) and a maximum delay of 10000
+ * milliseconds.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] window_ms The amount of time to wait for more events after an
+ * event is received. A value of 0 disables debouncing.
+ * @param[in] max_delay_ms The maximum amount of time the first event of a batch
+ * can be delayed. This must be greater than or equal to the window.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_event_debounce(CassCluster* cluster,
+                                unsigned window_ms,
+                                unsigned max_delay_ms);
+
+/**
+ * Sets the file used to persist cluster metadata between sessions. When set,
+ * the schema metadata (including keyspace replication) and the results of
+ * prepared statements are loaded from the file when connecting and saved to
+ * the file when the session is closed.
+ *
+ * A session that's able to use the cached metadata doesn't wait for the schema
+ * metadata queries and can route requests token-aware as soon as it's
+ * connected. Statements prepared in a previous session are returned without a
+ * round trip to the cluster. The cached schema metadata is revalidated in the
+ * background right after connecting and prepared statements that are no longer
+ * known by the server are transparently re-prepared.
+ *
+ * The cached metadata is ignored if the file is missing, invalid, or if the
+ * protocol or server version of the cluster is different.
+ *
+ * <b>Default:</b> Disabled
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] file_name The path of the metadata cache file. An empty string
+ * disables the metadata cache.
+ */
+CASS_EXPORT void
+cass_cluster_set_metadata_cache_file(CassCluster* cluster,
+                                     const char* file_name);
+
+/**
+ * Same as cass_cluster_set_metadata_cache_file(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] file_name
+ * @param[in] file_name_length
+ * @return same as cass_cluster_set_metadata_cache_file()
+ *
+ * @see cass_cluster_set_metadata_cache_file()
+ */
+CASS_EXPORT void
+cass_cluster_set_metadata_cache_file_n(CassCluster* cluster,
+                                       const char* file_name,
+                                       size_t file_name_length);
+
 /**
  * Enable/Disable retrieving hostnames for IP addresses using reverse IP lookup.
  *
@@ -2720,6 +3078,31 @@ CASS_EXPORT CassError
 cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster,
                                            cass_bool_t enabled);
 
+/**
+ * Sets how cached prepared statements are pre-prepared on hosts that become
+ * available again or are added to the cluster. The most recently used
+ * statements are prepared first with up to the given number of prepare
+ * requests outstanding at a time. The host isn't used for queries until its
+ * statements are prepared or the deadline expires. After the deadline the
+ * remaining statements are prepared in the background.
+ *
+ * <b>Default:</b> 128 outstanding requests and 0 milliseconds (no deadline)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] max_outstanding The maximum number of outstanding prepare requests.
+ * @param[in] deadline_ms The amount of time to wait for statements to be
+ * prepared before using the host. A value of 0 waits for all statements.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_prepare_on_up_or_add_host()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_prepare_on_up_or_add_host_window(CassCluster* cluster,
+                                                  unsigned max_outstanding,
+                                                  unsigned deadline_ms);
+
 /**
  * Enable the <b>NO_COMPACT</b> startup option.
  *
@@ -2760,6 +3143,132 @@ cass_cluster_set_host_listener_callback(CassCluster* cluster,
                                         CassHostListenerCallback callback,
                                         void* data);
 
+/**
+ * Sets tracer callbacks that are invoked as requests execute. A request span
+ * is started when an I/O thread starts processing a request and is ended when
+ * its future is set. An attempt span, a child of the request span, is started
+ * each time the request is written to a host (retries and speculative
+ * executions) and is ended when its response, or an error, is received.
+ *
+ * The sampling decision is made once per request; requests that aren't
+ * sampled don't invoke any callbacks. The callbacks are invoked on the
+ * driver's I/O threads and must be thread-safe.
+ *
+ * <b>Default:</b> No tracer
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] callbacks The callbacks or NULL to remove the tracer.
+ * @param[in] sample_one_in_n On average one in this many requests are traced.
+ * A value of 1 traces every request and a value of 0 is invalid.
+ * @param[in] data An opaque data object passed to the callbacks.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_tracer_callbacks(CassCluster* cluster,
+                                  const CassTracerCallbacks* callbacks,
+                                  unsigned sample_one_in_n,
+                                  void* data);
+
+/**
+ * Enables an HTTP endpoint that serves the session's metrics in the
+ * OpenMetrics text format (compatible with Prometheus). The endpoint only
+ * listens on the loopback interface (127.0.0.1) and is served from its own
+ * thread while the session is connected. Scrape it using "GET /metrics".
+ *
+ * The request latency histograms are exported in seconds using power of two
+ * bucket bounds (in microseconds). Per-host connection, in-flight request and
+ * pool stats are also exported.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] port The local port to listen on or 0 to disable the endpoint.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_metrics_exporter_port(CassCluster* cluster,
+                                       int port);
+
+/**
+ * Enables recording the time each request spends in each of its stages
+ * (queued, query plan, write, network, decode, complete and callback). Each
+ * stage is aggregated into its own latency histogram, which uses additional
+ * memory per session and adds clock reads to every request.
+ *
+ * When disabled, the stage timestamps returned by cass_future_get_timings()
+ * are zero, except for the callback timestamps, and the stage metrics are
+ * empty.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_future_get_timings()
+ * @see cass_session_get_request_stage_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_request_stage_timings(CassCluster* cluster,
+                                       cass_bool_t enabled);
+
+/**
+ * Sets the interval of the probe that measures the saturation of each I/O
+ * thread (event loop). The probe is a timer that records how late it runs
+ * and how busy the I/O thread was since it last ran. A shorter interval
+ * detects shorter stalls but wakes the I/O threads more often.
+ *
+ * <b>Default:</b> 100 milliseconds
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] interval_ms The probe interval in milliseconds or 0 to disable
+ * the probe. When disabled, no event loop metrics are recorded.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_event_loop_metrics()
+ * @see cass_session_get_event_loop_lag_histogram()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_event_loop_probe_interval(CassCluster* cluster,
+                                           unsigned interval_ms);
+
+/**
+ * Sets a threshold for the time a future callback can run on an I/O thread.
+ * Callbacks run on the driver's I/O threads when a future is set, so a slow
+ * callback delays every other request handled by the same thread. A warning
+ * is logged, and the optional callback is invoked, each time a callback takes
+ * longer than the threshold.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] threshold_us The threshold in microseconds or 0 to disable the
+ * warning.
+ * @param[in] callback An optional callback invoked on the I/O thread after a
+ * blocking callback (may be NULL).
+ * @param[in] data An opaque data object passed to the callback.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_event_loop_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_blocked_callback_warning(CassCluster* cluster,
+                                          cass_uint64_t threshold_us,
+                                          CassBlockedCallbackWarning callback,
+                                          void* data);
+
 /**
  * Sets the secure connection bundle path for processing DBaaS credentials.
  *
@@ -3062,98 +3571,452 @@ cass_session_prepare_n(CassSession* session,
  *
  * @public @memberof CassSession
  *
- * @param[in] session
- * @param[in] statement
- * @return A future that must be freed.
+ * @param[in] session
+ * @param[in] statement
+ * @return A future that must be freed.
+ *
+ * @see cass_future_get_prepared()
+ */
+CASS_EXPORT CassFuture*
+cass_session_prepare_from_existing(CassSession* session,
+                                   CassStatement* statement);
+
+/**
+ * Execute a query or bound statement.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @return A future that must be freed.
+ *
+ * @see cass_future_get_result()
+ */
+CASS_EXPORT CassFuture*
+cass_session_execute(CassSession* session,
+                     const CassStatement* statement);
+
+/**
+ * Execute a batch statement.
+ *
+ * @cassandra{2.0+}
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] batch
+ * @return A future that must be freed.
+ *
+ * @see cass_future_get_result()
+ */
+CASS_EXPORT CassFuture*
+cass_session_execute_batch(CassSession* session,
+                           const CassBatch* batch);
+
+/**
+ * Loads the schema metadata (tables, views, user types, functions and
+ * aggregates) of a keyspace when using lazy schema metadata. The keyspace's
+ * schema metadata is available in schema snapshots returned by
+ * cass_session_get_schema_meta() after the future is set and it's kept
+ * up-to-date from then on. The future is set immediately if the keyspace is
+ * already loaded. Calls made while the keyspace is being loaded wait on the
+ * same load and if it fails they all fail, in which case the keyspace can be
+ * loaded again.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] keyspace
+ * @return A future that must be freed.
+ *
+ * @see cass_cluster_set_use_lazy_schema()
+ * @see cass_session_get_schema_meta()
+ */
+CASS_EXPORT CassFuture*
+cass_session_load_schema_keyspace(CassSession* session,
+                                  const char* keyspace);
+
+/**
+ * Same as cass_session_load_schema_keyspace(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] keyspace
+ * @param[in] keyspace_length
+ * @return same as cass_session_load_schema_keyspace()
+ *
+ * @see cass_session_load_schema_keyspace()
+ */
+CASS_EXPORT CassFuture*
+cass_session_load_schema_keyspace_n(CassSession* session,
+                                    const char* keyspace,
+                                    size_t keyspace_length);
+
+/**
+ * Gets a snapshot of this session's schema metadata. The returned
+ * snapshot of the schema metadata is not updated. This function
+ * must be called again to retrieve any schema changes since the
+ * previous call.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return A schema instance that must be freed.
+ *
+ * @see cass_schema_meta_free()
+ */
+CASS_EXPORT const CassSchemaMeta*
+cass_session_get_schema_meta(const CassSession* session);
+
+/**
+ * Gets a copy of this session's performance/diagnostic metrics.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_session_get_metrics(const CassSession* session,
+                         CassMetrics* output);
+
+/**
+ * Gets a copy of the request latency histogram (in microseconds). Unlike
+ * cass_session_get_metrics(), the snapshot keeps the recorded values so that
+ * any percentile can be computed and the histogram can be exported in the
+ * HdrHistogram format to be merged with histograms from other processes
+ * (percentiles can't be averaged).
+ *
+ * An interval snapshot only contains the requests completed since the
+ * previous interval snapshot of the session, so successive interval snapshots
+ * can be written to an HdrHistogram log.
+ *
+ * <b>Note:</b> The session has a single interval, so every interval snapshot
+ * starts a new interval for all callers. Only one consumer (e.g. a single
+ * reporting thread) should take interval snapshots.
+ *
+ * <b>Note:</b> Requests are recorded without locking, but taking a snapshot
+ * locks the histogram while the recorded values are copied. Snapshots are
+ * meant to be taken periodically, not per request.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] interval cass_true for the values recorded since the previous
+ * interval snapshot, otherwise cass_false for all recorded values.
+ * @return A histogram snapshot that must be freed or NULL if the session isn't
+ * connected.
+ *
+ * @see cass_histogram_snapshot_free()
+ */
+CASS_EXPORT const CassHistogramSnapshot*
+cass_session_get_request_latency_histogram(const CassSession* session,
+                                           cass_bool_t interval);
+
+/**
+ * Gets a copy of this session's speculative execution metrics.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_session_get_speculative_execution_metrics(const CassSession* session,
+                                               CassSpeculativeExecutionMetrics* output);
+
+/**
+ * Gets a copy of this session's metrics for a stage of its requests. Only
+ * requests that completed successfully are recorded and only if request stage
+ * timings are enabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] stage
+ * @param[out] output
+ *
+ * @see cass_future_get_timings()
+ * @see cass_cluster_set_request_stage_timings()
+ */
+CASS_EXPORT void
+cass_session_get_request_stage_metrics(const CassSession* session,
+                                       CassRequestStage stage,
+                                       CassRequestStageMetrics* output);
+
+/**
+ * Gets a copy of the saturation stats of one of this session's I/O threads
+ * (event loops). The stats are updated by a probe that runs on each event
+ * loop at the probe interval (every 100 milliseconds by default). A high utilization or lag means the I/O
+ * thread is saturated, e.g. by slow future callbacks, and requests handled
+ * by that thread are delayed.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] index The index of the I/O thread (0 to number of I/O threads - 1).
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS
+ * if the I/O thread doesn't exist or hasn't been probed yet.
+ *
+ * @see cass_cluster_set_num_threads_io()
+ * @see cass_cluster_set_event_loop_probe_interval()
+ */
+CASS_EXPORT CassError
+cass_session_get_event_loop_metrics(const CassSession* session,
+                                    size_t index,
+                                    CassEventLoopMetrics* output);
+
+/**
+ * Gets a copy of the event loop lag histogram (in microseconds) for all of
+ * this session's I/O threads. The lag is how late a periodic probe runs on an
+ * I/O thread compared to when it was scheduled.
+ *
+ * <b>Note:</b> Like cass_session_get_request_latency_histogram(), there's a
+ * single interval shared by all callers and taking a snapshot locks the
+ * histogram.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] interval cass_true for the values recorded since the previous
+ * interval snapshot, otherwise cass_false for all recorded values.
+ * @return A histogram snapshot that must be freed or NULL if the session isn't
+ * connected.
+ *
+ * @see cass_session_get_request_latency_histogram()
+ * @see cass_histogram_snapshot_free()
+ */
+CASS_EXPORT const CassHistogramSnapshot*
+cass_session_get_event_loop_lag_histogram(const CassSession* session,
+                                          cass_bool_t interval);
+
+/**
+ * Gets a copy of the stats of this session's open request connections (the
+ * control connection isn't included). The number of connections can change
+ * between calls so use an output array with room for a few extra connections.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output An array for the connection stats (may be NULL if
+ * output_count is 0).
+ * @param[in] output_count The number of elements in the output array.
+ * @return The number of open connections. Only the first output_count
+ * connections are copied to the output array.
+ */
+CASS_EXPORT size_t
+cass_session_get_connection_metrics(const CassSession* session,
+                                    CassConnectionMetrics* output,
+                                    size_t output_count);
+
+/**
+ * Get the client id.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return Client id.
+ */
+CASS_EXPORT CassUuid
+cass_session_get_client_id(CassSession* session);
+
+/***********************************************************************************
+ *
+ * Pager
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new pager for a statement. Pages are requested using the
+ * statement's paging state; the next page is requested as soon as the
+ * previous page arrives so that it's fetched while the application is
+ * processing the previous page.
+ *
+ * <b>Note:</b> The pager updates the statement's paging state as pages
+ * arrive. The statement must not be modified or executed elsewhere while the
+ * pager is in use.
+ *
+ * @public @memberof CassPager
+ *
+ * @param[in] session A connected session.
+ * @param[in] statement The statement to page. A page size must be set
+ * using cass_statement_set_paging_size().
+ * @return Returns a pager that must be freed.
+ *
+ * @see cass_pager_free()
+ */
+CASS_EXPORT CassPager*
+cass_pager_new(CassSession* session,
+               CassStatement* statement);
+
+/**
+ * Frees a pager instance. Pages that are in-flight are discarded when they
+ * arrive.
+ *
+ * @public @memberof CassPager
+ *
+ * @param[in] pager
+ */
+CASS_EXPORT void
+cass_pager_free(CassPager* pager);
+
+/**
+ * Sets the maximum number of pages fetched ahead of the application. A
+ * depth of zero disables prefetching and pages are only requested when
+ * cass_pager_next_page() is called.
+ *
+ * <b>Default:</b> 1
+ *
+ * @public @memberof CassPager
+ *
+ * @param[in] pager
+ * @param[in] prefetch_depth
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_pager_set_prefetch_depth(CassPager* pager,
+                              unsigned prefetch_depth);
+
+/**
+ * Sets the maximum number of bytes (the total size of the response bodies)
+ * that are buffered for pages fetched ahead of the application. Prefetching
+ * stops when the buffered pages reach this size and resumes as pages are
+ * consumed.
+ *
+ * <b>Default:</b> 16 MB
+ *
+ * @public @memberof CassPager
+ *
+ * @param[in] pager
+ * @param[in] prefetch_max_bytes
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_pager_set_prefetch_max_bytes(CassPager* pager,
+                                  size_t prefetch_max_bytes);
+
+/**
+ * Determines if the pager has pages that haven't been returned by
+ * cass_pager_next_page().
+ *
+ * @public @memberof CassPager
  *
- * @see cass_future_get_prepared()
+ * @param[in] pager
+ * @return cass_true if there are more pages, otherwise cass_false.
  */
-CASS_EXPORT CassFuture*
-cass_session_prepare_from_existing(CassSession* session,
-                                   CassStatement* statement);
+CASS_EXPORT cass_bool_t
+cass_pager_has_more_pages(CassPager* pager);
 
 /**
- * Execute a query or bound statement.
+ * Gets the next page. The returned future might already be ready if the
+ * page was prefetched.
  *
- * @public @memberof CassSession
+ * @public @memberof CassPager
  *
- * @param[in] session
- * @param[in] statement
- * @return A future that must be freed.
+ * @param[in] pager
+ * @return A future that must be freed. The future's error code is
+ * CASS_ERROR_LIB_NO_PAGING_STATE if there are no more pages.
  *
  * @see cass_future_get_result()
  */
 CASS_EXPORT CassFuture*
-cass_session_execute(CassSession* session,
-                     const CassStatement* statement);
+cass_pager_next_page(CassPager* pager);
+
+/***********************************************************************************
+ *
+ * Histogram Snapshot
+ *
+ ***********************************************************************************/
 
 /**
- * Execute a batch statement.
+ * Frees a histogram snapshot instance.
  *
- * @cassandra{2.0+}
+ * @public @memberof CassHistogramSnapshot
  *
- * @public @memberof CassSession
+ * @param[in] snapshot
+ */
+CASS_EXPORT void
+cass_histogram_snapshot_free(const CassHistogramSnapshot* snapshot);
+
+/**
+ * Gets the number of values in the histogram snapshot.
  *
- * @param[in] session
- * @param[in] batch
- * @return A future that must be freed.
+ * @public @memberof CassHistogramSnapshot
  *
- * @see cass_future_get_result()
+ * @param[in] snapshot
+ * @return The number of recorded values.
  */
-CASS_EXPORT CassFuture*
-cass_session_execute_batch(CassSession* session,
-                           const CassBatch* batch);
+CASS_EXPORT cass_int64_t
+cass_histogram_snapshot_total_count(const CassHistogramSnapshot* snapshot);
 
 /**
- * Gets a snapshot of this session's schema metadata. The returned
- * snapshot of the schema metadata is not updated. This function
- * must be called again to retrieve any schema changes since the
- * previous call.
+ * Gets the minimum value in the histogram snapshot.
  *
- * @public @memberof CassSession
+ * @public @memberof CassHistogramSnapshot
  *
- * @param[in] session
- * @return A schema instance that must be freed.
+ * @param[in] snapshot
+ * @return The minimum value or 0 if the snapshot is empty.
+ */
+CASS_EXPORT cass_int64_t
+cass_histogram_snapshot_min(const CassHistogramSnapshot* snapshot);
+
+/**
+ * Gets the maximum value in the histogram snapshot.
  *
- * @see cass_schema_meta_free()
+ * @public @memberof CassHistogramSnapshot
+ *
+ * @param[in] snapshot
+ * @return The maximum value or 0 if the snapshot is empty.
  */
-CASS_EXPORT const CassSchemaMeta*
-cass_session_get_schema_meta(const CassSession* session);
+CASS_EXPORT cass_int64_t
+cass_histogram_snapshot_max(const CassHistogramSnapshot* snapshot);
 
 /**
- * Gets a copy of this session's performance/diagnostic metrics.
+ * Gets the mean of the values in the histogram snapshot.
  *
- * @public @memberof CassSession
+ * @public @memberof CassHistogramSnapshot
  *
- * @param[in] session
- * @param[out] output
+ * @param[in] snapshot
+ * @return The mean or 0.0 if the snapshot is empty.
  */
-CASS_EXPORT void
-cass_session_get_metrics(const CassSession* session,
-                         CassMetrics* output);
+CASS_EXPORT cass_double_t
+cass_histogram_snapshot_mean(const CassHistogramSnapshot* snapshot);
 
 /**
- * Gets a copy of this session's speculative execution metrics.
+ * Gets the value at a percentile of the histogram snapshot.
  *
- * @public @memberof CassSession
+ * @public @memberof CassHistogramSnapshot
  *
- * @param[in] session
- * @param[out] output
+ * @param[in] snapshot
+ * @param[in] percentile A percentile from 0.0 to 100.0.
+ * @return The value at the percentile or 0 if the snapshot is empty.
  */
-CASS_EXPORT void
-cass_session_get_speculative_execution_metrics(const CassSession* session,
-                                               CassSpeculativeExecutionMetrics* output);
+CASS_EXPORT cass_int64_t
+cass_histogram_snapshot_value_at_percentile(const CassHistogramSnapshot* snapshot,
+                                            cass_double_t percentile);
 
 /**
- * Get the client id.
+ * Gets the histogram snapshot encoded as a compressed, base64 HdrHistogram V2
+ * histogram. This is the format of the histograms in HdrHistogram log files
+ * and can be decoded by the HdrHistogram libraries, e.g. to merge the
+ * histograms of several processes.
  *
- * @public @memberof CassSession
+ * @public @memberof CassHistogramSnapshot
  *
- * @param[in] session
- * @return Client id.
+ * @param[in] snapshot
+ * @param[out] output The encoded histogram. It's valid until the snapshot is
+ * freed.
+ * @param[out] output_length
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_NOT_IMPLEMENTED if
+ * the driver was built without zlib.
  */
-CASS_EXPORT CassUuid
-cass_session_get_client_id(CassSession* session);
+CASS_EXPORT CassError
+cass_histogram_snapshot_encode(const CassHistogramSnapshot* snapshot,
+                               const char** output,
+                               size_t* output_length);
 
 /***********************************************************************************
  *
@@ -4964,6 +5827,27 @@ CASS_EXPORT CassError
 cass_future_tracing_id(CassFuture* future,
                        CassUuid* tracing_id);
 
+/**
+ * Gets the timestamps recorded at each stage of the request. If the future is
+ * not ready this method will wait for the future to be set.
+ *
+ * <b>Note:</b> The callback timestamps are recorded after the future is set
+ * so they may be zero when called from the future's callback or while the
+ * callback is still running. The other timestamps are only recorded if
+ * request stage timings are enabled.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] future
+ * @param[out] timings
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_request_stage_metrics()
+ */
+CASS_EXPORT CassError
+cass_future_get_timings(CassFuture* future,
+                        CassRequestTimings* timings);
+
 /**
  * Gets a the number of custom payload items from a response future. If the future is not
  * ready this method will wait for the future to be set.
@@ -5212,6 +6096,32 @@ cass_statement_set_paging_state_token(CassStatement* statement,
                                       const char* paging_state,
                                       size_t paging_state_size);
 
+/**
+ * Sets a callback that's passed each row of the statement's result as soon as
+ * the row is received, instead of buffering the whole page. This allows very
+ * large pages to be processed in constant memory. The result returned by the
+ * statement's future contains the metadata and paging state, but no rows.
+ *
+ * <b>Important:</b> The callback is called on one of the driver's I/O threads
+ * and must not block. The row (and its values) are only valid for the
+ * duration of the callback. A statement with a row callback is never
+ * speculatively executed and it isn't retried after its connection is closed
+ * because rows could have already been passed to the callback.
+ *
+ * <b>Default:</b> NULL (the rows are buffered in the result)
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] callback The row callback. Use NULL to buffer the rows.
+ * @param[in] data User data that's passed to the callback.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_set_row_callback(CassStatement* statement,
+                                CassRowCallback callback,
+                                void* data);
+
 /**
  * Sets the statement's timestamp.
  *
@@ -7610,6 +8520,102 @@ cass_collection_append_duration(CassCollection* collection,
                                 cass_int32_t days,
                                 cass_int64_t nanos);
 
+/**
+ * Appends an array of "int"s to the collection. The elements are
+ * validated once and encoded directly into the collection which is much
+ * faster than appending them one at a time for large collections.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] count The number of elements in the array.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_int32()
+ */
+CASS_EXPORT CassError
+cass_collection_append_int32_array(CassCollection* collection,
+                                   const cass_int32_t* values,
+                                   size_t count);
+
+/**
+ * Appends an array of "bigint"s, "counter"s, "timestamp"s or "time"s to the
+ * collection. The elements are validated once and encoded directly into the
+ * collection which is much faster than appending them one at a time for large
+ * collections.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] count The number of elements in the array.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_int64()
+ */
+CASS_EXPORT CassError
+cass_collection_append_int64_array(CassCollection* collection,
+                                   const cass_int64_t* values,
+                                   size_t count);
+
+/**
+ * Appends an array of "float"s to the collection. The elements are
+ * validated once and encoded directly into the collection which is much
+ * faster than appending them one at a time for large collections.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] count The number of elements in the array.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_float()
+ */
+CASS_EXPORT CassError
+cass_collection_append_float_array(CassCollection* collection,
+                                   const cass_float_t* values,
+                                   size_t count);
+
+/**
+ * Appends an array of "double"s to the collection. The elements are
+ * validated once and encoded directly into the collection which is much
+ * faster than appending them one at a time for large collections.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] count The number of elements in the array.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_double()
+ */
+CASS_EXPORT CassError
+cass_collection_append_double_array(CassCollection* collection,
+                                    const cass_double_t* values,
+                                    size_t count);
+
+/**
+ * Appends an array of "timeuuid"s or "uuid"s to the collection. The elements are
+ * validated once and encoded directly into the collection which is much
+ * faster than appending them one at a time for large collections.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] count The number of elements in the array.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_uuid()
+ */
+CASS_EXPORT CassError
+cass_collection_append_uuid_array(CassCollection* collection,
+                                  const CassUuid* values,
+                                  size_t count);
+
 /**
  * Appends a "list", "map" or "set" to the collection.
  *
@@ -10700,6 +11706,107 @@ cass_value_primary_sub_type(const CassValue* collection);
 CASS_EXPORT CassValueType
 cass_value_secondary_sub_type(const CassValue* collection);
 
+/**
+ * Gets every element of a list or set of "int"s in a single pass. This
+ * avoids creating an iterator and a value per element for large collections.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array with room for at least cass_value_item_count()
+ * elements.
+ * @param[in] output_count The number of elements in the output array.
+ * @return CASS_OK if successful, otherwise error occurred. CASS_ERROR_LIB_NULL_VALUE
+ * is returned if the collection contains a NULL element.
+ *
+ * @see cass_value_get_int32()
+ */
+CASS_EXPORT CassError
+cass_value_get_int32_array(const CassValue* collection,
+                           cass_int32_t* output,
+                           size_t output_count);
+
+/**
+ * Gets every element of a list or set of "bigint"s, "counter"s, "timestamp"s
+ * or "time"s in a single pass. This avoids creating an iterator and a value
+ * per element for large collections.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array with room for at least cass_value_item_count()
+ * elements.
+ * @param[in] output_count The number of elements in the output array.
+ * @return CASS_OK if successful, otherwise error occurred. CASS_ERROR_LIB_NULL_VALUE
+ * is returned if the collection contains a NULL element.
+ *
+ * @see cass_value_get_int64()
+ */
+CASS_EXPORT CassError
+cass_value_get_int64_array(const CassValue* collection,
+                           cass_int64_t* output,
+                           size_t output_count);
+
+/**
+ * Gets every element of a list or set of "float"s in a single pass. This
+ * avoids creating an iterator and a value per element for large collections.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array with room for at least cass_value_item_count()
+ * elements.
+ * @param[in] output_count The number of elements in the output array.
+ * @return CASS_OK if successful, otherwise error occurred. CASS_ERROR_LIB_NULL_VALUE
+ * is returned if the collection contains a NULL element.
+ *
+ * @see cass_value_get_float()
+ */
+CASS_EXPORT CassError
+cass_value_get_float_array(const CassValue* collection,
+                           cass_float_t* output,
+                           size_t output_count);
+
+/**
+ * Gets every element of a list or set of "double"s in a single pass. This
+ * avoids creating an iterator and a value per element for large collections.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array with room for at least cass_value_item_count()
+ * elements.
+ * @param[in] output_count The number of elements in the output array.
+ * @return CASS_OK if successful, otherwise error occurred. CASS_ERROR_LIB_NULL_VALUE
+ * is returned if the collection contains a NULL element.
+ *
+ * @see cass_value_get_double()
+ */
+CASS_EXPORT CassError
+cass_value_get_double_array(const CassValue* collection,
+                            cass_double_t* output,
+                            size_t output_count);
+
+/**
+ * Gets every element of a list or set of "timeuuid"s or "uuid"s in a single pass. This
+ * avoids creating an iterator and a value per element for large collections.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array with room for at least cass_value_item_count()
+ * elements.
+ * @param[in] output_count The number of elements in the output array.
+ * @return CASS_OK if successful, otherwise error occurred. CASS_ERROR_LIB_NULL_VALUE
+ * is returned if the collection contains a NULL element.
+ *
+ * @see cass_value_get_uuid()
+ */
+CASS_EXPORT CassError
+cass_value_get_uuid_array(const CassValue* collection,
+                          CassUuid* output,
+                          size_t output_count);
+
 
 /***********************************************************************************
  *
@@ -10754,7 +11861,14 @@ cass_uuid_gen_free(CassUuidGen* uuid_gen);
 /**
  * Generates a V1 (time) UUID.
  *
- * <b>Note:</b> This method is thread-safe
+ * <b>Note:</b> This method is thread-safe. Each thread that generates V1
+ * UUIDs is assigned its own clock sequence, the one that follows the
+ * generator's clock sequence or the previous thread's. UUIDs generated by
+ * different threads therefore differ in their clock sequence, and each
+ * thread's UUIDs are monotonically increasing. Once all 16,384 clock
+ * sequences are assigned, the remaining threads share the generator's clock
+ * sequence. cass_uuid_gen_from_time() always uses the generator's clock
+ * sequence.
  *
  * @public @memberof CassUuidGen
  *
@@ -10765,6 +11879,27 @@ CASS_EXPORT void
 cass_uuid_gen_time(CassUuidGen* uuid_gen,
                    CassUuid* output);
 
+/**
+ * Generates multiple V1 (time) UUIDs.
+ *
+ * <b>Note:</b> This method is thread-safe. UUIDs are generated the same way as
+ * cass_uuid_gen_time(), using the calling thread's clock sequence. If more
+ * than 10,000 UUIDs are requested in a millisecond, then generating them waits
+ * for the clock instead of running ahead of it.
+ *
+ * @public @memberof CassUuidGen
+ *
+ * @param[in] uuid_gen
+ * @param[out] outputs An array of at least count UUIDs.
+ * @param[in] count The number of V1 UUIDs to generate.
+ *
+ * @see cass_uuid_gen_time()
+ */
+CASS_EXPORT void
+cass_uuid_gen_time_batch(CassUuidGen* uuid_gen,
+                         CassUuid* outputs,
+                         size_t count);
+
 /**
  * Generates a new V4 (random) UUID
  *
@@ -10779,6 +11914,24 @@ CASS_EXPORT void
 cass_uuid_gen_random(CassUuidGen* uuid_gen,
                      CassUuid* output);
 
+/**
+ * Generates multiple V4 (random) UUIDs.
+ *
+ * <b>Note:</b>: This method is thread-safe
+ *
+ * @public @memberof CassUuidGen
+ *
+ * @param[in] uuid_gen
+ * @param[out] outputs An array of at least count UUIDs.
+ * @param[in] count The number of V4 UUIDs to generate.
+ *
+ * @see cass_uuid_gen_random()
+ */
+CASS_EXPORT void
+cass_uuid_gen_random_batch(CassUuidGen* uuid_gen,
+                           CassUuid* outputs,
+                           size_t count);
+
 /**
  * Generates a V1 (time) UUID for the specified time.
  *
@@ -10957,6 +12110,39 @@ CASS_EXPORT CassTimestampGen*
 cass_timestamp_gen_monotonic_new_with_settings(cass_int64_t warning_threshold_us,
                                                cass_int64_t warning_interval_ms);
 
+/**
+ * Creates a new monotonically increasing timestamp generator with microsecond
+ * precision that reserves blocks of timestamps for each thread.
+ *
+ * The generator returned by cass_timestamp_gen_monotonic_new() updates a
+ * single shared timestamp for every request, which can become a point of
+ * contention when many threads execute requests. This generator only updates
+ * the shared timestamp once per block. Each thread's timestamps are
+ * monotonically increasing, but a timestamp can be up to the block size
+ * behind a timestamp already generated by another thread. Timestamps are
+ * never generated twice by the same generator.
+ *
+ * <b>Note:</b> This generator is thread-safe and can be shared by multiple
+ * sessions.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassTimestampGen
+ *
+ * @param[in] block_size_us The number of microseconds reserved for a thread at a
+ * time. A thread can generate a timestamp up to this much behind a timestamp
+ * already generated by another thread. A block never starts more than this
+ * past the current time, so a thread that uses up its block faster than the
+ * clock advances waits for the clock before reserving the next one. Values
+ * less than 1 are treated as 1.
+ * @return Returns a timestamp generator that must be freed.
+ *
+ * @see cass_timestamp_gen_monotonic_new()
+ * @see cass_timestamp_gen_free()
+ */
+CASS_EXPORT CassTimestampGen*
+cass_timestamp_gen_batched_monotonic_new(cass_int64_t block_size_us);
+
 /**
  * Frees a timestamp generator instance.
  *
@@ -11240,11 +12426,17 @@ cass_error_desc(CassError error);
  * This *MUST* be the last call using the library. It is an error
  * to call any cass_*() functions after this call.
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
+ * <b>Note:</b> This only needs to be called when asynchronous logging is
+ * enabled. Queued log messages that haven't been passed to the callback are
+ * lost if this isn't called before the application exits.
+ *
+ * <b>Warning:</b> This is not thread-safe. It must not be called while other
+ * threads might log, so all sessions and clusters must be freed first.
+ *
+ * @see cass_log_set_queue_size()
  */
-CASS_EXPORT CASS_DEPRECATED(void
-cass_log_cleanup());
+CASS_EXPORT void
+cass_log_cleanup();
 
 /**
  * Sets the log level.
@@ -11276,20 +12468,64 @@ cass_log_set_callback(CassLogCallback callback,
                       void* data);
 
 /**
- * Sets the log queue size.
+ * Sets the log queue size and enables asynchronous logging. Log messages are
+ * queued without blocking the logging thread, and the log callback is called
+ * by a separate logging thread. Messages are dropped when the queue is full,
+ * and the number of dropped messages is logged as a warning once the queue
+ * has drained.
  *
  * <b>Note:</b> This needs to be done before any call that might log, such as
- * any of the cass_cluster_*() or cass_ssl_*() functions.
+ * any of the cass_cluster_*() or cass_ssl_*() functions, and after
+ * cass_log_set_callback(). The callback is read by the logging thread without
+ * synchronization, so changing it afterwards isn't safe.
  *
- * <b>Default:</b> 2048
+ * <b>Warning:</b> This is not thread-safe. Changing the queue size frees the
+ * current queue, so it must not be called while other threads might log.
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
+ * <b>Default:</b> 0 (Asynchronous logging is disabled and the callback is
+ * called by the thread that logs the message)
  *
- * @param[in] queue_size
+ * @param[in] queue_size The maximum number of queued log messages. A value of
+ * 0 disables asynchronous logging.
+ *
+ * @see cass_log_cleanup()
  */
-CASS_EXPORT CASS_DEPRECATED(void
-cass_log_set_queue_size(size_t queue_size));
+CASS_EXPORT void
+cass_log_set_queue_size(size_t queue_size);
+
+/**
+ * Limits the number of messages each log statement in the driver logs per
+ * second. Messages over the limit are suppressed and the number of suppressed
+ * messages is logged with the statement's next message.
+ *
+ * <b>Default:</b> 0 (No limit)
+ *
+ * @param[in] max_messages_per_second The maximum number of messages per
+ * second for each log statement. A value of 0 disables the limit.
+ */
+CASS_EXPORT void
+cass_log_set_rate_limit(unsigned max_messages_per_second);
+
+/**
+ * Sets the rate at which requests are sampled for tracing. The trace messages
+ * of a sampled request are logged with the CASS_LOG_TRACE severity regardless
+ * of the log level, from the time it's executed until it completes. Each
+ * message is prefixed with a request ID, and messages written to or read from
+ * connections include the stream ID, so the messages of a request can be
+ * correlated. This allows request-level diagnostics to be left on with a
+ * bounded cost.
+ *
+ * <b>Note:</b> All requests are traced when the log level is CASS_LOG_TRACE.
+ *
+ * <b>Default:</b> 0 (No requests are sampled)
+ *
+ * @param[in] one_in_n On average one in this many requests are sampled. A
+ * value of 0 disables sampling.
+ *
+ * @see cass_log_set_rate_limit()
+ */
+CASS_EXPORT void
+cass_log_set_trace_sample_rate(unsigned one_in_n);
 
 /**
  * Gets the string for a log level.
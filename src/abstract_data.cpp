@@ -32,7 +32,7 @@ CassError AbstractData::set(size_t index, CassNull value) {
 
 CassError AbstractData::set(size_t index, const Collection* value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
-  if (value->type() == CASS_COLLECTION_TYPE_MAP && value->items().size() % 2 != 0) {
+  if (value->type() == CASS_COLLECTION_TYPE_MAP && value->item_count() % 2 != 0) {
     return CASS_ERROR_LIB_INVALID_ITEM_COUNT;
   }
   elements_[index] = value;
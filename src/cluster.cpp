@@ -125,6 +125,27 @@ public:
   virtual void on_close(Cluster* cluster) {}
 };
 
+/**
+ * A task for loading the schema metadata of a keyspace.
+ */
+class ClusterLoadSchemaKeyspace : public Task {
+public:
+  ClusterLoadSchemaKeyspace(const Cluster::Ptr& cluster, const String& keyspace_name,
+                            const Future::Ptr& future)
+      : cluster_(cluster)
+      , keyspace_name_(keyspace_name)
+      , future_(future) {}
+
+  void run(EventLoop* event_loop) {
+    cluster_->internal_load_schema_keyspace(keyspace_name_, future_);
+  }
+
+private:
+  Cluster::Ptr cluster_;
+  String keyspace_name_;
+  Future::Ptr future_;
+};
+
 }}} // namespace datastax::internal::core
 
 void ClusterEvent::process_event(const ClusterEvent& event, ClusterListener* listener) {
@@ -179,6 +200,11 @@ Host::Ptr LockedHostMap::get(const Address& address) const {
   return it->second;
 }
 
+HostMap LockedHostMap::copy() const {
+  ScopedMutex l(&mutex_);
+  return hosts_;
+}
+
 void LockedHostMap::erase(const Address& address) {
   ScopedMutex l(&mutex_);
   hosts_.erase(address);
@@ -200,7 +226,8 @@ ClusterSettings::ClusterSettings()
     , port(CASS_DEFAULT_PORT)
     , reconnection_policy(new ExponentialReconnectionPolicy())
     , prepare_on_up_or_add_host(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST)
-    , max_prepares_per_flush(CASS_DEFAULT_MAX_PREPARES_PER_FLUSH)
+    , max_prepares_outstanding(CASS_DEFAULT_MAX_PREPARES_OUTSTANDING)
+    , prepare_on_up_or_add_host_timeout_ms(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_TIMEOUT_MS)
     , disable_events_on_startup(false)
     , cluster_metadata_resolver_factory(new DefaultClusterMetadataResolverFactory()) {
   load_balancing_policies.push_back(load_balancing_policy);
@@ -213,7 +240,8 @@ ClusterSettings::ClusterSettings(const Config& config)
     , port(config.port())
     , reconnection_policy(config.reconnection_policy())
     , prepare_on_up_or_add_host(config.prepare_on_up_or_add_host())
-    , max_prepares_per_flush(CASS_DEFAULT_MAX_PREPARES_PER_FLUSH)
+    , max_prepares_outstanding(config.max_prepares_outstanding())
+    , prepare_on_up_or_add_host_timeout_ms(config.prepare_on_up_or_add_host_timeout_ms())
     , disable_events_on_startup(false)
     , cluster_metadata_resolver_factory(config.cluster_metadata_resolver_factory()) {}
 
@@ -229,12 +257,17 @@ Cluster::Cluster(const ControlConnection::Ptr& connection, ClusterListener* list
     , load_balancing_policy_(load_balancing_policy)
     , load_balancing_policies_(load_balancing_policies)
     , settings_(settings)
+    , control_connection_settings_(settings.control_connection_settings)
     , is_closing_(false)
     , connected_host_(connected_host)
     , hosts_(hosts)
+    , is_token_map_build_deferred_(false)
+    , is_token_map_build_pending_(false)
     , local_dc_(local_dc)
     , supported_options_(supported_options)
-    , is_recording_events_(settings.disable_events_on_startup) {
+    , is_recording_events_(settings.disable_events_on_startup)
+    , metadata_cache_(settings.control_connection_settings.metadata_cache)
+    , is_schema_stale_(false) {
   inc_ref();
   connection_->set_listener(this);
 
@@ -243,6 +276,18 @@ Cluster::Cluster(const ControlConnection::Ptr& connection, ClusterListener* list
   update_schema(schema);
   update_token_map(hosts, connected_host_->partitioner(), schema);
 
+  if (metadata_cache_) {
+    // Reconnecting always queries the schema metadata from the cluster.
+    control_connection_settings_.metadata_cache.reset();
+    schema_ = schema;
+    schema_scope_ = schema_metadata_scope(settings.control_connection_settings);
+  }
+
+  if (schema.is_cached) {
+    // The cluster might have changed since the cache was saved.
+    connection_->refresh_schema();
+  }
+
   listener_->on_reconnect(this);
 }
 
@@ -263,12 +308,16 @@ void Cluster::start_monitor_reporting(const String& client_id, const String& ses
   event_loop_->add(new ClusterStartClientMonitor(Ptr(this), client_id, session_id, config));
 }
 
+void Cluster::load_schema_keyspace(const String& keyspace_name, const Future::Ptr& future) {
+  event_loop_->add(new ClusterLoadSchemaKeyspace(Ptr(this), keyspace_name, future));
+}
+
 Metadata::SchemaSnapshot Cluster::schema_snapshot() { return metadata_.schema_snapshot(); }
 
 Host::Ptr Cluster::find_host(const Address& address) const { return hosts_.get(address); }
 
-PreparedMetadata::Entry::Ptr Cluster::prepared(const String& id) const {
-  return prepared_metadata_.get(id);
+PreparedMetadata::Entry::Ptr Cluster::prepared(const String& id, uint64_t id_hash) const {
+  return prepared_metadata_.get(id, id_hash);
 }
 
 void Cluster::prepared(const String& id, const PreparedMetadata::Entry::Ptr& entry) {
@@ -403,7 +452,7 @@ void Cluster::handle_schedule_reconnect() {
   if (host) {
     reconnector_.reset(new ControlConnector(host, connection_->protocol_version(),
                                             bind_callback(&Cluster::on_reconnect, this)));
-    reconnector_->with_settings(settings_.control_connection_settings)
+    reconnector_->with_settings(control_connection_settings_)
         ->connect(connection_->loop());
   } else {
     // No more hosts, refresh the query plan and schedule a re-connection
@@ -435,6 +484,14 @@ void Cluster::on_reconnect(ControlConnector* connector) {
     update_schema(connector->schema());
     update_token_map(connector->hosts(), connected_host_->partitioner(), connector->schema());
 
+    if (metadata_cache_) {
+      schema_ = connector->schema();
+      schema_scope_ = schema_metadata_scope(control_connection_settings_);
+      is_schema_stale_ = false;
+      // The schema might have changed while disconnected
+      metadata_cache_->invalidate_prepared();
+    }
+
     // Notify the listener that we've built a new token map
     if (token_map_) {
       notify_or_record(ClusterEvent(token_map_));
@@ -471,6 +528,15 @@ void Cluster::handle_close() {
        it != end; ++it) {
     (*it)->close_handles();
   }
+  fail_pending_schema_keyspaces(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Cluster is closing");
+  if (metadata_cache_ && connection_) {
+    if (is_schema_stale_) {
+      metadata_cache_->clear_schema();
+    } else {
+      metadata_cache_->set_schema(connection_->protocol_version(), connection_->server_version(),
+                                  connection_->dse_server_version(), schema_scope_, schema_);
+    }
+  }
   connection_.reset();
   listener_->on_close(this);
   dec_ref();
@@ -549,6 +615,33 @@ void Cluster::internal_start_events() {
   }
 }
 
+void Cluster::internal_load_schema_keyspace(const String& keyspace_name,
+                                            const Future::Ptr& future) {
+  ControlConnectionSettings& settings = control_connection_settings_;
+
+  if (!settings.use_schema) {
+    future->set_error(CASS_ERROR_LIB_BAD_PARAMS, "Schema metadata is disabled");
+  } else if (settings.is_schema_keyspace_loaded(keyspace_name)) {
+    future->set();
+  } else if (!settings.is_schema_keyspace_allowed(keyspace_name)) {
+    future->set_error(CASS_ERROR_LIB_BAD_PARAMS,
+                      "Keyspace '" + keyspace_name + "' is not allowed by the schema keyspace filter");
+  } else if (is_closing_) {
+    future->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Cluster is closing");
+  } else if (reconnector_ || connection_->connection()->is_closing()) {
+    future->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Control connection is not available");
+  } else {
+    // Concurrent requests for the same keyspace wait on the same load. The
+    // keyspace is only recorded, so that it's also loaded by future control
+    // connections, once its schema metadata has been loaded successfully.
+    Vector<Future::Ptr>& futures = pending_schema_keyspaces_[keyspace_name];
+    futures.push_back(future);
+    if (futures.size() == 1) {
+      connection_->load_keyspace_schema(keyspace_name);
+    }
+  }
+}
+
 void Cluster::internal_start_monitor_reporting(const String& client_id, const String& session_id,
                                                const Config& config) {
   monitor_reporting_.reset(create_monitor_reporting(client_id, session_id, config));
@@ -604,9 +697,14 @@ void Cluster::notify_host_add(const Host::Ptr& host) {
 
 void Cluster::notify_host_add_after_prepare(const Host::Ptr& host) {
   if (token_map_) {
-    token_map_ = token_map_->copy();
-    token_map_->update_host_and_build(host);
-    notify_or_record(ClusterEvent(token_map_));
+    if (defer_token_map_build()) {
+      token_map_->remove_host(host);
+      token_map_->add_host(host);
+    } else {
+      token_map_ = token_map_->copy();
+      token_map_->update_host_and_build(host);
+      notify_or_record(ClusterEvent(token_map_));
+    }
   }
   notify_or_record(ClusterEvent(ClusterEvent::HOST_ADD, host));
 }
@@ -622,9 +720,13 @@ void Cluster::notify_host_remove(const Address& address) {
   Host::Ptr host(it->second);
 
   if (token_map_) {
-    token_map_ = token_map_->copy();
-    token_map_->remove_host_and_build(host);
-    notify_or_record(ClusterEvent(token_map_));
+    if (defer_token_map_build()) {
+      token_map_->remove_host(host);
+    } else {
+      token_map_ = token_map_->copy();
+      token_map_->remove_host_and_build(host);
+      notify_or_record(ClusterEvent(token_map_));
+    }
   }
 
   // If not marked down yet then explicitly trigger the event.
@@ -650,11 +752,23 @@ void Cluster::notify_or_record(const ClusterEvent& event) {
   }
 }
 
+bool Cluster::defer_token_map_build() {
+  if (!is_token_map_build_deferred_) return false;
+  if (!is_token_map_build_pending_) {
+    // The current token map may be in use so it's copied once for the whole
+    // batch.
+    token_map_ = token_map_->copy();
+    is_token_map_build_pending_ = true;
+  }
+  return true;
+}
+
 bool Cluster::prepare_host(const Host::Ptr& host, const PrepareHostHandler::Callback& callback) {
   if (connection_ && settings_.prepare_on_up_or_add_host) {
     PrepareHostHandler::Ptr prepare_host_handler(
         new PrepareHostHandler(host, prepared_metadata_.copy(), callback,
-                               connection_->protocol_version(), settings_.max_prepares_per_flush));
+                               connection_->protocol_version(), settings_.max_prepares_outstanding,
+                               settings_.prepare_on_up_or_add_host_timeout_ms));
 
     prepare_host_handler->prepare(connection_->loop(),
                                   settings_.control_connection_settings.connection_settings);
@@ -673,14 +787,23 @@ void Cluster::on_prepare_host_up(const PrepareHostHandler* handler) {
 
 void Cluster::on_update_schema(SchemaType type, const ResultResponse::Ptr& result,
                                const String& keyspace_name, const String& target_name) {
+  // Keyspaces loaded on demand aren't part of the cached schema metadata
+  if (pending_schema_keyspaces_.find(keyspace_name) == pending_schema_keyspaces_.end()) {
+    handle_schema_change(type);
+  }
+
   switch (type) {
     case KEYSPACE:
       // Virtual keyspaces are not updated (always false)
       metadata_.update_keyspaces(result.get(), false);
       if (token_map_) {
-        token_map_ = token_map_->copy();
-        token_map_->update_keyspaces_and_build(connection_->server_version(), result.get());
-        notify_or_record(ClusterEvent(token_map_));
+        if (defer_token_map_build()) {
+          token_map_->add_keyspaces(connection_->server_version(), result.get());
+        } else {
+          token_map_ = token_map_->copy();
+          token_map_->update_keyspaces_and_build(connection_->server_version(), result.get());
+          notify_or_record(ClusterEvent(token_map_));
+        }
       }
       break;
     case TABLE:
@@ -709,13 +832,19 @@ void Cluster::on_update_schema(SchemaType type, const ResultResponse::Ptr& resul
 
 void Cluster::on_drop_schema(SchemaType type, const String& keyspace_name,
                              const String& target_name) {
+  handle_schema_change(type);
+
   switch (type) {
     case KEYSPACE:
       metadata_.drop_keyspace(keyspace_name);
       if (token_map_) {
-        token_map_ = token_map_->copy();
-        token_map_->drop_keyspace(keyspace_name);
-        notify_or_record(ClusterEvent(token_map_));
+        if (defer_token_map_build()) {
+          token_map_->drop_keyspace(keyspace_name);
+        } else {
+          token_map_ = token_map_->copy();
+          token_map_->drop_keyspace(keyspace_name);
+          notify_or_record(ClusterEvent(token_map_));
+        }
       }
       break;
     case TABLE:
@@ -758,9 +887,83 @@ void Cluster::on_add(const Host::Ptr& host) { notify_host_add(host); }
 
 void Cluster::on_remove(const Address& address) { notify_host_remove(address); }
 
+void Cluster::on_refresh_batch_begin() { is_token_map_build_deferred_ = true; }
+
+void Cluster::on_refresh_batch_end() {
+  is_token_map_build_deferred_ = false;
+  if (is_token_map_build_pending_) {
+    is_token_map_build_pending_ = false;
+    token_map_->build();
+    notify_or_record(ClusterEvent(token_map_));
+  }
+}
+
+void Cluster::on_refresh_schema(const ControlConnectionSchema& schema) {
+  LOG_DEBUG("Replacing schema metadata with refreshed schema metadata");
+
+  update_schema(schema);
+  update_token_map(hosts_, connected_host_->partitioner(), schema);
+
+  if (token_map_) {
+    notify_or_record(ClusterEvent(token_map_));
+  }
+
+  if (metadata_cache_) {
+    schema_ = schema;
+    schema_scope_ = schema_metadata_scope(control_connection_settings_);
+    is_schema_stale_ = false;
+  }
+}
+
+void Cluster::handle_schema_change(SchemaType type) {
+  if (!metadata_cache_) return;
+
+  // The saved schema metadata is only updated by full refreshes so it's
+  // discarded when the cluster is closed.
+  is_schema_stale_ = true;
+
+  // Prepared statements need to be prepared again to get the new result
+  // metadata. Keyspace changes don't affect the result metadata.
+  if (type != KEYSPACE) {
+    metadata_cache_->invalidate_prepared();
+  }
+}
+
+void Cluster::on_load_keyspace_schema(const String& keyspace_name, CassError error_code,
+                                      const String& error_message) {
+  PendingSchemaKeyspaceMap::iterator it = pending_schema_keyspaces_.find(keyspace_name);
+  if (it == pending_schema_keyspaces_.end()) return;
+
+  ControlConnectionSettings& settings = control_connection_settings_;
+  if (error_code == CASS_OK && !settings.is_schema_keyspace_loaded(keyspace_name)) {
+    settings.lazy_schema_keyspaces.push_back(keyspace_name);
+  }
+
+  Vector<Future::Ptr> futures;
+  futures.swap(it->second);
+  pending_schema_keyspaces_.erase(it);
+  for (Vector<Future::Ptr>::const_iterator i = futures.begin(), end = futures.end(); i != end;
+       ++i) {
+    if (error_code == CASS_OK) {
+      (*i)->set();
+    } else {
+      (*i)->set_error(error_code, error_message);
+    }
+  }
+}
+
+void Cluster::fail_pending_schema_keyspaces(CassError error_code, const String& error_message) {
+  while (!pending_schema_keyspaces_.empty()) {
+    String keyspace_name(pending_schema_keyspaces_.begin()->first);
+    on_load_keyspace_schema(keyspace_name, error_code, error_message);
+  }
+}
+
 void Cluster::on_close(ControlConnection* connection) {
   if (!is_closing_) {
     LOG_WARN("Lost control connection to host %s", connection_->address_string().c_str());
+    fail_pending_schema_keyspaces(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+                                  "Lost the control connection while loading schema metadata");
     schedule_reconnect();
   } else {
     handle_close();
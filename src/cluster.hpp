@@ -21,10 +21,12 @@
 #include "control_connector.hpp"
 #include "event_loop.hpp"
 #include "external.hpp"
+#include "map.hpp"
 #include "metadata.hpp"
 #include "monitor_reporting.hpp"
 #include "prepare_host_handler.hpp"
 #include "prepared.hpp"
+#include "vector.hpp"
 
 #include <uv.h>
 
@@ -48,6 +50,8 @@ public:
 
   Host::Ptr get(const Address& address) const;
 
+  HostMap copy() const;
+
   void erase(const Address& address);
 
   Host::Ptr& operator[](const Address& address);
@@ -204,9 +208,17 @@ struct ClusterSettings {
   bool prepare_on_up_or_add_host;
 
   /**
-   * Max number of requests to be written out to the socket per write system call.
+   * Max number of outstanding prepare requests when preparing statements on a
+   * host that's brought up or is added.
    */
-  unsigned max_prepares_per_flush;
+  unsigned max_prepares_outstanding;
+
+  /**
+   * The amount of time to wait for statements to be prepared before a host is
+   * made available. The remaining statements are prepared in the background.
+   * A value of 0 waits for all statements.
+   */
+  uint64_t prepare_on_up_or_add_host_timeout_ms;
 
   /**
    * If true then events are disabled on startup. Events can be explicitly
@@ -307,6 +319,16 @@ public:
   void start_monitor_reporting(const String& client_id, const String& session_id,
                                const Config& config);
 
+  /**
+   * Load the schema metadata of a keyspace and keep it up-to-date. This is
+   * used with lazy schema metadata (thread-safe).
+   *
+   * @param keyspace_name The name of the keyspace to load.
+   * @param future A future that's set once the keyspace's schema metadata is
+   * available in schema snapshots.
+   */
+  void load_schema_keyspace(const String& keyspace_name, const Future::Ptr& future);
+
   /**
    * Get the latest snapshot of the schema metadata (thread-safe).
    *
@@ -327,10 +349,13 @@ public:
    * Get a prepared metadata entry for a prepared ID (thread-safe).
    *
    * @param id A prepared ID
+   * @param id_hash The hash of the prepared ID.
    * @return The prepare metadata object for the specified ID or a null object
    * pointer if the entry doesn't exist.
+   *
+   * @see Prepared::id_hash()
    */
-  PreparedMetadata::Entry::Ptr prepared(const String& id) const;
+  PreparedMetadata::Entry::Ptr prepared(const String& id, uint64_t id_hash) const;
 
   /**
    * Set the prepared metadata for a given prepared ID (thread-safe).
@@ -348,6 +373,14 @@ public:
    */
   HostMap available_hosts() const;
 
+  /**
+   * Get a copy of all the hosts in the cluster, including ignored hosts
+   * (thread-safe).
+   *
+   * @return A mapping of all hosts.
+   */
+  HostMap hosts() const { return hosts_.copy(); }
+
 public:
   ProtocolVersion protocol_version() const { return connection_->protocol_version(); }
   const Host::Ptr& connected_host() const { return connected_host_; }
@@ -362,6 +395,7 @@ private:
   friend class ClusterNotifyDown;
   friend class ClusterStartEvents;
   friend class ClusterStartClientMonitor;
+  friend class ClusterLoadSchemaKeyspace;
 
 private:
   void update_hosts(const HostMap& hosts);
@@ -388,6 +422,7 @@ private:
   void internal_notify_host_down(const Address& address);
 
   void internal_start_events();
+  void internal_load_schema_keyspace(const String& keyspace_name, const Future::Ptr& future);
   void internal_start_monitor_reporting(const String& client_id, const String& session_id,
                                         const Config& config);
 
@@ -401,6 +436,8 @@ private:
 private:
   void notify_or_record(const ClusterEvent& event);
 
+  bool defer_token_map_build();
+
 private:
   bool prepare_host(const Host::Ptr& host, const PrepareHostHandler::Callback& callback);
 
@@ -424,6 +461,18 @@ private:
 
   virtual void on_close(ControlConnection* connection);
 
+  virtual void on_refresh_batch_begin();
+  virtual void on_refresh_batch_end();
+  virtual void on_refresh_schema(const ControlConnectionSchema& schema);
+  virtual void on_load_keyspace_schema(const String& keyspace_name, CassError error_code,
+                                       const String& error_message);
+
+private:
+  typedef Map<String, Vector<Future::Ptr> > PendingSchemaKeyspaceMap;
+
+  void fail_pending_schema_keyspaces(CassError error_code, const String& error_message);
+  void handle_schema_change(SchemaType type);
+
 private:
   ControlConnection::Ptr connection_;
   ControlConnector::Ptr reconnector_;
@@ -432,6 +481,11 @@ private:
   const LoadBalancingPolicy::Ptr load_balancing_policy_;
   LoadBalancingPolicy::Vec load_balancing_policies_;
   const ClusterSettings settings_;
+  // A copy of the control connection settings that includes the keyspaces
+  // loaded on demand (lazy schema metadata). This is used for reconnecting.
+  ControlConnectionSettings control_connection_settings_;
+  // The futures waiting on keyspaces that are currently being loaded on demand
+  PendingSchemaKeyspaceMap pending_schema_keyspaces_;
   ScopedPtr<QueryPlan> query_plan_;
   bool is_closing_;
   Host::Ptr connected_host_;
@@ -439,6 +493,9 @@ private:
   Metadata metadata_;
   PreparedMetadata prepared_metadata_;
   TokenMap::Ptr token_map_;
+  // Used to rebuild the token map once for a batch of debounced events
+  bool is_token_map_build_deferred_;
+  bool is_token_map_build_pending_;
   String local_dc_;
   StringMultimap supported_options_;
   Timer timer_;
@@ -447,6 +504,13 @@ private:
   ScopedPtr<MonitorReporting> monitor_reporting_;
   Timer monitor_reporting_timer_;
   ScopedPtr<ReconnectionSchedule> reconnection_schedule_;
+  // The latest full schema metadata, this is saved to the metadata cache when
+  // the cluster is closed.
+  MetadataCache::Ptr metadata_cache_;
+  ControlConnectionSchema schema_;
+  String schema_scope_;
+  // The schema metadata changed incrementally since the last full refresh
+  bool is_schema_stale_;
 };
 
 }}} // namespace datastax::internal::core
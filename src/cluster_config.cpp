@@ -146,6 +146,16 @@ CassError cass_cluster_set_core_connections_per_host(CassCluster* cluster,
   return CASS_OK;
 }
 
+CassError cass_cluster_set_connection_warm_up(CassCluster* cluster, unsigned max_concurrent_connects,
+                                              cass_double_t local_dc_ready_ratio,
+                                              unsigned timeout_ms) {
+  if (local_dc_ready_ratio < 0.0 || local_dc_ready_ratio > 1.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_warm_up(max_concurrent_connects, local_dc_ready_ratio, timeout_ms);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_max_connections_per_host(CassCluster* cluster,
                                                     unsigned num_connections) {
   return CASS_OK;
@@ -415,6 +425,41 @@ void cass_cluster_set_use_schema(CassCluster* cluster, cass_bool_t enabled) {
   cluster->config().set_use_schema(enabled == cass_true);
 }
 
+void cass_cluster_set_schema_keyspace_filter(CassCluster* cluster, const char* keyspaces) {
+  cass_cluster_set_schema_keyspace_filter_n(cluster, keyspaces, SAFE_STRLEN(keyspaces));
+}
+
+void cass_cluster_set_schema_keyspace_filter_n(CassCluster* cluster, const char* keyspaces,
+                                               size_t keyspaces_length) {
+  if (keyspaces_length == 0) {
+    cluster->config().schema_keyspaces().clear();
+  } else {
+    explode(String(keyspaces, keyspaces_length), cluster->config().schema_keyspaces());
+  }
+}
+
+void cass_cluster_set_use_lazy_schema(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_use_lazy_schema(enabled == cass_true);
+}
+
+CassError cass_cluster_set_event_debounce(CassCluster* cluster, unsigned window_ms,
+                                          unsigned max_delay_ms) {
+  if (max_delay_ms < window_ms) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_event_debounce(window_ms, max_delay_ms);
+  return CASS_OK;
+}
+
+void cass_cluster_set_metadata_cache_file(CassCluster* cluster, const char* file_name) {
+  cass_cluster_set_metadata_cache_file_n(cluster, file_name, SAFE_STRLEN(file_name));
+}
+
+void cass_cluster_set_metadata_cache_file_n(CassCluster* cluster, const char* file_name,
+                                            size_t file_name_length) {
+  cluster->config().set_metadata_cache_file(String(file_name, file_name_length));
+}
+
 CassError cass_cluster_set_use_hostname_resolution(CassCluster* cluster, cass_bool_t enabled) {
   cluster->config().set_use_hostname_resolution(enabled == cass_true);
   return CASS_OK;
@@ -471,6 +516,16 @@ CassError cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster, cass_
   return CASS_OK;
 }
 
+CassError cass_cluster_set_prepare_on_up_or_add_host_window(CassCluster* cluster,
+                                                            unsigned max_outstanding,
+                                                            unsigned deadline_ms) {
+  if (max_outstanding == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_prepare_on_up_or_add_host_window(max_outstanding, deadline_ms);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_local_address(CassCluster* cluster, const char* name) {
   return cass_cluster_set_local_address_n(cluster, name, SAFE_STRLEN(name));
 }
@@ -502,6 +557,47 @@ CassError cass_cluster_set_host_listener_callback(CassCluster* cluster,
   return CASS_OK;
 }
 
+CassError cass_cluster_set_tracer_callbacks(CassCluster* cluster,
+                                            const CassTracerCallbacks* callbacks,
+                                            unsigned sample_one_in_n, void* data) {
+  if (callbacks == NULL) {
+    cluster->config().set_tracer(RequestTracer::Ptr());
+    return CASS_OK;
+  }
+  if (callbacks->start_callback == NULL || sample_one_in_n == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_tracer(
+      RequestTracer::Ptr(new RequestTracer(*callbacks, sample_one_in_n, data)));
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_metrics_exporter_port(CassCluster* cluster, int port) {
+  if (port < 0 || port > 65535) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_metrics_exporter_port(port);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_request_stage_timings(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_request_stage_timings(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_event_loop_probe_interval(CassCluster* cluster, unsigned interval_ms) {
+  cluster->config().set_event_loop_probe_interval_ms(interval_ms);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_blocked_callback_warning(CassCluster* cluster,
+                                                    cass_uint64_t threshold_us,
+                                                    CassBlockedCallbackWarning callback,
+                                                    void* data) {
+  cluster->config().set_blocked_callback_warning(threshold_us, callback, data);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_cloud_secure_connection_bundle(CassCluster* cluster, const char* path) {
   return cass_cluster_set_cloud_secure_connection_bundle_n(cluster, path, SAFE_STRLEN(path));
 }
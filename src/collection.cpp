@@ -25,6 +25,7 @@
 #include <string.h>
 
 using namespace datastax;
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 extern "C" {
@@ -81,6 +82,20 @@ CASS_COLLECTION_APPEND(duration,
 
 #undef CASS_COLLECTION_APPEND
 
+#define CASS_COLLECTION_APPEND_ARRAY(Name, Type)                                      \
+  CassError cass_collection_append_##Name##_array(CassCollection* collection,         \
+                                                  const Type* values, size_t count) { \
+    return collection->append(values, count);                                         \
+  }
+
+CASS_COLLECTION_APPEND_ARRAY(int32, cass_int32_t)
+CASS_COLLECTION_APPEND_ARRAY(int64, cass_int64_t)
+CASS_COLLECTION_APPEND_ARRAY(float, cass_float_t)
+CASS_COLLECTION_APPEND_ARRAY(double, cass_double_t)
+CASS_COLLECTION_APPEND_ARRAY(uuid, CassUuid)
+
+#undef CASS_COLLECTION_APPEND_ARRAY
+
 CassError cass_collection_append_string(CassCollection* collection, const char* value) {
   return collection->append(CassString(value, SAFE_STRLEN(value)));
 }
@@ -104,45 +119,80 @@ CassError cass_collection_append_custom_n(CassCollection* collection, const char
 
 } // extern "C"
 
+namespace {
+
+// The element encoders are the shift based big-endian encoders which compilers
+// lower to byte swap instructions, so the bulk loops below have no branches
+// other than the loop itself.
+inline char* encode_element(char* output, cass_int32_t value) {
+  return encode_int32(output, value);
+}
+
+inline char* encode_element(char* output, cass_int64_t value) {
+  return encode_int64(output, value);
+}
+
+inline char* encode_element(char* output, cass_float_t value) {
+  return encode_float(output, value);
+}
+
+inline char* encode_element(char* output, cass_double_t value) {
+  return encode_double(output, value);
+}
+
+inline char* encode_element(char* output, CassUuid value) { return encode_uuid(output, value); }
+
+} // namespace
+
 CassError Collection::append(CassNull value) {
   CASS_COLLECTION_CHECK_TYPE(value);
-  items_.push_back(Buffer());
+  append_item(Buffer());
   return CASS_OK;
 }
 
 CassError Collection::append(const Collection* value) {
   CASS_COLLECTION_CHECK_TYPE(value);
-  items_.push_back(value->encode());
+  append_item(value->encode());
   return CASS_OK;
 }
 
 CassError Collection::append(const Tuple* value) {
   CASS_COLLECTION_CHECK_TYPE(value);
-  items_.push_back(value->encode());
+  append_item(value->encode());
   return CASS_OK;
 }
 
 CassError Collection::append(const UserTypeValue* value) {
   CASS_COLLECTION_CHECK_TYPE(value);
-  items_.push_back(value->encode());
+  append_item(value->encode());
   return CASS_OK;
 }
 
-size_t Collection::get_items_size() const {
-  size_t size = 0;
-  for (BufferVec::const_iterator i = items_.begin(), end = items_.end(); i != end; ++i) {
-    size += sizeof(int32_t);
-    size += i->size();
-  }
-  return size;
+CassError Collection::append(const cass_int32_t* values, size_t count) {
+  return append_array(values, count);
+}
+
+CassError Collection::append(const cass_int64_t* values, size_t count) {
+  return append_array(values, count);
 }
 
+CassError Collection::append(const cass_float_t* values, size_t count) {
+  return append_array(values, count);
+}
+
+CassError Collection::append(const cass_double_t* values, size_t count) {
+  return append_array(values, count);
+}
+
+CassError Collection::append(const CassUuid* values, size_t count) {
+  return append_array(values, count);
+}
+
+size_t Collection::get_items_size() const { return items_.size(); }
+
 void Collection::encode_items(char* buf) const {
-  for (BufferVec::const_iterator i = items_.begin(), end = items_.end(); i != end; ++i) {
-    encode_int32(buf, i->size());
-    buf += sizeof(int32_t);
-    memcpy(buf, i->data(), i->size());
-    buf += i->size();
+  if (!items_.empty()) {
+    memcpy(buf, &items_[0], items_.size());
   }
 }
 
@@ -157,6 +207,45 @@ Buffer Collection::encode() const {
   return buf;
 }
 
+template <class T>
+CassError Collection::append_array(const T* values, size_t count) {
+  if (count == 0) return CASS_OK;
+
+  // All the elements have the same type so only the first element (and the
+  // second for maps, which alternate between the key and value types) needs to
+  // be validated.
+  for (size_t i = 0; i < count && i < 2; ++i) {
+    CassError rc = check(values[i], item_count_ + i);
+    if (rc != CASS_OK) return rc;
+  }
+
+  const size_t element_size = sizeof(int32_t) + sizeof(T);
+  size_t pos = items_.size();
+  items_.resize(pos + count * element_size);
+  char* buf = &items_[pos];
+  for (size_t i = 0; i < count; ++i) {
+    buf = encode_int32(buf, sizeof(T));
+    buf = encode_element(buf, values[i]);
+  }
+  item_count_ += count;
+  return CASS_OK;
+}
+
+void Collection::append_item(const Buffer& item) {
+  size_t pos = items_.size();
+  items_.resize(pos + sizeof(int32_t) + item.size());
+  char* buf = encode_int32(&items_[pos], item.size());
+  if (item.size() > 0) {
+    memcpy(buf, item.data(), item.size());
+  }
+  ++item_count_;
+}
+
+void Collection::reserve(size_t item_count) {
+  // Assume small, fixed width items. Larger items will grow the buffer.
+  items_.reserve(item_count * (sizeof(int32_t) + sizeof(int64_t)));
+}
+
 Buffer Collection::encode_with_length() const {
   size_t internal_size = get_size();
   Buffer buf(sizeof(int32_t) + internal_size);
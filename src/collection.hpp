@@ -24,6 +24,7 @@
 #include "external.hpp"
 #include "ref_counted.hpp"
 #include "types.hpp"
+#include "vector.hpp"
 
 #define CASS_COLLECTION_CHECK_TYPE(Value) \
   do {                                    \
@@ -38,13 +39,15 @@ class UserTypeValue;
 class Collection : public RefCounted<Collection> {
 public:
   Collection(CassCollectionType type, size_t item_count)
-      : data_type_(new CollectionType(static_cast<CassValueType>(type), false)) {
-    items_.reserve(item_count);
+      : data_type_(new CollectionType(static_cast<CassValueType>(type), false))
+      , item_count_(0) {
+    reserve(item_count);
   }
 
   Collection(const CollectionType::ConstPtr& data_type, size_t item_count)
-      : data_type_(data_type) {
-    items_.reserve(item_count);
+      : data_type_(data_type)
+      , item_count_(0) {
+    reserve(item_count);
   }
 
   CassCollectionType type() const {
@@ -52,13 +55,13 @@ public:
   }
 
   const CollectionType::ConstPtr& data_type() const { return data_type_; }
-  const BufferVec& items() const { return items_; }
+  size_t item_count() const { return item_count_; }
 
-#define APPEND_TYPE(Type)                  \
-  CassError append(const Type value) {     \
-    CASS_COLLECTION_CHECK_TYPE(value);     \
-    items_.push_back(core::encode(value)); \
-    return CASS_OK;                        \
+#define APPEND_TYPE(Type)              \
+  CassError append(const Type value) { \
+    CASS_COLLECTION_CHECK_TYPE(value); \
+    append_item(core::encode(value));  \
+    return CASS_OK;                    \
   }
 
   APPEND_TYPE(cass_int8_t)
@@ -84,6 +87,14 @@ public:
   CassError append(const Tuple* value);
   CassError append(const UserTypeValue* value);
 
+  // Append many fixed width elements at once. The elements are validated once
+  // and then encoded directly into the collection's buffer.
+  CassError append(const cass_int32_t* values, size_t count);
+  CassError append(const cass_int64_t* values, size_t count);
+  CassError append(const cass_float_t* values, size_t count);
+  CassError append(const cass_double_t* values, size_t count);
+  CassError append(const CassUuid* values, size_t count);
+
   size_t get_items_size() const;
   void encode_items(char* buf) const;
 
@@ -93,13 +104,20 @@ public:
   Buffer encode() const;
   Buffer encode_with_length() const;
 
-  void clear() { items_.clear(); }
+  void clear() {
+    items_.clear();
+    item_count_ = 0;
+  }
 
 private:
   template <class T>
   CassError check(const T value) {
+    return check(value, item_count_);
+  }
+
+  template <class T>
+  CassError check(const T value, size_t index) {
     IsValidDataType<T> is_valid_type;
-    size_t index = items_.size();
 
     switch (type()) {
       case CASS_COLLECTION_TYPE_MAP:
@@ -119,13 +137,22 @@ private:
     return CASS_OK;
   }
 
+  template <class T>
+  CassError append_array(const T* values, size_t count);
+
+  void append_item(const Buffer& item);
+  void reserve(size_t item_count);
+
   int32_t get_count() const {
-    return ((type() == CASS_COLLECTION_TYPE_MAP) ? items_.size() / 2 : items_.size());
+    return ((type() == CASS_COLLECTION_TYPE_MAP) ? item_count_ / 2 : item_count_);
   }
 
 private:
   CollectionType::ConstPtr data_type_;
-  BufferVec items_;
+  // Items are stored already encoded, each prefixed by its size, so that
+  // encoding the collection is a single copy.
+  Vector<char> items_;
+  size_t item_count_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Collection);
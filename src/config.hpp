@@ -25,6 +25,7 @@
 #include "execution_profile.hpp"
 #include "protocol.hpp"
 #include "reconnection_policy.hpp"
+#include "request_tracer.hpp"
 #include "speculative_execution.hpp"
 #include "ssl.hpp"
 #include "string.hpp"
@@ -45,6 +46,9 @@ public:
       , thread_count_io_(CASS_DEFAULT_THREAD_COUNT_IO)
       , queue_size_io_(CASS_DEFAULT_QUEUE_SIZE_IO)
       , core_connections_per_host_(CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST)
+      , warm_up_max_concurrent_connects_(CASS_DEFAULT_WARM_UP_MAX_CONCURRENT_CONNECTS)
+      , warm_up_ready_ratio_(CASS_DEFAULT_WARM_UP_READY_RATIO)
+      , warm_up_timeout_ms_(CASS_DEFAULT_WARM_UP_TIMEOUT_MS)
       , reconnection_policy_(new ExponentialReconnectionPolicy())
       , connect_timeout_ms_(CASS_DEFAULT_CONNECT_TIMEOUT_MS)
       , resolve_timeout_ms_(CASS_DEFAULT_RESOLVE_TIMEOUT_MS)
@@ -65,15 +69,26 @@ public:
       , connection_heartbeat_interval_secs_(CASS_DEFAULT_HEARTBEAT_INTERVAL_SECS)
       , timestamp_gen_(new MonotonicTimestampGenerator())
       , use_schema_(CASS_DEFAULT_USE_SCHEMA)
+      , use_lazy_schema_(CASS_DEFAULT_USE_LAZY_SCHEMA)
+      , event_debounce_window_ms_(CASS_DEFAULT_EVENT_DEBOUNCE_WINDOW_MS)
+      , event_debounce_max_delay_ms_(CASS_DEFAULT_EVENT_DEBOUNCE_MAX_DELAY_MS)
       , use_hostname_resolution_(CASS_DEFAULT_HOSTNAME_RESOLUTION_ENABLED)
       , use_randomized_contact_points_(CASS_DEFAULT_USE_RANDOMIZED_CONTACT_POINTS)
       , max_reusable_write_objects_(CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS)
       , prepare_on_all_hosts_(CASS_DEFAULT_PREPARE_ON_ALL_HOSTS)
       , prepare_on_up_or_add_host_(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST)
+      , max_prepares_outstanding_(CASS_DEFAULT_MAX_PREPARES_OUTSTANDING)
+      , prepare_on_up_or_add_host_timeout_ms_(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_TIMEOUT_MS)
       , no_compact_(CASS_DEFAULT_NO_COMPACT)
       , is_client_id_set_(false)
       , host_listener_(new DefaultHostListener())
       , monitor_reporting_interval_secs_(CASS_DEFAULT_CLIENT_MONITOR_EVENTS_INTERVAL_SECS)
+      , metrics_exporter_port_(CASS_DEFAULT_METRICS_EXPORTER_PORT)
+      , request_stage_timings_(CASS_DEFAULT_REQUEST_STAGE_TIMINGS)
+      , event_loop_probe_interval_ms_(CASS_DEFAULT_EVENT_LOOP_PROBE_INTERVAL_MS)
+      , blocked_callback_threshold_us_(CASS_DEFAULT_BLOCKED_CALLBACK_THRESHOLD_US)
+      , blocked_callback_warning_(NULL)
+      , blocked_callback_warning_data_(NULL)
       , cluster_metadata_resolver_factory_(new DefaultClusterMetadataResolverFactory()) {
     profiles_.set_empty_key(String());
 
@@ -119,6 +134,15 @@ public:
     core_connections_per_host_ = num_connections;
   }
 
+  unsigned warm_up_max_concurrent_connects() const { return warm_up_max_concurrent_connects_; }
+  double warm_up_ready_ratio() const { return warm_up_ready_ratio_; }
+  uint64_t warm_up_timeout_ms() const { return warm_up_timeout_ms_; }
+  void set_warm_up(unsigned max_concurrent_connects, double ready_ratio, uint64_t timeout_ms) {
+    warm_up_max_concurrent_connects_ = max_concurrent_connects;
+    warm_up_ready_ratio_ = ready_ratio;
+    warm_up_timeout_ms_ = timeout_ms;
+  }
+
   ReconnectionPolicy::Ptr reconnection_policy() const { return reconnection_policy_; }
 
   void set_constant_reconnect(uint64_t wait_time_ms) {
@@ -291,6 +315,22 @@ public:
   bool use_schema() const { return use_schema_; }
   void set_use_schema(bool enable) { use_schema_ = enable; }
 
+  const StringVec& schema_keyspaces() const { return schema_keyspaces_; }
+  StringVec& schema_keyspaces() { return schema_keyspaces_; }
+
+  bool use_lazy_schema() const { return use_lazy_schema_; }
+  void set_use_lazy_schema(bool enable) { use_lazy_schema_ = enable; }
+
+  uint64_t event_debounce_window_ms() const { return event_debounce_window_ms_; }
+  uint64_t event_debounce_max_delay_ms() const { return event_debounce_max_delay_ms_; }
+  void set_event_debounce(uint64_t window_ms, uint64_t max_delay_ms) {
+    event_debounce_window_ms_ = window_ms;
+    event_debounce_max_delay_ms_ = max_delay_ms;
+  }
+
+  const String& metadata_cache_file() const { return metadata_cache_file_; }
+  void set_metadata_cache_file(const String& file_name) { metadata_cache_file_ = file_name; }
+
   bool use_hostname_resolution() const { return use_hostname_resolution_; }
   void set_use_hostname_resolution(bool enable) { use_hostname_resolution_ = enable; }
 
@@ -322,6 +362,15 @@ public:
 
   void set_prepare_on_up_or_add_host(bool enabled) { prepare_on_up_or_add_host_ = enabled; }
 
+  unsigned max_prepares_outstanding() const { return max_prepares_outstanding_; }
+  uint64_t prepare_on_up_or_add_host_timeout_ms() const {
+    return prepare_on_up_or_add_host_timeout_ms_;
+  }
+  void set_prepare_on_up_or_add_host_window(unsigned max_outstanding, uint64_t timeout_ms) {
+    max_prepares_outstanding_ = max_outstanding;
+    prepare_on_up_or_add_host_timeout_ms_ = timeout_ms;
+  }
+
   const Address& local_address() const { return local_address_; }
 
   void set_local_address(const Address& address) { local_address_ = address; }
@@ -360,11 +409,37 @@ public:
     }
   }
 
+  const RequestTracer::Ptr& tracer() const { return tracer_; }
+
+  void set_tracer(const RequestTracer::Ptr& tracer) { tracer_ = tracer; }
+
   unsigned monitor_reporting_interval_secs() const { return monitor_reporting_interval_secs_; }
   void set_monitor_reporting_interval_secs(unsigned interval_secs) {
     monitor_reporting_interval_secs_ = interval_secs;
   };
 
+  int metrics_exporter_port() const { return metrics_exporter_port_; }
+  void set_metrics_exporter_port(int port) { metrics_exporter_port_ = port; }
+
+  bool request_stage_timings() const { return request_stage_timings_; }
+  void set_request_stage_timings(bool enabled) { request_stage_timings_ = enabled; }
+
+  unsigned event_loop_probe_interval_ms() const { return event_loop_probe_interval_ms_; }
+  void set_event_loop_probe_interval_ms(unsigned interval_ms) {
+    event_loop_probe_interval_ms_ = interval_ms;
+  }
+
+  uint64_t blocked_callback_threshold_us() const { return blocked_callback_threshold_us_; }
+  CassBlockedCallbackWarning blocked_callback_warning() const { return blocked_callback_warning_; }
+  void* blocked_callback_warning_data() const { return blocked_callback_warning_data_; }
+
+  void set_blocked_callback_warning(uint64_t threshold_us, CassBlockedCallbackWarning callback,
+                                    void* data) {
+    blocked_callback_threshold_us_ = threshold_us;
+    blocked_callback_warning_ = callback;
+    blocked_callback_warning_data_ = data;
+  }
+
   const CloudSecureConnectionConfig& cloud_secure_connection_config() const {
     return cloud_secure_connection_config_;
   }
@@ -403,6 +478,9 @@ private:
   unsigned thread_count_io_;
   unsigned queue_size_io_;
   unsigned core_connections_per_host_;
+  unsigned warm_up_max_concurrent_connects_;
+  double warm_up_ready_ratio_;
+  uint64_t warm_up_timeout_ms_;
   SharedRefPtr<ReconnectionPolicy> reconnection_policy_;
   unsigned connect_timeout_ms_;
   unsigned resolve_timeout_ms_;
@@ -424,6 +502,11 @@ private:
   unsigned connection_heartbeat_interval_secs_;
   SharedRefPtr<TimestampGenerator> timestamp_gen_;
   bool use_schema_;
+  StringVec schema_keyspaces_;
+  bool use_lazy_schema_;
+  uint64_t event_debounce_window_ms_;
+  uint64_t event_debounce_max_delay_ms_;
+  String metadata_cache_file_;
   bool use_hostname_resolution_;
   bool use_randomized_contact_points_;
   unsigned max_reusable_write_objects_;
@@ -431,6 +514,8 @@ private:
   ExecutionProfile::Map profiles_;
   bool prepare_on_all_hosts_;
   bool prepare_on_up_or_add_host_;
+  unsigned max_prepares_outstanding_;
+  uint64_t prepare_on_up_or_add_host_timeout_ms_;
   Address local_address_;
   bool no_compact_;
   String application_name_;
@@ -438,7 +523,14 @@ private:
   bool is_client_id_set_;
   CassUuid client_id_;
   DefaultHostListener::Ptr host_listener_;
+  RequestTracer::Ptr tracer_;
   unsigned monitor_reporting_interval_secs_;
+  int metrics_exporter_port_;
+  bool request_stage_timings_;
+  unsigned event_loop_probe_interval_ms_;
+  uint64_t blocked_callback_threshold_us_;
+  CassBlockedCallbackWarning blocked_callback_warning_;
+  void* blocked_callback_warning_data_;
   CloudSecureConnectionConfig cloud_secure_connection_config_;
   ClusterMetadataResolverFactory::Ptr cluster_metadata_resolver_factory_;
 };
@@ -20,6 +20,7 @@
 #include "options_request.hpp"
 #include "request.hpp"
 #include "result_response.hpp"
+#include "statement.hpp"
 
 using namespace datastax;
 using namespace datastax::internal::core;
@@ -49,6 +50,8 @@ HeartbeatCallback::HeartbeatCallback(Connection* connection)
 void HeartbeatCallback::on_internal_set(ResponseMessage* response) {
   LOG_TRACE("Heartbeat completed on host %s", connection_->host_->address_string().c_str());
   connection_->heartbeat_outstanding_ = false;
+  connection_->heartbeat_rtt_ns_.store(uv_hrtime() - connection_->heartbeat_start_ns_,
+                                       MEMORY_ORDER_RELAXED);
 }
 
 void HeartbeatCallback::on_internal_error(CassError code, const String& message) {
@@ -104,16 +107,21 @@ void RecordingConnectionListener::process_events(const EventResponse::Vec& event
 
 Connection::Connection(const Socket::Ptr& socket, const Host::Ptr& host,
                        ProtocolVersion protocol_version, unsigned int idle_timeout_secs,
-                       unsigned int heartbeat_interval_secs)
+                       unsigned int heartbeat_interval_secs, bool record_request_timings)
     : socket_(socket)
     , host_(host)
     , inflight_request_count_(0)
-    , response_(new ResponseMessage())
+    , streams_in_use_(0)
+    , max_streams_in_use_(0)
+    , response_(new ResponseMessage(this))
     , listener_(&nop_listener__)
     , protocol_version_(protocol_version)
     , idle_timeout_secs_(idle_timeout_secs)
     , heartbeat_interval_secs_(heartbeat_interval_secs)
-    , heartbeat_outstanding_(false) {
+    , record_request_timings_(record_request_timings)
+    , heartbeat_outstanding_(false)
+    , heartbeat_start_ns_(0)
+    , heartbeat_rtt_ns_(0) {
   inc_ref(); // For the event loop
   host_->increment_connection_count();
 }
@@ -126,12 +134,18 @@ int32_t Connection::write(const RequestCallback::Ptr& callback) {
     return Request::REQUEST_ERROR_NO_AVAILABLE_STREAM_IDS;
   }
 
+  size_t streams_in_use = stream_manager_.pending_streams();
+  streams_in_use_.store(streams_in_use, MEMORY_ORDER_RELAXED);
+  if (streams_in_use > max_streams_in_use_.load(MEMORY_ORDER_RELAXED)) {
+    max_streams_in_use_.store(streams_in_use, MEMORY_ORDER_RELAXED);
+  }
+
   callback->notify_write(this, stream);
 
   int32_t request_size = socket_->write(callback.get());
 
   if (request_size <= 0) {
-    stream_manager_.release(stream);
+    release_stream(stream);
     if (request_size == 0) {
       callback->on_error(CASS_ERROR_LIB_MESSAGE_ENCODE, "The encoded request had no data to write");
       return Request::REQUEST_ERROR_NO_DATA_WRITTEN;
@@ -142,9 +156,9 @@ int32_t Connection::write(const RequestCallback::Ptr& callback) {
   // Add to the inflight count after we've cleared all posssible errors.
   inflight_request_count_.fetch_add(1);
 
-  LOG_TRACE("Sending message type %s with stream %d on host %s",
-            opcode_to_string(callback->request()->opcode()).c_str(), stream,
-            host_->address_string().c_str());
+  LOG_TRACE_REQUEST(callback->trace_id(), "Sending message type %s with stream %d on host %s",
+                    opcode_to_string(callback->request()->opcode()).c_str(), stream,
+                    host_->address_string().c_str());
 
   callback->set_state(RequestCallback::REQUEST_STATE_WRITING);
 
@@ -174,6 +188,20 @@ void Connection::start_heartbeats() {
   restart_terminate_timer();
 }
 
+ConnectionStats Connection::stats() const {
+  ConnectionStats stats;
+  stats.address = host_->address();
+  stats.streams_in_use = streams_in_use_.load(MEMORY_ORDER_RELAXED);
+  stats.max_streams_in_use = max_streams_in_use_.load(MEMORY_ORDER_RELAXED);
+  stats.bytes_read = socket_->bytes_read();
+  stats.bytes_written = socket_->bytes_written();
+  stats.pending_writes = socket_->pending_write_count();
+  stats.write_queue_size = socket_->write_queue_size();
+  stats.write_blocked_time_ns = socket_->write_blocked_time_ns();
+  stats.heartbeat_rtt_ns = heartbeat_rtt_ns_.load(MEMORY_ORDER_RELAXED);
+  return stats;
+}
+
 void Connection::maybe_set_keyspace(ResponseMessage* response) {
   if (response->opcode() == CQL_OPCODE_RESULT) {
     ResultResponse* result = static_cast<ResultResponse*>(response->response_body().get());
@@ -183,6 +211,25 @@ void Connection::maybe_set_keyspace(ResponseMessage* response) {
   }
 }
 
+void Connection::release_stream(int stream) {
+  stream_manager_.release(stream);
+  streams_in_use_.store(stream_manager_.pending_streams(), MEMORY_ORDER_RELAXED);
+}
+
+bool Connection::resolve_row_callback(int16_t stream, CassRowCallback* callback, void** data) {
+  RequestCallback::Ptr request_callback;
+  if (!stream_manager_.get(stream, request_callback)) return false;
+
+  const Request* request = request_callback->request();
+  if (!Statement::has_row_callback(request)) return false;
+
+  const Statement* statement = static_cast<const Statement*>(request);
+  *callback = statement->row_callback();
+  *data = statement->row_callback_data();
+  request_callback->set_is_streaming_rows();
+  return true;
+}
+
 void Connection::on_write(int status, RequestCallback* request) {
   listener_->on_write();
 
@@ -198,10 +245,13 @@ void Connection::on_write(int status, RequestCallback* request) {
   switch (callback->state()) {
     case RequestCallback::REQUEST_STATE_WRITING:
       if (status == 0) {
+        if (record_request_timings_) {
+          callback->set_write_time_ns(uv_hrtime());
+        }
         callback->set_state(RequestCallback::REQUEST_STATE_READING);
         pending_reads_.add_to_back(request);
       } else {
-        stream_manager_.release(callback->stream());
+        release_stream(callback->stream());
         inflight_request_count_.fetch_sub(1);
         callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
         callback->on_error(CASS_ERROR_LIB_WRITE_ERROR, "Unable to write to socket");
@@ -209,7 +259,10 @@ void Connection::on_write(int status, RequestCallback* request) {
       break;
 
     case RequestCallback::REQUEST_STATE_READ_BEFORE_WRITE:
-      stream_manager_.release(callback->stream());
+      if (record_request_timings_) {
+        callback->set_write_time_ns(uv_hrtime());
+      }
+      release_stream(callback->stream());
       inflight_request_count_.fetch_sub(1);
       // The read callback happened before the write callback
       // returned. This is now responsible for finishing the request.
@@ -234,7 +287,13 @@ void Connection::on_read(const char* buf, size_t size) {
   // A successful read means the connection is still responsive
   restart_terminate_timer();
 
+  const uint64_t read_time_ns = record_request_timings_ ? uv_hrtime() : 0;
+
   while (remaining != 0 && !socket_->is_closing()) {
+    if (record_request_timings_ && response_->first_byte_time_ns() == 0) {
+      response_->set_first_byte_time_ns(read_time_ns);
+    }
+
     ssize_t consumed = response_->decode(pos, remaining);
     if (consumed <= 0) {
       LOG_ERROR("Error decoding/consuming message");
@@ -243,15 +302,18 @@ void Connection::on_read(const char* buf, size_t size) {
     }
 
     if (response_->is_body_ready()) {
+      if (record_request_timings_) {
+        response_->set_decoded_time_ns(uv_hrtime());
+      }
       ScopedPtr<ResponseMessage> response(response_.release());
-      response_.reset(new ResponseMessage());
-
-      LOG_TRACE("Consumed message type %s with stream %d, input %u, remaining %u on host %s",
-                opcode_to_string(response->opcode()).c_str(), static_cast<int>(response->stream()),
-                static_cast<unsigned int>(size), static_cast<unsigned int>(remaining),
-                host_->address_string().c_str());
+      response_.reset(new ResponseMessage(this));
 
       if (response->stream() < 0) {
+        LOG_TRACE("Consumed message type %s with stream %d, input %u, remaining %u on host %s",
+                  opcode_to_string(response->opcode()).c_str(),
+                  static_cast<int>(response->stream()), static_cast<unsigned int>(size),
+                  static_cast<unsigned int>(remaining), host_->address_string().c_str());
+
         if (response->opcode() == CQL_OPCODE_EVENT) {
           listener_->on_event(response->response_body());
         } else {
@@ -264,10 +326,17 @@ void Connection::on_read(const char* buf, size_t size) {
         RequestCallback::Ptr callback;
 
         if (stream_manager_.get(response->stream(), callback)) {
+          LOG_TRACE_REQUEST(callback->trace_id(),
+                            "Consumed message type %s with stream %d, input %u, remaining %u on "
+                            "host %s",
+                            opcode_to_string(response->opcode()).c_str(),
+                            static_cast<int>(response->stream()), static_cast<unsigned int>(size),
+                            static_cast<unsigned int>(remaining), host_->address_string().c_str());
+
           switch (callback->state()) {
             case RequestCallback::REQUEST_STATE_READING:
               pending_reads_.remove(callback.get());
-              stream_manager_.release(callback->stream());
+              release_stream(callback->stream());
               inflight_request_count_.fetch_sub(1);
               callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
               maybe_set_keyspace(response.get());
@@ -329,6 +398,7 @@ void Connection::on_heartbeat(Timer* timer) {
       return;
     }
     heartbeat_outstanding_ = true;
+    heartbeat_start_ns_ = uv_hrtime();
   }
 
   restart_heartbeat_timer();
@@ -16,6 +16,7 @@
 
 #include "event_response.hpp"
 #include "request_callback.hpp"
+#include "row_stream.hpp"
 #include "socket.hpp"
 #include "stream_manager.hpp"
 
@@ -111,6 +112,33 @@ private:
   EventResponse::Vec events_;
 };
 
+/**
+ * A point-in-time copy of a connection's stats.
+ */
+struct ConnectionStats {
+  typedef Vector<ConnectionStats> Vec;
+
+  ConnectionStats()
+      : streams_in_use(0)
+      , max_streams_in_use(0)
+      , bytes_read(0)
+      , bytes_written(0)
+      , pending_writes(0)
+      , write_queue_size(0)
+      , write_blocked_time_ns(0)
+      , heartbeat_rtt_ns(0) {}
+
+  Address address;
+  size_t streams_in_use;
+  size_t max_streams_in_use; // High-water mark
+  uint64_t bytes_read;
+  uint64_t bytes_written;
+  size_t pending_writes;
+  size_t write_queue_size;
+  uint64_t write_blocked_time_ns;
+  uint64_t heartbeat_rtt_ns; // Round trip time of the last heartbeat (0 if none)
+};
+
 /**
  * A connection. It's a socket wrapper that handles Cassandra/DSE specific
  * functionality such as decoding responses and heartbeats. It can not be
@@ -118,7 +146,9 @@ private:
  *
  * @see Connector
  */
-class Connection : public RefCounted<Connection> {
+class Connection
+    : public RefCounted<Connection>
+    , public RowStreamResolver {
   friend class ConnectionConnector;
   friend class ConnectionHandler;
   friend class SslConnectionHandler;
@@ -137,9 +167,12 @@ public:
    * @param idle_timeout_secs The amount of time (in seconds) without a write or heartbeat
    * where the connection is considered idle and is terminated.
    * @param heartbeat_interval_secs The interval (in seconds) to send a heartbeat.
+   * @param record_request_timings If true, record when each request is written and when
+   * its response is read and decoded.
    */
   Connection(const Socket::Ptr& socket, const Host::Ptr& host, ProtocolVersion protocol_version,
-             unsigned int idle_timeout_secs, unsigned int heartbeat_interval_secs);
+             unsigned int idle_timeout_secs, unsigned int heartbeat_interval_secs,
+             bool record_request_timings = false);
   ~Connection();
 
   /**
@@ -213,8 +246,19 @@ public:
 
   int inflight_request_count() const { return inflight_request_count_.load(MEMORY_ORDER_RELAXED); }
 
+  /**
+   * Get a copy of the connection's stream, byte, write queue and heartbeat
+   * stats (thread-safe).
+   *
+   * @return The connection's stats.
+   */
+  ConnectionStats stats() const;
+
 private:
   void maybe_set_keyspace(ResponseMessage* response);
+  void release_stream(int stream);
+
+  virtual bool resolve_row_callback(int16_t stream, CassRowCallback* callback, void** data);
 
   void on_write(int status, RequestCallback* request);
   void on_read(const char* buf, size_t size);
@@ -232,6 +276,8 @@ private:
   const Host::Ptr host_;
   StreamManager<RequestCallback::Ptr> stream_manager_;
   Atomic<int> inflight_request_count_;
+  Atomic<size_t> streams_in_use_;
+  Atomic<size_t> max_streams_in_use_;
 
   List<SocketRequest> pending_reads_;
   ScopedPtr<ResponseMessage> response_;
@@ -243,7 +289,10 @@ private:
 
   unsigned int idle_timeout_secs_;
   unsigned int heartbeat_interval_secs_;
+  bool record_request_timings_;
   bool heartbeat_outstanding_;
+  uint64_t heartbeat_start_ns_;
+  Atomic<uint64_t> heartbeat_rtt_ns_;
   Timer heartbeat_timer_;
   Timer terminate_timer_;
 };
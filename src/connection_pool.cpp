@@ -39,12 +39,18 @@ static inline bool least_busy_comp(const PooledConnection::Ptr& a, const PooledC
 
 ConnectionPoolSettings::ConnectionPoolSettings()
     : num_connections_per_host(CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST)
-    , reconnection_policy(new ExponentialReconnectionPolicy()) {}
+    , reconnection_policy(new ExponentialReconnectionPolicy())
+    , warm_up_max_concurrent_connects(CASS_DEFAULT_WARM_UP_MAX_CONCURRENT_CONNECTS)
+    , warm_up_ready_ratio(CASS_DEFAULT_WARM_UP_READY_RATIO)
+    , warm_up_timeout_ms(CASS_DEFAULT_WARM_UP_TIMEOUT_MS) {}
 
 ConnectionPoolSettings::ConnectionPoolSettings(const Config& config)
     : connection_settings(config)
     , num_connections_per_host(config.core_connections_per_host())
-    , reconnection_policy(config.reconnection_policy()) {}
+    , reconnection_policy(config.reconnection_policy())
+    , warm_up_max_concurrent_connects(config.warm_up_max_concurrent_connects())
+    , warm_up_ready_ratio(config.warm_up_ready_ratio())
+    , warm_up_timeout_ms(config.warm_up_timeout_ms()) {}
 
 class NopConnectionPoolListener : public ConnectionPoolListener {
 public:
@@ -141,6 +147,7 @@ void ConnectionPool::requires_flush(PooledConnection* connection, ConnectionPool
 void ConnectionPool::close_connection(PooledConnection* connection, Protected) {
   if (metrics_) {
     metrics_->total_connections.dec();
+    metrics_->connections.remove(connection->connection());
   }
   connections_.erase(std::remove(connections_.begin(), connections_.end(), connection),
                      connections_.end());
@@ -160,6 +167,7 @@ void ConnectionPool::close_connection(PooledConnection* connection, Protected) {
 void ConnectionPool::add_connection(const PooledConnection::Ptr& connection) {
   if (metrics_) {
     metrics_->total_connections.inc();
+    metrics_->connections.add(connection->connection());
   }
   connections_.push_back(connection);
 }
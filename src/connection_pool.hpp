@@ -94,6 +94,9 @@ struct ConnectionPoolSettings {
   ConnectionSettings connection_settings;
   size_t num_connections_per_host;
   ReconnectionPolicy::Ptr reconnection_policy;
+  size_t warm_up_max_concurrent_connects;
+  double warm_up_ready_ratio;
+  uint64_t warm_up_timeout_ms;
 };
 
 /**
@@ -29,6 +29,8 @@ ConnectionPoolConnector::ConnectionPoolConnector(const Host::Ptr& host,
     , callback_(callback)
     , is_canceled_(false)
     , remaining_(0)
+    , connect_start_time_ns_(0)
+    , connect_time_ns_(0)
     , host_(host)
     , protocol_version_(protocol_version)
     , listener_(NULL)
@@ -59,6 +61,7 @@ void ConnectionPoolConnector::connect(uv_loop_t* loop) {
   inc_ref();
   loop_ = loop;
   remaining_ = settings_.num_connections_per_host;
+  connect_start_time_ns_ = uv_hrtime();
   for (size_t i = 0; i < settings_.num_connections_per_host; ++i) {
     Connector::Ptr connector(new Connector(
         host_, protocol_version_, bind_callback(&ConnectionPoolConnector::on_connect, this)));
@@ -87,6 +90,11 @@ void ConnectionPoolConnector::cancel() {
   }
 }
 
+void ConnectionPoolConnector::reassign(const Callback& callback, ConnectionPoolListener* listener) {
+  callback_ = callback;
+  listener_ = listener;
+}
+
 ConnectionPool::Ptr ConnectionPoolConnector::release_pool() {
   ConnectionPool::Ptr temp = pool_;
   pool_.reset();
@@ -137,8 +145,11 @@ void ConnectionPoolConnector::on_connect(Connector* connector) {
   }
 
   if (--remaining_ == 0) {
+    connect_time_ns_ = uv_hrtime() - connect_start_time_ns_;
     if (!is_canceled_) {
       if (!critical_error_connector_) {
+        LOG_DEBUG("Connected pool for host %s in %llu ms", host_->address().to_string().c_str(),
+                  static_cast<unsigned long long>(connect_time_ms()));
         pool_.reset(new ConnectionPool(connections_, listener_, keyspace_, loop_, host_,
                                        protocol_version_, settings_, metrics_));
       } else {
@@ -97,6 +97,16 @@ public:
    */
   void cancel();
 
+  /**
+   * Hand the connection process over to a new owner. The pool is created with
+   * the new listener and the new callback is called when the pool is
+   * connected or if an error occurred.
+   *
+   * @param callback The new callback.
+   * @param listener The new pool listener.
+   */
+  void reassign(const Callback& callback, ConnectionPoolListener* listener);
+
   /**
    * Release the pool from the connector. If not released in the callback
    * the pool automatically be closed.
@@ -107,8 +117,17 @@ public:
   ConnectionPool::Ptr release_pool();
 
 public:
+  const Host::Ptr& host() const { return host_; }
   const Address& address() const { return host_->address(); }
 
+  /**
+   * The amount of time it took to connect the pool's connections. This is
+   * only valid after the connection process has finished.
+   *
+   * @return The connect time in milliseconds.
+   */
+  uint64_t connect_time_ms() const { return connect_time_ns_ / (1000 * 1000); }
+
   Connector::ConnectionError error_code() const;
   String error_message() const;
 
@@ -125,6 +144,8 @@ private:
   Callback callback_;
   bool is_canceled_;
   size_t remaining_;
+  uint64_t connect_start_time_ns_;
+  uint64_t connect_time_ns_;
 
   Connector::Vec pending_connections_;
   Connection::Vec connections_;
@@ -113,6 +113,11 @@ void ConnectionPoolManager::add(const Host::Ptr& host) {
       ->connect(loop_);
 }
 
+void ConnectionPoolManager::add(const ConnectionPoolConnector::Ptr& connector) {
+  pending_pools_.push_back(connector);
+  connector->reassign(bind_callback(&ConnectionPoolManager::on_connect, this), this);
+}
+
 void ConnectionPoolManager::remove(const Address& address) {
   ConnectionPool::Map::iterator it = pools_.find(address);
   if (it == pools_.end()) return;
@@ -113,6 +113,14 @@ public:
    */
   void add(const Host::Ptr& host);
 
+  /**
+   * Take over a pool connector that's still connecting. The pool is added
+   * when the connector finishes.
+   *
+   * @param connector The connector that's connecting.
+   */
+  void add(const ConnectionPoolConnector::Ptr& connector);
+
   /**
    * Remove a connection pool for the given host.
    *
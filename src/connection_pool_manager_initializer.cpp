@@ -16,6 +16,10 @@
 
 #include "connection_pool_manager_initializer.hpp"
 
+#include "logger.hpp"
+
+#include <math.h>
+
 using namespace datastax;
 using namespace datastax::internal::core;
 
@@ -26,27 +30,51 @@ ConnectionPoolManagerInitializer::ConnectionPoolManagerInitializer(ProtocolVersi
     , remaining_(0)
     , protocol_version_(protocol_version)
     , listener_(NULL)
-    , metrics_(NULL) {}
+    , metrics_(NULL)
+    , has_local_hosts_(false)
+    , local_ready_(0)
+    , local_required_(0)
+    , is_warm_up_expired_(false) {}
 
 void ConnectionPoolManagerInitializer::initialize(uv_loop_t* loop, const HostMap& hosts) {
   inc_ref();
   loop_ = loop;
   remaining_ = hosts.size();
+
+  if (!local_dc_.empty()) {
+    for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+      if (it->second->dc() == local_dc_) {
+        has_local_hosts_ = true;
+        break;
+      }
+    }
+  }
+
+  // Hosts are connected from the back of the queue so that local hosts are
+  // connected first.
+  size_t local_count = 0;
   for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
-    ConnectionPoolConnector::Ptr pool_connector(new ConnectionPoolConnector(
-        it->second, protocol_version_,
-        bind_callback(&ConnectionPoolManagerInitializer::on_connect, this)));
-    pending_pools_.push_back(pool_connector);
-    pool_connector->with_listener(this)
-        ->with_keyspace(keyspace_)
-        ->with_metrics(metrics_)
-        ->with_settings(settings_)
-        ->connect(loop);
+    if (!is_local(it->second)) queued_hosts_.push_back(it->second);
   }
+  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+    if (is_local(it->second)) {
+      queued_hosts_.push_back(it->second);
+      local_count++;
+    }
+  }
+  local_required_ = static_cast<size_t>(ceil(settings_.warm_up_ready_ratio * local_count));
+
+  if (settings_.warm_up_timeout_ms > 0 && !hosts.empty()) {
+    warm_up_timer_.start(loop, settings_.warm_up_timeout_ms,
+                         bind_callback(&ConnectionPoolManagerInitializer::on_warm_up_timeout, this));
+  }
+
+  connect_next();
 }
 
 void ConnectionPoolManagerInitializer::cancel() {
   is_canceled_ = true;
+  warm_up_timer_.stop();
   if (manager_) {
     manager_->close();
   } else {
@@ -84,6 +112,12 @@ ConnectionPoolManagerInitializer::with_settings(const ConnectionPoolSettings& se
   return this;
 }
 
+ConnectionPoolManagerInitializer*
+ConnectionPoolManagerInitializer::with_local_dc(const String& local_dc) {
+  local_dc_ = local_dc;
+  return this;
+}
+
 ConnectionPoolConnector::Vec ConnectionPoolManagerInitializer::failures() const {
   return failures_;
 }
@@ -112,32 +146,98 @@ void ConnectionPoolManagerInitializer::on_close(ConnectionPool* pool) {
   // Ignore
 }
 
+bool ConnectionPoolManagerInitializer::is_local(const Host::Ptr& host) const {
+  return !has_local_hosts_ || host->dc() == local_dc_;
+}
+
+bool ConnectionPoolManagerInitializer::is_warm() const {
+  if (pools_.empty()) return false; // Always wait for at least one pool
+  return is_warm_up_expired_ ||
+         (settings_.warm_up_ready_ratio > 0.0 && local_ready_ >= local_required_);
+}
+
+void ConnectionPoolManagerInitializer::connect_next() {
+  size_t max_concurrent_connects = settings_.warm_up_max_concurrent_connects;
+  while (!queued_hosts_.empty() &&
+         (max_concurrent_connects == 0 || pending_pools_.size() < max_concurrent_connects)) {
+    Host::Ptr host(queued_hosts_.back());
+    queued_hosts_.pop_back();
+    ConnectionPoolConnector::Ptr pool_connector(new ConnectionPoolConnector(
+        host, protocol_version_,
+        bind_callback(&ConnectionPoolManagerInitializer::on_connect, this)));
+    pending_pools_.push_back(pool_connector);
+    pool_connector->with_listener(this)
+        ->with_keyspace(keyspace_)
+        ->with_metrics(metrics_)
+        ->with_settings(settings_)
+        ->connect(loop_);
+  }
+}
+
+void ConnectionPoolManagerInitializer::finish() {
+  warm_up_timer_.stop();
+
+  if (!is_canceled_) {
+    manager_.reset(new ConnectionPoolManager(pools_, loop_, protocol_version_, keyspace_,
+                                             listener_, metrics_, settings_));
+    if (remaining_ > 0) {
+      LOG_DEBUG("Connection pools warmed up with %u local pools ready, %u pools will continue "
+                "connecting in the background",
+                static_cast<unsigned int>(local_ready_), static_cast<unsigned int>(remaining_));
+      // The manager takes over the pools that haven't finished connecting
+      for (ConnectionPoolConnector::Vec::const_iterator it = pending_pools_.begin(),
+                                                        end = pending_pools_.end();
+           it != end; ++it) {
+        manager_->add(*it);
+      }
+      for (HostVec::const_iterator it = queued_hosts_.begin(), end = queued_hosts_.end();
+           it != end; ++it) {
+        manager_->add(*it);
+      }
+    }
+  }
+  pending_pools_.clear();
+  queued_hosts_.clear();
+
+  callback_(this);
+  // If the manager hasn't been released then close it.
+  if (manager_) {
+    // If the callback doesn't take possession of the manager then we should
+    // also clear the listener.
+    manager_->set_listener();
+    manager_->close();
+  }
+  dec_ref();
+}
+
 void ConnectionPoolManagerInitializer::on_connect(ConnectionPoolConnector* pool_connector) {
   pending_pools_.erase(std::remove(pending_pools_.begin(), pending_pools_.end(), pool_connector),
                        pending_pools_.end());
+  remaining_--;
 
-  if (!is_canceled_) {
+  if (is_canceled_) {
+    // Queued hosts are never connected
+    remaining_ -= queued_hosts_.size();
+    queued_hosts_.clear();
+  } else {
     if (pool_connector->is_ok()) {
       ConnectionPool::Ptr pool = pool_connector->release_pool();
       pools_[pool->address()] = pool;
+      if (is_local(pool_connector->host())) local_ready_++;
     } else {
       failures_.push_back(ConnectionPoolConnector::Ptr(pool_connector));
     }
+    connect_next();
   }
 
-  if (--remaining_ == 0) {
-    if (!is_canceled_) {
-      manager_.reset(new ConnectionPoolManager(pools_, loop_, protocol_version_, keyspace_,
-                                               listener_, metrics_, settings_));
-    }
-    callback_(this);
-    // If the manager hasn't been released then close it.
-    if (manager_) {
-      // If the callback doesn't take possession of the manager then we should
-      // also clear the listener.
-      manager_->set_listener();
-      manager_->close();
-    }
-    dec_ref();
+  if (remaining_ == 0 || (!is_canceled_ && is_warm())) {
+    finish();
+  }
+}
+
+void ConnectionPoolManagerInitializer::on_warm_up_timeout(Timer* timer) {
+  is_warm_up_expired_ = true;
+  if (is_warm()) {
+    finish();
   }
 }
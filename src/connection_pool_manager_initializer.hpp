@@ -24,6 +24,7 @@
 #include "connection_pool_manager.hpp"
 #include "ref_counted.hpp"
 #include "string.hpp"
+#include "timer.hpp"
 
 #include <uv.h>
 
@@ -35,6 +36,12 @@ class Metrics;
 /**
  * An initializer for a connection pool manager. This connects many connection
  * pools to different hosts.
+ *
+ * If warm-up is enabled in the settings, then the number of pools that are
+ * connecting at a time is limited (local data center hosts are connected
+ * first) and the manager is returned as soon as enough local data center
+ * pools are ready or the warm-up time budget expires. Pools that haven't
+ * finished connecting are handed over to the manager.
  */
 class ConnectionPoolManagerInitializer
     : public RefCounted<ConnectionPoolManagerInitializer>
@@ -98,6 +105,16 @@ public:
    */
   ConnectionPoolManagerInitializer* with_settings(const ConnectionPoolSettings& settings);
 
+  /**
+   * Set the local data center used to determine which pools need to be ready
+   * when warm-up is enabled. If not set, or if it doesn't match any hosts,
+   * then all hosts are considered local.
+   *
+   * @param local_dc The local data center.
+   * @return The initializer to chain calls.
+   */
+  ConnectionPoolManagerInitializer* with_local_dc(const String& local_dc);
+
   /**
    * Critical failures that happened during the connection process.
    *
@@ -130,8 +147,15 @@ private:
 
   virtual void on_close(ConnectionPool* pool);
 
+private:
+  bool is_local(const Host::Ptr& host) const;
+  bool is_warm() const;
+  void connect_next();
+  void finish();
+
 private:
   void on_connect(ConnectionPoolConnector* pool_connector);
+  void on_warm_up_timeout(Timer* timer);
 
 private:
   uv_loop_t* loop_;
@@ -143,12 +167,20 @@ private:
   ConnectionPool::Map pools_;
   ConnectionPoolConnector::Vec pending_pools_;
   ConnectionPoolConnector::Vec failures_;
+  HostVec queued_hosts_;
 
   ProtocolVersion protocol_version_;
   String keyspace_;
   ConnectionPoolManagerListener* listener_;
   Metrics* metrics_;
   ConnectionPoolSettings settings_;
+
+  String local_dc_;
+  bool has_local_hosts_;
+  size_t local_ready_;
+  size_t local_required_;
+  bool is_warm_up_expired_;
+  Timer warm_up_timer_;
 };
 
 }}} // namespace datastax::internal::core
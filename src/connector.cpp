@@ -154,6 +154,7 @@ ConnectionSettings::ConnectionSettings()
     , auth_provider(new AuthProvider())
     , idle_timeout_secs(CASS_DEFAULT_IDLE_TIMEOUT_SECS)
     , heartbeat_interval_secs(CASS_DEFAULT_HEARTBEAT_INTERVAL_SECS)
+    , record_request_timings(CASS_DEFAULT_REQUEST_STAGE_TIMINGS)
     , no_compact(CASS_DEFAULT_NO_COMPACT) {}
 
 ConnectionSettings::ConnectionSettings(const Config& config)
@@ -162,6 +163,7 @@ ConnectionSettings::ConnectionSettings(const Config& config)
     , auth_provider(config.auth_provider())
     , idle_timeout_secs(config.connection_idle_timeout_secs())
     , heartbeat_interval_secs(config.connection_heartbeat_interval_secs())
+    , record_request_timings(config.request_stage_timings())
     , no_compact(config.no_compact())
     , application_name(config.application_name())
     , application_version(config.application_version()) {}
@@ -336,7 +338,8 @@ void Connector::on_connect(SocketConnector* socket_connector) {
     Socket::Ptr socket(socket_connector->release_socket());
 
     connection_.reset(new Connection(socket, host_, protocol_version_, settings_.idle_timeout_secs,
-                                     settings_.heartbeat_interval_secs));
+                                     settings_.heartbeat_interval_secs,
+                                     settings_.record_request_timings));
     connection_->set_listener(this);
 
     if (socket_connector->ssl_session()) {
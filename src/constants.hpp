@@ -113,12 +113,18 @@
 #define CASS_DEFAULT_HOSTNAME_RESOLUTION_ENABLED false
 #define CASS_DEFAULT_IDLE_TIMEOUT_SECS 60
 #define CASS_DEFAULT_LOG_LEVEL CASS_LOG_WARN
-#define CASS_DEFAULT_MAX_PREPARES_PER_FLUSH 128
+#define CASS_DEFAULT_MAX_PREPARES_OUTSTANDING 128
 #define CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS UINT_MAX
 #define CASS_DEFAULT_MAX_SCHEMA_WAIT_TIME_MS 10000
 #define CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST 1
+#define CASS_DEFAULT_WARM_UP_MAX_CONCURRENT_CONNECTS 0
+#define CASS_DEFAULT_WARM_UP_READY_RATIO 0.0
+#define CASS_DEFAULT_WARM_UP_TIMEOUT_MS 0
 #define CASS_DEFAULT_PREPARE_ON_ALL_HOSTS true
 #define CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST true
+#define CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_TIMEOUT_MS 0
+#define CASS_DEFAULT_PAGER_PREFETCH_DEPTH 1
+#define CASS_DEFAULT_PAGER_PREFETCH_MAX_BYTES (16 * 1024 * 1024)
 #define CASS_DEFAULT_PORT 9042
 #define CASS_DEFAULT_QUEUE_SIZE_IO 8192
 #define CASS_DEFAULT_CONSTANT_RECONNECT_WAIT_TIME_MS 2000u
@@ -135,6 +141,9 @@
 #define CASS_DEFAULT_USE_BETA_PROTOCOL_VERSION false
 #define CASS_DEFAULT_USE_RANDOMIZED_CONTACT_POINTS true
 #define CASS_DEFAULT_USE_SCHEMA true
+#define CASS_DEFAULT_USE_LAZY_SCHEMA false
+#define CASS_DEFAULT_EVENT_DEBOUNCE_WINDOW_MS 0
+#define CASS_DEFAULT_EVENT_DEBOUNCE_MAX_DELAY_MS 10000
 #define CASS_DEFAULT_COALESCE_DELAY 200
 #define CASS_DEFAULT_NEW_REQUEST_RATIO 50
 #define CASS_DEFAULT_NO_COMPACT false
@@ -151,6 +160,16 @@
 // Client monitoring defaults
 #define CASS_DEFAULT_CLIENT_MONITOR_EVENTS_INTERVAL_SECS 300
 
+// Metrics exporter defaults
+#define CASS_DEFAULT_METRICS_EXPORTER_PORT 0 // Disabled
+
+// Request stage timing defaults
+#define CASS_DEFAULT_REQUEST_STAGE_TIMINGS false
+
+// Event loop monitoring defaults
+#define CASS_DEFAULT_EVENT_LOOP_PROBE_INTERVAL_MS 100
+#define CASS_DEFAULT_BLOCKED_CALLBACK_THRESHOLD_US 0 // Disabled
+
 // DBaaS product type identification
 #define CASS_DBAAS_PRODUCT_TYPE "DATASTAX_APOLLO"
 
@@ -20,6 +20,7 @@
 #include "constants.hpp"
 #include "error_response.hpp"
 #include "event_response.hpp"
+#include "get_time.hpp"
 #include "load_balancing.hpp"
 #include "logger.hpp"
 #include "metadata.hpp"
@@ -279,6 +280,79 @@ public:
   const bool is_aggregate;
 };
 
+/**
+ * A specialized request callback for loading all the schema metadata of a
+ * keyspace on demand. The listener is notified once the queries finish.
+ */
+class LoadKeyspaceSchemaCallback : public ChainedControlRequestCallback {
+public:
+  /**
+   * Constructor.
+   *
+   * @param keyspace_name The name of the keyspace to load.
+   * @param query The first query to run.
+   * @param control_connection The control connection to run the queries on.
+   */
+  LoadKeyspaceSchemaCallback(const String& keyspace_name, const String& query,
+                             ControlConnection* control_connection)
+      : ChainedControlRequestCallback("keyspaces", query, control_connection,
+                                      ControlConnection::on_load_keyspace_schema)
+      , keyspace_name(keyspace_name) {}
+
+  virtual void on_chain_set() {
+    for (Map::const_iterator it = responses().begin(), end = responses().end(); it != end; ++it) {
+      if (it->second->opcode() != CQL_OPCODE_RESULT) {
+        notify_error(CASS_ERROR_LIB_UNEXPECTED_RESPONSE,
+                     "Unexpected response loading schema metadata for keyspace");
+        break;
+      }
+    }
+    ChainedControlRequestCallback::on_chain_set();
+  }
+
+  virtual void on_chain_error(CassError code, const String& message) {
+    notify_error(code, "Error loading schema metadata for keyspace: " + message);
+    ChainedControlRequestCallback::on_chain_error(code, message);
+  }
+
+  virtual void on_chain_timeout() {
+    notify_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                 "Timed out loading schema metadata for keyspace");
+    ChainedControlRequestCallback::on_chain_timeout();
+  }
+
+  const String keyspace_name;
+
+private:
+  void notify_error(CassError code, const String& message) {
+    control_connection()->listener_->on_load_keyspace_schema(keyspace_name, code, message);
+  }
+};
+
+/**
+ * A specialized request callback for refreshing a batch of debounced events.
+ * The queries for all the schema and topology changes are run together and
+ * the results are passed to the listener at the same time.
+ */
+class RefreshBatchCallback : public ChainedControlRequestCallback {
+public:
+  /**
+   * Constructor.
+   *
+   * @param events The events being refreshed.
+   * @param key The key of the first query.
+   * @param query The first query to run.
+   * @param control_connection The control connection to run the queries on.
+   */
+  RefreshBatchCallback(const ControlConnection::PendingEvents& events, const String& key,
+                       const String& query, ControlConnection* control_connection)
+      : ChainedControlRequestCallback(key, query, control_connection,
+                                      ControlConnection::on_refresh_batch)
+      , events(events) {}
+
+  const ControlConnection::PendingEvents events;
+};
+
 /**
  * A no operation control connection listener. This is used if no listener
  * is set.
@@ -304,17 +378,147 @@ public:
 
 static NopControlConnectionListener nop_listener__;
 
+namespace datastax { namespace internal { namespace core {
+
+ChainedRequestCallback::Ptr chain_schema_queries(const ChainedRequestCallback::Ptr& callback,
+                                                 const VersionNumber& server_version,
+                                                 const String& where_clause) {
+  ChainedRequestCallback::Ptr chained(callback);
+  if (server_version >= VersionNumber(3, 0, 0)) {
+    chained = chained->chain("tables", SELECT_TABLES_30 + where_clause)
+                  ->chain("views", SELECT_VIEWS_30 + where_clause)
+                  ->chain("columns", SELECT_COLUMNS_30 + where_clause)
+                  ->chain("indexes", SELECT_INDEXES_30 + where_clause)
+                  ->chain("user_types", SELECT_USERTYPES_30 + where_clause)
+                  ->chain("functions", SELECT_FUNCTIONS_30 + where_clause)
+                  ->chain("aggregates", SELECT_AGGREGATES_30 + where_clause);
+  } else {
+    chained = chained->chain("tables", SELECT_COLUMN_FAMILIES_20 + where_clause)
+                  ->chain("columns", SELECT_COLUMNS_20 + where_clause);
+
+    if (server_version >= VersionNumber(2, 1, 0)) {
+      chained = chained->chain("user_types", SELECT_USERTYPES_21 + where_clause);
+    }
+    if (server_version >= VersionNumber(2, 2, 0)) {
+      chained = chained->chain("functions", SELECT_FUNCTIONS_22 + where_clause)
+                    ->chain("aggregates", SELECT_AGGREGATES_22 + where_clause);
+    }
+  }
+  return chained;
+}
+
+// Quote a name as a CQL string literal
+static String quote_name(const String& name) {
+  String quoted("'");
+  for (String::const_iterator c = name.begin(); c != name.end(); ++c) {
+    if (*c == '\'') quoted.push_back('\''); // Escape single quotes
+    quoted.push_back(*c);
+  }
+  quoted.push_back('\'');
+  return quoted;
+}
+
+String schema_keyspaces_where_clause(const StringVec& keyspaces) {
+  String where_clause(" WHERE keyspace_name IN (");
+  for (StringVec::const_iterator it = keyspaces.begin(), end = keyspaces.end(); it != end; ++it) {
+    if (it != keyspaces.begin()) where_clause.append(",");
+    where_clause.append(quote_name(*it));
+  }
+  where_clause.append(")");
+  return where_clause;
+}
+
+ChainedRequestCallback::Ptr chain_full_schema_queries(const ChainedRequestCallback::Ptr& callback,
+                                                      const VersionNumber& server_version,
+                                                      const ControlConnectionSettings& settings) {
+  // The replication settings of all keyspaces are always loaded (for
+  // token-aware routing), but the rest of the schema metadata can be
+  // restricted to a set of keyspaces.
+  bool use_schema = settings.use_schema;
+  String where_clause;
+  StringVec keyspaces;
+  if (use_schema && settings.loaded_schema_keyspaces(&keyspaces)) {
+    use_schema = !keyspaces.empty(); // Lazy schema without any loaded keyspaces
+    where_clause = schema_keyspaces_where_clause(keyspaces);
+  }
+
+  if (!use_schema) return callback;
+
+  ChainedRequestCallback::Ptr chained(chain_schema_queries(callback, server_version, where_clause));
+  if (server_version >= VersionNumber(4, 0, 0)) {
+    chained = chained->chain("virtual_keyspaces", SELECT_VIRTUAL_KEYSPACES_40)
+                  ->chain("virtual_tables", SELECT_VIRTUAL_TABLES_40)
+                  ->chain("virtual_columns", SELECT_VIRTUAL_COLUMNS_40);
+  }
+  return chained;
+}
+
+String schema_metadata_scope(const ControlConnectionSettings& settings) {
+  if (!settings.use_schema) return "none";
+  StringVec keyspaces;
+  if (!settings.loaded_schema_keyspaces(&keyspaces)) return "all";
+  return "keyspaces" + schema_keyspaces_where_clause(keyspaces);
+}
+
+void get_schema_results(const ChainedRequestCallback* callback, ControlConnectionSchema* schema) {
+  schema->keyspaces = callback->result("keyspaces");
+  schema->tables = callback->result("tables");
+  schema->views = callback->result("views");
+  schema->columns = callback->result("columns");
+  schema->indexes = callback->result("indexes");
+  schema->user_types = callback->result("user_types");
+  schema->functions = callback->result("functions");
+  schema->aggregates = callback->result("aggregates");
+  schema->virtual_keyspaces = callback->result("virtual_keyspaces");
+  schema->virtual_tables = callback->result("virtual_tables");
+  schema->virtual_columns = callback->result("virtual_columns");
+}
+
+}}} // namespace datastax::internal::core
+
 ControlConnectionSettings::ControlConnectionSettings()
     : use_schema(CASS_DEFAULT_USE_SCHEMA)
+    , use_lazy_schema(CASS_DEFAULT_USE_LAZY_SCHEMA)
+    , event_debounce_window_ms(CASS_DEFAULT_EVENT_DEBOUNCE_WINDOW_MS)
+    , event_debounce_max_delay_ms(CASS_DEFAULT_EVENT_DEBOUNCE_MAX_DELAY_MS)
     , use_token_aware_routing(CASS_DEFAULT_USE_TOKEN_AWARE_ROUTING)
     , address_factory(new DefaultAddressFactory()) {}
 
 ControlConnectionSettings::ControlConnectionSettings(const Config& config)
     : connection_settings(config)
     , use_schema(config.use_schema())
+    , schema_keyspaces(config.schema_keyspaces())
+    , use_lazy_schema(config.use_lazy_schema())
+    , event_debounce_window_ms(config.event_debounce_window_ms())
+    , event_debounce_max_delay_ms(config.event_debounce_max_delay_ms())
     , use_token_aware_routing(config.token_aware_routing())
     , address_factory(create_address_factory_from_config(config)) {}
 
+bool ControlConnectionSettings::is_schema_keyspace_allowed(const String& keyspace_name) const {
+  return schema_keyspaces.empty() ||
+         std::find(schema_keyspaces.begin(), schema_keyspaces.end(), keyspace_name) !=
+             schema_keyspaces.end();
+}
+
+bool ControlConnectionSettings::is_schema_keyspace_loaded(const String& keyspace_name) const {
+  if (use_lazy_schema) {
+    return std::find(lazy_schema_keyspaces.begin(), lazy_schema_keyspaces.end(), keyspace_name) !=
+           lazy_schema_keyspaces.end();
+  }
+  return is_schema_keyspace_allowed(keyspace_name);
+}
+
+bool ControlConnectionSettings::loaded_schema_keyspaces(StringVec* keyspaces) const {
+  if (use_lazy_schema) {
+    *keyspaces = lazy_schema_keyspaces;
+    return true;
+  } else if (!schema_keyspaces.empty()) {
+    *keyspaces = schema_keyspaces;
+    return true;
+  }
+  return false;
+}
+
 ControlConnector::ControlConnector(const Host::Ptr& host, ProtocolVersion protocol_version,
                                    const Callback& callback)
     : connector_(
@@ -335,7 +539,8 @@ ControlConnection::ControlConnection(const Connection::Ptr& connection,
     , server_version_(server_version)
     , dse_server_version_(dse_server_version)
     , listen_addresses_(listen_addresses)
-    , listener_(listener ? listener : &nop_listener__) {
+    , listener_(listener ? listener : &nop_listener__)
+    , pending_events_start_ms_(0) {
   connection_->set_listener(this);
   inc_ref();
 }
@@ -356,6 +561,90 @@ void ControlConnection::set_listener(ControlConnectionListener* listener) {
   listener_ = listener ? listener : &nop_listener__;
 }
 
+void ControlConnection::load_keyspace_schema(const String& keyspace_name) {
+  StringVec keyspaces;
+  keyspaces.push_back(keyspace_name);
+  String where_clause(schema_keyspaces_where_clause(keyspaces));
+
+  String query(server_version_ >= VersionNumber(3, 0, 0) ? SELECT_KEYSPACES_30
+                                                         : SELECT_KEYSPACES_20);
+  query.append(where_clause);
+
+  LOG_DEBUG("Loading schema metadata for keyspace %s", keyspace_name.c_str());
+
+  ChainedRequestCallback::Ptr callback(
+      new LoadKeyspaceSchemaCallback(keyspace_name, query, this));
+  callback = chain_schema_queries(callback, server_version_, where_clause);
+
+  if (write_and_flush(callback) < 0) {
+    LOG_ERROR("No more stream available while attempting to load keyspace schema");
+    listener_->on_load_keyspace_schema(
+        keyspace_name, CASS_ERROR_LIB_NO_STREAMS,
+        "Unable to write schema metadata queries to the control connection");
+    defunct();
+  }
+}
+
+void ControlConnection::on_load_keyspace_schema(ChainedControlRequestCallback* callback) {
+  LoadKeyspaceSchemaCallback* load_callback = static_cast<LoadKeyspaceSchemaCallback*>(callback);
+  load_callback->control_connection()->handle_load_keyspace_schema(load_callback);
+}
+
+void ControlConnection::handle_load_keyspace_schema(LoadKeyspaceSchemaCallback* callback) {
+  // The keyspace itself is already up-to-date, its metadata is always loaded.
+  // The order matters here: tables are needed before views, columns and
+  // indexes.
+  static const struct {
+    const char* key;
+    ControlConnectionListener::SchemaType type;
+  } schema_results[] = { { "tables", ControlConnectionListener::TABLE },
+                         { "views", ControlConnectionListener::VIEW },
+                         { "columns", ControlConnectionListener::COLUMN },
+                         { "indexes", ControlConnectionListener::INDEX },
+                         { "user_types", ControlConnectionListener::USER_TYPE },
+                         { "functions", ControlConnectionListener::FUNCTION },
+                         { "aggregates", ControlConnectionListener::AGGREGATE } };
+
+  for (size_t i = 0; i < sizeof(schema_results) / sizeof(schema_results[0]); ++i) {
+    ResultResponse::Ptr result(callback->result(schema_results[i].key));
+    if (result) {
+      listener_->on_update_schema(schema_results[i].type, result, callback->keyspace_name);
+    }
+  }
+
+  // Only record the keyspace once its schema metadata has been loaded so that
+  // it's kept up-to-date by schema events.
+  if (!settings_.is_schema_keyspace_loaded(callback->keyspace_name)) {
+    settings_.lazy_schema_keyspaces.push_back(callback->keyspace_name);
+  }
+  listener_->on_load_keyspace_schema(callback->keyspace_name, CASS_OK, "");
+}
+
+void ControlConnection::refresh_schema() {
+  LOG_DEBUG("Refreshing all schema metadata");
+
+  ChainedRequestCallback::Ptr callback(new ChainedControlRequestCallback(
+      "keyspaces",
+      server_version_ >= VersionNumber(3, 0, 0) ? SELECT_KEYSPACES_30 : SELECT_KEYSPACES_20, this,
+      ControlConnection::on_refresh_schema));
+  callback = chain_full_schema_queries(callback, server_version_, settings_);
+
+  if (write_and_flush(callback) < 0) {
+    LOG_ERROR("No more stream available while attempting to refresh schema metadata");
+    defunct();
+  }
+}
+
+void ControlConnection::on_refresh_schema(ChainedControlRequestCallback* callback) {
+  callback->control_connection()->handle_refresh_schema(callback);
+}
+
+void ControlConnection::handle_refresh_schema(ChainedControlRequestCallback* callback) {
+  ControlConnectionSchema schema;
+  get_schema_results(callback, &schema);
+  listener_->on_refresh_schema(schema);
+}
+
 void ControlConnection::refresh_node(RefreshNodeType type, const Address& address) {
   bool is_connected_host = connection_->host()->rpc_address().equals(address, false);
 
@@ -416,13 +705,17 @@ void ControlConnection::handle_refresh_node(RefreshNodeCallback* callback) {
     return;
   }
 
+  handle_node_row(callback->type, row);
+}
+
+void ControlConnection::handle_node_row(RefreshNodeType type, const Row* row) {
   Address address;
   if (settings_.address_factory->create(row, connection_->host(), &address)) {
     Host::Ptr host(new Host(address));
     host->set(row, settings_.use_token_aware_routing);
     listen_addresses_[host->rpc_address()] = determine_listen_address(address, row);
 
-    switch (callback->type) {
+    switch (type) {
       case NEW_NODE:
         listener_->on_add(host);
         break;
@@ -686,12 +979,372 @@ void ControlConnection::handle_refresh_function(RefreshFunctionCallback* callbac
       Metadata::full_function_name(callback->function_name, callback->arg_types));
 }
 
+void ControlConnection::debounce_event(const EventResponse::Ptr& response) {
+  switch (response->event_type()) {
+    case CASS_EVENT_TOPOLOGY_CHANGE:
+      pending_events_.topology[response->affected_node()] = response;
+      break;
+
+    case CASS_EVENT_STATUS_CHANGE:
+      pending_events_.status[response->affected_node()] = response;
+      break;
+
+    case CASS_EVENT_SCHEMA_CHANGE: {
+      if (is_schema_event_ignored(response)) return;
+
+      String keyspace_name(response->keyspace().to_string());
+      String target_name(response->target().to_string());
+      String function_name;
+      if (response->schema_change_target() == EventResponse::FUNCTION ||
+          response->schema_change_target() == EventResponse::AGGREGATE) {
+        function_name =
+            Metadata::full_function_name(target_name, to_strings(response->arg_types()));
+      }
+
+      if (response->schema_change() == EventResponse::DROPPED) {
+        // Drops don't require a query so they're applied immediately, but any
+        // pending refresh of the dropped object is no longer needed.
+        PendingSchemaRefreshMap::iterator it = pending_events_.schema.find(keyspace_name);
+        if (it != pending_events_.schema.end()) {
+          PendingSchemaRefresh& refresh = it->second;
+          switch (response->schema_change_target()) {
+            case EventResponse::KEYSPACE:
+              pending_events_.schema.erase(it);
+              break;
+            case EventResponse::TABLE:
+              refresh.tables_or_views.erase(std::remove(refresh.tables_or_views.begin(),
+                                                        refresh.tables_or_views.end(),
+                                                        target_name),
+                                            refresh.tables_or_views.end());
+              break;
+            case EventResponse::TYPE:
+              refresh.types.erase(
+                  std::remove(refresh.types.begin(), refresh.types.end(), target_name),
+                  refresh.types.end());
+              break;
+            case EventResponse::FUNCTION:
+              refresh.functions.erase(function_name);
+              break;
+            case EventResponse::AGGREGATE:
+              refresh.aggregates.erase(function_name);
+              break;
+          }
+        }
+        handle_event(response);
+        return;
+      }
+
+      PendingSchemaRefresh& refresh = pending_events_.schema[keyspace_name];
+      switch (response->schema_change_target()) {
+        case EventResponse::KEYSPACE:
+          refresh.is_keyspace = true;
+          break;
+        case EventResponse::TABLE:
+          if (std::find(refresh.tables_or_views.begin(), refresh.tables_or_views.end(),
+                        target_name) == refresh.tables_or_views.end()) {
+            refresh.tables_or_views.push_back(target_name);
+          }
+          break;
+        case EventResponse::TYPE:
+          if (std::find(refresh.types.begin(), refresh.types.end(), target_name) ==
+              refresh.types.end()) {
+            refresh.types.push_back(target_name);
+          }
+          break;
+        case EventResponse::FUNCTION:
+          refresh.functions[function_name] = response;
+          break;
+        case EventResponse::AGGREGATE:
+          refresh.aggregates[function_name] = response;
+          break;
+      }
+      break;
+    }
+
+    default:
+      assert(false);
+      return;
+  }
+
+  // The first event starts the batch. Each event after that extends the batch
+  // by the debounce window, but never past the maximum delay.
+  uint64_t now_ms = get_time_monotonic_ns() / (1000 * 1000);
+  if (!debounce_timer_.is_running()) {
+    pending_events_start_ms_ = now_ms;
+  }
+  uint64_t elapsed_ms = now_ms - pending_events_start_ms_;
+  uint64_t timeout_ms = 0;
+  if (elapsed_ms < settings_.event_debounce_max_delay_ms) {
+    timeout_ms = std::min(settings_.event_debounce_window_ms,
+                          settings_.event_debounce_max_delay_ms - elapsed_ms);
+  }
+  debounce_timer_.start(loop(), timeout_ms,
+                        bind_callback(&ControlConnection::on_event_debounce, this));
+}
+
+void ControlConnection::on_event_debounce(Timer* timer) { refresh_batch(); }
+
+void ControlConnection::refresh_batch() {
+  PendingEvents events;
+  events.schema.swap(pending_events_.schema);
+  events.topology.swap(pending_events_.topology);
+  events.status.swap(pending_events_.status);
+
+  // Status changes don't require any queries.
+  for (PendingNodeEventMap::const_iterator it = events.status.begin(), end = events.status.end();
+       it != end; ++it) {
+    handle_event(it->second);
+  }
+  events.status.clear();
+
+  bool is_server_30 = server_version_ >= VersionNumber(3, 0, 0);
+  typedef std::pair<String, String> KeyQuery;
+  Vector<KeyQuery> queries;
+
+  StringVec keyspaces;
+  for (PendingSchemaRefreshMap::const_iterator it = events.schema.begin(),
+                                               end = events.schema.end();
+       it != end; ++it) {
+    if (it->second.is_keyspace) keyspaces.push_back(it->first);
+  }
+  if (!keyspaces.empty()) {
+    // All the keyspaces are refreshed using a single query so that the token
+    // map's replicas only need to be rebuilt once.
+    queries.push_back(
+        KeyQuery("keyspaces", String(is_server_30 ? SELECT_KEYSPACES_30 : SELECT_KEYSPACES_20) +
+                                  schema_keyspaces_where_clause(keyspaces)));
+  }
+
+  bool is_local_refreshed = false;
+  bool is_peers_refreshed = false;
+  for (PendingNodeEventMap::const_iterator it = events.topology.begin(),
+                                           end = events.topology.end();
+       it != end; ++it) {
+    if (it->second->topology_change() == EventResponse::REMOVED_NODE) continue;
+    if (connection_->host()->rpc_address().equals(it->first, false)) {
+      is_local_refreshed = true;
+    } else {
+      is_peers_refreshed = true;
+    }
+  }
+  if (is_local_refreshed) queries.push_back(KeyQuery("local", SELECT_LOCAL));
+  if (is_peers_refreshed) queries.push_back(KeyQuery("peers", SELECT_PEERS));
+
+  for (PendingSchemaRefreshMap::const_iterator it = events.schema.begin(),
+                                               end = events.schema.end();
+       it != end; ++it) {
+    const String& keyspace_name = it->first;
+    const PendingSchemaRefresh& refresh = it->second;
+    String keyspace_where(" WHERE keyspace_name=" + quote_name(keyspace_name));
+
+    // A single change is refreshed by name, otherwise everything in the
+    // keyspace is refreshed.
+    if (!refresh.tables_or_views.empty()) {
+      String table_name_where;
+      String view_name_where;
+      if (refresh.tables_or_views.size() == 1) {
+        const String& name = refresh.tables_or_views.front();
+        table_name_where =
+            (is_server_30 ? " AND table_name=" : " AND columnfamily_name=") + quote_name(name);
+        view_name_where = " AND view_name=" + quote_name(name);
+      }
+      if (is_server_30) {
+        queries.push_back(KeyQuery("tables:" + keyspace_name,
+                                   SELECT_TABLES_30 + keyspace_where + table_name_where));
+        queries.push_back(KeyQuery("views:" + keyspace_name,
+                                   SELECT_VIEWS_30 + keyspace_where + view_name_where));
+        queries.push_back(KeyQuery("columns:" + keyspace_name,
+                                   SELECT_COLUMNS_30 + keyspace_where + table_name_where));
+        queries.push_back(KeyQuery("indexes:" + keyspace_name,
+                                   SELECT_INDEXES_30 + keyspace_where + table_name_where));
+      } else {
+        queries.push_back(KeyQuery("tables:" + keyspace_name,
+                                   SELECT_COLUMN_FAMILIES_20 + keyspace_where + table_name_where));
+        queries.push_back(KeyQuery("columns:" + keyspace_name,
+                                   SELECT_COLUMNS_20 + keyspace_where + table_name_where));
+      }
+    }
+
+    if (!refresh.types.empty()) {
+      String type_name_where;
+      if (refresh.types.size() == 1) {
+        type_name_where = " AND type_name=" + quote_name(refresh.types.front());
+      }
+      queries.push_back(
+          KeyQuery("user_types:" + keyspace_name,
+                   (is_server_30 ? SELECT_USERTYPES_30 : SELECT_USERTYPES_21) + keyspace_where +
+                       type_name_where));
+    }
+
+    // Functions and aggregates are refreshed individually because they're
+    // rare and don't affect the token map.
+    for (PendingFunctionMap::const_iterator function_it = refresh.functions.begin(),
+                                            functions_end = refresh.functions.end();
+         function_it != functions_end; ++function_it) {
+      const EventResponse::Ptr& response = function_it->second;
+      refresh_function(response->keyspace(), response->target(), response->arg_types(), false);
+    }
+    for (PendingFunctionMap::const_iterator aggregate_it = refresh.aggregates.begin(),
+                                            aggregates_end = refresh.aggregates.end();
+         aggregate_it != aggregates_end; ++aggregate_it) {
+      const EventResponse::Ptr& response = aggregate_it->second;
+      refresh_function(response->keyspace(), response->target(), response->arg_types(), true);
+    }
+  }
+
+  if (queries.empty()) {
+    if (!events.topology.empty()) { // Only removed nodes
+      listener_->on_refresh_batch_begin();
+      for (PendingNodeEventMap::const_iterator it = events.topology.begin(),
+                                               end = events.topology.end();
+           it != end; ++it) {
+        handle_event(it->second);
+      }
+      listener_->on_refresh_batch_end();
+    }
+    return;
+  }
+
+  LOG_DEBUG("Refreshing %u keyspace(s), %u schema query(s) and %u node(s) from debounced events",
+            (unsigned int)keyspaces.size(), (unsigned int)queries.size(),
+            (unsigned int)events.topology.size());
+
+  ChainedRequestCallback::Ptr callback(
+      new RefreshBatchCallback(events, queries.front().first, queries.front().second, this));
+  for (Vector<KeyQuery>::const_iterator it = queries.begin() + 1, end = queries.end(); it != end;
+       ++it) {
+    callback = callback->chain(it->first, it->second);
+  }
+
+  if (write_and_flush(callback) < 0) {
+    LOG_ERROR("No more stream available while attempting to refresh debounced events");
+    defunct();
+  }
+}
+
+void ControlConnection::on_refresh_batch(ChainedControlRequestCallback* callback) {
+  RefreshBatchCallback* batch_callback = static_cast<RefreshBatchCallback*>(callback);
+  batch_callback->control_connection()->handle_refresh_batch(batch_callback);
+}
+
+void ControlConnection::handle_refresh_batch(RefreshBatchCallback* callback) {
+  const PendingEvents& events = callback->events;
+
+  listener_->on_refresh_batch_begin();
+
+  ResultResponse::Ptr keyspaces_result(callback->result("keyspaces"));
+  if (keyspaces_result && keyspaces_result->row_count() > 0) {
+    listener_->on_update_schema(ControlConnectionListener::KEYSPACE, keyspaces_result, "");
+  }
+
+  ResultResponse::Ptr local_result(callback->result("local"));
+  ResultResponse::Ptr peers_result(callback->result("peers"));
+  for (PendingNodeEventMap::const_iterator it = events.topology.begin(),
+                                           end = events.topology.end();
+       it != end; ++it) {
+    const EventResponse::Ptr& response = it->second;
+    if (response->topology_change() == EventResponse::REMOVED_NODE) {
+      handle_event(response);
+      continue;
+    }
+
+    const Row* row = NULL;
+    if (connection_->host()->rpc_address().equals(it->first, false)) {
+      ResultIterator rows(local_result.get());
+      if (rows.next()) row = rows.row();
+    } else {
+      ResultIterator rows(peers_result.get());
+      while (rows.next() && !row) {
+        Address address;
+        if (settings_.address_factory->create(rows.row(), connection_->host(), &address) &&
+            it->first == address) {
+          row = rows.row();
+        }
+      }
+    }
+
+    if (!row) {
+      String address_str = it->first.to_string();
+      LOG_ERROR("No row found for host %s in %s's peers system table. "
+                "%s will be ignored.",
+                address_str.c_str(), address_string().c_str(), address_str.c_str());
+      continue;
+    }
+
+    handle_node_row(response->topology_change() == EventResponse::NEW_NODE ? NEW_NODE : MOVED_NODE,
+                    row);
+  }
+
+  for (PendingSchemaRefreshMap::const_iterator it = events.schema.begin(),
+                                               end = events.schema.end();
+       it != end; ++it) {
+    const String& keyspace_name = it->first;
+    const PendingSchemaRefresh& refresh = it->second;
+    String target_name(refresh.tables_or_views.size() == 1 ? refresh.tables_or_views.front() : "");
+
+    ResultResponse::Ptr tables_result(callback->result("tables:" + keyspace_name));
+    ResultResponse::Ptr views_result(callback->result("views:" + keyspace_name));
+    bool has_tables = tables_result && tables_result->row_count() > 0;
+    bool has_views = views_result && views_result->row_count() > 0;
+    if (has_tables) {
+      listener_->on_update_schema(ControlConnectionListener::TABLE, tables_result, keyspace_name,
+                                  target_name);
+    }
+    if (has_views) {
+      listener_->on_update_schema(ControlConnectionListener::VIEW, views_result, keyspace_name,
+                                  target_name);
+    }
+    if (has_tables || has_views) {
+      ResultResponse::Ptr columns_result(callback->result("columns:" + keyspace_name));
+      if (columns_result) {
+        listener_->on_update_schema(ControlConnectionListener::COLUMN, columns_result,
+                                    keyspace_name, target_name);
+      }
+      ResultResponse::Ptr indexes_result(callback->result("indexes:" + keyspace_name));
+      if (indexes_result) {
+        listener_->on_update_schema(ControlConnectionListener::INDEX, indexes_result,
+                                    keyspace_name, target_name);
+      }
+    }
+
+    ResultResponse::Ptr types_result(callback->result("user_types:" + keyspace_name));
+    if (types_result && types_result->row_count() > 0) {
+      listener_->on_update_schema(ControlConnectionListener::USER_TYPE, types_result,
+                                  keyspace_name,
+                                  refresh.types.size() == 1 ? refresh.types.front() : "");
+    }
+  }
+
+  listener_->on_refresh_batch_end();
+}
+
 void ControlConnection::on_close(Connection* connection) {
+  debounce_timer_.stop();
   listener_->on_close(this);
   dec_ref();
 }
 
 void ControlConnection::on_event(const EventResponse::Ptr& response) {
+  if (settings_.event_debounce_window_ms > 0) {
+    debounce_event(response);
+  } else {
+    handle_event(response);
+  }
+}
+
+bool ControlConnection::is_schema_event_ignored(const EventResponse::Ptr& response) const {
+  // Only handle keyspace events when using token-aware routing
+  if (!settings_.use_schema && response->schema_change_target() != EventResponse::KEYSPACE) {
+    return true;
+  }
+
+  // Keyspace events are always handled, but everything else is only handled
+  // for keyspaces that have their schema metadata loaded.
+  return response->schema_change_target() != EventResponse::KEYSPACE &&
+         !settings_.is_schema_keyspace_loaded(response->keyspace().to_string());
+}
+
+void ControlConnection::handle_event(const EventResponse::Ptr& response) {
   switch (response->event_type()) {
     case CASS_EVENT_TOPOLOGY_CHANGE: {
       String address_str = response->affected_node().to_string();
@@ -736,10 +1389,7 @@ void ControlConnection::on_event(const EventResponse::Ptr& response) {
     }
 
     case CASS_EVENT_SCHEMA_CHANGE:
-      // Only handle keyspace events when using token-aware routing
-      if (!settings_.use_schema && response->schema_change_target() != EventResponse::KEYSPACE) {
-        return;
-      }
+      if (is_schema_event_ignored(response)) return;
 
       LOG_DEBUG("Schema change (%d): %.*s %.*s", response->schema_change(),
                 (int)response->keyspace().size(), response->keyspace().data(),
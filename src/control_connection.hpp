@@ -23,12 +23,16 @@
 #include "connection.hpp"
 #include "connector.hpp"
 #include "dense_hash_map.hpp"
+#include "future.hpp"
 #include "host.hpp"
 #include "load_balancing.hpp"
 #include "macros.hpp"
+#include "map.hpp"
+#include "metadata_cache.hpp"
 #include "request_callback.hpp"
 #include "response.hpp"
 #include "scoped_ptr.hpp"
+#include "timer.hpp"
 #include "token_map.hpp"
 
 #include <stdint.h>
@@ -62,11 +66,14 @@ class ChainedControlRequestCallback;
 class ControlRequestCallback;
 class ControlConnection;
 class EventResponse;
+class LoadKeyspaceSchemaCallback;
+class RefreshBatchCallback;
 class RefreshNodeCallback;
 class RefreshKeyspaceCallback;
 class RefreshTableCallback;
 class RefreshTypeCallback;
 class RefreshFunctionCallback;
+struct ControlConnectionSchema;
 
 /**
  * A listener for processing control connection events such as topology, node
@@ -130,6 +137,41 @@ public:
   virtual void on_drop_schema(SchemaType type, const String& keyspace_name,
                               const String& target_name = "") = 0;
 
+  /**
+   * A callback that's called before a batch of debounced events is applied.
+   * The callbacks for all the events in the batch are called before
+   * `on_refresh_batch_end()` so expensive work, such as rebuilding the token
+   * map, can be deferred until the end of the batch.
+   */
+  virtual void on_refresh_batch_begin() {}
+
+  /**
+   * A callback that's called after a batch of debounced events is applied.
+   */
+  virtual void on_refresh_batch_end() {}
+
+  /**
+   * A callback that's called when all the schema metadata has been refreshed.
+   * This is used to revalidate schema metadata loaded from the metadata cache.
+   *
+   * @param schema The refreshed schema metadata. This replaces all the
+   * existing schema metadata.
+   */
+  virtual void on_refresh_schema(const ControlConnectionSchema& schema) {}
+
+  /**
+   * A callback that's called when loading a keyspace's schema metadata on
+   * demand finishes. On success, the schema metadata has already been passed
+   * to `on_update_schema()`.
+   *
+   * @param keyspace_name The name of the keyspace.
+   * @param error_code CASS_OK if the schema metadata was loaded, otherwise
+   * the error that occurred.
+   * @param error_message The error message if an error occurred.
+   */
+  virtual void on_load_keyspace_schema(const String& keyspace_name, CassError error_code,
+                                       const String& error_message) {}
+
   /**
    * A callback that's called when the control connection is closed.
    *
@@ -166,6 +208,31 @@ struct ControlConnectionSettings {
    */
   ControlConnectionSettings(const Config& config);
 
+  /**
+   * Determine if a keyspace is allowed by the schema keyspace filter.
+   *
+   * @param keyspace_name The name of the keyspace.
+   * @return true if the keyspace's schema metadata can be loaded.
+   */
+  bool is_schema_keyspace_allowed(const String& keyspace_name) const;
+
+  /**
+   * Determine if the schema metadata (tables, types, functions, etc.) of a
+   * keyspace is loaded and kept up-to-date.
+   *
+   * @param keyspace_name The name of the keyspace.
+   * @return true if the keyspace's schema metadata is loaded.
+   */
+  bool is_schema_keyspace_loaded(const String& keyspace_name) const;
+
+  /**
+   * Get the keyspaces that have their schema metadata loaded.
+   *
+   * @param keyspaces The loaded keyspaces (output).
+   * @return false if the schema metadata of all keyspaces is loaded.
+   */
+  bool loaded_schema_keyspaces(StringVec* keyspaces) const;
+
   /**
    * The settings for the underlying connection.
    */
@@ -176,6 +243,38 @@ struct ControlConnectionSettings {
    */
   bool use_schema;
 
+  /**
+   * If not empty then only the schema metadata of these keyspaces is loaded.
+   * The replication settings of all keyspaces are still loaded for token-aware
+   * routing.
+   */
+  StringVec schema_keyspaces;
+
+  /**
+   * If true then the schema metadata of a keyspace is only loaded after it's
+   * explicitly requested.
+   */
+  bool use_lazy_schema;
+
+  /**
+   * The keyspaces that have been loaded on demand when using lazy schema
+   * metadata.
+   */
+  StringVec lazy_schema_keyspaces;
+
+  /**
+   * The amount of time to wait for more events before refreshing schema and
+   * topology metadata. Events received within the window are coalesced. If
+   * zero then events are handled immediately.
+   */
+  uint64_t event_debounce_window_ms;
+
+  /**
+   * The maximum amount of time an event is delayed when more events continue
+   * to arrive within the debounce window.
+   */
+  uint64_t event_debounce_max_delay_ms;
+
   /**
    * If true then the control connection will listen for keyspace schema
    * events. This is needed for the keyspaces replication strategy.
@@ -186,8 +285,94 @@ struct ControlConnectionSettings {
    * A factory for creating addresses (for the connection process).
    */
   AddressFactory::Ptr address_factory;
+
+  /**
+   * If not null then the initial schema metadata is taken from the metadata
+   * cache when it matches the cluster.
+   */
+  MetadataCache::Ptr metadata_cache;
 };
 
+/**
+ * Chain the queries for schema metadata other than keyspaces (tables, views,
+ * columns, indexes, user types, functions and aggregates).
+ *
+ * @param callback The callback to chain the queries to.
+ * @param server_version The version number of the server implementation.
+ * @param where_clause A where clause that's appended to each query (can be empty).
+ * @return The last callback in the chain.
+ */
+ChainedRequestCallback::Ptr chain_schema_queries(const ChainedRequestCallback::Ptr& callback,
+                                                 const VersionNumber& server_version,
+                                                 const String& where_clause);
+
+/**
+ * Build a where clause that restricts schema queries to a set of keyspaces.
+ *
+ * @param keyspaces The keyspaces to include.
+ * @return The where clause.
+ */
+String schema_keyspaces_where_clause(const StringVec& keyspaces);
+
+/**
+ * Chain the queries for the full schema metadata that's loaded when the
+ * control connection is established, other than keyspaces. This respects the
+ * schema keyspace filter and lazy schema metadata settings.
+ *
+ * @param callback The callback to chain the queries to.
+ * @param server_version The version number of the server implementation.
+ * @param settings The control connection settings.
+ * @return The last callback in the chain.
+ */
+ChainedRequestCallback::Ptr chain_full_schema_queries(const ChainedRequestCallback::Ptr& callback,
+                                                      const VersionNumber& server_version,
+                                                      const ControlConnectionSettings& settings);
+
+/**
+ * Get the scope of the schema metadata that's loaded for the control
+ * connection settings. Cached schema metadata is only used if its scope
+ * matches.
+ *
+ * @param settings The control connection settings.
+ * @return A string describing the loaded keyspaces.
+ */
+String schema_metadata_scope(const ControlConnectionSettings& settings);
+
+/**
+ * The full schema metadata retrieved from the cluster when the control
+ * connection is established (or from the metadata cache).
+ */
+struct ControlConnectionSchema {
+  ControlConnectionSchema()
+      : is_cached(false) {}
+
+  ResultResponse::Ptr keyspaces;
+  ResultResponse::Ptr tables;
+  ResultResponse::Ptr views;
+  ResultResponse::Ptr columns;
+  ResultResponse::Ptr indexes;
+  ResultResponse::Ptr user_types;
+  ResultResponse::Ptr functions;
+  ResultResponse::Ptr aggregates;
+  ResultResponse::Ptr virtual_keyspaces;
+  ResultResponse::Ptr virtual_tables;
+  ResultResponse::Ptr virtual_columns;
+
+  /**
+   * If true then the schema metadata was loaded from the metadata cache and
+   * needs to be revalidated.
+   */
+  bool is_cached;
+};
+
+/**
+ * Get the results of the full schema metadata queries.
+ *
+ * @param callback The callback chained using `chain_full_schema_queries()`.
+ * @param schema The schema metadata (output).
+ */
+void get_schema_results(const ChainedRequestCallback* callback, ControlConnectionSchema* schema);
+
 /**
  * A control connection. This is a wrapper around a connection that handles
  * schema, node status, and topology changes. This class handles events
@@ -242,6 +427,23 @@ public:
    */
   void set_listener(ControlConnectionListener* listener = NULL);
 
+  /**
+   * Load the schema metadata (tables, views, user types, functions, etc.) of a
+   * keyspace and keep it up-to-date. This is used to load a keyspace's schema
+   * metadata on demand when using lazy schema metadata.
+   *
+   * @param keyspace_name The name of the keyspace to load. The listener's
+   * `on_load_keyspace_schema()` callback is called after the schema metadata
+   * is passed to the listener or when an error occurs.
+   */
+  void load_keyspace_schema(const String& keyspace_name);
+
+  /**
+   * Refresh all the schema metadata. The results are passed to the listener's
+   * `on_refresh_schema()` callback.
+   */
+  void refresh_schema();
+
 public:
   const Address& address() const { return connection_->address(); }
 
@@ -265,6 +467,52 @@ private:
   friend class RefreshTableCallback;
   friend class RefreshTypeCallback;
   friend class RefreshFunctionCallback;
+  friend class LoadKeyspaceSchemaCallback;
+  friend class RefreshBatchCallback;
+
+private:
+  typedef Map<String, EventResponse::Ptr> PendingFunctionMap;
+
+  /**
+   * The schema changes of a keyspace that are waiting to be refreshed.
+   */
+  struct PendingSchemaRefresh {
+    PendingSchemaRefresh()
+        : is_keyspace(false) {}
+
+    bool is_keyspace;
+    StringVec tables_or_views;
+    StringVec types;
+    PendingFunctionMap functions;  // Keyed by the full function name
+    PendingFunctionMap aggregates; // Keyed by the full aggregate name
+  };
+
+  typedef Map<String, PendingSchemaRefresh> PendingSchemaRefreshMap;
+  typedef Map<Address, EventResponse::Ptr> PendingNodeEventMap;
+
+  /**
+   * The events that are waiting to be refreshed when events are debounced.
+   */
+  struct PendingEvents {
+    bool empty() const {
+      return schema.empty() && topology.empty() && status.empty();
+    }
+
+    PendingSchemaRefreshMap schema;
+    PendingNodeEventMap topology; // The most recent event per node
+    PendingNodeEventMap status;   // The most recent event per node
+  };
+
+private:
+  void handle_event(const EventResponse::Ptr& response);
+  bool is_schema_event_ignored(const EventResponse::Ptr& response) const;
+
+  void debounce_event(const EventResponse::Ptr& response);
+  void on_event_debounce(Timer* timer);
+  void refresh_batch();
+  static void on_refresh_batch(ChainedControlRequestCallback* callback);
+  void handle_refresh_batch(RefreshBatchCallback* callback);
+  void handle_node_row(RefreshNodeType type, const Row* row);
 
 private:
   void refresh_node(RefreshNodeType type, const Address& address);
@@ -288,6 +536,12 @@ private:
   static void on_refresh_function(ControlRequestCallback* callback);
   void handle_refresh_function(RefreshFunctionCallback* callback);
 
+  static void on_load_keyspace_schema(ChainedControlRequestCallback* callback);
+  void handle_load_keyspace_schema(LoadKeyspaceSchemaCallback* callback);
+
+  static void on_refresh_schema(ChainedControlRequestCallback* callback);
+  void handle_refresh_schema(ChainedControlRequestCallback* callback);
+
   // Connection listener methods
   virtual void on_close(Connection* connection);
   virtual void on_event(const EventResponse::Ptr& response);
@@ -299,6 +553,9 @@ private:
   VersionNumber dse_server_version_;
   ListenAddressMap listen_addresses_;
   ControlConnectionListener* listener_;
+  PendingEvents pending_events_;
+  uint64_t pending_events_start_ms_;
+  Timer debounce_timer_;
 };
 
 }}} // namespace datastax::internal::core
@@ -15,6 +15,7 @@
 */
 
 #include "control_connector.hpp"
+#include "logger.hpp"
 #include "result_iterator.hpp"
 
 using namespace datastax;
@@ -240,61 +241,30 @@ void ControlConnector::handle_query_hosts(HostsConnectorRequestCallback* callbac
 }
 
 void ControlConnector::query_schema() {
-  ChainedRequestCallback::Ptr callback;
-
-  if (server_version_ >= VersionNumber(3, 0, 0)) {
-    callback = ChainedRequestCallback::Ptr(
-        new SchemaConnectorRequestCallback("keyspaces", SELECT_KEYSPACES_30, this));
-    if (settings_.use_schema) {
-      callback = callback->chain("tables", SELECT_TABLES_30)
-                     ->chain("views", SELECT_VIEWS_30)
-                     ->chain("columns", SELECT_COLUMNS_30)
-                     ->chain("indexes", SELECT_INDEXES_30)
-                     ->chain("user_types", SELECT_USERTYPES_30)
-                     ->chain("functions", SELECT_FUNCTIONS_30)
-                     ->chain("aggregates", SELECT_AGGREGATES_30);
-
-      if (server_version_ >= VersionNumber(4, 0, 0)) {
-        callback = callback->chain("virtual_keyspaces", SELECT_VIRTUAL_KEYSPACES_40)
-                       ->chain("virtual_tables", SELECT_VIRTUAL_TABLES_40)
-                       ->chain("virtual_columns", SELECT_VIRTUAL_COLUMNS_40);
-      }
-    }
-  } else {
-    callback = ChainedRequestCallback::Ptr(
-        new SchemaConnectorRequestCallback("keyspaces", SELECT_KEYSPACES_20, this));
-    if (settings_.use_schema) {
-      callback =
-          callback->chain("tables", SELECT_COLUMN_FAMILIES_20)->chain("columns", SELECT_COLUMNS_20);
-
-      if (server_version_ >= VersionNumber(2, 1, 0)) {
-        callback = callback->chain("user_types", SELECT_USERTYPES_21);
-      }
-      if (server_version_ >= VersionNumber(2, 2, 0)) {
-        callback = callback->chain("functions", SELECT_FUNCTIONS_22)
-                       ->chain("aggregates", SELECT_AGGREGATES_22);
-      }
-    }
+  if (settings_.metadata_cache &&
+      settings_.metadata_cache->schema(connector_->protocol_version(), server_version_,
+                                       dse_server_version_, schema_metadata_scope(settings_),
+                                       &schema_)) {
+    // The cached schema metadata is revalidated once the cluster is
+    // established.
+    LOG_DEBUG("Using cached schema metadata from %s",
+              settings_.metadata_cache->file_name().c_str());
+    on_success();
+    return;
   }
 
+  ChainedRequestCallback::Ptr callback(new SchemaConnectorRequestCallback(
+      "keyspaces",
+      server_version_ >= VersionNumber(3, 0, 0) ? SELECT_KEYSPACES_30 : SELECT_KEYSPACES_20, this));
+  callback = chain_full_schema_queries(callback, server_version_, settings_);
+
   if (connection_->write_and_flush(callback) < 0) {
     on_error(CONTROL_CONNECTION_ERROR_SCHEMA, "Unable able to write schema query to connection");
   }
 }
 
 void ControlConnector::handle_query_schema(SchemaConnectorRequestCallback* callback) {
-  schema_.keyspaces = callback->result("keyspaces");
-  schema_.tables = callback->result("tables");
-  schema_.views = callback->result("views");
-  schema_.columns = callback->result("columns");
-  schema_.indexes = callback->result("indexes");
-  schema_.user_types = callback->result("user_types");
-  schema_.functions = callback->result("functions");
-  schema_.aggregates = callback->result("aggregates");
-  schema_.virtual_keyspaces = callback->result("virtual_keyspaces");
-  schema_.virtual_tables = callback->result("virtual_tables");
-  schema_.virtual_columns = callback->result("virtual_columns");
-
+  get_schema_results(callback, &schema_);
   on_success();
 }
 
@@ -28,24 +28,6 @@ class HostsConnectorRequestCallback;
 class Metrics;
 class SchemaConnectorRequestCallback;
 
-/**
- * The initial schema metadata retrieved from the cluster when the control
- * connection is established.
- */
-struct ControlConnectionSchema {
-  ResultResponse::Ptr keyspaces;
-  ResultResponse::Ptr tables;
-  ResultResponse::Ptr views;
-  ResultResponse::Ptr columns;
-  ResultResponse::Ptr indexes;
-  ResultResponse::Ptr user_types;
-  ResultResponse::Ptr functions;
-  ResultResponse::Ptr aggregates;
-  ResultResponse::Ptr virtual_keyspaces;
-  ResultResponse::Ptr virtual_tables;
-  ResultResponse::Ptr virtual_columns;
-};
-
 /**
  * A connector that establishes a control connection, negotiates the protocol
  * version, and registers for cluster events (topology and schema changes). It
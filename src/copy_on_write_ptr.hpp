@@ -26,6 +26,8 @@ namespace datastax { namespace internal { namespace core {
 template <class T>
 class CopyOnWritePtr {
 public:
+  CopyOnWritePtr() {}
+
   CopyOnWritePtr(T* t)
       : ptr_(new Referenced(t)) {}
 
@@ -45,7 +47,7 @@ public:
     return *this;
   }
 
-  operator bool() const { return ptr_->ref != NULL; }
+  operator bool() const { return ptr_ && ptr_->ref != NULL; }
 
   const T& operator*() const { return *(ptr_->ref); }
 
@@ -64,7 +66,7 @@ public:
 private:
   void detach() {
     Referenced* temp = ptr_.get();
-    if (temp->ref != NULL && temp->ref_count() > 1) {
+    if (temp != NULL && temp->ref != NULL && temp->ref_count() > 1) {
       ptr_ = SharedRefPtr<Referenced>(new Referenced(new T(*(temp->ref))));
     }
   }
@@ -397,6 +397,33 @@ const DataType::ConstPtr& SimpleDataTypeCache::by_value_type(uint16_t value_type
   return data_type;
 }
 
+static bool has_user_type(const DataType::ConstPtr& data_type) {
+  if (!data_type) return false;
+  if (data_type->is_user_type()) return true;
+  if (data_type->is_collection() || data_type->is_tuple()) {
+    const DataType::Vec& types = static_cast<const CompositeType*>(data_type.get())->types();
+    for (DataType::Vec::const_iterator it = types.begin(), end = types.end(); it != end; ++it) {
+      if (has_user_type(*it)) return true;
+    }
+  }
+  return false;
+}
+
+const DataType::ConstPtr& SimpleDataTypeCache::by_cql_type(const String& type,
+                                                           bool is_frozen) const {
+  CqlTypeMap::const_iterator it = cql_types_.find(std::make_pair(type, is_frozen));
+  if (it == cql_types_.end()) {
+    return DataType::NIL;
+  }
+  return it->second;
+}
+
+void SimpleDataTypeCache::add_cql_type(const String& type, bool is_frozen,
+                                       const DataType::ConstPtr& data_type) {
+  if (!data_type || has_user_type(data_type)) return;
+  cql_types_[std::make_pair(type, is_frozen)] = data_type;
+}
+
 bool IsValidDataType<const Collection*>::operator()(const Collection* value,
                                                     const DataType::ConstPtr& data_type) const {
   return value->data_type()->equals(data_type);
@@ -28,6 +28,8 @@
 #include "types.hpp"
 #include "vector.hpp"
 
+#include <utility>
+
 namespace datastax { namespace internal { namespace core {
 
 class Collection;
@@ -426,8 +428,25 @@ public:
 
   const DataType::ConstPtr& by_value_type(uint16_t value_type);
 
+  /**
+   * Get a data type that was previously parsed from a CQL type string. This
+   * allows the same instance to be shared by all columns and keyspaces that
+   * use the type.
+   */
+  const DataType::ConstPtr& by_cql_type(const String& type, bool is_frozen) const;
+
+  /**
+   * Add a data type parsed from a CQL type string. Types that contain user
+   * types aren't added because user types belong to a keyspace and can
+   * change.
+   */
+  void add_cql_type(const String& type, bool is_frozen, const DataType::ConstPtr& data_type);
+
 private:
+  typedef Map<std::pair<String, bool>, DataType::ConstPtr> CqlTypeMap;
+
   DataType::ConstPtr cache_[CASS_VALUE_TYPE_LAST_ENTRY];
+  CqlTypeMap cql_types_;
 };
 
 template <class T>
@@ -66,6 +66,17 @@ bool from_hex(const String& hex, String* result) {
 
 DataType::ConstPtr DataTypeCqlNameParser::parse(const String& type, SimpleDataTypeCache& cache,
                                                 KeyspaceMetadata* keyspace, bool is_frozen) {
+  DataType::ConstPtr data_type(cache.by_cql_type(type, is_frozen));
+  if (!data_type) {
+    data_type = parse_type(type, cache, keyspace, is_frozen);
+    cache.add_cql_type(type, is_frozen, data_type);
+  }
+  return data_type;
+}
+
+DataType::ConstPtr DataTypeCqlNameParser::parse_type(const String& type,
+                                                     SimpleDataTypeCache& cache,
+                                                     KeyspaceMetadata* keyspace, bool is_frozen) {
   Parser parser(type, 0);
   String type_name;
   Parser::TypeParamsVec params;
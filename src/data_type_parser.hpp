@@ -82,6 +82,9 @@ public:
                                   KeyspaceMetadata* keyspace, bool is_frozen = false);
 
 private:
+  static DataType::ConstPtr parse_type(const String& type, SimpleDataTypeCache& cache,
+                                       KeyspaceMetadata* keyspace, bool is_frozen);
+
   class Parser : public ParserBase {
   public:
     typedef Vector<String> TypeParamsVec;
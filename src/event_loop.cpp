@@ -49,7 +49,9 @@ EventLoop::EventLoop()
     , is_joinable_(false)
     , is_closing_(false)
     , io_time_start_(0)
-    , io_time_elapsed_(0) {
+    , io_time_elapsed_(0)
+    , poll_start_(0)
+    , idle_time_(0) {
   // Set user data for PooledConnection to start the I/O elapsed time.
   loop_.data = this;
 }
@@ -76,6 +78,7 @@ int EventLoop::init(const String& thread_name /*= ""*/) {
   rc = async_.start(loop(), bind_callback(&EventLoop::on_task, this));
   if (rc != 0) return rc;
   rc = check_.start(loop(), bind_callback(&EventLoop::on_check, this));
+  if (rc == 0) rc = poll_prepare_.start(loop(), bind_callback(&EventLoop::on_poll_prepare, this));
   is_loop_initialized_ = true;
 
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
@@ -172,6 +175,10 @@ void EventLoop::handle_run() {
 
 void EventLoop::on_check(Check* check) {
   uint64_t now = uv_hrtime();
+  if (poll_start_ > 0) {
+    idle_time_ += now - poll_start_;
+    poll_start_ = 0;
+  }
   if (io_time_start_ > 0) {
     io_time_elapsed_ = now - io_time_start_;
     io_time_start_ = 0;
@@ -180,6 +187,8 @@ void EventLoop::on_check(Check* check) {
   }
 }
 
+void EventLoop::on_poll_prepare(Prepare* prepare) { poll_start_ = uv_hrtime(); }
+
 void EventLoop::on_task(Async* async) {
   Task* task = NULL;
   while (tasks_.dequeue(task)) {
@@ -192,6 +201,7 @@ void EventLoop::on_task(Async* async) {
   if (is_closing_.load() && tasks_.is_empty()) {
     async_.close_handle();
     check_.close_handle();
+    poll_prepare_.close_handle();
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
     uv_prepare_stop(&prepare_);
     uv_close(reinterpret_cast<uv_handle_t*>(&prepare_), NULL);
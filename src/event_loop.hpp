@@ -101,6 +101,15 @@ public:
    */
   uint64_t io_time_elapsed() const { return io_time_elapsed_; }
 
+  /**
+   * Get the total time the event loop has spent waiting for I/O (polling).
+   * The difference between two reads over a wall clock interval gives the
+   * loop's utilization.
+   *
+   * @return Total idle time (in nanoseconds)
+   */
+  uint64_t idle_time() const { return idle_time_; }
+
   /**
    * Determines if we're running on this event loop.
    *
@@ -146,6 +155,7 @@ private:
   void handle_run();
 
   void on_check(Check* check);
+  void on_poll_prepare(Prepare* prepare);
   void on_task(Async* async);
 
   uv_loop_t loop_;
@@ -168,6 +178,10 @@ private:
   uint64_t io_time_start_;
   uint64_t io_time_elapsed_;
 
+  Prepare poll_prepare_;
+  uint64_t poll_start_;
+  uint64_t idle_time_;
+
   String name_;
 };
 
@@ -132,6 +132,26 @@ CassError cass_future_tracing_id(CassFuture* future, CassUuid* tracing_id) {
   return CASS_OK;
 }
 
+CassError cass_future_get_timings(CassFuture* future, CassRequestTimings* timings) {
+  if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
+    return CASS_ERROR_LIB_INVALID_FUTURE_TYPE;
+  }
+
+  RequestTimings internal_timings(static_cast<ResponseFuture*>(future->from())->timings());
+
+  timings->enqueued = internal_timings.enqueued_ns;
+  timings->dequeued = internal_timings.dequeued_ns;
+  timings->query_plan = internal_timings.query_plan_ns;
+  timings->written = internal_timings.written_ns;
+  timings->first_byte = internal_timings.first_byte_ns;
+  timings->decoded = internal_timings.decoded_ns;
+  timings->future_set = internal_timings.future_set_ns;
+  timings->callback_start = internal_timings.callback_start_ns;
+  timings->callback_end = internal_timings.callback_end_ns;
+
+  return CASS_OK;
+}
+
 size_t cass_future_custom_payload_item_count(CassFuture* future) {
   if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
     return 0;
@@ -173,9 +193,17 @@ bool Future::set_callback(Future::Callback callback, void* data) {
   callback_ = callback;
   data_ = data;
   if (is_set_) {
-    // Run the callback if the future is already set
+    // Run the callback if the future is already set. The callback is allowed
+    // to free the future so keep it alive until the callback is recorded.
+    inc_ref();
+    callback_start_ns_ = uv_hrtime();
     lock.unlock();
     callback(CassFuture::to(this), data);
+    lock.lock();
+    callback_end_ns_ = uv_hrtime();
+    on_callback_finished(callback_end_ns_ - callback_start_ns_, false);
+    lock.unlock();
+    dec_ref();
   }
   return true;
 }
@@ -185,9 +213,12 @@ void Future::internal_set(ScopedMutex& lock) {
   if (callback_) {
     Callback callback = callback_;
     void* data = data_;
+    callback_start_ns_ = uv_hrtime();
     lock.unlock();
     callback(CassFuture::to(this), data);
     lock.lock();
+    callback_end_ns_ = uv_hrtime();
+    on_callback_finished(callback_end_ns_ - callback_start_ns_, true);
   }
   // Broadcast after we've run the callback so that threads waiting
   // on this future see the side effects of the callback.
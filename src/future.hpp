@@ -53,7 +53,9 @@ public:
   Future(Type type)
       : is_set_(false)
       , type_(type)
-      , callback_(NULL) {
+      , callback_(NULL)
+      , callback_start_ns_(0)
+      , callback_end_ns_(0) {
     uv_mutex_init(&mutex_);
     uv_cond_init(&cond_);
   }
@@ -129,6 +131,24 @@ protected:
 
   uv_mutex_t mutex_;
 
+  // The times the callback was invoked and returned (only valid when the
+  // mutex is held).
+  uint64_t callback_start_ns() const { return callback_start_ns_; }
+  uint64_t callback_end_ns() const { return callback_end_ns_; }
+
+  // Only valid when the mutex is held
+  const Error* internal_error() const { return error_.get(); }
+
+  /**
+   * Called with the mutex held after the callback returns.
+   *
+   * @param elapsed_ns The time spent in the callback in nanoseconds.
+   * @param is_set_thread If true, the callback was run by the thread that set
+   * the future, otherwise it was run by the thread that set the callback on an
+   * already set future.
+   */
+  virtual void on_callback_finished(uint64_t elapsed_ns, bool is_set_thread) {}
+
 private:
   bool is_set_;
   uv_cond_t cond_;
@@ -136,6 +156,8 @@ private:
   ScopedPtr<Error> error_;
   Callback callback_;
   void* data_;
+  uint64_t callback_start_ns_;
+  uint64_t callback_end_ns_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Future);
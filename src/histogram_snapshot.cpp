@@ -0,0 +1,205 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "histogram_snapshot.hpp"
+
+#include "driver_config.hpp"
+#include "utils.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+// The "| 0x10" denotes zig-zag LEB128 encoded counts
+#define V2_ENCODING_COOKIE (0x1c849303 | 0x10)
+#define V2_COMPRESSION_COOKIE (0x1c849304 | 0x10)
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+void cass_histogram_snapshot_free(const CassHistogramSnapshot* snapshot) {
+  delete snapshot->from();
+}
+
+cass_int64_t cass_histogram_snapshot_total_count(const CassHistogramSnapshot* snapshot) {
+  return snapshot->total_count();
+}
+
+cass_int64_t cass_histogram_snapshot_min(const CassHistogramSnapshot* snapshot) {
+  return snapshot->min();
+}
+
+cass_int64_t cass_histogram_snapshot_max(const CassHistogramSnapshot* snapshot) {
+  return snapshot->max();
+}
+
+cass_double_t cass_histogram_snapshot_mean(const CassHistogramSnapshot* snapshot) {
+  return snapshot->mean();
+}
+
+cass_int64_t cass_histogram_snapshot_value_at_percentile(const CassHistogramSnapshot* snapshot,
+                                                         cass_double_t percentile) {
+  return snapshot->value_at_percentile(percentile);
+}
+
+CassError cass_histogram_snapshot_encode(const CassHistogramSnapshot* snapshot,
+                                         const char** output, size_t* output_length) {
+  const String& encoded = snapshot->encoded();
+  if (encoded.empty()) {
+    return CASS_ERROR_LIB_NOT_IMPLEMENTED;
+  }
+  *output = encoded.data();
+  *output_length = encoded.size();
+  return CASS_OK;
+}
+
+} // extern "C"
+
+#ifdef HAVE_ZLIB
+namespace {
+
+void encode_int32(int32_t value, String* output) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    output->push_back(static_cast<char>((value >> shift) & 0xFF));
+  }
+}
+
+void encode_int64(int64_t value, String* output) {
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    output->push_back(static_cast<char>((value >> shift) & 0xFF));
+  }
+}
+
+// A zig-zag encoded LEB128 value using at most 9 bytes (the last byte uses all
+// 8 bits).
+void encode_zig_zag(int64_t value, String* output) {
+  uint64_t n = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  for (int i = 0; i < 8 && n >= 0x80; ++i) {
+    output->push_back(static_cast<char>((n & 0x7F) | 0x80));
+    n >>= 7;
+  }
+  output->push_back(static_cast<char>(n));
+}
+
+String encode_base64(const String& input) {
+  static const char alphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  String output;
+  output.reserve(((input.size() + 2) / 3) * 4);
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(input.data());
+  size_t i = 0;
+  for (; i + 2 < input.size(); i += 3) {
+    uint32_t triple = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+    output.push_back(alphabet[(triple >> 18) & 0x3F]);
+    output.push_back(alphabet[(triple >> 12) & 0x3F]);
+    output.push_back(alphabet[(triple >> 6) & 0x3F]);
+    output.push_back(alphabet[triple & 0x3F]);
+  }
+  if (i < input.size()) {
+    uint32_t triple = data[i] << 16;
+    if (i + 1 < input.size()) triple |= data[i + 1] << 8;
+    output.push_back(alphabet[(triple >> 18) & 0x3F]);
+    output.push_back(alphabet[(triple >> 12) & 0x3F]);
+    output.push_back(i + 1 < input.size() ? alphabet[(triple >> 6) & 0x3F] : '=');
+    output.push_back('=');
+  }
+  return output;
+}
+
+} // namespace
+#endif
+
+HistogramSnapshot::HistogramSnapshot(hdr_histogram* from) {
+  hdr_init(from->lowest_trackable_value, from->highest_trackable_value,
+           static_cast<int>(from->significant_figures), &histogram_);
+  hdr_add(histogram_, from);
+}
+
+HistogramSnapshot::~HistogramSnapshot() { free(histogram_); }
+
+int64_t HistogramSnapshot::min() const {
+  return histogram_->total_count > 0 ? hdr_min(histogram_) : 0;
+}
+
+int64_t HistogramSnapshot::max() const {
+  return histogram_->total_count > 0 ? hdr_max(histogram_) : 0;
+}
+
+double HistogramSnapshot::mean() const {
+  return histogram_->total_count > 0 ? hdr_mean(histogram_) : 0.0;
+}
+
+int64_t HistogramSnapshot::value_at_percentile(double percentile) const {
+  return histogram_->total_count > 0 ? hdr_value_at_percentile(histogram_, percentile) : 0;
+}
+
+const String& HistogramSnapshot::encoded() const {
+#ifdef HAVE_ZLIB
+  if (!encoded_.empty()) return encoded_;
+
+  // Only the counts up to the last non-zero count are encoded
+  int32_t counts_limit = histogram_->counts_len;
+  while (counts_limit > 0 && histogram_->counts[counts_limit - 1] == 0) {
+    --counts_limit;
+  }
+
+  // Runs of more than one zero count are encoded as a negative count
+  String payload;
+  for (int32_t i = 0; i < counts_limit;) {
+    int64_t count = histogram_->counts[i++];
+    if (count == 0) {
+      int64_t zeros = 1;
+      while (i < counts_limit && histogram_->counts[i] == 0) {
+        ++zeros;
+        ++i;
+      }
+      if (zeros > 1) count = -zeros;
+    }
+    encode_zig_zag(count, &payload);
+  }
+
+  String uncompressed;
+  encode_int32(V2_ENCODING_COOKIE, &uncompressed);
+  encode_int32(static_cast<int32_t>(payload.size()), &uncompressed);
+  encode_int32(histogram_->normalizing_index_offset, &uncompressed);
+  encode_int32(static_cast<int32_t>(histogram_->significant_figures), &uncompressed);
+  encode_int64(histogram_->lowest_trackable_value, &uncompressed);
+  encode_int64(histogram_->highest_trackable_value, &uncompressed);
+  encode_int64(copy_cast<double, int64_t>(histogram_->conversion_ratio), &uncompressed);
+  uncompressed.append(payload);
+
+  uLongf compressed_length = compressBound(uncompressed.size());
+  String compressed(compressed_length, '\0');
+  int rc = compress(reinterpret_cast<Bytef*>(&compressed[0]), &compressed_length,
+                    reinterpret_cast<const Bytef*>(uncompressed.data()), uncompressed.size());
+  if (rc != Z_OK) return encoded_;
+  compressed.resize(compressed_length);
+
+  String output;
+  encode_int32(V2_COMPRESSION_COOKIE, &output);
+  encode_int32(static_cast<int32_t>(compressed.size()), &output);
+  output.append(compressed);
+  encoded_ = encode_base64(output);
+#endif
+  return encoded_;
+}
@@ -0,0 +1,74 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_HISTOGRAM_SNAPSHOT_HPP
+#define DATASTAX_INTERNAL_HISTOGRAM_SNAPSHOT_HPP
+
+#include "allocated.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "macros.hpp"
+#include "string.hpp"
+
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A standalone copy of a metrics histogram. Unlike the stats snapshot it keeps
+ * the recorded values so that it can be encoded in the HdrHistogram V2 format
+ * and merged with histograms from other processes.
+ */
+class HistogramSnapshot : public Allocated {
+public:
+  /**
+   * Constructor. Copies the values of an existing histogram.
+   *
+   * @param from The histogram to copy.
+   */
+  explicit HistogramSnapshot(hdr_histogram* from);
+
+  ~HistogramSnapshot();
+
+  int64_t total_count() const { return histogram_->total_count; }
+  int64_t min() const;
+  int64_t max() const;
+  double mean() const;
+  int64_t value_at_percentile(double percentile) const;
+
+  /**
+   * Get the histogram in the compressed, base64 encoded HdrHistogram V2
+   * format used by HdrHistogram log files. The encoding is computed the first
+   * time it's requested.
+   *
+   * @return The encoded histogram or an empty string if the driver was built
+   * without zlib.
+   */
+  const String& encoded() const;
+
+private:
+  hdr_histogram* histogram_;
+  mutable String encoded_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(HistogramSnapshot);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::HistogramSnapshot, CassHistogramSnapshot)
+
+#endif
@@ -200,7 +200,7 @@ int HttpClient::on_body(http_parser* parser, const char* buf, size_t len) {
 }
 
 int HttpClient::handle_body(const char* buf, size_t len) {
-  response_body_.assign(buf, len);
+  response_body_.append(buf, len);
   return 0;
 }
 
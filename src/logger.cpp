@@ -16,13 +16,19 @@
 
 #include "logger.hpp"
 
+#include "allocated.hpp"
+#include "atomic.hpp"
+#include "hash.hpp"
+#include "mpmc_queue.hpp"
+#include "utils.hpp"
+
+#include <uv.h>
+
 using namespace datastax::internal;
 
 extern "C" {
 
-void cass_log_cleanup() {
-  // Deprecated
-}
+void cass_log_cleanup() { Logger::cleanup(); }
 
 void cass_log_set_level(CassLogLevel log_level) { Logger::set_log_level(log_level); }
 
@@ -30,10 +36,14 @@ void cass_log_set_callback(CassLogCallback callback, void* data) {
   Logger::set_callback(callback, data);
 }
 
-void cass_log_set_queue_size(size_t queue_size) {
-  // Deprecated
+void cass_log_set_queue_size(size_t queue_size) { Logger::set_queue_size(queue_size); }
+
+void cass_log_set_rate_limit(unsigned max_messages_per_second) {
+  Logger::set_rate_limit(max_messages_per_second);
 }
 
+void cass_log_set_trace_sample_rate(unsigned one_in_n) { Logger::set_trace_sample_rate(one_in_n); }
+
 } // extern "C"
 
 namespace datastax { namespace internal { namespace core {
@@ -49,20 +59,204 @@ void stderr_log_callback(const CassLogMessage* message, void* data) {
 
 void noop_log_callback(const CassLogMessage* message, void* data) {}
 
+/**
+ * A bounded, lock-free queue of formatted messages that's drained by a
+ * background thread. Logging threads never block on the callback; when the
+ * queue is full the message is dropped and counted.
+ */
+class Logger::Queue : public Allocated {
+public:
+  Queue(size_t queue_size)
+      : queue_(queue_size)
+      , is_closing_(false)
+      , dropped_count_(0)
+      , reported_dropped_count_(0) {
+    uv_sem_init(&sem_, 0);
+    uv_thread_create(&thread_, on_run, this);
+  }
+
+  ~Queue() {
+    is_closing_.store(true);
+    uv_sem_post(&sem_);
+    uv_thread_join(&thread_);
+    uv_sem_destroy(&sem_);
+  }
+
+  void enqueue(const CassLogMessage& message) {
+    if (queue_.enqueue(message)) {
+      uv_sem_post(&sem_);
+    } else {
+      dropped_count_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    }
+  }
+
+  uint64_t dropped_count() const { return dropped_count_.load(MEMORY_ORDER_RELAXED); }
+
+private:
+  static void on_run(void* data) {
+    Queue* queue = static_cast<Queue*>(data);
+    bool is_closing = false;
+    while (!is_closing) {
+      uv_sem_wait(&queue->sem_);
+      is_closing = queue->is_closing_.load();
+      queue->drain();
+    }
+  }
+
+  void drain() {
+    CassLogMessage message;
+    while (queue_.dequeue(message)) {
+      Logger::callback(&message);
+    }
+
+    uint64_t dropped_count = dropped_count_.load(MEMORY_ORDER_RELAXED);
+    if (dropped_count != reported_dropped_count_) {
+      CassLogMessage message = { get_time_since_epoch_ms(), CASS_LOG_WARN, LOG_FILE_, __LINE__,
+                                 LOG_FUNCTION_, "" };
+      snprintf(message.message, sizeof(message.message),
+               "Dropped %llu log message(s) because the log queue is full",
+               static_cast<unsigned long long>(dropped_count - reported_dropped_count_));
+      Logger::callback(&message);
+      reported_dropped_count_ = dropped_count;
+    }
+  }
+
+private:
+  core::MPMCQueue<CassLogMessage> queue_;
+  uv_sem_t sem_;
+  uv_thread_t thread_;
+  Atomic<bool> is_closing_;
+  Atomic<uint64_t> dropped_count_;
+  uint64_t reported_dropped_count_;
+};
+
 CassLogLevel Logger::log_level_ = CASS_LOG_WARN;
 CassLogCallback Logger::cb_ = core::stderr_log_callback;
 void* Logger::data_ = NULL;
+Logger::Queue* Logger::queue_ = NULL;
+unsigned Logger::rate_limit_ = 0;
+Atomic<unsigned> Logger::trace_sample_rate_(0);
+Atomic<uint64_t> Logger::next_trace_id_(1);
+
+namespace {
+
+// The maximum number of log statements that can be rate limited. This is
+// several times the number of log statements in the driver so the table stays
+// sparse. Statements that don't fit aren't rate limited.
+#define CALL_SITE_RATE_LIMITER_COUNT 1024
+
+struct CallSiteRateLimiter {
+  CallSiteRateLimiter()
+      : key(0) {}
+
+  Atomic<uint64_t> key; // 0 if the slot is unused
+  Logger::RateLimiter rate_limiter;
+};
+
+// The rate limiters are kept in a table at namespace scope, not in a static in
+// each log statement, so they're initialized once at startup. Otherwise every
+// log statement would need a guarded (and on older compilers, unsafe) static
+// initialization.
+CallSiteRateLimiter call_site_rate_limiters__[CALL_SITE_RATE_LIMITER_COUNT];
+
+} // namespace
 
 void Logger::internal_log(CassLogLevel severity, const char* file, int line, const char* function,
                           const char* format, va_list args) {
   CassLogMessage message = { get_time_since_epoch_ms(), severity, file, line, function, "" };
   vsnprintf(message.message, sizeof(message.message), format, args);
-  Logger::cb_(&message, Logger::data_);
+  if (queue_ != NULL) {
+    queue_->enqueue(message);
+  } else {
+    Logger::cb_(&message, Logger::data_);
+  }
 }
 
+// The queue isn't reference counted, so the queue size can't be changed while
+// other threads might be logging. This is documented in cass_log_cleanup() and
+// cass_log_set_queue_size().
+void Logger::set_queue_size(size_t queue_size) {
+  cleanup();
+  if (queue_size > 0) {
+    queue_ = new Queue(queue_size);
+  }
+}
+
+void Logger::cleanup() {
+  Queue* queue = queue_;
+  queue_ = NULL;
+  delete queue; // Flushes the remaining messages
+}
+
+uint64_t Logger::dropped_count() { return queue_ != NULL ? queue_->dropped_count() : 0; }
+
 void Logger::set_log_level(CassLogLevel log_level) { log_level_ = log_level; }
 
 void Logger::set_callback(CassLogCallback cb, void* data) {
   cb_ = cb == NULL ? noop_log_callback : cb;
   data_ = data;
 }
+
+void Logger::set_rate_limit(unsigned max_messages_per_second) {
+  rate_limit_ = max_messages_per_second;
+}
+
+void Logger::set_trace_sample_rate(unsigned one_in_n) {
+  trace_sample_rate_.store(one_in_n, MEMORY_ORDER_RELAXED);
+}
+
+uint64_t Logger::internal_sample_trace_id(unsigned trace_sample_rate) {
+  if (log_level_ < CASS_LOG_TRACE) {
+    if (trace_sample_rate == 0) {
+      return 0; // The log level changed after it was checked
+    }
+    if (!sample_one_in_n(trace_sample_rate)) {
+      return 0;
+    }
+  }
+  return next_trace_id_.fetch_add(1, MEMORY_ORDER_RELAXED);
+}
+
+bool Logger::internal_allow(CassLogLevel severity, const char* file, int line,
+                            const char* function) {
+  // A call site is identified by the address of its file name and its line.
+  // Addresses use less than 48 bits, so the key is unique and never 0.
+  uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(file)) ^
+                 (static_cast<uint64_t>(line) << 48);
+  size_t index = static_cast<size_t>(hash::fnv1a(reinterpret_cast<const char*>(&key), sizeof(key)));
+  for (size_t i = 0; i < CALL_SITE_RATE_LIMITER_COUNT; ++i) {
+    CallSiteRateLimiter& slot =
+        call_site_rate_limiters__[(index + i) % CALL_SITE_RATE_LIMITER_COUNT];
+    uint64_t slot_key = slot.key.load(MEMORY_ORDER_ACQUIRE);
+    if (slot_key == 0) {
+      if (slot.key.compare_exchange_strong(slot_key, key, MEMORY_ORDER_ACQ_REL)) {
+        slot_key = key;
+      }
+    }
+    if (slot_key == key) {
+      return slot.rate_limiter.allow_at(get_time_monotonic_ns(), severity, file, line, function);
+    }
+  }
+  return true; // The table is full
+}
+
+bool Logger::RateLimiter::internal_allow(unsigned limit, uint64_t now, CassLogLevel severity,
+                                         const char* file, int line, const char* function) {
+  uint64_t window_start_ns = window_start_ns_.load(MEMORY_ORDER_RELAXED);
+  if (now - window_start_ns >= 1000000000ULL &&
+      window_start_ns_.compare_exchange_strong(window_start_ns, now, MEMORY_ORDER_RELAXED)) {
+    count_.store(0, MEMORY_ORDER_RELAXED);
+    unsigned suppressed_count = suppressed_count_.exchange(0, MEMORY_ORDER_RELAXED);
+    if (suppressed_count > 0) {
+      Logger::log(severity, file, line, function,
+                  "Suppressed %u message(s) from this log statement in the last %llu ms",
+                  suppressed_count,
+                  static_cast<unsigned long long>((now - window_start_ns) / 1000000));
+    }
+  }
+  if (count_.fetch_add(1, MEMORY_ORDER_RELAXED) < limit) {
+    return true;
+  }
+  suppressed_count_.fetch_add(1, MEMORY_ORDER_RELAXED);
+  return false;
+}
@@ -17,6 +17,7 @@
 #ifndef DATASTAX_INTERNAL_LOGGER_HPP
 #define DATASTAX_INTERNAL_LOGGER_HPP
 
+#include "atomic.hpp"
 #include "cassandra.h"
 #include "get_time.hpp"
 #include "string.hpp"
@@ -32,6 +33,96 @@ public:
   static void set_log_level(CassLogLevel level);
   static void set_callback(CassLogCallback cb, void* data);
 
+  /**
+   * Enables asynchronous logging. Messages are formatted by the logging thread
+   * and queued in a lock-free queue, and the callback is called by a
+   * background thread. Messages are dropped when the queue is full.
+   *
+   * @param queue_size The maximum number of queued messages. A value of 0
+   * disables asynchronous logging.
+   */
+  static void set_queue_size(size_t queue_size);
+
+  /**
+   * Flushes queued messages and stops the background logging thread.
+   */
+  static void cleanup();
+
+  /**
+   * The number of messages dropped because the queue was full.
+   */
+  static uint64_t dropped_count();
+
+  /**
+   * Limits the number of messages logged per second by each log statement.
+   * The number of suppressed messages is logged with the statement's next
+   * message after the limit resets.
+   *
+   * @param max_messages_per_second The limit. A value of 0 disables it.
+   */
+  static void set_rate_limit(unsigned max_messages_per_second);
+  static unsigned rate_limit() { return rate_limit_; }
+
+  /**
+   * Sets the rate at which requests are sampled for tracing. The trace
+   * messages of sampled requests are logged regardless of the log level.
+   *
+   * @param one_in_n On average one in this many requests are sampled. A value
+   * of 0 disables sampling.
+   */
+  static void set_trace_sample_rate(unsigned one_in_n);
+
+  /**
+   * Returns a trace ID for a new request if it's sampled or if the log level is
+   * CASS_LOG_TRACE, otherwise 0. The ID prefixes the request's trace messages.
+   */
+  static uint64_t sample_trace_id() {
+    unsigned trace_sample_rate = trace_sample_rate_.load(MEMORY_ORDER_RELAXED);
+    if (log_level_ < CASS_LOG_TRACE && trace_sample_rate == 0) {
+      return 0;
+    }
+    return internal_sample_trace_id(trace_sample_rate);
+  }
+
+  /**
+   * Returns true if the log statement at the given call site hasn't reached the
+   * rate limit. The call site's rate limiter is only looked up when a rate
+   * limit is set.
+   */
+  static bool allow(CassLogLevel severity, const char* file, int line, const char* function) {
+    return rate_limit_ == 0 || internal_allow(severity, file, line, function);
+  }
+
+  /**
+   * A per log statement limit on the number of messages logged per second.
+   */
+  class RateLimiter {
+  public:
+    RateLimiter()
+        : window_start_ns_(0)
+        , count_(0)
+        , suppressed_count_(0) {}
+
+    /**
+     * Returns true if the limit hasn't been reached at the given monotonic
+     * time.
+     */
+    bool allow_at(uint64_t now_ns, CassLogLevel severity, const char* file, int line,
+                  const char* function) {
+      unsigned limit = Logger::rate_limit();
+      return limit == 0 || internal_allow(limit, now_ns, severity, file, line, function);
+    }
+
+  private:
+    bool internal_allow(unsigned limit, uint64_t now_ns, CassLogLevel severity, const char* file,
+                        int line, const char* function);
+
+  private:
+    Atomic<uint64_t> window_start_ns_;
+    Atomic<unsigned> count_;
+    Atomic<unsigned> suppressed_count_;
+  };
+
 #if defined(__GNUC__) || defined(__clang__)
 #define ATTR_FORMAT(string, first) __attribute__((__format__(__printf__, string, first)))
 #else
@@ -54,10 +145,23 @@ private:
   static void internal_log(CassLogLevel severity, const char* file, int line, const char* function,
                            const char* format, va_list args);
 
+  static void callback(const CassLogMessage* message) { cb_(message, data_); }
+
+  static uint64_t internal_sample_trace_id(unsigned trace_sample_rate);
+
+  static bool internal_allow(CassLogLevel severity, const char* file, int line,
+                             const char* function);
+
 private:
+  class Queue;
+
   static CassLogLevel log_level_;
   static CassLogCallback cb_;
   static void* data_;
+  static Queue* queue_;
+  static unsigned rate_limit_;
+  static Atomic<unsigned> trace_sample_rate_;
+  static Atomic<uint64_t> next_trace_id_;
 
   Logger(); // Keep this object from being created
 };
@@ -107,12 +211,31 @@ private:
 #define LOG_FUNCTION_ ""
 #endif
 
-#define LOG_CHECK_LEVEL(severity, ...)                                                   \
-  do {                                                                                   \
-    if (severity <= ::datastax::internal::Logger::log_level()) {                         \
-      ::datastax::internal::Logger::log(severity, LOG_FILE_, __LINE__, LOG_FUNCTION_,    \
-                                        LOG_FIRST_(__VA_ARGS__) LOG_REST_(__VA_ARGS__)); \
-    }                                                                                    \
+// Each log statement is rate limited separately (see Logger::allow()).
+#define LOG_CHECK_LEVEL(severity, ...)                                                        \
+  do {                                                                                        \
+    if (severity <= ::datastax::internal::Logger::log_level() &&                              \
+        ::datastax::internal::Logger::allow(severity, LOG_FILE_, __LINE__, LOG_FUNCTION_)) {  \
+      ::datastax::internal::Logger::log(severity, LOG_FILE_, __LINE__, LOG_FUNCTION_,         \
+                                        LOG_FIRST_(__VA_ARGS__) LOG_REST_(__VA_ARGS__));      \
+    }                                                                                         \
+  } while (0)
+
+// Logs a trace message for a request. The message is logged if the request was
+// sampled (it has a non-zero trace ID) or if the log level is CASS_LOG_TRACE,
+// and is prefixed with the trace ID so that all of the messages for a request
+// can be correlated.
+#define LOG_TRACE_REQUEST(trace_id, ...)                                                      \
+  do {                                                                                        \
+    uint64_t log_trace_id_ = (trace_id);                                                      \
+    if ((log_trace_id_ != 0 || CASS_LOG_TRACE <= ::datastax::internal::Logger::log_level()) && \
+        ::datastax::internal::Logger::allow(CASS_LOG_TRACE, LOG_FILE_, __LINE__,              \
+                                            LOG_FUNCTION_)) {                                 \
+      ::datastax::internal::Logger::log(                                                      \
+          CASS_LOG_TRACE, LOG_FILE_, __LINE__, LOG_FUNCTION_,                                 \
+          "[Request %llu] " LOG_FIRST_(__VA_ARGS__),                                          \
+          static_cast<unsigned long long>(log_trace_id_) LOG_REST_(__VA_ARGS__));             \
+    }                                                                                         \
   } while (0)
 
 #define LOG_CRITICAL(...) LOG_CHECK_LEVEL(CASS_LOG_CRITICAL, __VA_ARGS__)
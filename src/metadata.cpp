@@ -37,6 +37,7 @@
 #include <cmath>
 #include <ctype.h>
 #include <iterator>
+#include <string.h>
 
 using namespace datastax;
 using namespace datastax::internal;
@@ -717,15 +718,15 @@ const T& as_const(const T& x) {
 }
 
 const KeyspaceMetadata* Metadata::SchemaSnapshot::get_keyspace(const String& name) const {
-  KeyspaceMetadata::Map::const_iterator i = keyspaces_->find(name);
-  if (i == keyspaces_->end()) return NULL;
+  KeyspaceMetadata::Map::const_iterator i = keyspaces_.find(name);
+  if (i == keyspaces_.end()) return NULL;
   return &i->second;
 }
 
 const UserType* Metadata::SchemaSnapshot::get_user_type(const String& keyspace_name,
                                                         const String& type_name) const {
-  KeyspaceMetadata::Map::const_iterator i = keyspaces_->find(keyspace_name);
-  if (i == keyspaces_->end()) {
+  KeyspaceMetadata::Map::const_iterator i = keyspaces_.find(keyspace_name);
+  if (i == keyspaces_.end()) {
     return NULL;
   }
   return i->second.get_user_type(type_name);
@@ -929,10 +930,44 @@ void Metadata::clear() {
   back_.clear();
 }
 
+namespace {
+
+// Orders fields the same way as a map of strings
+struct FieldNameLess {
+  bool operator()(const MetadataField& field, StringRef name) const {
+    return less(field.name(), name);
+  }
+
+  bool operator()(StringRef name, const MetadataField& field) const {
+    return less(name, field.name());
+  }
+
+  static bool less(StringRef a, StringRef b) {
+    int result = memcmp(a.data(), b.data(), std::min(a.size(), b.size()));
+    return result < 0 || (result == 0 && a.size() < b.size());
+  }
+};
+
+} // namespace
+
+MetadataField::MetadataField(StringRef name, const Value& value)
+    : name_(name) {
+  if (value.is_null()) {
+    value_ = value;
+    return;
+  }
+  StringRef bytes(value.decoder().as_string_ref());
+  buffer_.reset(RefBuffer::create(bytes.size()));
+  if (!bytes.empty()) memcpy(buffer_->data(), bytes.data(), bytes.size());
+  value_ = Value(value.data_type(), value.count(),
+                 Decoder(buffer_->data(), bytes.size(), value.protocol_version()));
+}
+
 const Value* MetadataBase::get_field(const String& name) const {
-  MetadataField::Map::const_iterator it = fields_.find(name);
-  if (it == fields_.end()) return NULL;
-  return it->second.value();
+  MetadataField::Vec::const_iterator it =
+      std::lower_bound(fields_.begin(), fields_.end(), StringRef(name), FieldNameLess());
+  if (it == fields_.end() || it->name() != name) return NULL;
+  return it->value();
 }
 
 String MetadataBase::get_string_field(const String& name) const {
@@ -941,28 +976,43 @@ String MetadataBase::get_string_field(const String& name) const {
   return value->to_string();
 }
 
-const Value* MetadataBase::add_field(const RefBuffer::Ptr& buffer, const Row* row,
-                                     const String& name) {
+void MetadataBase::reserve_fields(const Row* row) {
+  // Most of a row's columns become fields so this avoids the extra capacity
+  // from growing the fields one at a time.
+  if (fields_.capacity() < row->values.size()) {
+    fields_.reserve(row->values.size());
+  }
+}
+
+const Value* MetadataBase::set_field(const MetadataField& field) {
+  MetadataField::Vec::iterator it =
+      std::lower_bound(fields_.begin(), fields_.end(), field.name(), FieldNameLess());
+  if (it != fields_.end() && it->name() == field.name()) {
+    *it = field;
+  } else {
+    it = fields_.insert(it, field);
+  }
+  return it->value();
+}
+
+const Value* MetadataBase::add_field(const Row* row, const char* name) {
+  reserve_fields(row);
   const Value* value = row->get_by_name(name);
   if (value == NULL) return NULL;
   if (value->is_null()) {
-    fields_[name] = MetadataField(name);
+    set_field(MetadataField(name));
     return NULL; // Return NULL for "null" columns
   } else {
-    fields_[name] = MetadataField(name, *value, buffer);
-    return value;
+    return set_field(MetadataField(name, *value));
   }
 }
 
-void MetadataBase::add_field(const RefBuffer::Ptr& buffer, const Value& value, const String& name) {
-  fields_[name] = MetadataField(name, value, buffer);
-}
-
-void MetadataBase::add_json_list_field(const Row* row, const String& name) {
+void MetadataBase::add_json_list_field(const Row* row, const char* name) {
+  reserve_fields(row);
   const Value* value = row->get_by_name(name);
   if (value == NULL) return;
   if (value->is_null()) {
-    fields_[name] = MetadataField(name);
+    set_field(MetadataField(name));
     return;
   }
 
@@ -971,13 +1021,13 @@ void MetadataBase::add_json_list_field(const Row* row, const String& name) {
   d.ParseInsitu(&buf[0]);
 
   if (d.HasParseError()) {
-    LOG_ERROR("Unable to parse JSON (array) for column '%s'", name.c_str());
+    LOG_ERROR("Unable to parse JSON (array) for column '%s'", name);
     return;
   }
 
   if (!d.IsArray()) {
-    LOG_DEBUG("Expected JSON array for column '%s' (probably null or empty)", name.c_str());
-    fields_[name] = MetadataField(name);
+    LOG_DEBUG("Expected JSON array for column '%s' (probably null or empty)", name);
+    set_field(MetadataField(name));
     return;
   }
 
@@ -994,14 +1044,15 @@ void MetadataBase::add_json_list_field(const Row* row, const String& name) {
 
   Value list(collection.data_type(), d.Size(),
              Decoder(encoded->data(), encoded_size, value->protocol_version()));
-  fields_[name] = MetadataField(name, list, encoded);
+  set_field(MetadataField(name, list));
 }
 
-const Value* MetadataBase::add_json_map_field(const Row* row, const String& name) {
+const Value* MetadataBase::add_json_map_field(const Row* row, const char* name) {
+  reserve_fields(row);
   const Value* value = row->get_by_name(name);
   if (value == NULL) return NULL;
   if (value->is_null()) {
-    return (fields_[name] = MetadataField(name)).value();
+    return set_field(MetadataField(name));
   }
 
   Vector<char> buf = value->decoder().as_vector();
@@ -1009,14 +1060,13 @@ const Value* MetadataBase::add_json_map_field(const Row* row, const String& name
   d.ParseInsitu(&buf[0]);
 
   if (d.HasParseError()) {
-    LOG_ERROR("Unable to parse JSON (object) for column '%s'", name.c_str());
-    return (fields_[name] = MetadataField(name)).value();
+    LOG_ERROR("Unable to parse JSON (object) for column '%s'", name);
+    return set_field(MetadataField(name));
   }
 
   if (!d.IsObject()) {
-    LOG_DEBUG("Expected JSON object for column '%s' (probably null or empty)", name.c_str());
-    fields_[name] = MetadataField(name);
-    return (fields_[name] = MetadataField(name)).value();
+    LOG_DEBUG("Expected JSON object for column '%s' (probably null or empty)", name);
+    return set_field(MetadataField(name));
   }
 
   Collection collection(CollectionType::map(DataType::Ptr(new DataType(CASS_VALUE_TYPE_TEXT)),
@@ -1036,32 +1086,32 @@ const Value* MetadataBase::add_json_map_field(const Row* row, const String& name
   Value map(collection.data_type(), d.MemberCount(),
             Decoder(encoded->data(), encoded_size, value->protocol_version()));
 
-  return (fields_[name] = MetadataField(name, map, encoded)).value();
+  return set_field(MetadataField(name, map));
 }
 
 const TableMetadata* KeyspaceMetadata::get_table(const String& name) const {
-  TableMetadata::Map::const_iterator i = tables_->find(name);
-  if (i == tables_->end()) return NULL;
+  TableMetadata::Map::const_iterator i = tables_.find(name);
+  if (i == tables_.end()) return NULL;
   return i->second.get();
 }
 
 const TableMetadata::Ptr& KeyspaceMetadata::get_table(const String& name) {
-  TableMetadata::Map::iterator i = tables_->find(name);
-  if (i == tables_->end()) return TableMetadata::NIL;
-  return i->second;
+  TableMetadata::Ptr* table = tables_.find_mutable(name);
+  if (table == NULL) return TableMetadata::NIL;
+  return *table;
 }
 
 void KeyspaceMetadata::add_table(const TableMetadata::Ptr& table) {
-  TableMetadata::Map::iterator table_it = tables_->find(table->name());
+  TableMetadata::Map::const_iterator table_it = tables_.find(table->name());
 
   // If there's a previous version of this table then copy its views
   // to the new version of the table, and update the table back-refs
   // in the views.
-  if (table_it != tables_->end()) {
+  if (table_it != tables_.end()) {
     TableMetadata::Ptr old_table(table_it->second);
     internal_add_table(table, old_table->views());
   } else {
-    (*tables_)[table->name()] = table; // Add new table
+    tables_.set(table->name(), table); // Add new table
   }
 }
 
@@ -1073,7 +1123,7 @@ void KeyspaceMetadata::internal_add_table(const TableMetadata::Ptr& table,
     table->add_view(view);
     (*views_)[view->name()] = view;
   }
-  (*tables_)[table->name()] = table;
+  tables_.set(table->name(), table);
 }
 
 const ViewMetadata* KeyspaceMetadata::get_view(const String& name) const {
@@ -1091,8 +1141,8 @@ const ViewMetadata::Ptr& KeyspaceMetadata::get_view(const String& name) {
 void KeyspaceMetadata::add_view(const ViewMetadata::Ptr& view) { (*views_)[view->name()] = view; }
 
 void KeyspaceMetadata::drop_table_or_view(const String& table_or_view_name) {
-  TableMetadata::Map::iterator table_it = tables_->find(table_or_view_name);
-  if (table_it != tables_->end()) { // The name is for a table, remove the
+  TableMetadata::Map::const_iterator table_it = tables_.find(table_or_view_name);
+  if (table_it != tables_.end()) { // The name is for a table, remove the
     // table and views from keyspace
     TableMetadata::Ptr table(table_it->second);
     // Cassandra doesn't allow for tables to be dropped while it has active
@@ -1102,7 +1152,7 @@ void KeyspaceMetadata::drop_table_or_view(const String& table_or_view_name) {
          i != end; ++i) {
       views_->erase((*i)->name());
     }
-    tables_->erase(table_it);
+    tables_.erase(table_or_view_name);
   } else { // The name is for a view, remove the view from the table and keyspace
     ViewMetadata::Map::iterator view_it = views_->find(table_or_view_name);
     if (view_it != views_->end()) {
@@ -1143,12 +1193,11 @@ const UserType* KeyspaceMetadata::get_user_type(const String& name) const {
   return i->second.get();
 }
 
-void KeyspaceMetadata::update(const VersionNumber& server_version, const RefBuffer::Ptr& buffer,
-                              const Row* row) {
-  add_field(buffer, row, "keyspace_name");
-  add_field(buffer, row, "durable_writes");
+void KeyspaceMetadata::update(const VersionNumber& server_version, const Row* row) {
+  add_field(row, "keyspace_name");
+  add_field(row, "durable_writes");
   if (server_version >= VersionNumber(3, 0, 0)) {
-    const Value* map = add_field(buffer, row, "replication");
+    const Value* map = add_field(row, "replication");
     if (map != NULL && map->value_type() == CASS_VALUE_TYPE_MAP &&
         is_string_type(map->primary_value_type()) && is_string_type(map->secondary_value_type())) {
       MapIterator iterator(map);
@@ -1162,7 +1211,7 @@ void KeyspaceMetadata::update(const VersionNumber& server_version, const RefBuff
       strategy_options_ = *map;
     }
   } else {
-    const Value* value = add_field(buffer, row, "strategy_class");
+    const Value* value = add_field(row, "strategy_class");
     if (value != NULL && is_string_type(value->value_type())) {
       strategy_class_ = value->to_string_ref();
     }
@@ -1204,53 +1253,53 @@ void KeyspaceMetadata::drop_aggregate(const String& full_aggregate_name) {
 }
 
 TableMetadataBase::TableMetadataBase(const VersionNumber& server_version, const String& name,
-                                     const RefBuffer::Ptr& buffer, const Row* row, bool is_virtual)
+                                     const Row* row, bool is_virtual)
     : MetadataBase(name)
     , is_virtual_(is_virtual) {
-  add_field(buffer, row, "keyspace_name");
-  add_field(buffer, row, "bloom_filter_fp_chance");
-  add_field(buffer, row, "caching");
-  add_field(buffer, row, "comment");
-  add_field(buffer, row, "default_time_to_live");
-  add_field(buffer, row, "gc_grace_seconds");
-  add_field(buffer, row, "id");
-  add_field(buffer, row, "speculative_retry");
-  add_field(buffer, row, "max_index_interval");
-  add_field(buffer, row, "min_index_interval");
-  add_field(buffer, row, "memtable_flush_period_in_ms");
-  add_field(buffer, row, "read_repair_chance");
+  add_field(row, "keyspace_name");
+  add_field(row, "bloom_filter_fp_chance");
+  add_field(row, "caching");
+  add_field(row, "comment");
+  add_field(row, "default_time_to_live");
+  add_field(row, "gc_grace_seconds");
+  add_field(row, "id");
+  add_field(row, "speculative_retry");
+  add_field(row, "max_index_interval");
+  add_field(row, "min_index_interval");
+  add_field(row, "memtable_flush_period_in_ms");
+  add_field(row, "read_repair_chance");
 
   if (server_version >= VersionNumber(3, 0, 0)) {
-    add_field(buffer, row, "dclocal_read_repair_chance");
-    add_field(buffer, row, "crc_check_chance");
-    add_field(buffer, row, "compaction");
-    add_field(buffer, row, "compression");
-    add_field(buffer, row, "extensions");
+    add_field(row, "dclocal_read_repair_chance");
+    add_field(row, "crc_check_chance");
+    add_field(row, "compaction");
+    add_field(row, "compression");
+    add_field(row, "extensions");
   } else {
-    add_field(buffer, row, "cf_id");
-    add_field(buffer, row, "local_read_repair_chance");
+    add_field(row, "cf_id");
+    add_field(row, "local_read_repair_chance");
 
-    add_field(buffer, row, "compaction_strategy_class");
+    add_field(row, "compaction_strategy_class");
     add_json_map_field(row, "compaction_strategy_options");
     add_json_map_field(row, "compression_parameters");
 
     add_json_list_field(row, "column_aliases");
-    add_field(buffer, row, "comparator");
-    add_field(buffer, row, "subcomparator");
-    add_field(buffer, row, "default_validator");
-    add_field(buffer, row, "key_alias");
+    add_field(row, "comparator");
+    add_field(row, "subcomparator");
+    add_field(row, "default_validator");
+    add_field(row, "key_alias");
     add_json_list_field(row, "key_aliases");
-    add_field(buffer, row, "value_alias");
-    add_field(buffer, row, "key_validator");
-    add_field(buffer, row, "type");
+    add_field(row, "value_alias");
+    add_field(row, "key_validator");
+    add_field(row, "type");
 
-    add_field(buffer, row, "dropped_columns");
-    add_field(buffer, row, "index_interval");
-    add_field(buffer, row, "is_dense");
-    add_field(buffer, row, "max_compaction_threshold");
-    add_field(buffer, row, "min_compaction_threshold");
-    add_field(buffer, row, "populate_io_cache_on_flush");
-    add_field(buffer, row, "replicate_on_write");
+    add_field(row, "dropped_columns");
+    add_field(row, "index_interval");
+    add_field(row, "is_dense");
+    add_field(row, "max_compaction_threshold");
+    add_field(row, "min_compaction_threshold");
+    add_field(row, "populate_io_cache_on_flush");
+    add_field(row, "replicate_on_write");
   }
 }
 
@@ -1422,11 +1471,11 @@ void TableMetadataBase::build_keys_and_sort(const VersionNumber& server_version,
 const TableMetadata::Ptr TableMetadata::NIL;
 
 TableMetadata::TableMetadata(const VersionNumber& server_version, const String& name,
-                             const RefBuffer::Ptr& buffer, const Row* row, bool is_virtual)
-    : TableMetadataBase(server_version, name, buffer, row, is_virtual) {
-  add_field(buffer, row, table_column_name(server_version));
+                             const Row* row, bool is_virtual)
+    : TableMetadataBase(server_version, name, row, is_virtual) {
+  add_field(row, table_column_name(server_version));
   if (server_version >= VersionNumber(3, 0, 0)) {
-    add_field(buffer, row, "flags");
+    add_field(row, "flags");
   }
 }
 
@@ -1487,16 +1536,15 @@ void TableMetadata::key_aliases(SimpleDataTypeCache& cache, KeyAliases* output)
 const ViewMetadata::Ptr ViewMetadata::NIL;
 
 ViewMetadata::ViewMetadata(const VersionNumber& server_version, const TableMetadata* table,
-                           const String& name, const RefBuffer::Ptr& buffer, const Row* row,
-                           bool is_virtual)
-    : TableMetadataBase(server_version, name, buffer, row, is_virtual)
+                           const String& name, const Row* row, bool is_virtual)
+    : TableMetadataBase(server_version, name, row, is_virtual)
     , base_table_(table) {
-  add_field(buffer, row, "keyspace_name");
-  add_field(buffer, row, "view_name");
-  add_field(buffer, row, "base_table_name");
-  add_field(buffer, row, "base_table_id");
-  add_field(buffer, row, "include_all_columns");
-  add_field(buffer, row, "where_clause");
+  add_field(row, "keyspace_name");
+  add_field(row, "view_name");
+  add_field(row, "base_table_name");
+  add_field(row, "base_table_id");
+  add_field(row, "include_all_columns");
+  add_field(row, "where_clause");
 }
 
 const IndexMetadata* TableMetadata::get_index(const String& name) const {
@@ -1518,18 +1566,19 @@ void TableMetadata::clear_indexes() {
 
 FunctionMetadata::FunctionMetadata(const VersionNumber& server_version, SimpleDataTypeCache& cache,
                                    const String& name, const Value* signature,
-                                   KeyspaceMetadata* keyspace, const RefBuffer::Ptr& buffer,
-                                   const Row* row)
+                                   KeyspaceMetadata* keyspace, const Row* row)
     : MetadataBase(Metadata::full_function_name(name, signature->as_stringlist()))
     , simple_name_(name) {
   const Value* value1;
   const Value* value2;
 
-  add_field(buffer, row, "keyspace_name");
-  add_field(buffer, row, "function_name");
+  add_field(row, "keyspace_name");
+  add_field(row, "function_name");
 
-  value1 = add_field(buffer, row, "argument_names");
-  value2 = add_field(buffer, row, "argument_types");
+  add_field(row, "argument_names");
+  add_field(row, "argument_types");
+  value1 = get_field("argument_names");
+  value2 = get_field("argument_types");
   if (value1 != NULL && value1->value_type() == CASS_VALUE_TYPE_LIST &&
       value1->primary_value_type() == CASS_VALUE_TYPE_VARCHAR && value2 != NULL &&
       value2->value_type() == CASS_VALUE_TYPE_LIST &&
@@ -1553,7 +1602,7 @@ FunctionMetadata::FunctionMetadata(const VersionNumber& server_version, SimpleDa
     }
   }
 
-  value1 = add_field(buffer, row, "return_type");
+  value1 = add_field(row, "return_type");
   if (value1 != NULL && value1->value_type() == CASS_VALUE_TYPE_VARCHAR) {
     if (server_version >= VersionNumber(3, 0, 0)) {
       return_type_ = DataTypeCqlNameParser::parse(value1->to_string(), cache, keyspace);
@@ -1562,17 +1611,17 @@ FunctionMetadata::FunctionMetadata(const VersionNumber& server_version, SimpleDa
     }
   }
 
-  value1 = add_field(buffer, row, "body");
+  value1 = add_field(row, "body");
   if (value1 != NULL && value1->value_type() == CASS_VALUE_TYPE_VARCHAR) {
     body_ = value1->to_string_ref();
   }
 
-  value1 = add_field(buffer, row, "language");
+  value1 = add_field(row, "language");
   if (value1 != NULL && value1->value_type() == CASS_VALUE_TYPE_VARCHAR) {
     language_ = value1->to_string_ref();
   }
 
-  value1 = add_field(buffer, row, "called_on_null_input");
+  value1 = add_field(row, "called_on_null_input");
   if (value1 != NULL && value1->value_type() == CASS_VALUE_TYPE_BOOLEAN) {
     called_on_null_input_ = value1->as_bool();
   }
@@ -1587,16 +1636,16 @@ const DataType* FunctionMetadata::get_arg_type(StringRef name) const {
 AggregateMetadata::AggregateMetadata(const VersionNumber& server_version,
                                      SimpleDataTypeCache& cache, const String& name,
                                      const Value* signature, KeyspaceMetadata* keyspace,
-                                     const RefBuffer::Ptr& buffer, const Row* row)
+                                     const Row* row)
     : MetadataBase(Metadata::full_function_name(name, signature->as_stringlist()))
     , simple_name_(name) {
   const Value* value;
   const FunctionMetadata::Map& functions = keyspace->functions();
 
-  add_field(buffer, row, "keyspace_name");
-  add_field(buffer, row, "aggregate_name");
+  add_field(row, "keyspace_name");
+  add_field(row, "aggregate_name");
 
-  value = add_field(buffer, row, "argument_types");
+  value = add_field(row, "argument_types");
   if (value != NULL && value->value_type() == CASS_VALUE_TYPE_LIST &&
       value->primary_value_type() == CASS_VALUE_TYPE_VARCHAR) {
     CollectionIterator iterator(value);
@@ -1613,7 +1662,7 @@ AggregateMetadata::AggregateMetadata(const VersionNumber& server_version,
     }
   }
 
-  value = add_field(buffer, row, "return_type");
+  value = add_field(row, "return_type");
   if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR) {
     if (server_version >= VersionNumber(3, 0, 0)) {
       return_type_ = DataTypeCqlNameParser::parse(value->to_string(), cache, keyspace);
@@ -1622,7 +1671,7 @@ AggregateMetadata::AggregateMetadata(const VersionNumber& server_version,
     }
   }
 
-  value = add_field(buffer, row, "state_type");
+  value = add_field(row, "state_type");
   if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR) {
     if (server_version >= VersionNumber(3, 0, 0)) {
       state_type_ = DataTypeCqlNameParser::parse(value->to_string(), cache, keyspace);
@@ -1631,7 +1680,7 @@ AggregateMetadata::AggregateMetadata(const VersionNumber& server_version,
     }
   }
 
-  value = add_field(buffer, row, "final_func");
+  value = add_field(row, "final_func");
   if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR) {
     StringVec final_func_signature;
     final_func_signature.push_back(state_type_->to_string());
@@ -1641,7 +1690,7 @@ AggregateMetadata::AggregateMetadata(const VersionNumber& server_version,
     if (i != functions.end()) final_func_ = i->second;
   }
 
-  value = add_field(buffer, row, "state_func");
+  value = add_field(row, "state_func");
   if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR) {
     StringVec state_func_signature;
     state_func_signature.push_back(state_type_->to_string());
@@ -1655,7 +1704,7 @@ AggregateMetadata::AggregateMetadata(const VersionNumber& server_version,
     if (i != functions.end()) state_func_ = i->second;
   }
 
-  value = add_field(buffer, row, "initcond");
+  value = add_field(row, "initcond");
   if (value != NULL) {
     if (value->value_type() == CASS_VALUE_TYPE_BLOB) {
       init_cond_ = Value(state_type_, value->decoder());
@@ -1666,17 +1715,16 @@ AggregateMetadata::AggregateMetadata(const VersionNumber& server_version,
   }
 }
 
-IndexMetadata::Ptr IndexMetadata::from_row(const String& index_name, const RefBuffer::Ptr& buffer,
-                                           const Row* row) {
+IndexMetadata::Ptr IndexMetadata::from_row(const String& index_name, const Row* row) {
   IndexMetadata::Ptr index(new IndexMetadata(index_name));
 
   StringRef kind;
-  const Value* value = index->add_field(buffer, row, "kind");
+  const Value* value = index->add_field(row, "kind");
   if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR) {
     kind = value->to_string_ref();
   }
 
-  const Value* options = index->add_field(buffer, row, "options");
+  const Value* options = index->add_field(row, "options");
   index->update(kind, options);
 
   return index;
@@ -1698,14 +1746,13 @@ void IndexMetadata::update(StringRef kind, const Value* options) {
 }
 
 IndexMetadata::Ptr IndexMetadata::from_legacy(const String& index_name,
-                                              const ColumnMetadata* column,
-                                              const RefBuffer::Ptr& buffer, const Row* row) {
+                                              const ColumnMetadata* column, const Row* row) {
   IndexMetadata::Ptr index(new IndexMetadata(index_name));
 
-  index->add_field(buffer, row, "index_name");
+  index->add_field(row, "index_name");
 
   StringRef index_type;
-  const Value* value = index->add_field(buffer, row, "index_type");
+  const Value* value = index->add_field(row, "index_type");
   if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR) {
     index_type = value->to_string_ref();
   }
@@ -1758,28 +1805,27 @@ CassIndexType IndexMetadata::index_type_from_string(StringRef index_type) {
 }
 
 ColumnMetadata::ColumnMetadata(const VersionNumber& server_version, SimpleDataTypeCache& cache,
-                               const String& name, KeyspaceMetadata* keyspace,
-                               const RefBuffer::Ptr& buffer, const Row* row)
+                               const String& name, KeyspaceMetadata* keyspace, const Row* row)
     : MetadataBase(name)
     , type_(CASS_COLUMN_TYPE_REGULAR)
     , position_(0)
     , is_reversed_(false) {
   const Value* value;
 
-  add_field(buffer, row, "keyspace_name");
-  add_field(buffer, row, table_column_name(server_version));
-  add_field(buffer, row, "column_name");
+  add_field(row, "keyspace_name");
+  add_field(row, table_column_name(server_version));
+  add_field(row, "column_name");
 
   if (server_version >= VersionNumber(3, 0, 0)) {
-    value = add_field(buffer, row, "clustering_order");
+    value = add_field(row, "clustering_order");
     if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR &&
         value->to_string_ref().iequals("desc")) {
       is_reversed_ = true;
     }
 
-    add_field(buffer, row, "column_name_bytes");
+    add_field(row, "column_name_bytes");
 
-    value = add_field(buffer, row, "kind");
+    value = add_field(row, "kind");
     if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR) {
       StringRef type = value->to_string_ref();
       if (type == "partition_key") {
@@ -1793,19 +1839,19 @@ ColumnMetadata::ColumnMetadata(const VersionNumber& server_version, SimpleDataTy
       }
     }
 
-    value = add_field(buffer, row, "position");
+    value = add_field(row, "position");
     if (value != NULL && value->value_type() == CASS_VALUE_TYPE_INT) {
       position_ = value->as_int32();
       if (position_ < 0) position_ = 0;
     }
 
-    value = add_field(buffer, row, "type");
+    value = add_field(row, "type");
     if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR) {
       String type(value->to_string());
       data_type_ = DataTypeCqlNameParser::parse(type, cache, keyspace);
     }
   } else {
-    value = add_field(buffer, row, "type");
+    value = add_field(row, "type");
     if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR) {
       StringRef type = value->to_string_ref();
       if (type == "partition_key") {
@@ -1821,29 +1867,28 @@ ColumnMetadata::ColumnMetadata(const VersionNumber& server_version, SimpleDataTy
       }
     }
 
-    value = add_field(buffer, row, "component_index");
+    value = add_field(row, "component_index");
     // For C* 2.0 to 2.2 this is "null" for single component partition keys
     // so the default position of 0 works. C* 1.2 and below don't use this.
     if (value != NULL && value->value_type() == CASS_VALUE_TYPE_INT) {
       position_ = value->as_int32();
     }
 
-    value = add_field(buffer, row, "validator");
+    value = add_field(row, "validator");
     if (value != NULL && value->value_type() == CASS_VALUE_TYPE_VARCHAR) {
       String validator(value->to_string());
       data_type_ = DataTypeClassNameParser::parse_one(validator, cache);
       is_reversed_ = DataTypeClassNameParser::is_reversed(validator);
     }
 
-    add_field(buffer, row, "index_type");
-    add_field(buffer, row, "index_name");
+    add_field(row, "index_type");
+    add_field(row, "index_name");
     add_json_map_field(row, "index_options");
   }
 }
 
 void Metadata::InternalData::update_keyspaces(const VersionNumber& server_version,
                                               const ResultResponse* result, bool is_virtual) {
-  RefBuffer::Ptr buffer = result->buffer();
   ResultIterator rows(result);
 
   while (rows.next()) {
@@ -1856,13 +1901,12 @@ void Metadata::InternalData::update_keyspaces(const VersionNumber& server_versio
     }
 
     KeyspaceMetadata* keyspace = get_or_create_keyspace(keyspace_name, is_virtual);
-    keyspace->update(server_version, buffer, row);
+    keyspace->update(server_version, row);
   }
 }
 
 void Metadata::InternalData::update_tables(const VersionNumber& server_version,
                                            const ResultResponse* result) {
-  RefBuffer::Ptr buffer = result->buffer();
 
   ResultIterator rows(result);
 
@@ -1887,13 +1931,12 @@ void Metadata::InternalData::update_tables(const VersionNumber& server_version,
     }
 
     keyspace->add_table(TableMetadata::Ptr(
-        new TableMetadata(server_version, table_name, buffer, row, keyspace->is_virtual())));
+        new TableMetadata(server_version, table_name, row, keyspace->is_virtual())));
   }
 }
 
 void Metadata::InternalData::update_views(const VersionNumber& server_version,
                                           const ResultResponse* result) {
-  RefBuffer::Ptr buffer = result->buffer();
 
   ResultIterator rows(result);
 
@@ -1935,7 +1978,7 @@ void Metadata::InternalData::update_views(const VersionNumber& server_version,
       continue;
     }
 
-    ViewMetadata::Ptr view(new ViewMetadata(server_version, table.get(), view_name, buffer, row,
+    ViewMetadata::Ptr view(new ViewMetadata(server_version, table.get(), view_name, row,
                                             keyspace->is_virtual()));
     keyspace->add_view(view);
     table->add_view(view);
@@ -2034,7 +2077,6 @@ void Metadata::InternalData::update_user_types(const VersionNumber& server_versi
 void Metadata::InternalData::update_functions(const VersionNumber& server_version,
                                               SimpleDataTypeCache& cache,
                                               const ResultResponse* result) {
-  RefBuffer::Ptr buffer = result->buffer();
 
   ResultIterator rows(result);
 
@@ -2059,14 +2101,13 @@ void Metadata::InternalData::update_functions(const VersionNumber& server_versio
     }
 
     keyspace->add_function(FunctionMetadata::Ptr(new FunctionMetadata(
-        server_version, cache, function_name, signature, keyspace, buffer, row)));
+        server_version, cache, function_name, signature, keyspace, row)));
   }
 }
 
 void Metadata::InternalData::update_aggregates(const VersionNumber& server_version,
                                                SimpleDataTypeCache& cache,
                                                const ResultResponse* result) {
-  RefBuffer::Ptr buffer = result->buffer();
 
   ResultIterator rows(result);
 
@@ -2091,45 +2132,44 @@ void Metadata::InternalData::update_aggregates(const VersionNumber& server_versi
     }
 
     keyspace->add_aggregate(AggregateMetadata::Ptr(new AggregateMetadata(
-        server_version, cache, aggregate_name, signature, keyspace, buffer, row)));
+        server_version, cache, aggregate_name, signature, keyspace, row)));
   }
 }
 
 void Metadata::InternalData::drop_keyspace(const String& keyspace_name) {
-  keyspaces_->erase(keyspace_name);
+  keyspaces_.erase(keyspace_name);
 }
 
 void Metadata::InternalData::drop_table_or_view(const String& keyspace_name,
                                                 const String& table_or_view_name) {
-  KeyspaceMetadata::Map::iterator i = keyspaces_->find(keyspace_name);
-  if (i == keyspaces_->end()) return;
-  i->second.drop_table_or_view(table_or_view_name);
+  KeyspaceMetadata* keyspace = keyspaces_.find_mutable(keyspace_name);
+  if (keyspace == NULL) return;
+  keyspace->drop_table_or_view(table_or_view_name);
 }
 
 void Metadata::InternalData::drop_user_type(const String& keyspace_name, const String& type_name) {
-  KeyspaceMetadata::Map::iterator i = keyspaces_->find(keyspace_name);
-  if (i == keyspaces_->end()) return;
-  i->second.drop_user_type(type_name);
+  KeyspaceMetadata* keyspace = keyspaces_.find_mutable(keyspace_name);
+  if (keyspace == NULL) return;
+  keyspace->drop_user_type(type_name);
 }
 
 void Metadata::InternalData::drop_function(const String& keyspace_name,
                                            const String& full_function_name) {
-  KeyspaceMetadata::Map::iterator i = keyspaces_->find(keyspace_name);
-  if (i == keyspaces_->end()) return;
-  i->second.drop_function(full_function_name);
+  KeyspaceMetadata* keyspace = keyspaces_.find_mutable(keyspace_name);
+  if (keyspace == NULL) return;
+  keyspace->drop_function(full_function_name);
 }
 
 void Metadata::InternalData::drop_aggregate(const String& keyspace_name,
                                             const String& full_aggregate_name) {
-  KeyspaceMetadata::Map::iterator i = keyspaces_->find(keyspace_name);
-  if (i == keyspaces_->end()) return;
-  i->second.drop_aggregate(full_aggregate_name);
+  KeyspaceMetadata* keyspace = keyspaces_.find_mutable(keyspace_name);
+  if (keyspace == NULL) return;
+  keyspace->drop_aggregate(full_aggregate_name);
 }
 
 void Metadata::InternalData::update_columns(const VersionNumber& server_version,
                                             SimpleDataTypeCache& cache,
                                             const ResultResponse* result) {
-  RefBuffer::Ptr buffer = result->buffer();
 
   ResultIterator rows(result);
 
@@ -2176,7 +2216,7 @@ void Metadata::InternalData::update_columns(const VersionNumber& server_version,
     if (table_or_view) {
       table_or_view->add_column(
           server_version, ColumnMetadata::Ptr(new ColumnMetadata(server_version, cache, column_name,
-                                                                 keyspace, buffer, row)));
+                                                                 keyspace, row)));
     }
   }
 
@@ -2188,7 +2228,6 @@ void Metadata::InternalData::update_columns(const VersionNumber& server_version,
 
 void Metadata::InternalData::update_legacy_indexes(const VersionNumber& server_version,
                                                    const ResultResponse* result) {
-  RefBuffer::Ptr buffer = result->buffer();
 
   ResultIterator rows(result);
 
@@ -2231,7 +2270,7 @@ void Metadata::InternalData::update_legacy_indexes(const VersionNumber& server_v
         const Value* index_type = column->get_field("index_type");
         if (index_type != NULL && index_type->value_type() == CASS_VALUE_TYPE_VARCHAR) {
           String index_name = column->get_string_field("index_name");
-          table->add_index(IndexMetadata::from_legacy(index_name, column, buffer, row));
+          table->add_index(IndexMetadata::from_legacy(index_name, column, row));
         }
       }
     }
@@ -2240,7 +2279,6 @@ void Metadata::InternalData::update_legacy_indexes(const VersionNumber& server_v
 
 void Metadata::InternalData::update_indexes(const VersionNumber& server_version,
                                             const ResultResponse* result) {
-  RefBuffer::Ptr buffer = result->buffer();
 
   ResultIterator rows(result);
 
@@ -2276,15 +2314,15 @@ void Metadata::InternalData::update_indexes(const VersionNumber& server_version,
       table->clear_indexes();
     }
 
-    table->add_index(IndexMetadata::from_row(index_name, buffer, row));
+    table->add_index(IndexMetadata::from_row(index_name, row));
   }
 }
 
 KeyspaceMetadata* Metadata::InternalData::get_or_create_keyspace(const String& name,
                                                                  bool is_virtual) {
-  KeyspaceMetadata::Map::iterator i = keyspaces_->find(name);
-  if (i == keyspaces_->end()) {
-    i = keyspaces_->insert(std::make_pair(name, KeyspaceMetadata(name, is_virtual))).first;
+  KeyspaceMetadata* keyspace = keyspaces_.find_mutable(name);
+  if (keyspace == NULL) {
+    keyspace = keyspaces_.set(name, KeyspaceMetadata(name, is_virtual));
   }
-  return &i->second;
+  return keyspace;
 }
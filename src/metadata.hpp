@@ -25,6 +25,7 @@
 #include "iterator.hpp"
 #include "macros.hpp"
 #include "map.hpp"
+#include "persistent_map.hpp"
 #include "ref_counted.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
@@ -42,11 +43,11 @@ class KeyspaceMetadata;
 class Row;
 class ResultResponse;
 
-template <class T>
+template <class T, class C = internal::Map<String, T> >
 class MapIteratorImpl {
 public:
   typedef T ItemType;
-  typedef internal::Map<String, T> Collection;
+  typedef C Collection;
 
   MapIteratorImpl(const Collection& map)
       : next_(map.begin())
@@ -94,43 +95,46 @@ private:
   typename Collection::const_iterator end_;
 };
 
+/**
+ * A schema metadata field. Field names refer to string literals so they're
+ * shared by every object that has the field, and the value is copied out of
+ * the system table result so the result's buffer isn't kept alive by the
+ * schema metadata.
+ */
 class MetadataField {
 public:
-  typedef internal::Map<String, MetadataField> Map;
+  typedef Vector<MetadataField> Vec;
 
   MetadataField() {}
 
-  MetadataField(const String& name)
+  MetadataField(StringRef name)
       : name_(name) {}
 
-  MetadataField(const String& name, const Value& value, const RefBuffer::Ptr& buffer)
-      : name_(name)
-      , value_(value)
-      , buffer_(buffer) {}
+  MetadataField(StringRef name, const Value& value);
 
-  const String& name() const { return name_; }
+  StringRef name() const { return name_; }
 
   const Value* value() const { return &value_; }
 
 private:
-  String name_;
+  StringRef name_;
   Value value_;
   RefBuffer::Ptr buffer_;
 };
 
 class MetadataFieldIterator : public Iterator {
 public:
-  typedef MapIteratorImpl<MetadataField>::Collection Map;
+  typedef VecIteratorImpl<MetadataField>::Collection Vec;
 
-  MetadataFieldIterator(const Map& map)
+  MetadataFieldIterator(const Vec& fields)
       : Iterator(CASS_ITERATOR_TYPE_META_FIELD)
-      , impl_(map) {}
+      , impl_(fields) {}
 
   virtual bool next() { return impl_.next(); }
   const MetadataField* field() const { return &impl_.item(); }
 
 private:
-  MapIteratorImpl<MetadataField> impl_;
+  VecIteratorImpl<MetadataField> impl_;
 };
 
 class MetadataBase {
@@ -147,12 +151,17 @@ public:
   void swap_fields(MetadataBase& meta) { fields_.swap(meta.fields_); }
 
 protected:
-  const Value* add_field(const RefBuffer::Ptr& buffer, const Row* row, const String& name);
-  void add_field(const RefBuffer::Ptr& buffer, const Value& value, const String& name);
-  void add_json_list_field(const Row* row, const String& name);
-  const Value* add_json_map_field(const Row* row, const String& name);
+  // Field names must be string literals. The returned value is only valid
+  // until another field is added.
+  const Value* add_field(const Row* row, const char* name);
+  void add_json_list_field(const Row* row, const char* name);
+  const Value* add_json_map_field(const Row* row, const char* name);
+
+  MetadataField::Vec fields_; // Sorted by name
 
-  MetadataField::Map fields_;
+private:
+  void reserve_fields(const Row* row);
+  const Value* set_field(const MetadataField& field);
 
 private:
   const String name_;
@@ -193,7 +202,7 @@ public:
 
   FunctionMetadata(const VersionNumber& server_version, SimpleDataTypeCache& cache,
                    const String& name, const Value* signature, KeyspaceMetadata* keyspace,
-                   const RefBuffer::Ptr& buffer, const Row* row);
+                   const Row* row);
 
   const String& simple_name() const { return simple_name_; }
   const Argument::Vec& args() const { return args_; }
@@ -225,7 +234,7 @@ public:
 
   AggregateMetadata(const VersionNumber& server_version, SimpleDataTypeCache& cache,
                     const String& name, const Value* signature, KeyspaceMetadata* keyspace,
-                    const RefBuffer::Ptr& buffer, const Row* row);
+                    const Row* row);
 
   const String& simple_name() const { return simple_name_; }
   const DataType::Vec arg_types() const { return arg_types_; }
@@ -261,12 +270,11 @@ public:
       : MetadataBase(index_name)
       , type_(CASS_INDEX_TYPE_UNKNOWN) {}
 
-  static IndexMetadata::Ptr from_row(const String& index_name, const RefBuffer::Ptr& buffer,
-                                     const Row* row);
+  static IndexMetadata::Ptr from_row(const String& index_name, const Row* row);
   void update(StringRef index_type, const Value* options);
 
   static IndexMetadata::Ptr from_legacy(const String& index_name, const ColumnMetadata* column,
-                                        const RefBuffer::Ptr& buffer, const Row* row);
+                                        const Row* row);
   void update_legacy(StringRef index_type, const ColumnMetadata* column, const Value* options);
 
 private:
@@ -305,8 +313,7 @@ public:
       , is_reversed_(false) {}
 
   ColumnMetadata(const VersionNumber& server_version, SimpleDataTypeCache& cache,
-                 const String& name, KeyspaceMetadata* keyspace, const RefBuffer::Ptr& buffer,
-                 const Row* row);
+                 const String& name, KeyspaceMetadata* keyspace, const Row* row);
 
   CassColumnType type() const { return type_; }
   int32_t position() const { return position_; }
@@ -340,8 +347,8 @@ public:
     const ColumnMetadata* column() const { return impl_.item().get(); }
   };
 
-  TableMetadataBase(const VersionNumber& server_version, const String& name,
-                    const RefBuffer::Ptr& buffer, const Row* row, bool is_virtual);
+  TableMetadataBase(const VersionNumber& server_version, const String& name, const Row* row,
+                    bool is_virtual);
 
   TableMetadataBase(const TableMetadataBase& other)
       : MetadataBase(other)
@@ -387,7 +394,7 @@ public:
   static const ViewMetadata::Ptr NIL;
 
   ViewMetadata(const VersionNumber& server_version, const TableMetadata* table, const String& name,
-               const RefBuffer::Ptr& buffer, const Row* row, bool is_virtual);
+               const Row* row, bool is_virtual);
 
   ViewMetadata(const ViewMetadata& other, const TableMetadata* table)
       : TableMetadataBase(other)
@@ -450,7 +457,7 @@ inline bool operator==(const ViewMetadata::Ptr& a, const ViewMetadata::Ptr& b) {
 class TableMetadata : public TableMetadataBase {
 public:
   typedef SharedRefPtr<TableMetadata> Ptr;
-  typedef internal::Map<String, Ptr> Map;
+  typedef PersistentMap<String, Ptr> Map;
   typedef Vector<Ptr> Vec;
   typedef Vector<String> KeyAliases;
 
@@ -464,8 +471,8 @@ public:
     const IndexMetadata* index() const { return impl_.item().get(); }
   };
 
-  TableMetadata(const VersionNumber& server_version, const String& name,
-                const RefBuffer::Ptr& buffer, const Row* row, bool is_virtual);
+  TableMetadata(const VersionNumber& server_version, const String& name, const Row* row,
+                bool is_virtual);
 
   TableMetadata(const TableMetadata& other)
       : TableMetadataBase(other)
@@ -496,14 +503,14 @@ private:
 
 class KeyspaceMetadata : public MetadataBase {
 public:
-  typedef internal::Map<String, KeyspaceMetadata> Map;
-  typedef CopyOnWritePtr<KeyspaceMetadata::Map> MapPtr;
+  typedef PersistentMap<String, KeyspaceMetadata> Map;
 
-  class TableIterator : public MetadataIteratorImpl<MapIteratorImpl<TableMetadata::Ptr> > {
+  class TableIterator
+      : public MetadataIteratorImpl<MapIteratorImpl<TableMetadata::Ptr, TableMetadata::Map> > {
   public:
     TableIterator(const TableIterator::Collection& collection)
-        : MetadataIteratorImpl<MapIteratorImpl<TableMetadata::Ptr> >(CASS_ITERATOR_TYPE_TABLE_META,
-                                                                     collection) {}
+        : MetadataIteratorImpl<MapIteratorImpl<TableMetadata::Ptr, TableMetadata::Map> >(
+              CASS_ITERATOR_TYPE_TABLE_META, collection) {}
     const TableMetadata* table() const { return static_cast<TableMetadata*>(impl_.item().get()); }
   };
 
@@ -534,20 +541,19 @@ public:
   KeyspaceMetadata(const String& name, bool is_virtual = false)
       : MetadataBase(name)
       , is_virtual_(is_virtual)
-      , tables_(new TableMetadata::Map())
       , views_(new ViewMetadata::Map())
       , user_types_(new UserType::Map())
       , functions_(new FunctionMetadata::Map())
       , aggregates_(new AggregateMetadata::Map()) {}
 
-  void update(const VersionNumber& server_version, const RefBuffer::Ptr& buffer, const Row* row);
+  void update(const VersionNumber& server_version, const Row* row);
 
   bool is_virtual() const { return is_virtual_; }
 
   const FunctionMetadata::Map& functions() const { return *functions_; }
   const UserType::Map& user_types() const { return *user_types_; }
 
-  Iterator* iterator_tables() const { return new TableIterator(*tables_); }
+  Iterator* iterator_tables() const { return new TableIterator(tables_); }
   const TableMetadata* get_table(const String& name) const;
   const TableMetadata::Ptr& get_table(const String& name);
   void add_table(const TableMetadata::Ptr& table);
@@ -585,7 +591,7 @@ private:
   StringRef strategy_class_;
   Value strategy_options_;
 
-  CopyOnWritePtr<TableMetadata::Map> tables_;
+  TableMetadata::Map tables_;
   CopyOnWritePtr<ViewMetadata::Map> views_;
   CopyOnWritePtr<UserType::Map> user_types_;
   CopyOnWritePtr<FunctionMetadata::Map> functions_;
@@ -594,18 +600,19 @@ private:
 
 class Metadata {
 public:
-  class KeyspaceIterator : public MetadataIteratorImpl<MapIteratorImpl<KeyspaceMetadata> > {
+  class KeyspaceIterator
+      : public MetadataIteratorImpl<MapIteratorImpl<KeyspaceMetadata, KeyspaceMetadata::Map> > {
   public:
     KeyspaceIterator(const KeyspaceIterator::Collection& collection)
-        : MetadataIteratorImpl<MapIteratorImpl<KeyspaceMetadata> >(CASS_ITERATOR_TYPE_KEYSPACE_META,
-                                                                   collection) {}
+        : MetadataIteratorImpl<MapIteratorImpl<KeyspaceMetadata, KeyspaceMetadata::Map> >(
+              CASS_ITERATOR_TYPE_KEYSPACE_META, collection) {}
     const KeyspaceMetadata* keyspace() const { return &impl_.item(); }
   };
 
   class SchemaSnapshot : public Allocated {
   public:
     SchemaSnapshot(uint32_t version, const VersionNumber& server_version,
-                   const KeyspaceMetadata::MapPtr& keyspaces)
+                   const KeyspaceMetadata::Map& keyspaces)
         : version_(version)
         , server_version_(server_version)
         , keyspaces_(keyspaces) {}
@@ -614,14 +621,14 @@ public:
     VersionNumber server_version() const { return server_version_; }
 
     const KeyspaceMetadata* get_keyspace(const String& name) const;
-    Iterator* iterator_keyspaces() const { return new KeyspaceIterator(*keyspaces_); }
+    Iterator* iterator_keyspaces() const { return new KeyspaceIterator(keyspaces_); }
 
     const UserType* get_user_type(const String& keyspace_name, const String& type_name) const;
 
   private:
     uint32_t version_;
     VersionNumber server_version_;
-    KeyspaceMetadata::MapPtr keyspaces_;
+    KeyspaceMetadata::Map keyspaces_;
   };
 
   static String full_function_name(const String& name, const StringVec& signature);
@@ -668,10 +675,9 @@ private:
 private:
   class InternalData {
   public:
-    InternalData()
-        : keyspaces_(new KeyspaceMetadata::Map()) {}
+    InternalData() {}
 
-    const KeyspaceMetadata::MapPtr& keyspaces() const { return keyspaces_; }
+    const KeyspaceMetadata::Map& keyspaces() const { return keyspaces_; }
 
     void update_keyspaces(const VersionNumber& server_version, const ResultResponse* result,
                           bool is_virtual);
@@ -694,10 +700,10 @@ private:
     void drop_function(const String& keyspace_name, const String& full_function_name);
     void drop_aggregate(const String& keyspace_name, const String& full_aggregate_name);
 
-    void clear() { keyspaces_->clear(); }
+    void clear() { keyspaces_.clear(); }
 
     void swap(InternalData& other) {
-      CopyOnWritePtr<KeyspaceMetadata::Map> temp = other.keyspaces_;
+      KeyspaceMetadata::Map temp = other.keyspaces_;
       other.keyspaces_ = keyspaces_;
       keyspaces_ = temp;
     }
@@ -706,7 +712,7 @@ private:
     KeyspaceMetadata* get_or_create_keyspace(const String& name, bool is_virtual = false);
 
   private:
-    CopyOnWritePtr<KeyspaceMetadata::Map> keyspaces_;
+    KeyspaceMetadata::Map keyspaces_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(InternalData);
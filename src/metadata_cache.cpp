@@ -0,0 +1,501 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "metadata_cache.hpp"
+
+#include "control_connection.hpp"
+#include "logger.hpp"
+#include "scoped_lock.hpp"
+#include "serialization.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+const size_t MAGIC_SIZE = sizeof(CASS_METADATA_CACHE_MAGIC) - 1;
+const size_t SECTION_ALIGNMENT = 8;
+
+/**
+ * The schema metadata results and their keys in the cache file.
+ */
+const struct {
+  const char* key;
+  ResultResponse::Ptr ControlConnectionSchema::*result;
+} schema_results[] = { { "keyspaces", &ControlConnectionSchema::keyspaces },
+                       { "tables", &ControlConnectionSchema::tables },
+                       { "views", &ControlConnectionSchema::views },
+                       { "columns", &ControlConnectionSchema::columns },
+                       { "indexes", &ControlConnectionSchema::indexes },
+                       { "user_types", &ControlConnectionSchema::user_types },
+                       { "functions", &ControlConnectionSchema::functions },
+                       { "aggregates", &ControlConnectionSchema::aggregates },
+                       { "virtual_keyspaces", &ControlConnectionSchema::virtual_keyspaces },
+                       { "virtual_tables", &ControlConnectionSchema::virtual_tables },
+                       { "virtual_columns", &ControlConnectionSchema::virtual_columns } };
+
+const size_t schema_results_count = sizeof(schema_results) / sizeof(schema_results[0]);
+
+class Writer {
+public:
+  Writer(String* output)
+      : output_(output) {}
+
+  void write_uint16(uint16_t value) {
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, value);
+    output_->append(buf, sizeof(buf));
+  }
+
+  void write_uint32(uint32_t value) {
+    char buf[sizeof(uint32_t)];
+    encode_uint32(buf, value);
+    output_->append(buf, sizeof(buf));
+  }
+
+  void write_version(const VersionNumber& version) {
+    write_uint32(version.major_version());
+    write_uint32(version.minor_version());
+    write_uint32(version.patch_version());
+  }
+
+  void write_string(const String& value) {
+    write_uint16(static_cast<uint16_t>(value.size()));
+    output_->append(value);
+  }
+
+  void write_bytes(const char* data, size_t size) {
+    write_uint32(static_cast<uint32_t>(size));
+    output_->append(data, size);
+  }
+
+  /**
+   * Write a result body along with the frame flags needed to decode it.
+   */
+  void write_result(const ResultResponse::Ptr& result) {
+    uint32_t flags = 0;
+    if (result->has_tracing_id()) flags |= CASS_FLAG_TRACING;
+    if (!result->warnings().empty()) flags |= CASS_FLAG_WARNING;
+    if (!result->custom_payload().empty()) flags |= CASS_FLAG_CUSTOM_PAYLOAD;
+    write_uint32(flags);
+    write_bytes(result->data(), result->buffer_size());
+  }
+
+  size_t begin_section(MetadataCache::SectionType type) {
+    write_uint32(type);
+    size_t pos = output_->size();
+    write_uint32(0); // The size is updated when the section ends
+    return pos;
+  }
+
+  void end_section(size_t pos) {
+    size_t size = output_->size() - pos - sizeof(uint32_t);
+    encode_uint32(&(*output_)[pos], static_cast<uint32_t>(size));
+    size_t remainder = output_->size() % SECTION_ALIGNMENT;
+    if (remainder > 0) output_->append(SECTION_ALIGNMENT - remainder, '\0');
+  }
+
+private:
+  String* output_;
+};
+
+class Reader {
+public:
+  Reader(const char* input, size_t size)
+      : pos_(input)
+      , end_(input + size) {}
+
+  const char* pos() const { return pos_; }
+  size_t remaining() const { return end_ - pos_; }
+
+  bool skip(size_t size) {
+    if (remaining() < size) return false;
+    pos_ += size;
+    return true;
+  }
+
+  bool read_uint16(uint16_t* output) {
+    if (remaining() < sizeof(uint16_t)) return false;
+    pos_ = decode_uint16(pos_, *output);
+    return true;
+  }
+
+  bool read_uint32(uint32_t* output) {
+    if (remaining() < sizeof(uint32_t)) return false;
+    pos_ = decode_uint32(pos_, *output);
+    return true;
+  }
+
+  bool read_version(VersionNumber* output) {
+    uint32_t major_version, minor_version, patch_version;
+    if (!read_uint32(&major_version) || !read_uint32(&minor_version) ||
+        !read_uint32(&patch_version)) {
+      return false;
+    }
+    *output = VersionNumber(major_version, minor_version, patch_version);
+    return true;
+  }
+
+  bool read_string(String* output) {
+    uint16_t size = 0;
+    if (!read_uint16(&size) || remaining() < size) return false;
+    output->assign(pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  bool read_bytes(String* output) {
+    uint32_t size = 0;
+    if (!read_uint32(&size) || remaining() < size) return false;
+    output->assign(pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  bool read_result(ProtocolVersion protocol_version, ResultResponse::Ptr* output) {
+    uint32_t flags = 0;
+    uint32_t size = 0;
+    if (!read_uint32(&flags) || !read_uint32(&size) || remaining() < size) return false;
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(size);
+    memcpy(result->data(), pos_, size);
+    pos_ += size;
+    if (!result->decode_body(protocol_version, static_cast<uint8_t>(flags))) return false;
+    *output = result;
+    return true;
+  }
+
+private:
+  const char* pos_;
+  const char* end_;
+};
+
+} // namespace
+
+MetadataCache::MetadataCache(const String& file_name)
+    : file_name_(file_name)
+    , prepared_generation_(0) {
+  uv_mutex_init(&mutex_);
+}
+
+MetadataCache::~MetadataCache() { uv_mutex_destroy(&mutex_); }
+
+bool MetadataCache::load() {
+  FILE* file = fopen(file_name_.c_str(), "rb");
+  if (file == NULL) {
+    LOG_DEBUG("Metadata cache file %s doesn't exist", file_name_.c_str());
+    return false;
+  }
+
+  String contents;
+  char buf[16 * 1024];
+  size_t size;
+  while ((size = fread(buf, 1, sizeof(buf), file)) > 0) {
+    contents.append(buf, size);
+  }
+  bool is_error = ferror(file) != 0;
+  fclose(file);
+
+  if (is_error) {
+    LOG_WARN("Unable to read metadata cache file %s", file_name_.c_str());
+    return false;
+  }
+
+  ScopedMutex l(&mutex_);
+  if (!decode(contents.data(), contents.size())) {
+    LOG_WARN("Ignoring invalid metadata cache file %s", file_name_.c_str());
+    protocol_version_ = ProtocolVersion();
+    schema_results_.clear();
+    prepared_.clear();
+    return false;
+  }
+
+  LOG_DEBUG("Loaded %u schema metadata results and %u prepared statements from metadata cache "
+            "file %s",
+            static_cast<unsigned>(schema_results_.size()), static_cast<unsigned>(prepared_.size()),
+            file_name_.c_str());
+  return true;
+}
+
+bool MetadataCache::save() {
+  String contents;
+  {
+    ScopedMutex l(&mutex_);
+    contents = encode();
+  }
+
+  // Write to a temporary file first so that a partially written cache is
+  // never loaded.
+  String temp_file_name(file_name_ + ".tmp");
+  FILE* file = fopen(temp_file_name.c_str(), "wb");
+  if (file == NULL) {
+    LOG_WARN("Unable to open metadata cache file %s for writing", temp_file_name.c_str());
+    return false;
+  }
+
+  bool is_error = fwrite(contents.data(), 1, contents.size(), file) != contents.size();
+  if (fclose(file) != 0) is_error = true;
+
+  if (!is_error) {
+#ifdef _WIN32
+    remove(file_name_.c_str()); // rename() doesn't replace existing files on Windows
+#endif
+    is_error = rename(temp_file_name.c_str(), file_name_.c_str()) != 0;
+  }
+
+  if (is_error) {
+    LOG_WARN("Unable to write metadata cache file %s", file_name_.c_str());
+    remove(temp_file_name.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+bool MetadataCache::schema(ProtocolVersion protocol_version, const VersionNumber& server_version,
+                           const VersionNumber& dse_server_version, const String& scope,
+                           ControlConnectionSchema* schema) const {
+  ScopedMutex l(&mutex_);
+  if (schema_results_.empty() || protocol_version != protocol_version_ ||
+      server_version.compare(server_version_) != 0 ||
+      dse_server_version.compare(dse_server_version_) != 0 || scope != schema_scope_) {
+    return false;
+  }
+
+  for (size_t i = 0; i < schema_results_count; ++i) {
+    SchemaResultMap::const_iterator it = schema_results_.find(schema_results[i].key);
+    schema->*schema_results[i].result =
+        it != schema_results_.end() ? it->second : ResultResponse::Ptr();
+  }
+  schema->is_cached = true;
+  return true;
+}
+
+void MetadataCache::set_schema(ProtocolVersion protocol_version,
+                               const VersionNumber& server_version,
+                               const VersionNumber& dse_server_version, const String& scope,
+                               const ControlConnectionSchema& schema) {
+  ScopedMutex l(&mutex_);
+  if (protocol_version != protocol_version_) {
+    prepared_.clear(); // Prepared results are specific to the protocol version
+  }
+  protocol_version_ = protocol_version;
+  server_version_ = server_version;
+  dse_server_version_ = dse_server_version;
+  schema_scope_ = scope;
+  schema_results_.clear();
+  for (size_t i = 0; i < schema_results_count; ++i) {
+    const ResultResponse::Ptr& result = schema.*schema_results[i].result;
+    if (result) schema_results_[schema_results[i].key] = result;
+  }
+}
+
+void MetadataCache::clear_schema() {
+  ScopedMutex l(&mutex_);
+  schema_results_.clear();
+}
+
+void MetadataCache::validate_prepared(ProtocolVersion protocol_version) {
+  ScopedMutex l(&mutex_);
+  if (protocol_version != protocol_version_) {
+    prepared_.clear();
+    prepared_futures_.clear();
+    schema_results_.clear(); // Also specific to the protocol version
+    protocol_version_ = protocol_version;
+  }
+}
+
+void MetadataCache::unvalidated_prepared(const String& keyspace, StringVec* queries) {
+  ScopedMutex l(&mutex_);
+  resolve_prepared();
+  for (PreparedMap::const_iterator it = prepared_.begin(), end = prepared_.end(); it != end; ++it) {
+    if (!it->second.is_valid && it->first.first == keyspace &&
+        prepared_futures_.find(it->first) == prepared_futures_.end()) {
+      queries->push_back(it->first.second);
+    }
+  }
+}
+
+ResultResponse::Ptr MetadataCache::prepared(const String& keyspace, const String& query) {
+  ScopedMutex l(&mutex_);
+  resolve_prepared();
+  PreparedMap::const_iterator it = prepared_.find(PreparedKey(keyspace, query));
+  if (it == prepared_.end() || !it->second.is_valid) return ResultResponse::Ptr();
+  return it->second.result;
+}
+
+void MetadataCache::add_prepared(const String& keyspace, const String& query,
+                                 const ResponseFuture::Ptr& future) {
+  ScopedMutex l(&mutex_);
+  resolve_prepared();
+  PendingPrepared& pending = prepared_futures_[PreparedKey(keyspace, query)];
+  pending.future = future;
+  pending.generation = prepared_generation_;
+}
+
+void MetadataCache::invalidate_prepared() {
+  ScopedMutex l(&mutex_);
+  resolve_prepared();
+  for (PreparedMap::iterator it = prepared_.begin(), end = prepared_.end(); it != end; ++it) {
+    it->second.is_valid = false;
+  }
+  prepared_generation_++;
+}
+
+size_t MetadataCache::prepared_count() const {
+  ScopedMutex l(&mutex_);
+  return prepared_.size();
+}
+
+void MetadataCache::resolve_prepared() {
+  PreparedFutureMap::iterator it = prepared_futures_.begin();
+  while (it != prepared_futures_.end()) {
+    const PendingPrepared& pending = it->second;
+    if (!pending.future->ready()) {
+      ++it;
+      continue;
+    }
+
+    const Response::Ptr& response = pending.future->response();
+    if (!pending.future->error() && response && response->opcode() == CQL_OPCODE_RESULT) {
+      ResultResponse::Ptr result(response);
+      if (result->kind() == CASS_RESULT_KIND_PREPARED &&
+          result->protocol_version() == protocol_version_) {
+        PreparedEntry& entry = prepared_[it->first];
+        entry.result = result;
+        // A result prepared before a schema change might be stale
+        entry.is_valid = pending.generation == prepared_generation_;
+      }
+    } else if (pending.future->error() &&
+               (pending.future->error()->code >> 24) == CASS_ERROR_SOURCE_SERVER) {
+      prepared_.erase(it->first); // The server rejected the statement
+    }
+    prepared_futures_.erase(it++);
+  }
+}
+
+bool MetadataCache::decode(const char* input, size_t size) {
+  Reader reader(input, size);
+
+  uint32_t format_version = 0;
+  uint32_t section_count = 0;
+  if (reader.remaining() < MAGIC_SIZE ||
+      memcmp(reader.pos(), CASS_METADATA_CACHE_MAGIC, MAGIC_SIZE) != 0 ||
+      !reader.skip(MAGIC_SIZE) || !reader.read_uint32(&format_version) ||
+      !reader.read_uint32(&section_count)) {
+    return false;
+  }
+
+  if (format_version != CASS_METADATA_CACHE_FORMAT_VERSION) {
+    LOG_DEBUG("Metadata cache file format version %u is not supported", format_version);
+    return false;
+  }
+
+  for (uint32_t i = 0; i < section_count; ++i) {
+    uint32_t type = 0;
+    uint32_t section_size = 0;
+    if (!reader.read_uint32(&type) || !reader.read_uint32(&section_size) ||
+        reader.remaining() < section_size) {
+      return false;
+    }
+
+    Reader section(reader.pos(), section_size);
+    switch (type) {
+      case SECTION_INFO: {
+        uint32_t protocol_version = 0;
+        if (!section.read_uint32(&protocol_version) || !section.read_version(&server_version_) ||
+            !section.read_version(&dse_server_version_) || !section.read_string(&schema_scope_)) {
+          return false;
+        }
+        protocol_version_ = ProtocolVersion(protocol_version);
+        if (!protocol_version_.is_valid()) return false;
+        break;
+      }
+      case SECTION_SCHEMA: {
+        String key;
+        ResultResponse::Ptr result;
+        if (!section.read_string(&key) || !section.read_result(protocol_version_, &result)) {
+          return false;
+        }
+        schema_results_[key] = result;
+        break;
+      }
+      case SECTION_PREPARED: {
+        String keyspace, query;
+        ResultResponse::Ptr result;
+        if (!section.read_string(&keyspace) || !section.read_bytes(&query) ||
+            !section.read_result(protocol_version_, &result) ||
+            result->kind() != CASS_RESULT_KIND_PREPARED) {
+          return false;
+        }
+        prepared_[PreparedKey(keyspace, query)].result = result;
+        break;
+      }
+      default:
+        break; // Ignore unknown sections
+    }
+
+    reader.skip(section_size);
+
+    // The padding after the last section is optional.
+    size_t remainder = (reader.pos() - input) % SECTION_ALIGNMENT;
+    if (remainder > 0 && !reader.skip(SECTION_ALIGNMENT - remainder) && i + 1 < section_count) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+String MetadataCache::encode() {
+  resolve_prepared();
+
+  String output;
+  Writer writer(&output);
+
+  output.append(CASS_METADATA_CACHE_MAGIC, MAGIC_SIZE);
+  writer.write_uint32(CASS_METADATA_CACHE_FORMAT_VERSION);
+  writer.write_uint32(1 + schema_results_.size() + prepared_.size());
+
+  size_t pos = writer.begin_section(SECTION_INFO);
+  writer.write_uint32(protocol_version_.value());
+  writer.write_version(server_version_);
+  writer.write_version(dse_server_version_);
+  writer.write_string(schema_scope_);
+  writer.end_section(pos);
+
+  for (SchemaResultMap::const_iterator it = schema_results_.begin(), end = schema_results_.end();
+       it != end; ++it) {
+    pos = writer.begin_section(SECTION_SCHEMA);
+    writer.write_string(it->first);
+    writer.write_result(it->second);
+    writer.end_section(pos);
+  }
+
+  for (PreparedMap::const_iterator it = prepared_.begin(), end = prepared_.end(); it != end; ++it) {
+    pos = writer.begin_section(SECTION_PREPARED);
+    writer.write_string(it->first.first);
+    writer.write_bytes(it->first.second.data(), it->first.second.size());
+    writer.write_result(it->second.result);
+    writer.end_section(pos);
+  }
+
+  return output;
+}
@@ -0,0 +1,214 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_METADATA_CACHE_HPP
+#define DATASTAX_INTERNAL_METADATA_CACHE_HPP
+
+#include "host.hpp"
+#include "macros.hpp"
+#include "map.hpp"
+#include "protocol.hpp"
+#include "ref_counted.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "string.hpp"
+#include "string_ref.hpp"
+
+#include <uv.h>
+
+#include <utility>
+
+#define CASS_METADATA_CACHE_MAGIC "CASSMETA"
+#define CASS_METADATA_CACHE_FORMAT_VERSION 1
+
+namespace datastax { namespace internal { namespace core {
+
+struct ControlConnectionSchema;
+
+/**
+ * A cache of cluster metadata that's persisted between sessions so that a new
+ * session can skip the schema metadata queries and reuse prepared statements.
+ * The cached schema metadata is always revalidated in the background after
+ * connecting.
+ *
+ * The file is a sequence of big-endian, length-prefixed sections that are
+ * aligned to 8 bytes:
+ *
+ * <pre>
+ * header:  "CASSMETA" [uint32 format version] [uint32 section count]
+ * section: [uint32 type] [uint32 size] [payload] [padding]
+ *
+ * INFO:     [uint32 protocol version] [3 x uint32 server version]
+ *           [3 x uint32 DSE server version] [string schema scope]
+ * SCHEMA:   [string key] [uint32 flags] [bytes result body]
+ * PREPARED: [string keyspace] [bytes query] [uint32 flags] [bytes result body]
+ * </pre>
+ *
+ * Strings use a uint16 length and bytes use a uint32 length. The result
+ * bodies are stored exactly as they were received from the server and unknown
+ * section types are skipped.
+ */
+class MetadataCache : public RefCounted<MetadataCache> {
+public:
+  typedef SharedRefPtr<MetadataCache> Ptr;
+
+  enum SectionType { SECTION_INFO = 1, SECTION_SCHEMA = 2, SECTION_PREPARED = 3 };
+
+  MetadataCache(const String& file_name);
+  ~MetadataCache();
+
+  const String& file_name() const { return file_name_; }
+
+  /**
+   * Load the cache from its file. A missing or invalid file results in an
+   * empty cache.
+   *
+   * @return true if the file was successfully loaded.
+   */
+  bool load();
+
+  /**
+   * Save the cache to its file. The file is replaced atomically.
+   *
+   * @return true if the file was successfully saved.
+   */
+  bool save();
+
+  /**
+   * Get the cached schema metadata if it matches the cluster.
+   *
+   * @param protocol_version The negotiated protocol version.
+   * @param server_version The version of the connected server.
+   * @param dse_server_version The DSE version of the connected server.
+   * @param scope The scope of the schema metadata (keyspace filter).
+   * @param schema The cached schema metadata (output).
+   * @return true if the cached schema metadata is usable.
+   */
+  bool schema(ProtocolVersion protocol_version, const VersionNumber& server_version,
+              const VersionNumber& dse_server_version, const String& scope,
+              ControlConnectionSchema* schema) const;
+
+  /**
+   * Replace the cached schema metadata.
+   *
+   * @param protocol_version The negotiated protocol version.
+   * @param server_version The version of the connected server.
+   * @param dse_server_version The DSE version of the connected server.
+   * @param scope The scope of the schema metadata (keyspace filter).
+   * @param schema The schema metadata.
+   */
+  void set_schema(ProtocolVersion protocol_version, const VersionNumber& server_version,
+                  const VersionNumber& dse_server_version, const String& scope,
+                  const ControlConnectionSchema& schema);
+
+  /**
+   * Discard the cached schema metadata. This is used when the schema metadata
+   * was changed incrementally and no longer matches the last full refresh.
+   */
+  void clear_schema();
+
+  /**
+   * Discard the cached prepared statements if they were prepared using a
+   * different protocol version.
+   *
+   * @param protocol_version The negotiated protocol version.
+   */
+  void validate_prepared(ProtocolVersion protocol_version);
+
+  /**
+   * Get the queries of the cached prepared statements that haven't been
+   * prepared since they were loaded from the file, or since the last schema
+   * change. They need to be prepared again before they're used.
+   *
+   * @param keyspace The keyspace used to prepare the queries.
+   * @param queries The queries (output).
+   */
+  void unvalidated_prepared(const String& keyspace, StringVec* queries);
+
+  /**
+   * Get the result of a prepared statement. Only results prepared by the
+   * server since the last schema change are returned so that the result
+   * metadata is up-to-date.
+   *
+   * @param keyspace The keyspace used to prepare the query.
+   * @param query The query.
+   * @return The PREPARED result or null if there's no valid result.
+   */
+  ResultResponse::Ptr prepared(const String& keyspace, const String& query);
+
+  /**
+   * Add a prepare request to the cache. The result is taken from the future
+   * once it's finished.
+   *
+   * @param keyspace The keyspace used to prepare the query.
+   * @param query The query.
+   * @param future The future of the prepare request.
+   */
+  void add_prepared(const String& keyspace, const String& query,
+                    const ResponseFuture::Ptr& future);
+
+  /**
+   * Mark all the prepared statements as needing to be prepared again because
+   * the schema changed. Prepare requests that are still running are ignored.
+   */
+  void invalidate_prepared();
+
+  size_t prepared_count() const;
+
+private:
+  typedef std::pair<String, String> PreparedKey; // Keyspace and query
+
+  struct PreparedEntry {
+    PreparedEntry()
+        : is_valid(false) {}
+    ResultResponse::Ptr result;
+    // Prepared by the server since the last schema change
+    bool is_valid;
+  };
+
+  struct PendingPrepared {
+    ResponseFuture::Ptr future;
+    unsigned generation;
+  };
+
+  typedef Map<PreparedKey, PreparedEntry> PreparedMap;
+  typedef Map<PreparedKey, PendingPrepared> PreparedFutureMap;
+  typedef Map<String, ResultResponse::Ptr> SchemaResultMap;
+
+  void resolve_prepared();
+  bool decode(const char* input, size_t size);
+  String encode();
+
+private:
+  const String file_name_;
+  mutable uv_mutex_t mutex_;
+  ProtocolVersion protocol_version_;
+  VersionNumber server_version_;
+  VersionNumber dse_server_version_;
+  String schema_scope_;
+  SchemaResultMap schema_results_;
+  PreparedMap prepared_;
+  PreparedFutureMap prepared_futures_;
+  // Incremented when the schema changes to ignore in-flight prepare requests
+  unsigned prepared_generation_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(MetadataCache);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
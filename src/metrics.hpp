@@ -22,16 +22,22 @@
 
 #include "allocated.hpp"
 #include "atomic.hpp"
+#include "connection.hpp"
 #include "constants.hpp"
+#include "histogram_snapshot.hpp"
+#include "ref_counted.hpp"
+#include "request_timings.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "utils.hpp"
+#include "vector.hpp"
 
 #include "third_party/hdr_histogram/hdr_histogram.hpp"
 
 #include <stdlib.h>
 #include <uv.h>
 
+#include <algorithm>
 #include <math.h>
 
 namespace datastax { namespace internal { namespace core {
@@ -251,7 +257,7 @@ public:
     DISALLOW_COPY_AND_ASSIGN(Meter);
   };
 
-  class Histogram {
+  class Histogram : public Allocated {
   public:
     static const int64_t HIGHEST_TRACKABLE_VALUE = 3600LL * 1000LL * 1000LL;
 
@@ -270,13 +276,15 @@ public:
 
     Histogram(ThreadState* thread_state)
         : thread_state_(thread_state)
-        , histograms_(new PerThreadHistogram[thread_state->max_threads()]) {
+        , histograms_(new PerThreadHistogram[thread_state->max_threads()])
+        , interval_histogram_(NULL) {
       hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histogram_);
       uv_mutex_init(&mutex_);
     }
 
     ~Histogram() {
       free(histogram_);
+      free(interval_histogram_); // NULL if there was never an interval read
       uv_mutex_destroy(&mutex_);
     }
 
@@ -284,13 +292,126 @@ public:
       histograms_[thread_state_->current_thread_id()].record_value(value);
     }
 
+    /**
+     * Record a value from a thread that isn't tracked by the thread state
+     * (e.g. an application thread). This takes the histogram's lock.
+     */
+    void record_value_synchronized(int64_t value) {
+      ScopedMutex l(&mutex_);
+      hdr_record_value(histogram_, value);
+      if (interval_histogram_) hdr_record_value(interval_histogram_, value);
+    }
+
+    struct Bucket {
+      int64_t upper_bound;      // In the histogram's unit; the last bucket has no bound
+      int64_t cumulative_count; // Number of values less than or equal to the upper bound
+    };
+
+    // Power of two bucket bounds up to and including the highest trackable value
+    static const size_t BUCKET_COUNT = 33;
+
+    /**
+     * Get the stats of all the values recorded since the histogram was
+     * created.
+     */
     void get_snapshot(Snapshot* snapshot) const {
+      ScopedMutex l(&mutex_);
+      merge_thread_histograms();
+      fill_snapshot(histogram_, snapshot);
+    }
+
+    /**
+     * Get the stats of the values recorded since the previous interval read
+     * (this or `copy(true)`) and start a new interval. There's only one
+     * interval, so interval reads by different consumers reset each other.
+     */
+    void get_interval_snapshot(Snapshot* snapshot) const {
+      ScopedMutex l(&mutex_);
+      merge_thread_histograms();
+      fill_snapshot(current_interval(), snapshot);
+      start_interval();
+    }
+
+    /**
+     * Copy the recorded values into a standalone HDR histogram that can be
+     * encoded and merged with histograms from other processes.
+     *
+     * @param interval If true, only the values recorded since the previous
+     * interval read are copied and a new interval is started.
+     * @return A new snapshot owned by the caller.
+     */
+    HistogramSnapshot* copy(bool interval) const {
+      ScopedMutex l(&mutex_);
+      merge_thread_histograms();
+      if (interval) {
+        HistogramSnapshot* snapshot = new HistogramSnapshot(current_interval());
+        start_interval();
+        return snapshot;
+      }
+      return new HistogramSnapshot(histogram_);
+    }
+
+    /**
+     * Get the cumulative counts of the recorded values using fixed power of two
+     * upper bounds (1, 2, 4, ..., 2^32).
+     *
+     * @param buckets An array of BUCKET_COUNT buckets.
+     * @param count The total number of recorded values.
+     * @param sum The (approximate) sum of the recorded values.
+     */
+    void get_buckets(Bucket* buckets, int64_t* count, double* sum) const {
       ScopedMutex l(&mutex_);
       hdr_histogram* h = histogram_;
+      merge_thread_histograms();
+
+      for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i].upper_bound = 1LL << i;
+        buckets[i].cumulative_count = 0;
+      }
+
+      hdr_iter iter;
+      hdr_iter_recorded_init(&iter, h);
+      while (hdr_iter_next(&iter)) {
+        size_t i = 0;
+        while (i < BUCKET_COUNT - 1 && buckets[i].upper_bound < iter.highest_equivalent_value) {
+          ++i;
+        }
+        buckets[i].cumulative_count += iter.count_at_index;
+      }
+      for (size_t i = 1; i < BUCKET_COUNT; ++i) {
+        buckets[i].cumulative_count += buckets[i - 1].cumulative_count;
+      }
+
+      *count = h->total_count;
+      *sum = h->total_count > 0 ? hdr_mean(h) * h->total_count : 0.0;
+    }
+
+  private:
+    // Requires the mutex to be held. Before the first interval read the
+    // interval spans every value recorded so it's the whole histogram.
+    hdr_histogram* current_interval() const {
+      return interval_histogram_ ? interval_histogram_ : histogram_;
+    }
+
+    // Requires the mutex to be held. The interval histogram is only allocated
+    // on the first interval read so that histograms only read in full don't
+    // pay for it.
+    void start_interval() const {
+      if (interval_histogram_) {
+        hdr_reset(interval_histogram_);
+      } else {
+        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &interval_histogram_);
+      }
+    }
+
+    // Requires the mutex to be held
+    void merge_thread_histograms() const {
       for (size_t i = 0; i < thread_state_->max_threads(); ++i) {
-        histograms_[i].add(h);
+        histograms_[i].add(histogram_, interval_histogram_);
       }
+    }
 
+    static void fill_snapshot(hdr_histogram* h, Snapshot* snapshot) {
       if (h->total_count == 0) {
         // There is no data; default to 0 for the stats.
         snapshot->max = 0;
@@ -390,12 +511,15 @@ public:
         phaser_.writer_critical_section_end(critical_value_enter);
       }
 
-      void add(hdr_histogram* to) const {
+      void add(hdr_histogram* to, hdr_histogram* interval_to) const {
         int inactive_index = active_index_.exchange(!active_index_.load());
         hdr_histogram* from = histograms_[inactive_index];
         phaser_.flip_phase();
-        hdr_add(to, from);
-        hdr_reset(from);
+        if (from->total_count > 0) {
+          hdr_add(to, from);
+          if (interval_to) hdr_add(interval_to, from);
+          hdr_reset(from);
+        }
       }
 
     private:
@@ -406,21 +530,204 @@ public:
 
     ThreadState* thread_state_;
     ScopedArray<PerThreadHistogram> histograms_;
-    hdr_histogram* histogram_;
+    hdr_histogram* histogram_;          // All recorded values
+    mutable hdr_histogram* interval_histogram_; // Values recorded since the last interval read
     mutable uv_mutex_t mutex_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(Histogram);
   };
 
-  Metrics(size_t max_threads)
+  /**
+   * The latest saturation stats of each event loop (I/O thread). Each loop
+   * updates its own slot so updates never contend.
+   */
+  class EventLoopGauges {
+  public:
+    struct Stats {
+      double utilization;        // Fraction of the probe interval spent outside of polling
+      uint64_t lag_us;           // Delay of the last probe past its scheduled time
+      uint64_t callback_time_us; // Time spent in future callbacks during the probe interval
+    };
+
+    EventLoopGauges(ThreadState* thread_state)
+        : thread_state_(thread_state)
+        , gauges_(new PerThreadGauge[thread_state->max_threads()]) {}
+
+    void set(const Stats& stats) { gauges_[thread_state_->current_thread_id()].set(stats); }
+
+    /**
+     * Get the stats of an event loop. Event loops are numbered in the order
+     * they first reported their stats.
+     *
+     * @param index The index of the event loop.
+     * @param stats The event loop's stats.
+     * @return true if the event loop exists, otherwise false.
+     */
+    bool get(size_t index, Stats* stats) const {
+      for (size_t i = 0; i < thread_state_->max_threads(); ++i) {
+        if (gauges_[i].get(stats) && index-- == 0) return true;
+      }
+      return false;
+    }
+
+  private:
+    class PerThreadGauge : public Allocated {
+    public:
+      PerThreadGauge()
+          : is_set_(false)
+          , utilization_(0.0)
+          , lag_us_(0)
+          , callback_time_us_(0) {}
+
+      void set(const Stats& stats) {
+        utilization_.store(stats.utilization, MEMORY_ORDER_RELAXED);
+        lag_us_.store(stats.lag_us, MEMORY_ORDER_RELAXED);
+        callback_time_us_.store(stats.callback_time_us, MEMORY_ORDER_RELAXED);
+        is_set_.store(true, MEMORY_ORDER_RELEASE);
+      }
+
+      bool get(Stats* stats) const {
+        if (!is_set_.load(MEMORY_ORDER_ACQUIRE)) return false;
+        stats->utilization = utilization_.load(MEMORY_ORDER_RELAXED);
+        stats->lag_us = lag_us_.load(MEMORY_ORDER_RELAXED);
+        stats->callback_time_us = callback_time_us_.load(MEMORY_ORDER_RELAXED);
+        return true;
+      }
+
+    private:
+      Atomic<bool> is_set_;
+      Atomic<double> utilization_;
+      Atomic<uint64_t> lag_us_;
+      Atomic<uint64_t> callback_time_us_;
+
+      static const size_t cacheline_size = 64;
+      char pad__[cacheline_size];
+      void no_unused_private_warning__() { pad__[0] = 0; }
+    };
+
+  private:
+    ThreadState* thread_state_;
+    ScopedArray<PerThreadGauge> gauges_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(EventLoopGauges);
+  };
+
+  /**
+   * The session's pooled connections. These are tracked by their pools rather
+   * than by their hosts so that a connection's stats are still reported after
+   * its host has been replaced, e.g. by a topology refresh.
+   */
+  class Connections {
+  public:
+    Connections() { uv_mutex_init(&mutex_); }
+    ~Connections() { uv_mutex_destroy(&mutex_); }
+
+    // The connection must be removed before it's destroyed
+    void add(const Connection* connection) {
+      ScopedMutex l(&mutex_);
+      connections_.push_back(connection);
+    }
+
+    void remove(const Connection* connection) {
+      ScopedMutex l(&mutex_);
+      Vector<const Connection*>::iterator it =
+          std::find(connections_.begin(), connections_.end(), connection);
+      if (it != connections_.end()) connections_.erase(it);
+    }
+
+    /**
+     * Get a copy of the stats of the open connections (thread-safe).
+     *
+     * @param stats The connection stats are appended to this vector.
+     */
+    void stats(ConnectionStats::Vec* stats) const {
+      ScopedMutex l(&mutex_);
+      for (Vector<const Connection*>::const_iterator it = connections_.begin(),
+                                                     end = connections_.end();
+           it != end; ++it) {
+        stats->push_back((*it)->stats());
+      }
+    }
+
+  private:
+    Vector<const Connection*> connections_;
+    mutable uv_mutex_t mutex_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(Connections);
+  };
+
+  /**
+   * The time spent in each stage of successful requests. This is only
+   * allocated when request stage timings are enabled. Response futures keep a
+   * reference so that a callback set after a request completes is recorded
+   * even if the session has been freed.
+   */
+  class RequestStageLatencies : public RefCounted<RequestStageLatencies> {
+  public:
+    typedef SharedRefPtr<RequestStageLatencies> Ptr;
+
+    RequestStageLatencies(size_t max_threads)
+        : thread_state_(max_threads) {
+      for (int i = 0; i < CASS_REQUEST_STAGE_LAST_ENTRY; ++i) {
+        histograms_[i].reset(new Histogram(&thread_state_));
+      }
+    }
+
+    const Histogram& get(CassRequestStage stage) const { return *histograms_[stage]; }
+
+    // Must be called from the session's threads. The callback stage is
+    // recorded separately by the response future.
+    void record(const RequestTimings& timings) {
+      for (int i = 0; i < CASS_REQUEST_STAGE_CALLBACK; ++i) {
+        uint64_t elapsed_ns;
+        if (timings.elapsed(static_cast<CassRequestStage>(i), &elapsed_ns)) {
+          // Final measurement is in microseconds
+          histograms_[i]->record_value(elapsed_ns / 1000);
+        }
+      }
+    }
+
+    /**
+     * Record the time spent in a request's callback.
+     *
+     * @param elapsed_ns The time spent in the callback in nanoseconds.
+     * @param is_session_thread If false, the callback was run by an
+     * application thread when it was set after the request completed.
+     */
+    void record_callback(uint64_t elapsed_ns, bool is_session_thread) {
+      Histogram* histogram = histograms_[CASS_REQUEST_STAGE_CALLBACK].get();
+      if (is_session_thread) {
+        histogram->record_value(elapsed_ns / 1000);
+      } else {
+        histogram->record_value_synchronized(elapsed_ns / 1000);
+      }
+    }
+
+  private:
+    ThreadState thread_state_;
+    ScopedPtr<Histogram> histograms_[CASS_REQUEST_STAGE_LAST_ENTRY];
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(RequestStageLatencies);
+  };
+
+  Metrics(size_t max_threads, bool record_request_stages = false)
       : thread_state_(max_threads)
       , request_latencies(&thread_state_)
       , speculative_request_latencies(&thread_state_)
       , request_rates(&thread_state_)
       , total_connections(&thread_state_)
       , connection_timeouts(&thread_state_)
-      , request_timeouts(&thread_state_) {}
+      , request_timeouts(&thread_state_)
+      , event_loop_lag(&thread_state_)
+      , event_loops(&thread_state_) {
+    if (record_request_stages) {
+      request_stage_latencies.reset(new RequestStageLatencies(max_threads));
+    }
+  }
 
   void record_request(uint64_t latency_ns) {
     // Final measurement is in microseconds
@@ -434,19 +741,35 @@ public:
     request_rates.mark_speculative();
   }
 
+  // Must be called from the event loop's thread
+  void record_event_loop(uint64_t lag_ns, double utilization, uint64_t callback_time_ns) {
+    // Final measurement is in microseconds
+    event_loop_lag.record_value(lag_ns / 1000);
+    EventLoopGauges::Stats stats;
+    stats.utilization = utilization;
+    stats.lag_us = lag_ns / 1000;
+    stats.callback_time_us = callback_time_ns / 1000;
+    event_loops.set(stats);
+  }
+
 private:
   ThreadState thread_state_;
 
 public:
   Histogram request_latencies;
   Histogram speculative_request_latencies;
+  RequestStageLatencies::Ptr request_stage_latencies; // Only set if stage timings are enabled
   Meter request_rates;
 
   Counter total_connections;
+  Connections connections;
 
   Counter connection_timeouts;
   Counter request_timeouts;
 
+  Histogram event_loop_lag;
+  EventLoopGauges event_loops;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(Metrics);
 };
@@ -0,0 +1,499 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "metrics_exporter.hpp"
+
+#include "address.hpp"
+#include "connection.hpp"
+#include "http_parser.h"
+#include "logger.hpp"
+#include "map.hpp"
+
+#include <iomanip>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A scrape connection. A single request is handled and the connection is
+ * closed after the response is written.
+ */
+class MetricsExporter::Client
+    : public List<Client>::Node
+    , public Allocated {
+public:
+  Client(MetricsExporter* exporter)
+      : exporter_(exporter)
+      , is_responded_(false)
+      , is_closing_(false) {
+    tcp_.data = this;
+    write_req_.data = this;
+    http_parser_init(&parser_, HTTP_REQUEST);
+    http_parser_settings_init(&parser_settings_);
+
+    parser_.data = this;
+    parser_settings_.on_url = on_url;
+    parser_settings_.on_message_complete = on_message_complete;
+  }
+
+  uv_stream_t* stream() { return reinterpret_cast<uv_stream_t*>(&tcp_); }
+
+  int init(uv_loop_t* loop) { return uv_tcp_init(loop, &tcp_); }
+
+  int accept(uv_stream_t* server) {
+    int rc = uv_accept(server, stream());
+    if (rc == 0) rc = uv_read_start(stream(), on_alloc, on_read);
+    return rc;
+  }
+
+  void close() {
+    if (!is_closing_) {
+      is_closing_ = true;
+      uv_close(reinterpret_cast<uv_handle_t*>(&tcp_), on_close);
+    }
+  }
+
+private:
+  static void on_alloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
+    Client* self = static_cast<Client*>(handle->data);
+    *buf = uv_buf_init(self->buf_, sizeof(self->buf_));
+  }
+
+  static void on_read(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf) {
+    Client* self = static_cast<Client*>(stream->data);
+    if (nread < 0) {
+      self->close();
+    } else if (nread > 0 && !self->is_responded_) {
+      size_t parsed =
+          http_parser_execute(&self->parser_, &self->parser_settings_, buf->base, nread);
+      if (parsed < static_cast<size_t>(nread) && !self->is_responded_) {
+        LOG_DEBUG("Metrics exporter HTTP parsing error (%s)",
+                  http_errno_name(HTTP_PARSER_ERRNO(&self->parser_)));
+        self->respond("400 Bad Request", "text/plain; charset=utf-8", "Bad Request\n");
+      }
+    }
+  }
+
+  static int on_url(http_parser* parser, const char* buf, size_t len) {
+    Client* self = static_cast<Client*>(parser->data);
+    self->url_.append(buf, len);
+    return 0;
+  }
+
+  static int on_message_complete(http_parser* parser) {
+    Client* self = static_cast<Client*>(parser->data);
+    self->handle_message_complete();
+    return 0;
+  }
+
+  void handle_message_complete() {
+    String path(url_.substr(0, url_.find('?')));
+    if (parser_.method != HTTP_GET) {
+      respond("405 Method Not Allowed", "text/plain; charset=utf-8", "Method Not Allowed\n");
+    } else if (path != CASS_METRICS_EXPORTER_PATH) {
+      respond("404 Not Found", "text/plain; charset=utf-8", "Not Found\n");
+    } else {
+      respond("200 OK", CASS_METRICS_EXPORTER_CONTENT_TYPE, exporter_->scrape());
+    }
+  }
+
+  void respond(const char* status, const char* content_type, const String& body) {
+    is_responded_ = true;
+    uv_read_stop(stream());
+
+    OStringStream ss;
+    ss << "HTTP/1.1 " << status << "\r\n"
+       << "Content-Type: " << content_type << "\r\n"
+       << "Content-Length: " << body.size() << "\r\n"
+       << "Connection: close\r\n\r\n"
+       << body;
+    response_ = ss.str();
+
+    uv_buf_t buf = uv_buf_init(const_cast<char*>(response_.data()), response_.size());
+    if (uv_write(&write_req_, stream(), &buf, 1, on_write) != 0) {
+      close();
+    }
+  }
+
+  static void on_write(uv_write_t* req, int status) {
+    Client* self = static_cast<Client*>(req->data);
+    self->close();
+  }
+
+  static void on_close(uv_handle_t* handle) {
+    Client* self = static_cast<Client*>(handle->data);
+    self->exporter_->clients_.remove(self);
+    delete self;
+  }
+
+private:
+  MetricsExporter* exporter_;
+  uv_tcp_t tcp_;
+  uv_write_t write_req_;
+  http_parser parser_;
+  http_parser_settings parser_settings_;
+  String url_;
+  String response_;
+  bool is_responded_;
+  bool is_closing_;
+  char buf_[1024];
+};
+
+class MetricsExporter::StopTask : public Task {
+public:
+  virtual void run(EventLoop* event_loop) {
+    static_cast<MetricsExporter*>(event_loop)->handle_stop();
+  }
+};
+
+}}} // namespace datastax::internal::core
+
+namespace {
+
+// Formats a value in microseconds as seconds without losing precision.
+void write_seconds(OStringStream& ss, int64_t micros) {
+  ss << micros / 1000000 << ".";
+  int64_t fraction = micros % 1000000;
+  if (fraction == 0) {
+    ss << "0";
+  } else {
+    int width = 6;
+    while (fraction % 10 == 0) {
+      fraction /= 10;
+      --width;
+    }
+    ss << std::setw(width) << std::setfill('0') << fraction << std::setfill(' ');
+  }
+}
+
+void write_header(OStringStream& ss, const char* name, const char* type, const char* unit,
+                  const char* help) {
+  ss << "# TYPE " << name << " " << type << "\n";
+  if (unit != NULL) {
+    ss << "# UNIT " << name << " " << unit << "\n";
+  }
+  ss << "# HELP " << name << " " << help << "\n";
+}
+
+// Histograms are recorded in microseconds and exported in seconds.
+void write_histogram(OStringStream& ss, const char* name, const String& labels,
+                     const Metrics::Histogram& histogram) {
+  Metrics::Histogram::Bucket buckets[Metrics::Histogram::BUCKET_COUNT];
+  int64_t count;
+  double sum;
+  histogram.get_buckets(buckets, &count, &sum);
+
+  const String separator(labels.empty() ? "" : ",");
+  for (size_t i = 0; i < Metrics::Histogram::BUCKET_COUNT - 1; ++i) {
+    ss << name << "_bucket{" << labels << separator << "le=\"";
+    write_seconds(ss, buckets[i].upper_bound);
+    ss << "\"} " << buckets[i].cumulative_count << "\n";
+  }
+  ss << name << "_bucket{" << labels << separator << "le=\"+Inf\"} "
+     << buckets[Metrics::Histogram::BUCKET_COUNT - 1].cumulative_count << "\n";
+
+  const String braced_labels(labels.empty() ? "" : "{" + labels + "}");
+  ss << name << "_count" << braced_labels << " " << count << "\n";
+  ss << name << "_sum" << braced_labels << " " << sum / 1e6 << "\n";
+}
+
+const char* stage_name(int stage) {
+  switch (stage) {
+    case CASS_REQUEST_STAGE_QUEUE:
+      return "queue";
+    case CASS_REQUEST_STAGE_QUERY_PLAN:
+      return "query_plan";
+    case CASS_REQUEST_STAGE_WRITE:
+      return "write";
+    case CASS_REQUEST_STAGE_NETWORK:
+      return "network";
+    case CASS_REQUEST_STAGE_DECODE:
+      return "decode";
+    case CASS_REQUEST_STAGE_COMPLETE:
+      return "complete";
+    case CASS_REQUEST_STAGE_CALLBACK:
+      return "callback";
+    default:
+      return "unknown";
+  }
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(Metrics* metrics, const Cluster::Ptr& cluster)
+    : metrics_(metrics)
+    , cluster_(cluster)
+    , is_listening_(false)
+    , is_running_(false) {}
+
+MetricsExporter::~MetricsExporter() { stop(); }
+
+int MetricsExporter::start(int port) {
+  int rc = init("Metrics Exporter");
+  if (rc != 0) return rc;
+
+  rc = uv_tcp_init(loop(), &server_);
+  if (rc != 0) return rc;
+  server_.data = this;
+  is_listening_ = true;
+
+  Address::SocketStorage storage;
+  int listen_rc = uv_tcp_bind(&server_, Address("127.0.0.1", port).to_sockaddr(&storage), 0);
+  if (listen_rc == 0) {
+    listen_rc = uv_listen(reinterpret_cast<uv_stream_t*>(&server_), 128, on_connection);
+  }
+
+  // The thread is started even if listening failed so that the listener's
+  // handle is closed by the event loop.
+  rc = run();
+  if (rc != 0) return rc;
+  is_running_ = true;
+
+  if (listen_rc != 0) {
+    stop();
+    return listen_rc;
+  }
+  return 0;
+}
+
+void MetricsExporter::stop() {
+  if (is_running_) {
+    is_running_ = false;
+    add(new StopTask());
+    close_handles();
+    join();
+  }
+}
+
+String MetricsExporter::scrape() const {
+  OStringStream ss;
+
+  write_header(ss, "cassandra_request_latency_seconds", "histogram", "seconds",
+               "Latency of successful requests.");
+  write_histogram(ss, "cassandra_request_latency_seconds", "", metrics_->request_latencies);
+
+  write_header(ss, "cassandra_speculative_request_latency_seconds", "histogram", "seconds",
+               "Latency of requests that completed on a speculative execution.");
+  write_histogram(ss, "cassandra_speculative_request_latency_seconds", "",
+                  metrics_->speculative_request_latencies);
+
+  if (metrics_->request_stage_latencies) {
+    write_header(ss, "cassandra_request_stage_latency_seconds", "histogram", "seconds",
+                 "Time spent in each stage of a request.");
+    for (int i = 0; i < CASS_REQUEST_STAGE_LAST_ENTRY; ++i) {
+      String labels("stage=\"");
+      labels.append(stage_name(i));
+      labels.append("\"");
+      write_histogram(ss, "cassandra_request_stage_latency_seconds", labels,
+                      metrics_->request_stage_latencies->get(static_cast<CassRequestStage>(i)));
+    }
+  }
+
+  const Metrics::Meter& rates = metrics_->request_rates;
+  write_header(ss, "cassandra_requests", "counter", NULL, "Number of successful requests.");
+  ss << "cassandra_requests_total " << rates.count() << "\n";
+
+  write_header(ss, "cassandra_speculative_requests", "counter", NULL,
+               "Number of speculative executions aborted after another execution succeeded.");
+  ss << "cassandra_speculative_requests_total " << rates.speculative_request_count() << "\n";
+
+  write_header(ss, "cassandra_request_rate", "gauge", NULL,
+               "Rate of successful requests per second.");
+  ss << "cassandra_request_rate{window=\"1m\"} " << rates.one_minute_rate() << "\n"
+     << "cassandra_request_rate{window=\"5m\"} " << rates.five_minute_rate() << "\n"
+     << "cassandra_request_rate{window=\"15m\"} " << rates.fifteen_minute_rate() << "\n"
+     << "cassandra_request_rate{window=\"mean\"} " << rates.mean_rate() << "\n";
+
+  write_header(ss, "cassandra_connections", "gauge", NULL, "Number of open connections.");
+  ss << "cassandra_connections " << metrics_->total_connections.sum() << "\n";
+
+  write_header(ss, "cassandra_connection_timeouts", "counter", NULL,
+               "Number of connection attempts that timed out.");
+  ss << "cassandra_connection_timeouts_total " << metrics_->connection_timeouts.sum() << "\n";
+
+  write_header(ss, "cassandra_request_timeouts", "counter", NULL,
+               "Number of requests that timed out.");
+  ss << "cassandra_request_timeouts_total " << metrics_->request_timeouts.sum() << "\n";
+
+  write_header(ss, "cassandra_event_loop_lag_seconds", "histogram", "seconds",
+               "Delay of the periodic event loop probe past its scheduled time.");
+  write_histogram(ss, "cassandra_event_loop_lag_seconds", "", metrics_->event_loop_lag);
+
+  write_header(ss, "cassandra_event_loop_utilization", "gauge", NULL,
+               "Fraction of the last probe interval the event loop spent processing.");
+  Metrics::EventLoopGauges::Stats stats;
+  for (size_t i = 0; metrics_->event_loops.get(i, &stats); ++i) {
+    ss << "cassandra_event_loop_utilization{loop=\"" << i << "\"} " << stats.utilization << "\n";
+  }
+
+  write_header(ss, "cassandra_event_loop_callback_seconds", "gauge", "seconds",
+               "Time spent running future callbacks during the last probe interval.");
+  for (size_t i = 0; metrics_->event_loops.get(i, &stats); ++i) {
+    ss << "cassandra_event_loop_callback_seconds{loop=\"" << i << "\"} ";
+    write_seconds(ss, static_cast<int64_t>(stats.callback_time_us));
+    ss << "\n";
+  }
+
+  if (cluster_) {
+    const HostMap hosts(cluster_->hosts());
+
+    write_header(ss, "cassandra_host_pool_up", "gauge", NULL,
+                 "Whether the host's connection pool has at least one connection.");
+    for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+      ss << "cassandra_host_pool_up{host=\"" << it->second->address_string() << "\"} "
+         << (it->second->connection_count() > 0 ? 1 : 0) << "\n";
+    }
+
+    write_header(ss, "cassandra_host_connections", "gauge", NULL,
+                 "Number of open connections to the host.");
+    for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+      ss << "cassandra_host_connections{host=\"" << it->second->address_string() << "\"} "
+         << it->second->connection_count() << "\n";
+    }
+
+    write_header(ss, "cassandra_host_inflight_requests", "gauge", NULL,
+                 "Number of requests written to the host that are waiting for a response.");
+    for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+      ss << "cassandra_host_inflight_requests{host=\"" << it->second->address_string() << "\"} "
+         << it->second->inflight_request_count() << "\n";
+    }
+
+    // Only tracked when the latency-aware load balancing policy is enabled
+    write_header(ss, "cassandra_host_latency_average_seconds", "gauge", "seconds",
+                 "Exponentially weighted average latency of requests to the host.");
+    for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+      TimestampedAverage average(it->second->get_current_average());
+      if (average.num_measured > 0) {
+        ss << "cassandra_host_latency_average_seconds{host=\""
+           << it->second->address_string() << "\"} " << average.average / 1e9 << "\n";
+      }
+    }
+
+    // Connections are labeled by their host and their index within the host
+    ConnectionStats::Vec connections;
+    Vector<String> labels;
+    Map<Address, size_t> connection_counts;
+    metrics_->connections.stats(&connections);
+    for (size_t i = 0; i < connections.size(); ++i) {
+      OStringStream label;
+      label << "host=\"" << connections[i].address.to_string() << "\",connection=\""
+            << connection_counts[connections[i].address]++ << "\"";
+      labels.push_back(label.str());
+    }
+
+    write_header(ss, "cassandra_connection_streams_in_use", "gauge", NULL,
+                 "Number of stream IDs used by requests waiting for a response.");
+    for (size_t i = 0; i < connections.size(); ++i) {
+      ss << "cassandra_connection_streams_in_use{" << labels[i] << "} "
+         << connections[i].streams_in_use << "\n";
+    }
+
+    write_header(ss, "cassandra_connection_max_streams_in_use", "gauge", NULL,
+                 "High-water mark of stream IDs in use.");
+    for (size_t i = 0; i < connections.size(); ++i) {
+      ss << "cassandra_connection_max_streams_in_use{" << labels[i] << "} "
+         << connections[i].max_streams_in_use << "\n";
+    }
+
+    write_header(ss, "cassandra_connection_read_bytes", "counter", "bytes",
+                 "Number of bytes read from the connection's socket.");
+    for (size_t i = 0; i < connections.size(); ++i) {
+      ss << "cassandra_connection_read_bytes_total{" << labels[i] << "} "
+         << connections[i].bytes_read << "\n";
+    }
+
+    write_header(ss, "cassandra_connection_written_bytes", "counter", "bytes",
+                 "Number of bytes written to the connection's socket.");
+    for (size_t i = 0; i < connections.size(); ++i) {
+      ss << "cassandra_connection_written_bytes_total{" << labels[i] << "} "
+         << connections[i].bytes_written << "\n";
+    }
+
+    write_header(ss, "cassandra_connection_pending_writes", "gauge", NULL,
+                 "Number of coalesced writes waiting to be flushed or to finish flushing.");
+    for (size_t i = 0; i < connections.size(); ++i) {
+      ss << "cassandra_connection_pending_writes{" << labels[i] << "} "
+         << connections[i].pending_writes << "\n";
+    }
+
+    write_header(ss, "cassandra_connection_write_queue_bytes", "gauge", "bytes",
+                 "Number of bytes queued because the socket isn't writable.");
+    for (size_t i = 0; i < connections.size(); ++i) {
+      ss << "cassandra_connection_write_queue_bytes{" << labels[i] << "} "
+         << connections[i].write_queue_size << "\n";
+    }
+
+    write_header(ss, "cassandra_connection_write_blocked_seconds", "counter", "seconds",
+                 "Time bytes have been queued because the socket wasn't writable.");
+    for (size_t i = 0; i < connections.size(); ++i) {
+      ss << "cassandra_connection_write_blocked_seconds_total{" << labels[i] << "} ";
+      write_seconds(ss, static_cast<int64_t>(connections[i].write_blocked_time_ns / 1000));
+      ss << "\n";
+    }
+
+    write_header(ss, "cassandra_connection_heartbeat_rtt_seconds", "gauge", "seconds",
+                 "Round trip time of the connection's last heartbeat.");
+    for (size_t i = 0; i < connections.size(); ++i) {
+      if (connections[i].heartbeat_rtt_ns > 0) {
+        ss << "cassandra_connection_heartbeat_rtt_seconds{" << labels[i] << "} ";
+        write_seconds(ss, static_cast<int64_t>(connections[i].heartbeat_rtt_ns / 1000));
+        ss << "\n";
+      }
+    }
+  }
+
+  ss << "# EOF\n";
+  return ss.str();
+}
+
+void MetricsExporter::on_connection(uv_stream_t* server, int status) {
+  MetricsExporter* self = static_cast<MetricsExporter*>(server->data);
+  if (status != 0) {
+    LOG_WARN("Metrics exporter unable to accept connection: %s", uv_strerror(status));
+    return;
+  }
+  self->handle_connection();
+}
+
+void MetricsExporter::handle_connection() {
+  Client* client = new Client(this);
+  int rc = client->init(loop());
+  if (rc != 0) {
+    LOG_WARN("Metrics exporter unable to accept connection: %s", uv_strerror(rc));
+    delete client;
+    return;
+  }
+
+  clients_.add_to_back(client);
+  rc = client->accept(reinterpret_cast<uv_stream_t*>(&server_));
+  if (rc != 0) {
+    LOG_WARN("Metrics exporter unable to accept connection: %s", uv_strerror(rc));
+    client->close();
+  }
+}
+
+void MetricsExporter::handle_stop() {
+  if (is_listening_) {
+    is_listening_ = false;
+    uv_close(reinterpret_cast<uv_handle_t*>(&server_), NULL);
+  }
+  for (List<Client>::Iterator<Client> it = clients_.iterator(); it.has_next();) {
+    it.next()->close();
+  }
+}
@@ -0,0 +1,93 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_METRICS_EXPORTER_HPP
+#define DATASTAX_INTERNAL_METRICS_EXPORTER_HPP
+
+#include "cluster.hpp"
+#include "event_loop.hpp"
+#include "list.hpp"
+#include "metrics.hpp"
+#include "string.hpp"
+
+#include <uv.h>
+
+#define CASS_METRICS_EXPORTER_PATH "/metrics"
+#define CASS_METRICS_EXPORTER_CONTENT_TYPE \
+  "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * An HTTP endpoint that serves a session's metrics in the OpenMetrics text
+ * format. It only listens on the loopback interface and runs on its own event
+ * loop thread so that scrapes don't run on the I/O threads. The metrics are
+ * read from the per-thread counters and histograms which never block the
+ * threads recording them.
+ */
+class MetricsExporter : public EventLoop {
+public:
+  /**
+   * Constructor.
+   *
+   * @param metrics The session's metrics. It must outlive the exporter.
+   * @param cluster The cluster used for per-host stats (optional).
+   */
+  MetricsExporter(Metrics* metrics, const Cluster::Ptr& cluster);
+
+  ~MetricsExporter();
+
+  /**
+   * Listen on the loopback interface and start the event loop thread.
+   *
+   * @param port The port to listen on.
+   * @return Returns 0 if successful, otherwise an error occurred.
+   */
+  int start(int port);
+
+  /**
+   * Close the listener and any open connections, then wait for the event loop
+   * thread to exit.
+   */
+  void stop();
+
+  /**
+   * Format the current metrics in the OpenMetrics text format.
+   *
+   * @return The metrics text terminated by "# EOF".
+   */
+  String scrape() const;
+
+private:
+  class Client;
+  class StopTask;
+
+  static void on_connection(uv_stream_t* server, int status);
+  void handle_connection();
+  void handle_stop();
+
+private:
+  Metrics* const metrics_;
+  const Cluster::Ptr cluster_;
+  uv_tcp_t server_;
+  bool is_listening_;
+  bool is_running_;
+  List<Client> clients_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,220 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "pager.hpp"
+
+#include "constants.hpp"
+#include "external.hpp"
+#include "result_response.hpp"
+#include "scoped_lock.hpp"
+#include "session.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassPager* cass_pager_new(CassSession* session, CassStatement* statement) {
+  Pager* pager = new Pager(session->from(), Statement::Ptr(statement->from()));
+  pager->inc_ref();
+  return CassPager::to(pager);
+}
+
+void cass_pager_free(CassPager* pager) { pager->dec_ref(); }
+
+CassError cass_pager_set_prefetch_depth(CassPager* pager, unsigned prefetch_depth) {
+  pager->set_prefetch_depth(prefetch_depth);
+  return CASS_OK;
+}
+
+CassError cass_pager_set_prefetch_max_bytes(CassPager* pager, size_t prefetch_max_bytes) {
+  pager->set_prefetch_max_bytes(prefetch_max_bytes);
+  return CASS_OK;
+}
+
+cass_bool_t cass_pager_has_more_pages(CassPager* pager) {
+  return pager->has_more_pages() ? cass_true : cass_false;
+}
+
+CassFuture* cass_pager_next_page(CassPager* pager) {
+  Future::Ptr future(pager->next_page());
+  future->inc_ref();
+  return CassFuture::to(future.get());
+}
+
+} // extern "C"
+
+Pager::Pager(Session* session, const Statement::Ptr& statement)
+    : session_(session)
+    , statement_(statement)
+    , prefetch_depth_(CASS_DEFAULT_PAGER_PREFETCH_DEPTH)
+    , prefetch_max_bytes_(CASS_DEFAULT_PAGER_PREFETCH_MAX_BYTES)
+    , is_fetching_(false)
+    , is_done_(false)
+    , buffered_bytes_(0) {
+  uv_mutex_init(&mutex_);
+}
+
+Pager::~Pager() { uv_mutex_destroy(&mutex_); }
+
+void Pager::set_prefetch_depth(unsigned prefetch_depth) {
+  ScopedMutex lock(&mutex_);
+  prefetch_depth_ = prefetch_depth;
+}
+
+void Pager::set_prefetch_max_bytes(size_t prefetch_max_bytes) {
+  ScopedMutex lock(&mutex_);
+  prefetch_max_bytes_ = prefetch_max_bytes;
+}
+
+bool Pager::has_more_pages() {
+  ScopedMutex lock(&mutex_);
+  // The page currently being fetched or the buffered pages haven't been
+  // returned yet.
+  return !is_done_ || !pages_.empty();
+}
+
+ResponseFuture::Ptr Pager::next_page() {
+  ResponseFuture::Ptr future(new ResponseFuture());
+  ResponseFuture::Ptr page;
+
+  {
+    ScopedMutex lock(&mutex_);
+    if (!pages_.empty()) {
+      page = pages_.front();
+      pages_.pop_front();
+      buffered_bytes_ -= page_size(page);
+    } else if (is_done_) {
+      lock.unlock();
+      set_no_more_pages(future);
+      return future;
+    } else {
+      waiting_.push_back(future);
+    }
+  }
+
+  // Futures are set outside of the lock because it's possible for the
+  // future's callback to reenter the pager.
+  if (page) {
+    set_page(future, page);
+  }
+
+  // Consuming a page frees up room to prefetch another.
+  maybe_fetch_next_page();
+
+  return future;
+}
+
+size_t Pager::buffered_page_count() {
+  ScopedMutex lock(&mutex_);
+  return pages_.size();
+}
+
+size_t Pager::buffered_bytes() {
+  ScopedMutex lock(&mutex_);
+  return buffered_bytes_;
+}
+
+void Pager::on_page(CassFuture* future, void* data) {
+  Pager* pager = static_cast<Pager*>(data);
+  pager->handle_page(ResponseFuture::Ptr(static_cast<ResponseFuture*>(future->from())));
+  pager->dec_ref();
+}
+
+void Pager::handle_page(const ResponseFuture::Ptr& page) {
+  ResponseFuture::Ptr future;
+  FutureDeque no_more_pages;
+
+  {
+    ScopedMutex lock(&mutex_);
+    is_fetching_ = false;
+
+    const Response::Ptr& response = page->response();
+    if (page->error() || !response || response->opcode() != CQL_OPCODE_RESULT) {
+      is_done_ = true;
+    } else {
+      ResultResponse* result = static_cast<ResultResponse*>(response.get());
+      if (result->has_more_pages()) {
+        // Only a single page request is ever in-flight so it's safe to update
+        // the statement for the next page.
+        statement_->set_paging_state(result->paging_state().to_string());
+      } else {
+        is_done_ = true;
+      }
+    }
+
+    if (!waiting_.empty()) {
+      future = waiting_.front();
+      waiting_.pop_front();
+    } else {
+      pages_.push_back(page);
+      buffered_bytes_ += page_size(page);
+    }
+
+    if (is_done_) {
+      no_more_pages.swap(waiting_);
+    }
+  }
+
+  if (future) {
+    set_page(future, page);
+  }
+
+  for (FutureDeque::iterator it = no_more_pages.begin(), end = no_more_pages.end(); it != end;
+       ++it) {
+    set_no_more_pages(*it);
+  }
+
+  maybe_fetch_next_page();
+}
+
+void Pager::maybe_fetch_next_page() {
+  {
+    ScopedMutex lock(&mutex_);
+    if (is_fetching_ || is_done_) return;
+    // Always fetch if the application is waiting on a page, otherwise only
+    // prefetch if it's within the configured bounds.
+    if (waiting_.empty() &&
+        (pages_.size() >= prefetch_depth_ || buffered_bytes_ >= prefetch_max_bytes_)) {
+      return;
+    }
+    is_fetching_ = true;
+  }
+
+  Future::Ptr future(session_->execute(Request::ConstPtr(statement_)));
+  inc_ref(); // Released in `on_page()`
+  future->set_callback(on_page, this);
+}
+
+size_t Pager::page_size(const ResponseFuture::Ptr& page) {
+  const Response::Ptr& response = page->response();
+  return response ? response->buffer_size() : 0;
+}
+
+void Pager::set_page(const ResponseFuture::Ptr& future, const ResponseFuture::Ptr& page) {
+  const Future::Error* error = page->error();
+  if (error) {
+    future->set_error_with_response(page->address(), page->response(), error->code,
+                                    error->message);
+  } else {
+    future->set_response(page->address(), page->response());
+  }
+}
+
+void Pager::set_no_more_pages(const ResponseFuture::Ptr& future) {
+  future->set_error(CASS_ERROR_LIB_NO_PAGING_STATE, "No more pages available");
+}
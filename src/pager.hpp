@@ -0,0 +1,104 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_PAGER_HPP
+#define DATASTAX_INTERNAL_PAGER_HPP
+
+#include "cassandra.h"
+#include "deque.hpp"
+#include "external.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "request_handler.hpp"
+#include "statement.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class Session;
+
+/**
+ * An automatic pager for a statement. Pages are requested sequentially using
+ * the paging state of the previous page, but the request for the next page is
+ * issued as soon as the previous page arrives (instead of when the application
+ * asks for it). The number of pages fetched ahead of the application is bounded
+ * by both a page count (prefetch depth) and the total size of the buffered
+ * response bodies (prefetch byte budget).
+ */
+class Pager : public RefCounted<Pager> {
+public:
+  typedef SharedRefPtr<Pager> Ptr;
+
+  Pager(Session* session, const Statement::Ptr& statement);
+  ~Pager();
+
+  void set_prefetch_depth(unsigned prefetch_depth);
+  void set_prefetch_max_bytes(size_t prefetch_max_bytes);
+
+  /**
+   * Determines if there are pages that haven't been returned by `next_page()`.
+   *
+   * @return true if `next_page()` will return another page.
+   */
+  bool has_more_pages();
+
+  /**
+   * Get a future for the next page. The future is set when the page is
+   * available; it might already be set if the page was prefetched.
+   *
+   * @return A response future for the next page. The future is set with the
+   * error `CASS_ERROR_LIB_NO_PAGING_STATE` if there are no more pages.
+   */
+  ResponseFuture::Ptr next_page();
+
+  // Testing only
+  size_t buffered_page_count();
+  size_t buffered_bytes();
+
+private:
+  typedef Deque<ResponseFuture::Ptr> FutureDeque;
+
+  static void on_page(CassFuture* future, void* data);
+  void handle_page(const ResponseFuture::Ptr& page);
+
+  void maybe_fetch_next_page();
+
+  static size_t page_size(const ResponseFuture::Ptr& page);
+  static void set_page(const ResponseFuture::Ptr& future, const ResponseFuture::Ptr& page);
+  static void set_no_more_pages(const ResponseFuture::Ptr& future);
+
+private:
+  uv_mutex_t mutex_;
+  Session* const session_;
+  Statement::Ptr statement_;
+  unsigned prefetch_depth_;
+  size_t prefetch_max_bytes_;
+  bool is_fetching_;
+  bool is_done_;
+  FutureDeque pages_;   // Pages that have arrived, but haven't been returned
+  FutureDeque waiting_; // Futures returned for pages that haven't arrived
+  size_t buffered_bytes_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(Pager);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::Pager, CassPager)
+
+#endif
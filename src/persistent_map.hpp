@@ -0,0 +1,302 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_PERSISTENT_MAP_HPP
+#define DATASTAX_INTERNAL_PERSISTENT_MAP_HPP
+
+#include "allocated.hpp"
+#include "copy_on_write_ptr.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <stddef.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * An ordered map with structural sharing. Copying the map is O(1) because the
+ * copy shares the same tree. The tree is an AVL tree built from
+ * `CopyOnWritePtr` nodes so modifying a copy only copies the nodes on the path
+ * to the modified entry, O(log n), and the other copies are unaffected.
+ *
+ * Iterators and pointers to values remain valid for as long as the map (or a
+ * copy of it) that they came from isn't modified.
+ */
+template <class K, class V, class Compare = std::less<K> >
+class PersistentMap : public Allocated {
+public:
+  class Node : public Allocated {
+  public:
+    typedef CopyOnWritePtr<Node> Ptr;
+
+    Node(const K& key, const V& value)
+        : first(key)
+        , second(value)
+        , height(1) {}
+
+    K first;
+    V second;
+    int height;
+    Ptr left;
+    Ptr right;
+  };
+
+  /**
+   * An in-order iterator. It dereferences to a node with `first` (the key)
+   * and `second` (the value) like a `std::map` iterator.
+   */
+  class const_iterator {
+  public:
+    const_iterator() {}
+
+    const Node& operator*() const { return *stack_.back(); }
+    const Node* operator->() const { return stack_.back(); }
+
+    const_iterator& operator++() {
+      const Node* node = stack_.back();
+      stack_.pop_back();
+      push_left(as_const(node->right));
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator temp(*this);
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      if (stack_.empty() || other.stack_.empty()) return stack_.empty() == other.stack_.empty();
+      return stack_.back() == other.stack_.back();
+    }
+
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+  private:
+    friend class PersistentMap;
+
+    void push_left(const typename Node::Ptr& node) {
+      for (const Node* n = get(node); n != NULL; n = get(n->left)) {
+        stack_.push_back(n);
+      }
+    }
+
+    Vector<const Node*> stack_;
+  };
+
+  friend class const_iterator;
+
+  typedef K key_type;
+  typedef V mapped_type;
+
+  PersistentMap(const Compare& compare = Compare())
+      : compare_(compare)
+      , size_(0) {}
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const_iterator begin() const {
+    const_iterator it;
+    it.push_left(root_);
+    return it;
+  }
+
+  const_iterator end() const { return const_iterator(); }
+
+  const_iterator find(const K& key) const {
+    const_iterator it;
+    const Node* node = get(root_);
+    while (node != NULL) {
+      if (compare_(key, node->first)) {
+        it.stack_.push_back(node); // The node comes after the found entry
+        node = get(node->left);
+      } else if (compare_(node->first, key)) {
+        node = get(node->right);
+      } else {
+        it.stack_.push_back(node);
+        return it;
+      }
+    }
+    return end();
+  }
+
+  /**
+   * Get a value that can be modified. Only the nodes on the path to the entry
+   * are copied if they're shared with other copies of the map.
+   *
+   * @param key The key of the entry.
+   * @return The value or NULL if the key doesn't exist.
+   */
+  V* find_mutable(const K& key) {
+    if (find(key) == end()) return NULL;
+    typename Node::Ptr* node = &root_;
+    while (true) {
+      const Node& current = *as_const(*node);
+      if (compare_(key, current.first)) {
+        node = &(*node)->left;
+      } else if (compare_(current.first, key)) {
+        node = &(*node)->right;
+      } else {
+        return &(*node)->second;
+      }
+    }
+  }
+
+  /**
+   * Insert or replace an entry.
+   *
+   * @return A value that can be modified.
+   */
+  V* set(const K& key, const V& value) {
+    if (insert(root_, key, value)) size_++;
+    return find_mutable(key);
+  }
+
+  V& operator[](const K& key) {
+    V* value = find_mutable(key);
+    if (value == NULL) value = set(key, V());
+    return *value;
+  }
+
+  bool erase(const K& key) {
+    if (find(key) == end()) return false;
+    remove(root_, key);
+    size_--;
+    return true;
+  }
+
+  void erase(const const_iterator& it) { erase(it->first); }
+
+  void clear() {
+    root_ = typename Node::Ptr();
+    size_ = 0;
+  }
+
+private:
+  typedef typename Node::Ptr NodePtr;
+
+  static const NodePtr& as_const(const NodePtr& node) { return node; }
+
+  static const Node* get(const NodePtr& node) { return node ? &*node : NULL; }
+
+  static int height(const NodePtr& node) { return node ? as_const(node)->height : 0; }
+
+  static int balance(const NodePtr& node) {
+    return height(as_const(node)->left) - height(as_const(node)->right);
+  }
+
+  static void update_height(NodePtr& node) {
+    node->height = 1 + std::max(height(as_const(node)->left), height(as_const(node)->right));
+  }
+
+  static void rotate_right(NodePtr& node) {
+    NodePtr left(as_const(node)->left);
+    node->left = as_const(left)->right;
+    update_height(node);
+    left->right = node;
+    update_height(left);
+    node = left;
+  }
+
+  static void rotate_left(NodePtr& node) {
+    NodePtr right(as_const(node)->right);
+    node->right = as_const(right)->left;
+    update_height(node);
+    right->left = node;
+    update_height(right);
+    node = right;
+  }
+
+  static void rebalance(NodePtr& node) {
+    update_height(node);
+    int factor = balance(node);
+    if (factor > 1) {
+      if (balance(as_const(node)->left) < 0) rotate_left(node->left);
+      rotate_right(node);
+    } else if (factor < -1) {
+      if (balance(as_const(node)->right) > 0) rotate_right(node->right);
+      rotate_left(node);
+    }
+  }
+
+  bool insert(NodePtr& node, const K& key, const V& value) {
+    if (!node) {
+      node = NodePtr(new Node(key, value));
+      return true;
+    }
+
+    bool inserted;
+    const Node& current = *as_const(node);
+    if (compare_(key, current.first)) {
+      inserted = insert(node->left, key, value);
+    } else if (compare_(current.first, key)) {
+      inserted = insert(node->right, key, value);
+    } else {
+      // Values aren't required to be assignable so the node is replaced
+      NodePtr replacement(new Node(key, value));
+      replacement->height = current.height;
+      replacement->left = current.left;
+      replacement->right = current.right;
+      node = replacement;
+      return false;
+    }
+
+    if (inserted) rebalance(node);
+    return inserted;
+  }
+
+  void remove(NodePtr& node, const K& key) {
+    const Node& current = *as_const(node);
+    if (compare_(key, current.first)) {
+      remove(node->left, key);
+    } else if (compare_(current.first, key)) {
+      remove(node->right, key);
+    } else if (!current.left || !current.right) {
+      NodePtr child(current.left ? current.left : current.right);
+      node = child;
+      return;
+    } else {
+      NodePtr min;
+      remove_min(node->right, &min);
+      min->left = as_const(node)->left;
+      min->right = as_const(node)->right;
+      node = min;
+    }
+    rebalance(node);
+  }
+
+  static void remove_min(NodePtr& node, NodePtr* min) {
+    if (!as_const(node)->left) {
+      *min = node;
+      NodePtr right(as_const(node)->right);
+      node = right;
+      return;
+    }
+    remove_min(node->left, min);
+    rebalance(node);
+  }
+
+private:
+  Compare compare_;
+  NodePtr root_;
+  size_t size_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
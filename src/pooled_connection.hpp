@@ -82,6 +82,8 @@ public:
 public:
   const String& keyspace() const { return connection_->keyspace(); } // Test only
 
+  const Connection* connection() const { return connection_.get(); }
+
 private:
   virtual void on_read();
   virtual void on_write();
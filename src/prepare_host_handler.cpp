@@ -16,6 +16,7 @@
 
 #include "prepare_host_handler.hpp"
 
+#include "map.hpp"
 #include "prepare_request.hpp"
 #include "protocol.hpp"
 #include "query_request.hpp"
@@ -24,42 +25,90 @@
 #include <algorithm>
 
 using namespace datastax;
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
-struct CompareEntryKeyspace {
-  bool operator()(const PreparedMetadata::Entry::Ptr& lhs,
-                  const PreparedMetadata::Entry::Ptr& rhs) const {
-    return lhs->keyspace() < rhs->keyspace();
+// The last used times are copied before sorting because they can be updated
+// concurrently by requests.
+struct EntryOrder {
+  EntryOrder(const PreparedMetadata::Entry::Ptr& entry, uint64_t keyspace_last_used_ns)
+      : entry(entry)
+      , last_used_ns(entry->last_used_ns())
+      , keyspace_last_used_ns(keyspace_last_used_ns) {}
+
+  bool operator<(const EntryOrder& other) const {
+    if (keyspace_last_used_ns != other.keyspace_last_used_ns) {
+      return keyspace_last_used_ns > other.keyspace_last_used_ns;
+    }
+    if (entry->keyspace() != other.entry->keyspace()) {
+      return entry->keyspace() < other.entry->keyspace();
+    }
+    return last_used_ns > other.last_used_ns;
   }
+
+  PreparedMetadata::Entry::Ptr entry;
+  uint64_t last_used_ns;
+  uint64_t keyspace_last_used_ns;
 };
 
 PrepareHostHandler::PrepareHostHandler(
     const Host::Ptr& host, const PreparedMetadata::Entry::Vec& prepared_metadata_entries,
-    const Callback& callback, ProtocolVersion protocol_version, unsigned max_requests_per_flush)
+    const Callback& callback, ProtocolVersion protocol_version, unsigned max_prepares_outstanding,
+    uint64_t timeout_ms)
     : host_(host)
     , protocol_version_(protocol_version)
     , callback_(callback)
+    , is_finished_(false)
+    , timeout_ms_(timeout_ms)
     , connection_(NULL)
     , prepares_outstanding_(0)
-    , max_prepares_outstanding_(CASS_MAX_STREAMS)
-    , prepared_metadata_entries_(prepared_metadata_entries) {
+    , max_prepares_outstanding_(
+          std::max(1, std::min(static_cast<int>(max_prepares_outstanding), CASS_MAX_STREAMS))) {
+  // Prepare the most recently used statements first. If the keyspace has to be
+  // set on the connection then statements are grouped by keyspace, ordered by
+  // each keyspace's most recently used statement, to minimize the number of
+  // times the keyspace needs to be changed.
+  Map<String, uint64_t> keyspace_last_used_ns;
+  bool group_by_keyspace = !protocol_version_.supports_set_keyspace();
+  if (group_by_keyspace) {
+    for (PreparedMetadata::Entry::Vec::const_iterator it = prepared_metadata_entries.begin(),
+                                                      end = prepared_metadata_entries.end();
+         it != end; ++it) {
+      uint64_t& last_used_ns = keyspace_last_used_ns[(*it)->keyspace()];
+      last_used_ns = std::max(last_used_ns, (*it)->last_used_ns());
+    }
+  }
+
+  Vector<EntryOrder> order;
+  order.reserve(prepared_metadata_entries.size());
+  for (PreparedMetadata::Entry::Vec::const_iterator it = prepared_metadata_entries.begin(),
+                                                    end = prepared_metadata_entries.end();
+       it != end; ++it) {
+    uint64_t keyspace_last_used = group_by_keyspace ? keyspace_last_used_ns[(*it)->keyspace()] : 0;
+    order.push_back(EntryOrder(*it, keyspace_last_used));
+  }
+  std::sort(order.begin(), order.end());
 
-  // Sort by keyspace to minimize the number of times the keyspace
-  // needs to be changed.
-  std::sort(prepared_metadata_entries_.begin(), prepared_metadata_entries_.end(),
-            CompareEntryKeyspace());
+  prepared_metadata_entries_.reserve(order.size());
+  for (Vector<EntryOrder>::const_iterator it = order.begin(), end = order.end(); it != end; ++it) {
+    prepared_metadata_entries_.push_back(it->entry);
+  }
 
   current_entry_it_ = prepared_metadata_entries_.begin();
 }
 
 void PrepareHostHandler::prepare(uv_loop_t* loop, const ConnectionSettings& settings) {
   if (prepared_metadata_entries_.empty()) {
-    callback_(this);
+    finish();
     return;
   }
 
   inc_ref(); // Reference for the event loop
 
+  if (timeout_ms_ > 0) {
+    timer_.start(loop, timeout_ms_, bind_callback(&PrepareHostHandler::on_timeout, this));
+  }
+
   Connector::Ptr connector(new Connector(host_, protocol_version_,
                                          bind_callback(&PrepareHostHandler::on_connect, this)));
 
@@ -67,7 +116,7 @@ void PrepareHostHandler::prepare(uv_loop_t* loop, const ConnectionSettings& sett
 }
 
 void PrepareHostHandler::on_close(Connection* connection) {
-  callback_(this);
+  finish();
 
   dec_ref(); // The event loop is done with this handler
 }
@@ -77,34 +126,39 @@ void PrepareHostHandler::on_connect(Connector* connector) {
     connection_ = connector->release_connection().get();
     prepare_next();
   } else {
-    callback_(this);
+    finish();
     dec_ref(); // The event loop is done with this handler
   }
 }
 
-// This is the main loop for preparing statements. It's called after each
-// request successfully completes, either setting the keyspace or preparing
-// a statement. It attempts to group prepare requests into a single batch as
-// long as the keyspace is the same and the number of outstanding requests is
-// under the maximum.
-void PrepareHostHandler::prepare_next() {
-  // Finish current prepares before continuing
-  if (--prepares_outstanding_ > 0) {
-    return;
-  }
+void PrepareHostHandler::on_timeout(Timer* timer) {
+  LOG_INFO("Preparing all queries on host %s is taking longer than %llu ms. The host is now "
+           "available and the remaining queries will be prepared in the background",
+           host_->address_string().c_str(), static_cast<unsigned long long>(timeout_ms_));
+  finish();
+}
 
+// This is the main loop for preparing statements. It's called after the
+// connection is established and after each request successfully completes,
+// either setting the keyspace or preparing a statement. It keeps up to the
+// maximum number of prepare requests outstanding as long as the keyspace is
+// the same.
+void PrepareHostHandler::prepare_next() {
   // Check to see if we're done
   if (is_done()) {
-    close();
+    // Wait for the outstanding prepares to finish before closing
+    if (prepares_outstanding_ == 0) {
+      close();
+    }
     return;
   }
 
-  prepares_outstanding_ = 0;
+  bool is_flush_needed = false;
 
   // Write prepare requests until there's no more left, the keyspace changes,
   // or the maximum number of outstanding prepares is reached.
-  while (!is_done() && check_and_set_keyspace() &&
-         prepares_outstanding_ < max_prepares_outstanding_) {
+  while (!is_done() && prepares_outstanding_ < max_prepares_outstanding_ &&
+         check_and_set_keyspace()) {
     const String& query((*current_entry_it_)->query());
     PrepareRequest::Ptr prepare_request(new PrepareRequest(query));
 
@@ -121,9 +175,17 @@ void PrepareHostHandler::prepare_next() {
 
     prepares_outstanding_++;
     current_entry_it_++;
+    is_flush_needed = true;
   }
 
-  connection_->flush();
+  if (is_flush_needed) {
+    connection_->flush();
+  }
+}
+
+void PrepareHostHandler::on_request_done() {
+  prepares_outstanding_--;
+  prepare_next();
 }
 
 bool PrepareHostHandler::check_and_set_keyspace() {
@@ -134,6 +196,11 @@ bool PrepareHostHandler::check_and_set_keyspace() {
   const String& keyspace((*current_entry_it_)->keyspace());
 
   if (keyspace != current_keyspace_) {
+    // The keyspace is changed once the outstanding prepares have finished
+    if (prepares_outstanding_ > 0) {
+      return false;
+    }
+
     PrepareCallback::Ptr callback(new SetKeyspaceCallback(keyspace, Ptr(this)));
     if (connection_->write_and_flush(callback) < 0) {
       LOG_WARN("Failed to write \"USE\" keyspace request while preparing all queries on host %s",
@@ -141,6 +208,7 @@ bool PrepareHostHandler::check_and_set_keyspace() {
       close();
       return false;
     }
+    prepares_outstanding_++;
     current_keyspace_ = keyspace;
     return false;
   }
@@ -154,6 +222,14 @@ bool PrepareHostHandler::is_done() const {
 
 void PrepareHostHandler::close() { connection_->close(); }
 
+void PrepareHostHandler::finish() {
+  timer_.stop();
+  if (!is_finished_) {
+    is_finished_ = true;
+    callback_(this);
+  }
+}
+
 PrepareHostHandler::PrepareCallback::PrepareCallback(
     const PrepareRequest::ConstPtr& prepare_request, const PrepareHostHandler::Ptr& handler)
     : SimpleRequestCallback(prepare_request)
@@ -163,7 +239,7 @@ void PrepareHostHandler::PrepareCallback::on_internal_set(ResponseMessage* respo
   LOG_DEBUG("Successfully prepared query \"%s\" on host %s while preparing all queries",
             static_cast<const PrepareRequest*>(request())->query().c_str(),
             handler_->host()->address_string().c_str());
-  handler_->prepare_next();
+  handler_->on_request_done();
 }
 
 void PrepareHostHandler::PrepareCallback::on_internal_error(CassError code, const String& message) {
@@ -186,7 +262,7 @@ PrepareHostHandler::SetKeyspaceCallback::SetKeyspaceCallback(const String& keysp
 void PrepareHostHandler::SetKeyspaceCallback::on_internal_set(ResponseMessage* response) {
   LOG_TRACE("Successfully set keyspace to \"%s\" on host %s while preparing all queries",
             handler_->current_keyspace_.c_str(), handler_->host()->address_string().c_str());
-  handler_->prepare_next();
+  handler_->on_request_done();
 }
 
 void PrepareHostHandler::SetKeyspaceCallback::on_internal_error(CassError code,
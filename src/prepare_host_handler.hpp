@@ -23,13 +23,18 @@
 #include "prepared.hpp"
 #include "ref_counted.hpp"
 #include "string.hpp"
+#include "timer.hpp"
 
 namespace datastax { namespace internal { namespace core {
 
 class Connector;
 
 /**
- * A handler for pre-preparing statements on a newly available host.
+ * A handler for pre-preparing statements on a newly available host. The most
+ * recently used statements are prepared first, and up to a window of prepare
+ * requests are kept outstanding on the connection. If a deadline is set then
+ * the callback is called when it expires and the remaining statements are
+ * prepared in the background.
  */
 class PrepareHostHandler
     : public RefCounted<PrepareHostHandler>
@@ -42,7 +47,7 @@ public:
   PrepareHostHandler(const Host::Ptr& host,
                      const PreparedMetadata::Entry::Vec& prepared_metadata_entries,
                      const Callback& callback, ProtocolVersion protocol_version,
-                     unsigned max_requests_per_flush);
+                     unsigned max_prepares_outstanding, uint64_t timeout_ms = 0);
 
   const Host::Ptr host() const { return host_; }
 
@@ -52,6 +57,7 @@ private:
   virtual void on_close(Connection* connection);
 
   void on_connect(Connector* connector);
+  void on_timeout(Timer* timer);
 
 private:
   /**
@@ -98,6 +104,9 @@ private:
   // This is the main method for iterating over the list of prepared statements
   void prepare_next();
 
+  // Called when a prepare or "USE" keyspace request finishes successfully
+  void on_request_done();
+
   // Returns true if the keyspace is current or using protocol v5/DSEv2
   bool check_and_set_keyspace();
 
@@ -105,10 +114,16 @@ private:
 
   void close();
 
+  // Calls the callback if it hasn't already been called
+  void finish();
+
 private:
   const Host::Ptr host_;
   const ProtocolVersion protocol_version_;
   Callback callback_;
+  bool is_finished_;
+  const uint64_t timeout_ms_;
+  Timer timer_;
   Connection* connection_;
   String current_keyspace_;
   int prepares_outstanding_;
@@ -19,6 +19,9 @@
 #include "execute_request.hpp"
 #include "external.hpp"
 #include "logger.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
 
 using namespace datastax;
 using namespace datastax::internal;
@@ -79,6 +82,7 @@ Prepared::Prepared(const ResultResponse::Ptr& result,
                    const Metadata::SchemaSnapshot& schema_metadata)
     : result_(result)
     , id_(result->prepared_id().to_string())
+    , id_hash_(PreparedMetadata::hash_id(id_))
     , query_(prepare_request->query())
     , keyspace_(prepare_request->keyspace())
     , request_settings_(prepare_request->settings()) {
@@ -109,3 +113,155 @@ Prepared::Prepared(const ResultResponse::Ptr& result,
     }
   }
 }
+
+PreparedMetadata::PreparedMetadata()
+    : version_(0)
+    , snapshot_(new Snapshot(0)) {
+  uv_mutex_init(&mutex_);
+  is_thread_snapshot_key_valid_ = uv_key_create(&thread_snapshot_key_) == 0;
+}
+
+PreparedMetadata::~PreparedMetadata() {
+  for (ThreadSnapshotVec::iterator it = thread_snapshots_.begin(), end = thread_snapshots_.end();
+       it != end; ++it) {
+    delete *it;
+  }
+  if (is_thread_snapshot_key_valid_) {
+    uv_key_delete(&thread_snapshot_key_);
+  }
+  uv_mutex_destroy(&mutex_);
+}
+
+PreparedMetadata::Entry::Ptr PreparedMetadata::get(const String& prepared_id,
+                                                   uint64_t id_hash) const {
+  if (!is_thread_snapshot_key_valid_) {
+    // Without thread-local storage fall back to looking up the shared snapshot
+    Snapshot::ConstPtr snapshot;
+    {
+      ScopedMutex l(&mutex_);
+      snapshot = snapshot_;
+    }
+    const Entry::Ptr* entry = snapshot->find(prepared_id, id_hash);
+    return entry != NULL ? *entry : Entry::Ptr();
+  }
+
+  ThreadSnapshot* thread_snapshot = static_cast<ThreadSnapshot*>(uv_key_get(&thread_snapshot_key_));
+  if (thread_snapshot == NULL) {
+    thread_snapshot = create_thread_snapshot();
+  }
+
+  // This has to be visible before the version is checked so that set() either
+  // sees the thread is active or the thread sees its snapshot was released.
+  thread_snapshot->is_active.store(true);
+  if (thread_snapshot->version.load() != version_.load(MEMORY_ORDER_ACQUIRE)) {
+    refresh_thread_snapshot(thread_snapshot);
+  }
+  const Entry::Ptr* entry = thread_snapshot->snapshot->find(prepared_id, id_hash);
+  Entry::Ptr result(entry != NULL ? *entry : Entry::Ptr());
+  thread_snapshot->is_active.store(false, MEMORY_ORDER_RELEASE);
+  return result;
+}
+
+void PreparedMetadata::set(const String& prepared_id, const PreparedMetadata::Entry::Ptr& entry) {
+  ScopedMutex l(&mutex_);
+  snapshot_ = Snapshot::ConstPtr(snapshot_->copy_and_set(prepared_id, hash_id(prepared_id), entry));
+  version_.store(version_.load(MEMORY_ORDER_RELAXED) + 1, MEMORY_ORDER_RELEASE);
+  release_thread_snapshots();
+}
+
+PreparedMetadata::Entry::Vec PreparedMetadata::copy() const {
+  Snapshot::ConstPtr snapshot;
+  {
+    ScopedMutex l(&mutex_);
+    snapshot = snapshot_;
+  }
+  Entry::Vec temp;
+  temp.reserve(snapshot->count());
+  for (Snapshot::NodeVec::const_iterator it = snapshot->nodes().begin(),
+                                         end = snapshot->nodes().end();
+       it != end; ++it) {
+    if (it->entry) {
+      temp.push_back(it->entry);
+    }
+  }
+  return temp;
+}
+
+PreparedMetadata::ThreadSnapshot* PreparedMetadata::create_thread_snapshot() const {
+  ThreadSnapshot* thread_snapshot = new ThreadSnapshot();
+  uv_key_set(&thread_snapshot_key_, thread_snapshot);
+  ScopedMutex l(&mutex_);
+  thread_snapshot->version.store(version_.load(MEMORY_ORDER_RELAXED), MEMORY_ORDER_RELAXED);
+  thread_snapshot->snapshot = snapshot_;
+  thread_snapshots_.push_back(thread_snapshot);
+  return thread_snapshot;
+}
+
+// Threads only take the lock the first time they look up an entry and after
+// entries have changed.
+void PreparedMetadata::refresh_thread_snapshot(ThreadSnapshot* thread_snapshot) const {
+  ScopedMutex l(&mutex_);
+  thread_snapshot->version.store(version_.load(MEMORY_ORDER_RELAXED), MEMORY_ORDER_RELAXED);
+  thread_snapshot->snapshot = snapshot_;
+}
+
+// The version is reset before checking whether the thread is active so that a
+// thread that starts a lookup concurrently refreshes its snapshot (under the
+// lock) instead of using the released one. Versions start at zero and are
+// incremented before this is called so a reset version never matches.
+void PreparedMetadata::release_thread_snapshots() {
+  for (ThreadSnapshotVec::iterator it = thread_snapshots_.begin(), end = thread_snapshots_.end();
+       it != end; ++it) {
+    ThreadSnapshot* thread_snapshot = *it;
+    thread_snapshot->version.store(0);
+    if (!thread_snapshot->is_active.load()) {
+      thread_snapshot->snapshot.reset();
+    }
+  }
+}
+
+PreparedMetadata::Snapshot::Snapshot(size_t count)
+    : count_(0)
+    , mask_(next_pow_2(std::max(2 * count, static_cast<size_t>(16))) - 1)
+    , nodes_(mask_ + 1) {}
+
+const PreparedMetadata::Entry::Ptr* PreparedMetadata::Snapshot::find(const String& prepared_id,
+                                                                     uint64_t id_hash) const {
+  // The table is never more than half full so there's always an empty node to
+  // end the probe.
+  for (size_t i = static_cast<size_t>(id_hash) & mask_;; i = (i + 1) & mask_) {
+    const Node& node = nodes_[i];
+    if (!node.entry) {
+      return NULL;
+    }
+    if (node.hash == id_hash && node.id == prepared_id) {
+      return &node.entry;
+    }
+  }
+}
+
+PreparedMetadata::Snapshot*
+PreparedMetadata::Snapshot::copy_and_set(const String& prepared_id, uint64_t id_hash,
+                                         const Entry::Ptr& entry) const {
+  Snapshot* snapshot = new Snapshot(count_ + 1);
+  for (NodeVec::const_iterator it = nodes_.begin(), end = nodes_.end(); it != end; ++it) {
+    if (it->entry && !(it->hash == id_hash && it->id == prepared_id)) {
+      snapshot->insert(it->id, it->hash, it->entry);
+    }
+  }
+  snapshot->insert(prepared_id, id_hash, entry);
+  return snapshot;
+}
+
+void PreparedMetadata::Snapshot::insert(const String& prepared_id, uint64_t id_hash,
+                                        const Entry::Ptr& entry) {
+  size_t i = static_cast<size_t>(id_hash) & mask_;
+  while (nodes_[i].entry) {
+    i = (i + 1) & mask_;
+  }
+  Node& node = nodes_[i];
+  node.hash = id_hash;
+  node.id = prepared_id;
+  node.entry = entry;
+  count_++;
+}
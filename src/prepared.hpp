@@ -17,9 +17,10 @@
 #ifndef DATASTAX_INTERNAL_PREPARED_HPP
 #define DATASTAX_INTERNAL_PREPARED_HPP
 
+#include "atomic.hpp"
 #include "buffer.hpp"
-#include "dense_hash_map.hpp"
 #include "external.hpp"
+#include "hash.hpp"
 #include "metadata.hpp"
 #include "prepare_request.hpp"
 #include "ref_counted.hpp"
@@ -42,6 +43,7 @@ public:
 
   const ResultResponse::ConstPtr& result() const { return result_; }
   const String& id() const { return id_; }
+  uint64_t id_hash() const { return id_hash_; }
   const String& query() const { return query_; }
   const String& keyspace() const { return keyspace_; }
   const RequestSettings& request_settings() const { return request_settings_; }
@@ -50,6 +52,7 @@ public:
 private:
   ResultResponse::ConstPtr result_;
   String id_;
+  uint64_t id_hash_;
   String query_;
   String keyspace_;
   RequestSettings request_settings_;
@@ -68,7 +71,8 @@ public:
         : query_(query)
         , keyspace_(keyspace)
         , result_metadata_id_(sizeof(uint16_t) + result_metadata_id.size())
-        , result_(result) {
+        , result_(result)
+        , last_used_ns_(uv_hrtime()) {
       result_metadata_id_.encode_string(0, result_metadata_id.data(),
                                         static_cast<uint16_t>(result_metadata_id.size()));
     }
@@ -78,49 +82,131 @@ public:
     const Buffer& result_metadata_id() const { return result_metadata_id_; }
     const ResultResponse::ConstPtr& result() const { return result_; }
 
+    /**
+     * The last time the statement was prepared or executed. Statements are
+     * re-prepared on hosts that come up in most recently used order. The
+     * shared timestamp is written at most once a millisecond.
+     */
+    uint64_t last_used_ns() const { return last_used_ns_.load(MEMORY_ORDER_RELAXED); }
+    void mark_used() const {
+      // Avoid writing to the shared entry on every execution of a hot statement
+      uint64_t now = uv_hrtime();
+      if (now - last_used_ns_.load(MEMORY_ORDER_RELAXED) > MARK_USED_GRANULARITY_NS) {
+        last_used_ns_.store(now, MEMORY_ORDER_RELAXED);
+      }
+    }
+
   private:
+    static const uint64_t MARK_USED_GRANULARITY_NS = 1000000; // 1 millisecond
+
     String query_;
     String keyspace_;
     Buffer result_metadata_id_;
     ResultResponse::ConstPtr result_;
+    mutable Atomic<uint64_t> last_used_ns_;
   };
 
-  PreparedMetadata() {
-    metadata_.set_empty_key(String());
-    uv_rwlock_init(&rwlock_);
+  static uint64_t hash_id(const String& prepared_id) {
+    return hash::fnv1a(prepared_id.data(), prepared_id.size());
   }
 
-  ~PreparedMetadata() { uv_rwlock_destroy(&rwlock_); }
+  PreparedMetadata();
+  ~PreparedMetadata();
 
-  Entry::Ptr get(const String& prepared_id) const {
-    ScopedReadLock rl(&rwlock_);
-    Map::const_iterator i = metadata_.find(prepared_id);
-    if (i != metadata_.end()) {
-      return i->second;
-    }
-    return Entry::Ptr();
-  }
+  Entry::Ptr get(const String& prepared_id) const { return get(prepared_id, hash_id(prepared_id)); }
 
-  void set(const String& prepared_id, const PreparedMetadata::Entry::Ptr& entry) {
-    ScopedWriteLock wl(&rwlock_);
-    metadata_[prepared_id] = entry;
-  }
+  /**
+   * Get the entry for a prepared ID using its precomputed hash. The lookup
+   * doesn't lock unless the entries have changed since the calling thread's
+   * last lookup. The only shared write is the reference taken on the returned
+   * entry.
+   *
+   * @param prepared_id A prepared ID.
+   * @param id_hash The hash of the prepared ID.
+   * @return The entry or a null object pointer if it doesn't exist.
+   *
+   * @see hash_id()
+   */
+  Entry::Ptr get(const String& prepared_id, uint64_t id_hash) const;
 
-  Entry::Vec copy() const {
-    ScopedReadLock rl(&rwlock_);
-    Entry::Vec temp;
-    temp.reserve(metadata_.size());
-    for (Map::const_iterator it = metadata_.begin(), end = metadata_.end(); it != end; ++it) {
-      temp.push_back(it->second);
-    }
-    return temp;
-  }
+  void set(const String& prepared_id, const PreparedMetadata::Entry::Ptr& entry);
+
+  Entry::Vec copy() const;
 
 private:
-  typedef DenseHashMap<String, Entry::Ptr> Map;
+  /**
+   * An immutable open addressing hash table of the entries. A new snapshot is
+   * built every time an entry is set.
+   */
+  class Snapshot : public RefCounted<Snapshot> {
+  public:
+    typedef SharedRefPtr<const Snapshot> ConstPtr;
+
+    struct Node {
+      Node()
+          : hash(0) {}
+
+      uint64_t hash;
+      String id;
+      Entry::Ptr entry;
+    };
+
+    typedef Vector<Node> NodeVec;
+
+    Snapshot(size_t count);
 
-  mutable uv_rwlock_t rwlock_;
-  Map metadata_;
+    size_t count() const { return count_; }
+    const NodeVec& nodes() const { return nodes_; }
+
+    const Entry::Ptr* find(const String& prepared_id, uint64_t id_hash) const;
+
+    // Returns a copy of this snapshot with the entry added or replaced
+    Snapshot* copy_and_set(const String& prepared_id, uint64_t id_hash,
+                           const Entry::Ptr& entry) const;
+
+  private:
+    void insert(const String& prepared_id, uint64_t id_hash, const Entry::Ptr& entry);
+
+  private:
+    size_t count_;
+    size_t mask_;
+    NodeVec nodes_;
+  };
+
+  /**
+   * A thread's cached reference to the current snapshot. These are owned by the
+   * prepared metadata object and are only used by their own thread, except
+   * that set() releases the snapshots of threads that aren't doing a lookup.
+   * This keeps idle (or exited) threads from holding on to replaced entries.
+   *
+   * There's one of these for every thread that has ever done a lookup and they
+   * are only freed with the prepared metadata. A thread's exit can't be
+   * detected so these aren't pruned, but once released an exited thread's
+   * entry is only a flag and a version number.
+   */
+  struct ThreadSnapshot {
+    ThreadSnapshot()
+        : is_active(false)
+        , version(0) {}
+
+    Atomic<bool> is_active; // The thread is using the snapshot
+    Atomic<uint64_t> version;
+    Snapshot::ConstPtr snapshot;
+  };
+
+  typedef Vector<ThreadSnapshot*> ThreadSnapshotVec;
+
+  ThreadSnapshot* create_thread_snapshot() const;
+  void refresh_thread_snapshot(ThreadSnapshot* thread_snapshot) const;
+  void release_thread_snapshots();
+
+private:
+  mutable uv_mutex_t mutex_;
+  mutable uv_key_t thread_snapshot_key_;
+  bool is_thread_snapshot_key_valid_;
+  mutable ThreadSnapshotVec thread_snapshots_;
+  Atomic<uint64_t> version_;
+  Snapshot::ConstPtr snapshot_;
 };
 
 }}} // namespace datastax::internal::core
@@ -52,8 +52,23 @@ Random::Random()
 Random::~Random() { uv_mutex_destroy(&mutex_); }
 
 uint64_t Random::next(uint64_t max) {
+  if (thread_rngs_.is_valid()) {
+    ThreadRng* thread_rng = thread_rngs_.get();
+    if (thread_rng == NULL) {
+      thread_rng = new ThreadRng();
+      thread_rngs_.set(thread_rng);
+    }
+    return next(thread_rng->rng, max);
+  }
+
   ScopedMutex l(&mutex_);
+  return next(rng_, max);
+}
+
+Random::ThreadRng::ThreadRng()
+    : rng(get_random_seed(uv_hrtime())) {}
 
+uint64_t Random::next(MT19937_64& rng, uint64_t max) {
   if (max == 0) {
     return 0;
   }
@@ -61,7 +76,7 @@ uint64_t Random::next(uint64_t max) {
   const uint64_t limit = CASS_UINT64_MAX - CASS_UINT64_MAX % max;
   uint64_t r;
   do {
-    r = rng_();
+    r = rng();
   } while (r >= limit);
   return r % max;
 }
@@ -18,6 +18,7 @@
 #define DATASTAX_INTERNAL_RANDOM_HPP
 
 #include "allocated.hpp"
+#include "thread_local.hpp"
 #include "third_party/mt19937_64/mt19937_64.hpp"
 
 #include <algorithm>
@@ -32,9 +33,20 @@ public:
 
   uint64_t next(uint64_t max);
 
+private:
+  struct ThreadRng : public Allocated {
+    ThreadRng();
+    MT19937_64 rng;
+  };
+
+  static uint64_t next(MT19937_64& rng, uint64_t max);
+
 private:
   uv_mutex_t mutex_;
   MT19937_64 rng_;
+  // Each thread gets its own generator so that `next()` doesn't contend on
+  // `mutex_`. The shared generator is only used if a key couldn't be created.
+  ThreadLocal<ThreadRng> thread_rngs_;
 };
 
 uint64_t get_random_seed(uint64_t seed);
@@ -167,13 +167,16 @@ public:
 
   void set_execution_profile_name(const String& name) { profile_name_ = name; }
 
-  int32_t encode_custom_payload(BufferVec* bufs) const {
+  // The extra item is an encoded item that is only sent with a single
+  // execution of the request e.g. trace context.
+  int32_t encode_custom_payload(BufferVec* bufs, const Buffer* extra_item = NULL) const {
     int32_t length = sizeof(uint16_t);
     uint16_t count = 0;
 
     Buffer buf(sizeof(uint16_t));
     count += custom_payload_ ? custom_payload_->size() : 0;
     count += custom_payload_extra_.size();
+    count += extra_item ? 1 : 0;
     buf.encode_uint16(0, count);
     bufs->push_back(buf);
 
@@ -181,6 +184,10 @@ public:
       length += custom_payload_->encode(bufs);
     }
     length += custom_payload_extra_.encode(bufs);
+    if (extra_item) {
+      length += extra_item->size();
+      bufs->push_back(*extra_item);
+    }
     return length;
   }
 
@@ -24,6 +24,7 @@
 #include "metrics.hpp"
 #include "query_request.hpp"
 #include "request.hpp"
+#include "request_tracer.hpp"
 #include "result_response.hpp"
 #include "serialization.hpp"
 
@@ -49,10 +50,24 @@ void RequestCallback::notify_write(Connection* connection, int stream) {
   on_write(connection);
 }
 
+void RequestCallback::set_trace_context(const char* context, size_t context_length) {
+  if (context_length == 0) {
+    trace_context_ = Buffer();
+    return;
+  }
+  const size_t name_length = sizeof(CASS_TRACER_CONTEXT_PAYLOAD_NAME) - 1;
+  Buffer buf(sizeof(uint16_t) + name_length + sizeof(int32_t) + context_length);
+  size_t pos = buf.encode_string(0, CASS_TRACER_CONTEXT_PAYLOAD_NAME, name_length);
+  buf.encode_bytes(pos, context, context_length);
+  trace_context_ = buf;
+}
+
 bool RequestCallback::skip_metadata() const {
-  // Skip the metadata if this an execute request and we have an entry cached
+  // Skip the metadata if this an execute request and we have an entry cached. Streamed
+  // rows are decoded as they arrive so they always need the metadata from the response.
   return request()->opcode() == CQL_OPCODE_EXECUTE && prepared_metadata_entry() &&
-         prepared_metadata_entry()->result()->result_metadata();
+         prepared_metadata_entry()->result()->result_metadata() &&
+         !Statement::has_row_callback(request());
 }
 
 int32_t RequestCallback::encode(BufferVec* bufs) {
@@ -73,9 +88,10 @@ int32_t RequestCallback::encode(BufferVec* bufs) {
     flags |= CASS_FLAG_BETA;
   }
 
-  if (version >= CASS_PROTOCOL_VERSION_V4 && req->has_custom_payload()) {
+  const bool has_trace_context = trace_context_.size() > 0;
+  if (version >= CASS_PROTOCOL_VERSION_V4 && (req->has_custom_payload() || has_trace_context)) {
     flags |= CASS_FLAG_CUSTOM_PAYLOAD;
-    length += req->encode_custom_payload(bufs);
+    length += req->encode_custom_payload(bufs, has_trace_context ? &trace_context_ : NULL);
   }
 
   int32_t result = req->encode(version, this, bufs);
@@ -95,7 +111,8 @@ int32_t RequestCallback::encode(BufferVec* bufs) {
   buf.encode_int32(pos, length);
   (*bufs)[index] = buf;
 
-  return length + header_size;
+  encoded_size_ = length + header_size;
+  return encoded_size_;
 }
 
 void RequestCallback::on_close() {
@@ -114,7 +131,9 @@ void RequestCallback::on_close() {
     case RequestCallback::REQUEST_STATE_WRITING:
     case RequestCallback::REQUEST_STATE_READING:
       set_state(RequestCallback::REQUEST_STATE_FINISHED);
-      if (request()->is_idempotent()) {
+      // Rows might have already been passed to the row callback so a streamed
+      // request can't be retried.
+      if (request()->is_idempotent() && !is_streaming_rows_) {
         on_retry_next_host();
       } else {
         on_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
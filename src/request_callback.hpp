@@ -61,7 +61,8 @@ public:
       , consistency_(CASS_DEFAULT_CONSISTENCY)
       , serial_consistency_(CASS_DEFAULT_SERIAL_CONSISTENCY)
       , request_timeout_ms_(request_timeout_ms)
-      , timestamp_(CASS_INT64_MIN) {}
+      , timestamp_(CASS_INT64_MIN)
+      , trace_id_(0) {}
 
   void set_prepared_metadata(const PreparedMetadata::Entry::Ptr& entry);
 
@@ -108,6 +109,14 @@ public:
     return prepared_metadata_entry_;
   }
 
+  /**
+   * A non-zero ID if the request's trace messages are logged.
+   *
+   * @see Logger::sample_trace_id()
+   */
+  uint64_t trace_id() const { return trace_id_; }
+  void set_trace_id(uint64_t trace_id) { trace_id_ = trace_id; }
+
 private:
   Request::ConstPtr request_;
   CassConsistency consistency_;
@@ -116,6 +125,7 @@ private:
   int64_t timestamp_;
   RetryPolicy::Ptr retry_policy_;
   PreparedMetadata::Entry::Ptr prepared_metadata_entry_;
+  uint64_t trace_id_;
 };
 
 class RequestCallback
@@ -137,7 +147,10 @@ public:
       : wrapper_(wrapper)
       , stream_(-1)
       , state_(REQUEST_STATE_NEW)
-      , retry_consistency_(CASS_CONSISTENCY_UNKNOWN) {}
+      , retry_consistency_(CASS_CONSISTENCY_UNKNOWN)
+      , is_streaming_rows_(false)
+      , write_time_ns_(0)
+      , encoded_size_(0) {}
 
   virtual ~RequestCallback() {}
 
@@ -182,6 +195,8 @@ public:
     return wrapper_.prepared_metadata_entry();
   }
 
+  uint64_t trace_id() const { return wrapper_.trace_id(); }
+
   void set_retry_consistency(CassConsistency cl) { retry_consistency_ = cl; }
 
   int stream() const { return stream_; }
@@ -189,6 +204,19 @@ public:
   State state() const { return state_; }
   void set_state(State next_state);
 
+  bool is_streaming_rows() const { return is_streaming_rows_; }
+  void set_is_streaming_rows() { is_streaming_rows_ = true; }
+
+  // Trace context sent in the custom payload of the next write
+  void set_trace_context(const char* context, size_t context_length);
+
+  // The size of the request the last time it was encoded
+  int32_t encoded_size() const { return encoded_size_; }
+
+  // The time the request was last written to a socket
+  uint64_t write_time_ns() const { return write_time_ns_; }
+  void set_write_time_ns(uint64_t write_time_ns) { write_time_ns_ = write_time_ns; }
+
   ResponseMessage* read_before_write_response() const { return read_before_write_response_.get(); }
 
   void set_read_before_write_response(ResponseMessage* response) {
@@ -205,6 +233,10 @@ private:
   int stream_;
   State state_;
   CassConsistency retry_consistency_;
+  bool is_streaming_rows_;
+  uint64_t write_time_ns_;
+  int32_t encoded_size_;
+  Buffer trace_context_;
   ScopedPtr<ResponseMessage> read_before_write_response_;
 
 private:
@@ -152,12 +152,14 @@ public:
   }
 
   virtual void on_done() {}
+
+  virtual void on_callback_finished(uint64_t elapsed_ns) {}
 };
 
 static NopRequestListener nop_request_listener__;
 
 RequestHandler::RequestHandler(const Request::ConstPtr& request, const ResponseFuture::Ptr& future,
-                               Metrics* metrics)
+                               Metrics* metrics, const RequestTracer::Ptr& tracer)
     : wrapper_(request)
     , future_(future)
     , is_done_(false)
@@ -165,7 +167,14 @@ RequestHandler::RequestHandler(const Request::ConstPtr& request, const ResponseF
     , start_time_ns_(uv_hrtime())
     , listener_(&nop_request_listener__)
     , manager_(NULL)
-    , metrics_(metrics) {}
+    , metrics_(metrics)
+    , stage_latencies_(metrics ? metrics->request_stage_latencies
+                               : Metrics::RequestStageLatencies::Ptr())
+    , tracer_(tracer && tracer->sample() ? tracer : RequestTracer::Ptr())
+    , span_attempts_(0) {
+  wrapper_.set_trace_id(Logger::sample_trace_id());
+  if (future_) future_->stage_latencies_ = stage_latencies_;
+}
 
 void RequestHandler::set_prepared_metadata(const PreparedMetadata::Entry::Ptr& entry) {
   wrapper_.set_prepared_metadata(entry);
@@ -192,10 +201,16 @@ void RequestHandler::init(const ExecutionProfile& profile, ConnectionPoolManager
 
   execution_plan_.reset(
       profile.speculative_execution_policy()->new_plan(keyspace, wrapper_.request().get()));
+
+  if (tracer_) start_request_span(keyspace);
+
+  if (stage_latencies_) timings_.query_plan_ns = uv_hrtime();
 }
 
 void RequestHandler::execute() {
-  RequestExecution::Ptr request_execution(new RequestExecution(this));
+  LOG_TRACE_REQUEST(wrapper_.trace_id(), "Starting execution %d of %s request",
+                    running_executions_ + 1, opcode_to_string(request()->opcode()).c_str());
+  RequestExecution::Ptr request_execution(new RequestExecution(this, running_executions_ > 0));
   running_executions_++;
   internal_retry(request_execution.get());
 }
@@ -223,6 +238,41 @@ void RequestHandler::add_attempted_address(const Address& address, Protected) {
   future_->add_attempted_address(address);
 }
 
+void RequestHandler::set_execution_timings(uint64_t written_ns, const ResponseMessage* response,
+                                           Protected) {
+  // Only the execution that finishes the request is recorded; a response for
+  // an aborted speculative execution can arrive after the request is done.
+  if (!is_done_) {
+    timings_.written_ns = written_ns;
+    timings_.first_byte_ns = response->first_byte_time_ns();
+    timings_.decoded_ns = response->decoded_time_ns();
+  }
+}
+
+RequestTracer::Span* RequestHandler::start_span(const Host::Ptr& host, int stream,
+                                                bool is_speculative, Protected) {
+  // Attempts started after the request is done (e.g. a speculative execution
+  // that was already scheduled) aren't traced.
+  if (!span_) return NULL;
+
+  RequestTracer::Span* span = new RequestTracer::Span(CASS_SPAN_KIND_ATTEMPT, *span_);
+  span->attributes.host.address_length = host->address().to_inet(span->attributes.host.address);
+  span->attributes.attempt = ++span_attempts_;
+  span->attributes.is_speculative = is_speculative ? cass_true : cass_false;
+  span->attributes.stream = stream;
+  tracer_->start(span, span_.get());
+  return span;
+}
+
+void RequestHandler::end_span(RequestTracer::Span* span, CassError error, Protected) {
+  tracer_->end(span, error);
+}
+
+size_t RequestHandler::span_context(const RequestTracer::Span* span, char* context,
+                                    size_t context_size, Protected) {
+  return tracer_->context(span, context, context_size);
+}
+
 void RequestHandler::notify_result_metadata_changed(const String& prepared_id, const String& query,
                                                     const String& keyspace,
                                                     const String& result_metadata_id,
@@ -254,13 +304,22 @@ bool RequestHandler::prepare_all(const Host::Ptr& current_host, const Response::
 }
 
 void RequestHandler::set_response(const Host::Ptr& host, const Response::Ptr& response) {
+  LOG_TRACE_REQUEST(wrapper_.trace_id(), "Received response from host %s after %llu us",
+                    host->address_string().c_str(),
+                    static_cast<unsigned long long>((uv_hrtime() - start_time_ns_) / 1000));
   stop_request();
   running_executions_--;
+  end_request_span(CASS_OK);
 
-  if (future_->set_response(host->address(), response)) {
+  if (future_->set_response(host->address(), response, stage_timings())) {
+    RequestTimings timings(future_->timings());
     if (metrics_) {
       metrics_->record_request(uv_hrtime() - start_time_ns_);
     }
+    if (stage_latencies_) {
+      stage_latencies_->record(timings);
+    }
+    callback_finished(timings);
   } else {
     // This request is a speculative execution for whom we already processed
     // a response (another speculative execution). So consider this one an
@@ -272,19 +331,30 @@ void RequestHandler::set_response(const Host::Ptr& host, const Response::Ptr& re
 }
 
 void RequestHandler::set_error(CassError code, const String& message) {
+  LOG_TRACE_REQUEST(wrapper_.trace_id(), "Failed with error %s: %s", cass_error_desc(code),
+                    message.c_str());
   stop_request();
   bool skip = (code == CASS_ERROR_LIB_NO_HOSTS_AVAILABLE && --running_executions_ > 0);
   if (!skip) {
-    future_->set_error(code, message);
+    end_request_span(code);
+    if (future_->set_error(code, message)) {
+      callback_finished(future_->timings());
+    }
   }
 }
 
 void RequestHandler::set_error(const Host::Ptr& host, CassError code, const String& message) {
+  LOG_TRACE_REQUEST(wrapper_.trace_id(), "Failed on host %s with error %s: %s",
+                    host ? host->address_string().c_str() : "<no host>", cass_error_desc(code),
+                    message.c_str());
   stop_request();
   bool skip = (code == CASS_ERROR_LIB_NO_HOSTS_AVAILABLE && --running_executions_ > 0);
   if (!skip) {
+    end_request_span(code);
     if (host) {
-      future_->set_error_with_address(host->address(), code, message);
+      if (future_->set_error_with_address(host->address(), code, message, stage_timings())) {
+        callback_finished(future_->timings());
+      }
     } else {
       set_error(code, message);
     }
@@ -294,13 +364,25 @@ void RequestHandler::set_error(const Host::Ptr& host, CassError code, const Stri
 void RequestHandler::set_error_with_error_response(const Host::Ptr& host,
                                                    const Response::Ptr& error, CassError code,
                                                    const String& message) {
+  LOG_TRACE_REQUEST(wrapper_.trace_id(), "Received error response from host %s: %s",
+                    host->address_string().c_str(), message.c_str());
   stop_request();
   running_executions_--;
-  future_->set_error_with_response(host->address(), error, code, message);
+  end_request_span(code);
+  if (future_->set_error_with_response(host->address(), error, code, message, stage_timings())) {
+    callback_finished(future_->timings());
+  }
 }
 
 void RequestHandler::stop_timer() { timer_.stop(); }
 
+void RequestHandler::callback_finished(const RequestTimings& timings) {
+  uint64_t elapsed_ns;
+  if (timings.elapsed(CASS_REQUEST_STAGE_CALLBACK, &elapsed_ns)) {
+    listener_->on_callback_finished(elapsed_ns);
+  }
+}
+
 void RequestHandler::on_timeout(Timer* timer) {
   if (metrics_) {
     metrics_->request_timeouts.inc();
@@ -317,6 +399,38 @@ void RequestHandler::stop_request() {
   timer_.stop();
 }
 
+void RequestHandler::start_request_span(const String& keyspace) {
+  span_.reset(new RequestTracer::Span(CASS_SPAN_KIND_REQUEST));
+  span_->set_keyspace(keyspace);
+
+  const Request* request = this->request();
+  switch (request->opcode()) {
+    case CQL_OPCODE_QUERY:
+      span_->set_statement(static_cast<const Statement*>(request)->query());
+      break;
+    case CQL_OPCODE_EXECUTE: {
+      const Prepared::ConstPtr& prepared(static_cast<const ExecuteRequest*>(request)->prepared());
+      span_->set_statement(prepared->query());
+      span_->set_prepared_id(prepared->id());
+    } break;
+    case CQL_OPCODE_PREPARE:
+      span_->set_statement(static_cast<const PrepareRequest*>(request)->query());
+      break;
+    default:
+      break;
+  }
+
+  tracer_->start(span_.get(), NULL);
+}
+
+void RequestHandler::end_request_span(CassError error) {
+  if (span_) {
+    span_->attributes.attempt = span_attempts_;
+    tracer_->end(span_.get(), error);
+    span_.reset();
+  }
+}
+
 void RequestHandler::internal_retry(RequestExecution* request_execution) {
   if (is_done_) {
     LOG_DEBUG("Canceling speculative execution (%p) for request (%p) on host %s",
@@ -380,23 +494,36 @@ void RequestHandler::internal_retry(RequestExecution* request_execution) {
   }
 }
 
-RequestExecution::RequestExecution(RequestHandler* request_handler)
+RequestExecution::RequestExecution(RequestHandler* request_handler, bool is_speculative)
     : RequestCallback(request_handler->wrapper())
     , request_handler_(request_handler)
     , current_host_(request_handler->next_host(RequestHandler::Protected()))
     , num_retries_(0)
-    , start_time_ns_(uv_hrtime()) {}
+    , start_time_ns_(uv_hrtime())
+    , is_speculative_(is_speculative) {}
+
+RequestExecution::~RequestExecution() {
+  // The attempt was never written e.g. the request failed to encode
+  end_span(CASS_ERROR_LIB_WRITE_ERROR);
+}
 
 void RequestExecution::on_execute_next(Timer* timer) { request_handler_->execute(); }
 
-void RequestExecution::on_retry_current_host() { retry_current_host(); }
+void RequestExecution::on_retry_current_host() {
+  end_span(CASS_ERROR_LIB_REQUEST_TIMED_OUT);
+  retry_current_host();
+}
 
 void RequestExecution::on_retry_next_host() {
+  end_span(CASS_ERROR_LIB_REQUEST_TIMED_OUT);
   if (current_host_) current_host_->decrement_inflight_requests();
   retry_next_host();
 }
 
 void RequestExecution::retry_current_host() {
+  LOG_TRACE_REQUEST(trace_id(), "Retrying execution (%p) on host %s", static_cast<void*>(this),
+                    current_host_ ? current_host_->address_string().c_str() : "<no host>");
+
   // Reset the request so it can be executed again
   set_state(REQUEST_STATE_NEW);
 
@@ -410,13 +537,18 @@ void RequestExecution::retry_next_host() {
 
 void RequestExecution::on_write(Connection* connection) {
   assert(current_host_ && "Tried to start on a non-existent host");
+  LOG_TRACE_REQUEST(trace_id(), "Writing execution (%p) with stream %d to host %s",
+                    static_cast<void*>(this), stream(), current_host_->address_string().c_str());
   current_host_->increment_inflight_requests();
   connection_ = connection;
   if (request()->record_attempted_addresses()) {
     request_handler_->add_attempted_address(current_host_->address(), RequestHandler::Protected());
   }
   request_handler_->start_request(connection->loop(), RequestHandler::Protected());
-  if (request()->is_idempotent()) {
+  if (request_handler_->is_traced()) start_span();
+  // Speculative executions of a streamed request would pass duplicate rows to
+  // the row callback.
+  if (request()->is_idempotent() && !Statement::has_row_callback(request())) {
     int64_t timeout = request_handler_->next_execution(current_host_, RequestHandler::Protected());
     if (timeout == 0) {
       request_handler_->execute();
@@ -433,6 +565,17 @@ void RequestExecution::on_set(ResponseMessage* response) {
 
   current_host_->decrement_inflight_requests();
   Connection* connection = connection_;
+  request_handler_->set_execution_timings(write_time_ns(), response, RequestHandler::Protected());
+
+  if (span_) {
+    CassError error = CASS_OK;
+    if (response->opcode() == CQL_OPCODE_ERROR) {
+      const ErrorResponse* error_response =
+          static_cast<const ErrorResponse*>(response->response_body().get());
+      error = static_cast<CassError>(CASS_ERROR(CASS_ERROR_SOURCE_SERVER, error_response->code()));
+    }
+    end_span(error, response);
+  }
 
   switch (response->opcode()) {
     case CQL_OPCODE_RESULT:
@@ -449,6 +592,7 @@ void RequestExecution::on_set(ResponseMessage* response) {
 }
 
 void RequestExecution::on_error(CassError code, const String& message) {
+  end_span(code);
   if (current_host_) current_host_->decrement_inflight_requests();
   set_error(code, message);
 }
@@ -663,6 +807,31 @@ void RequestExecution::on_error_unprepared(Connection* connection, ErrorResponse
   }
 }
 
+void RequestExecution::start_span() {
+  // An attempt that failed to be written is retried using the same execution
+  end_span(CASS_ERROR_LIB_WRITE_ERROR);
+
+  span_.reset(request_handler_->start_span(current_host_, stream(), is_speculative_,
+                                           RequestHandler::Protected()));
+
+  char context[CASS_TRACER_MAX_CONTEXT_LENGTH];
+  size_t context_length = 0;
+  if (span_) {
+    context_length = request_handler_->span_context(span_.get(), context, sizeof(context),
+                                                    RequestHandler::Protected());
+  }
+  set_trace_context(context, context_length);
+}
+
+void RequestExecution::end_span(CassError error, const ResponseMessage* response) {
+  if (span_) {
+    span_->attributes.request_bytes = encoded_size();
+    span_->attributes.response_bytes = response ? response->size() : 0;
+    request_handler_->end_span(span_.get(), error, RequestHandler::Protected());
+    span_.reset();
+  }
+}
+
 void RequestExecution::set_response(const Response::Ptr& response) {
   request_handler_->set_response(current_host_, response);
 }
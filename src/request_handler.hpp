@@ -23,9 +23,12 @@
 #include "host.hpp"
 #include "load_balancing.hpp"
 #include "metadata.hpp"
+#include "metrics.hpp"
 #include "prepare_request.hpp"
 #include "request.hpp"
 #include "request_callback.hpp"
+#include "request_timings.hpp"
+#include "request_tracer.hpp"
 #include "response.hpp"
 #include "result_response.hpp"
 #include "retry_policy.hpp"
@@ -58,11 +61,13 @@ public:
       : Future(FUTURE_TYPE_RESPONSE)
       , schema_metadata(new Metadata::SchemaSnapshot(schema_metadata)) {}
 
-  bool set_response(Address address, const Response::Ptr& response) {
+  bool set_response(Address address, const Response::Ptr& response,
+                    const RequestTimings* timings = NULL) {
     ScopedMutex lock(&mutex_);
     if (!is_set()) {
       address_ = address;
       response_ = response;
+      set_timings(timings);
       internal_set(lock);
       return true;
     }
@@ -75,10 +80,12 @@ public:
     return response_;
   }
 
-  bool set_error_with_address(Address address, CassError code, const String& message) {
+  bool set_error_with_address(Address address, CassError code, const String& message,
+                              const RequestTimings* timings = NULL) {
     ScopedMutex lock(&mutex_);
     if (!is_set()) {
       address_ = address;
+      set_timings(timings);
       internal_set_error(code, message, lock);
       return true;
     }
@@ -86,11 +93,12 @@ public:
   }
 
   bool set_error_with_response(Address address, const Response::Ptr& response, CassError code,
-                               const String& message) {
+                               const String& message, const RequestTimings* timings = NULL) {
     ScopedMutex lock(&mutex_);
     if (!is_set()) {
       address_ = address;
       response_ = response;
+      set_timings(timings);
       internal_set_error(code, message, lock);
       return true;
     }
@@ -103,6 +111,15 @@ public:
     return address_;
   }
 
+  RequestTimings timings() {
+    ScopedMutex lock(&mutex_);
+    internal_wait(lock);
+    RequestTimings timings(timings_);
+    timings.callback_start_ns = callback_start_ns();
+    timings.callback_end_ns = callback_end_ns();
+    return timings;
+  }
+
   // Currently, used for testing only, but it could be exposed in the future.
   AddressVec attempted_addresses() {
     ScopedMutex lock(&mutex_);
@@ -121,10 +138,26 @@ private:
     attempted_addresses_.push_back(address);
   }
 
+  void set_timings(const RequestTimings* timings) {
+    if (timings) {
+      timings_ = *timings;
+      timings_.future_set_ns = uv_hrtime();
+    }
+  }
+
+  virtual void on_callback_finished(uint64_t elapsed_ns, bool is_set_thread) {
+    // Only successful requests are recorded
+    if (stage_latencies_ && !internal_error()) {
+      stage_latencies_->record_callback(elapsed_ns, is_set_thread);
+    }
+  }
+
 private:
   Address address_;
   Response::Ptr response_;
   AddressVec attempted_addresses_;
+  RequestTimings timings_;
+  Metrics::RequestStageLatencies::Ptr stage_latencies_; // Only set if stage timings are enabled
 };
 
 class RequestExecution;
@@ -137,7 +170,7 @@ public:
   typedef SharedRefPtr<RequestHandler> Ptr;
 
   RequestHandler(const Request::ConstPtr& request, const ResponseFuture::Ptr& future,
-                 Metrics* metrics = NULL);
+                 Metrics* metrics = NULL, const RequestTracer::Ptr& tracer = RequestTracer::Ptr());
 
   void set_prepared_metadata(const PreparedMetadata::Entry::Ptr& entry);
 
@@ -151,6 +184,15 @@ public:
   const Request* request() const { return wrapper_.request().get(); }
   CassConsistency consistency() const { return wrapper_.consistency(); }
 
+  // Record the times the request was added to and removed from a request
+  // processor's queue.
+  void set_enqueued() {
+    if (stage_latencies_) timings_.enqueued_ns = uv_hrtime();
+  }
+  void set_dequeued() {
+    if (stage_latencies_) timings_.dequeued_ns = uv_hrtime();
+  }
+
 public:
   class Protected {
     friend class RequestExecution;
@@ -167,6 +209,14 @@ public:
 
   void add_attempted_address(const Address& address, Protected);
 
+  void set_execution_timings(uint64_t written_ns, const ResponseMessage* response, Protected);
+
+  bool is_traced() const { return tracer_.get() != NULL; }
+  RequestTracer::Span* start_span(const Host::Ptr& host, int stream, bool is_speculative, Protected);
+  void end_span(RequestTracer::Span* span, CassError error, Protected);
+  size_t span_context(const RequestTracer::Span* span, char* context, size_t context_size,
+                      Protected);
+
   void notify_result_metadata_changed(const String& prepared_id, const String& query,
                                       const String& keyspace, const String& result_metadata_id,
                                       const ResultResponse::ConstPtr& result_response, Protected);
@@ -192,8 +242,13 @@ private:
 
 private:
   void stop_request();
+  void callback_finished(const RequestTimings& timings);
+  const RequestTimings* stage_timings() const { return stage_latencies_ ? &timings_ : NULL; }
   void internal_retry(RequestExecution* request_execution);
 
+  void start_request_span(const String& keyspace);
+  void end_request_span(CassError error);
+
 private:
   RequestWrapper wrapper_;
   SharedRefPtr<ResponseFuture> future_;
@@ -206,10 +261,17 @@ private:
   Timer timer_;
 
   const uint64_t start_time_ns_;
+  RequestTimings timings_;
   RequestListener* listener_;
   ConnectionPoolManager* manager_;
 
   Metrics* const metrics_;
+  const Metrics::RequestStageLatencies::Ptr stage_latencies_; // Only set if enabled
+
+  // Only set if the request is sampled for tracing
+  const RequestTracer::Ptr tracer_;
+  ScopedPtr<RequestTracer::Span> span_;
+  int span_attempts_;
 };
 
 class KeyspaceChangedResponse {
@@ -261,13 +323,22 @@ public:
                               const Host::Ptr& current_host, const Response::Ptr& response) = 0;
 
   virtual void on_done() = 0;
+
+  /**
+   * A callback called after a request's future callback has run on the
+   * current thread.
+   *
+   * @param elapsed_ns The time the future callback ran.
+   */
+  virtual void on_callback_finished(uint64_t elapsed_ns) = 0;
 };
 
 class RequestExecution : public RequestCallback {
 public:
   typedef SharedRefPtr<RequestExecution> Ptr;
 
-  RequestExecution(RequestHandler* request_handler);
+  RequestExecution(RequestHandler* request_handler, bool is_speculative = false);
+  virtual ~RequestExecution();
 
   const Host::Ptr& current_host() const { return current_host_; }
   void next_host() { current_host_ = request_handler_->next_host(RequestHandler::Protected()); }
@@ -284,6 +355,9 @@ private:
   void retry_current_host();
   void retry_next_host();
 
+  void start_span();
+  void end_span(CassError error, const ResponseMessage* response = NULL);
+
   virtual void on_write(Connection* connection);
 
   virtual void on_set(ResponseMessage* response);
@@ -306,6 +380,8 @@ private:
   Timer schedule_timer_;
   int num_retries_;
   const uint64_t start_time_ns_;
+  const bool is_speculative_;
+  ScopedPtr<RequestTracer::Span> span_;
 };
 
 }}} // namespace datastax::internal::core
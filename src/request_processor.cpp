@@ -146,7 +146,11 @@ RequestProcessorSettings::RequestProcessorSettings()
     , max_tracing_wait_time_ms(CASS_DEFAULT_MAX_TRACING_DATA_WAIT_TIME_MS)
     , retry_tracing_wait_time_ms(CASS_DEFAULT_RETRY_TRACING_DATA_WAIT_TIME_MS)
     , tracing_consistency(CASS_DEFAULT_TRACING_CONSISTENCY)
-    , address_factory(new DefaultAddressFactory()) {
+    , address_factory(new DefaultAddressFactory())
+    , event_loop_probe_interval_ms(CASS_DEFAULT_EVENT_LOOP_PROBE_INTERVAL_MS)
+    , blocked_callback_threshold_us(CASS_DEFAULT_BLOCKED_CALLBACK_THRESHOLD_US)
+    , blocked_callback_warning(NULL)
+    , blocked_callback_warning_data(NULL) {
   profiles.set_empty_key("");
 }
 
@@ -163,7 +167,11 @@ RequestProcessorSettings::RequestProcessorSettings(const Config& config)
     , max_tracing_wait_time_ms(config.max_tracing_wait_time_ms())
     , retry_tracing_wait_time_ms(config.retry_tracing_wait_time_ms())
     , tracing_consistency(config.tracing_consistency())
-    , address_factory(create_address_factory_from_config(config)) {}
+    , address_factory(create_address_factory_from_config(config))
+    , event_loop_probe_interval_ms(config.event_loop_probe_interval_ms())
+    , blocked_callback_threshold_us(config.blocked_callback_threshold_us())
+    , blocked_callback_warning(config.blocked_callback_warning())
+    , blocked_callback_warning_data(config.blocked_callback_warning_data()) {}
 
 RequestProcessor::RequestProcessor(RequestProcessorListener* listener, EventLoop* event_loop,
                                    const ConnectionPoolManager::Ptr& connection_pool_manager,
@@ -183,6 +191,9 @@ RequestProcessor::RequestProcessor(RequestProcessorListener* listener, EventLoop
     , is_processing_(false)
     , attempts_without_requests_(0)
     , io_time_during_coalesce_(0)
+    , probe_start_ns_(0)
+    , probe_idle_time_(0)
+    , callback_time_ns_(0)
 #ifdef CASS_INTERNAL_DIAGNOSTICS
     , reads_during_coalesce_(0)
     , writes_during_coalesce_(0)
@@ -259,6 +270,7 @@ void RequestProcessor::notify_token_map_updated(const TokenMap::Ptr& token_map)
 
 void RequestProcessor::process_request(const RequestHandler::Ptr& request_handler) {
   request_handler->inc_ref(); // Queue reference
+  request_handler->set_enqueued();
 
   if (request_queue_->enqueue(request_handler.get())) {
     request_count_.fetch_add(1);
@@ -278,7 +290,10 @@ void RequestProcessor::process_request(const RequestHandler::Ptr& request_handle
 int RequestProcessor::init(Protected) {
   int rc = async_.start(event_loop_->loop(), bind_callback(&RequestProcessor::on_async, this));
   if (rc != 0) return rc;
-  return prepare_.start(event_loop_->loop(), bind_callback(&RequestProcessor::on_prepare, this));
+  rc = prepare_.start(event_loop_->loop(), bind_callback(&RequestProcessor::on_prepare, this));
+  if (rc != 0) return rc;
+  start_probe();
+  return rc;
 }
 
 void RequestProcessor::on_pool_up(const Address& address) {
@@ -311,6 +326,7 @@ void RequestProcessor::on_close(ConnectionPoolManager* manager) {
   async_.close_handle();
   prepare_.close_handle();
   timer_.stop();
+  probe_timer_.stop();
   connection_pool_manager_.reset();
   listener_->on_close(this);
   dec_ref();
@@ -394,6 +410,20 @@ void RequestProcessor::on_done() {
   maybe_close(request_count_.fetch_sub(1) - 1);
 }
 
+void RequestProcessor::on_callback_finished(uint64_t elapsed_ns) {
+  callback_time_ns_ += elapsed_ns;
+  uint64_t elapsed_us = elapsed_ns / 1000;
+  if (settings_.blocked_callback_threshold_us > 0 &&
+      elapsed_us > settings_.blocked_callback_threshold_us) {
+    LOG_WARN("A future callback blocked the I/O thread \"%s\" for %llu us (threshold: %llu us)",
+             event_loop_->name().c_str(), static_cast<unsigned long long>(elapsed_us),
+             static_cast<unsigned long long>(settings_.blocked_callback_threshold_us));
+    if (settings_.blocked_callback_warning) {
+      settings_.blocked_callback_warning(elapsed_us, settings_.blocked_callback_warning_data);
+    }
+  }
+}
+
 bool RequestProcessor::on_is_host_up(const Address& address) {
   return default_profile_.load_balancing_policy()->is_host_up(address);
 }
@@ -403,6 +433,33 @@ void RequestProcessor::internal_close() {
   maybe_close(request_count_.load());
 }
 
+void RequestProcessor::start_probe() {
+  if (!connection_pool_manager_ || !connection_pool_manager_->metrics() ||
+      settings_.event_loop_probe_interval_ms == 0) {
+    return;
+  }
+  probe_start_ns_ = uv_hrtime();
+  probe_idle_time_ = event_loop_->idle_time();
+  callback_time_ns_ = 0;
+  probe_timer_.start(event_loop_->loop(), settings_.event_loop_probe_interval_ms,
+                     bind_callback(&RequestProcessor::on_probe, this));
+}
+
+void RequestProcessor::on_probe(Timer* timer) {
+  uint64_t elapsed_ns = uv_hrtime() - probe_start_ns_;
+  uint64_t interval_ns = settings_.event_loop_probe_interval_ms * 1000 * 1000;
+
+  // The time elapsed past the probe's interval is how long the event loop was
+  // too busy to run it.
+  uint64_t lag_ns = elapsed_ns > interval_ns ? elapsed_ns - interval_ns : 0;
+  uint64_t idle_ns = event_loop_->idle_time() - probe_idle_time_;
+  double utilization =
+      idle_ns < elapsed_ns ? 1.0 - static_cast<double>(idle_ns) / elapsed_ns : 0.0;
+
+  connection_pool_manager_->metrics()->record_event_loop(lag_ns, utilization, callback_time_ns_);
+  start_probe();
+}
+
 void RequestProcessor::internal_pool_down(const Address& address) {
   LoadBalancingPolicy::Vec policies = load_balancing_policies();
   for (LoadBalancingPolicy::Vec::const_iterator it = policies.begin(); it != policies.end(); ++it) {
@@ -545,6 +602,7 @@ int RequestProcessor::process_requests(uint64_t processing_time) {
   RequestHandler* request_handler = NULL;
   while (request_queue_->dequeue(request_handler)) {
     if (request_handler) {
+      request_handler->set_dequeued();
       const String& profile_name = request_handler->request()->execution_profile_name();
       const ExecutionProfile* profile(execution_profile(profile_name));
       if (profile) {
@@ -136,6 +136,14 @@ struct RequestProcessorSettings {
   CassConsistency tracing_consistency;
 
   AddressFactory::Ptr address_factory;
+
+  uint64_t event_loop_probe_interval_ms;
+
+  uint64_t blocked_callback_threshold_us;
+
+  CassBlockedCallbackWarning blocked_callback_warning;
+
+  void* blocked_callback_warning_data;
 };
 
 /**
@@ -293,6 +301,7 @@ private:
   virtual bool on_prepare_all(const RequestHandler::Ptr& request_handler,
                               const Host::Ptr& current_host, const Response::Ptr& response);
   virtual void on_done();
+  virtual void on_callback_finished(uint64_t elapsed_ns);
 
 private:
   // Schema agreement listener methods
@@ -301,9 +310,11 @@ private:
 
 private:
   void on_timeout(MicroTimer* timer);
+  void on_probe(Timer* timer);
 
 private:
   void internal_close();
+  void start_probe();
   void internal_pool_down(const Address& address);
 
   const ExecutionProfile* execution_profile(const String& name) const;
@@ -354,6 +365,11 @@ private:
   Prepare prepare_;
   MicroTimer timer_;
 
+  Timer probe_timer_;
+  uint64_t probe_start_ns_;
+  uint64_t probe_idle_time_;
+  uint64_t callback_time_ns_;
+
 #ifdef CASS_INTERNAL_DIAGNOSTICS
   int reads_during_coalesce_;
   int writes_during_coalesce_;
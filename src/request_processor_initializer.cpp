@@ -129,6 +129,7 @@ void RequestProcessorInitializer::internal_initialize() {
       ->with_listener(this)
       ->with_keyspace(keyspace_)
       ->with_metrics(metrics_)
+      ->with_local_dc(local_dc_)
       ->initialize(event_loop_->loop(), hosts_);
 }
 
@@ -0,0 +1,90 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_REQUEST_TIMINGS_HPP
+#define DATASTAX_INTERNAL_REQUEST_TIMINGS_HPP
+
+#include "cassandra.h"
+
+#include <stdint.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Monotonic timestamps (from `uv_hrtime()`) recorded at each stage of a
+ * request. A timestamp of zero means the stage wasn't reached.
+ */
+struct RequestTimings {
+  RequestTimings()
+      : enqueued_ns(0)
+      , dequeued_ns(0)
+      , query_plan_ns(0)
+      , written_ns(0)
+      , first_byte_ns(0)
+      , decoded_ns(0)
+      , future_set_ns(0)
+      , callback_start_ns(0)
+      , callback_end_ns(0) {}
+
+  /**
+   * The time spent in a stage.
+   *
+   * @param stage The request stage.
+   * @param elapsed_ns The time spent in the stage in nanoseconds.
+   * @return true if both ends of the stage were recorded, otherwise false.
+   */
+  bool elapsed(CassRequestStage stage, uint64_t* elapsed_ns) const {
+    switch (stage) {
+      case CASS_REQUEST_STAGE_QUEUE:
+        return elapsed(enqueued_ns, dequeued_ns, elapsed_ns);
+      case CASS_REQUEST_STAGE_QUERY_PLAN:
+        return elapsed(dequeued_ns, query_plan_ns, elapsed_ns);
+      case CASS_REQUEST_STAGE_WRITE:
+        return elapsed(query_plan_ns, written_ns, elapsed_ns);
+      case CASS_REQUEST_STAGE_NETWORK:
+        return elapsed(written_ns, first_byte_ns, elapsed_ns);
+      case CASS_REQUEST_STAGE_DECODE:
+        return elapsed(first_byte_ns, decoded_ns, elapsed_ns);
+      case CASS_REQUEST_STAGE_COMPLETE:
+        return elapsed(decoded_ns, future_set_ns, elapsed_ns);
+      case CASS_REQUEST_STAGE_CALLBACK:
+        return elapsed(callback_start_ns, callback_end_ns, elapsed_ns);
+      default:
+        return false;
+    }
+  }
+
+  uint64_t enqueued_ns;
+  uint64_t dequeued_ns;
+  uint64_t query_plan_ns;
+  uint64_t written_ns;
+  uint64_t first_byte_ns;
+  uint64_t decoded_ns;
+  uint64_t future_set_ns;
+  uint64_t callback_start_ns;
+  uint64_t callback_end_ns;
+
+private:
+  static bool elapsed(uint64_t start_ns, uint64_t end_ns, uint64_t* elapsed_ns) {
+    if (start_ns == 0 || end_ns < start_ns) return false;
+    *elapsed_ns = end_ns - start_ns;
+    return true;
+  }
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,63 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "request_tracer.hpp"
+
+#include "utils.hpp"
+
+#include <string.h>
+
+using namespace datastax::internal::core;
+
+bool RequestTracer::sample() const {
+  if (sample_one_in_n_ <= 1) return true;
+  return sample_one_in_n(sample_one_in_n_);
+}
+
+RequestTracer::Span::Span(CassSpanKind kind)
+    : handle(NULL) {
+  memset(&attributes, 0, sizeof(CassSpanAttributes));
+  attributes.kind = kind;
+  attributes.stream = -1;
+}
+
+RequestTracer::Span::Span(CassSpanKind kind, const Span& parent)
+    : handle(NULL) {
+  memset(&attributes, 0, sizeof(CassSpanAttributes));
+  attributes.kind = kind;
+  attributes.stream = -1;
+  set_keyspace(parent.keyspace_);
+  set_statement(parent.statement_);
+  set_prepared_id(parent.prepared_id_);
+}
+
+void RequestTracer::Span::set_keyspace(const String& keyspace) {
+  keyspace_ = keyspace;
+  attributes.keyspace = keyspace_.data();
+  attributes.keyspace_length = keyspace_.size();
+}
+
+void RequestTracer::Span::set_statement(const String& statement) {
+  statement_ = statement;
+  attributes.statement = statement_.data();
+  attributes.statement_length = statement_.size();
+}
+
+void RequestTracer::Span::set_prepared_id(const String& prepared_id) {
+  prepared_id_ = prepared_id;
+  attributes.prepared_id = reinterpret_cast<const cass_byte_t*>(prepared_id_.data());
+  attributes.prepared_id_length = prepared_id_.size();
+}
@@ -0,0 +1,118 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_REQUEST_TRACER_HPP
+#define DATASTAX_INTERNAL_REQUEST_TRACER_HPP
+
+#include "allocated.hpp"
+#include "cassandra.h"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "string.hpp"
+
+#define CASS_TRACER_CONTEXT_PAYLOAD_NAME "traceparent"
+#define CASS_TRACER_MAX_CONTEXT_LENGTH 256
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Invokes the application's tracer callbacks for sampled requests.
+ */
+class RequestTracer : public RefCounted<RequestTracer> {
+public:
+  typedef SharedRefPtr<RequestTracer> Ptr;
+
+  /**
+   * A started span. The attributes are passed to the end callback so they
+   * can be filled in while the span is running.
+   */
+  class Span : public Allocated {
+  public:
+    Span(CassSpanKind kind);
+
+    /**
+     * Constructor. Inherits the parent's request attributes.
+     */
+    Span(CassSpanKind kind, const Span& parent);
+
+    void set_keyspace(const String& keyspace);
+    void set_statement(const String& statement);
+    void set_prepared_id(const String& prepared_id);
+
+    void* handle;
+    CassSpanAttributes attributes;
+
+  private:
+    String keyspace_;
+    String statement_;
+    String prepared_id_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(Span);
+  };
+
+  RequestTracer(const CassTracerCallbacks& callbacks, unsigned sample_one_in_n, void* data)
+      : callbacks_(callbacks)
+      , sample_one_in_n_(sample_one_in_n)
+      , data_(data) {}
+
+  /**
+   * Decide if a new request is traced. This doesn't write to shared state so
+   * that requests that aren't sampled are cheap.
+   */
+  bool sample() const;
+
+  /**
+   * Start a span by invoking the start callback.
+   *
+   * @param span A span with its starting attributes.
+   * @param parent The parent span or NULL.
+   */
+  void start(Span* span, const Span* parent) const {
+    span->handle = callbacks_.start_callback(parent ? parent->handle : NULL, &span->attributes,
+                                             data_);
+  }
+
+  /**
+   * End a span by invoking the end callback.
+   */
+  void end(Span* span, CassError error) const {
+    span->attributes.error = error;
+    if (callbacks_.end_callback) {
+      callbacks_.end_callback(span->handle, &span->attributes, data_);
+    }
+  }
+
+  /**
+   * Get the trace context of a span.
+   *
+   * @return The length of the context written to the buffer.
+   */
+  size_t context(const Span* span, char* context, size_t context_size) const {
+    if (!callbacks_.context_callback) return 0;
+    size_t length = callbacks_.context_callback(span->handle, context, context_size, data_);
+    return length < context_size ? length : context_size;
+  }
+
+private:
+  const CassTracerCallbacks callbacks_;
+  const unsigned sample_one_in_n_;
+  void* const data_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -24,6 +24,7 @@
 #include "result_response.hpp"
 #include "supported_response.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace datastax::internal::core;
@@ -43,7 +44,8 @@ public:
 };
 
 Response::Response(uint8_t opcode)
-    : opcode_(opcode) {
+    : opcode_(opcode)
+    , buffer_size_(0) {
   memset(&tracing_id_, 0, sizeof(CassUuid));
 }
 
@@ -57,6 +59,24 @@ bool Response::decode_custom_payload(Decoder& decoder) {
 
 bool Response::decode_warnings(Decoder& decoder) { return decoder.decode_warnings(warnings_); }
 
+bool Response::decode_body(ProtocolVersion protocol_version, uint8_t flags) {
+  Decoder decoder(data(), buffer_size_, protocol_version);
+
+  if (flags & CASS_FLAG_TRACING) {
+    CHECK_RESULT(decode_trace_id(decoder));
+  }
+
+  if (flags & CASS_FLAG_WARNING) {
+    CHECK_RESULT(decode_warnings(decoder));
+  }
+
+  if (flags & CASS_FLAG_CUSTOM_PAYLOAD) {
+    CHECK_RESULT(decode_custom_payload(decoder));
+  }
+
+  return decode(decoder);
+}
+
 bool ResponseMessage::allocate_body(int8_t opcode) {
   response_body_.reset();
   switch (opcode) {
@@ -98,6 +118,21 @@ bool ResponseMessage::allocate_body(int8_t opcode) {
   }
 }
 
+void ResponseMessage::maybe_stream_rows() {
+  if (!resolver_ || opcode_ != CQL_OPCODE_RESULT || stream_ < 0 || length_ <= 0 ||
+      version_ < CASS_PROTOCOL_VERSION_V3) {
+    return;
+  }
+
+  CassRowCallback callback = NULL;
+  void* data = NULL;
+  if (resolver_->resolve_row_callback(stream_, &callback, &data)) {
+    row_stream_.reset(new RowStream(ProtocolVersion(version_), flags_, length_,
+                                    static_cast<ResultResponse*>(response_body_.get()), callback,
+                                    data));
+  }
+}
+
 ssize_t ResponseMessage::decode(const char* input, size_t size) {
   const char* input_pos = input;
 
@@ -149,8 +184,11 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
         return -1;
       }
 
-      response_body_->set_buffer(length_);
-      body_buffer_pos_ = response_body_->data();
+      maybe_stream_rows();
+      if (!row_stream_) {
+        response_body_->set_buffer(length_);
+        body_buffer_pos_ = response_body_->data();
+      }
     } else {
       // We haven't received all the data for the header. We consume the
       // entire buffer.
@@ -163,6 +201,15 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
   const size_t remaining = size - (input_pos - input);
   const size_t frame_size = header_size_ + length_;
 
+  if (row_stream_) {
+    // Only consume what's needed for this frame
+    size_t needed = std::min(remaining, row_stream_->remaining());
+    if (!row_stream_->decode(input_pos, needed)) return -1;
+    input_pos += needed;
+    is_body_ready_ = row_stream_->is_done();
+    return input_pos - input;
+  }
+
   if (received_ >= frame_size) {
     // We may have received more data then we need, only copy what we need
     size_t overage = received_ - frame_size;
@@ -172,21 +219,8 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
     body_buffer_pos_ += needed;
     input_pos += needed;
     assert(body_buffer_pos_ == response_body_->data() + length_);
-    Decoder decoder(response_body_->data(), length_, ProtocolVersion(version_));
-
-    if (flags_ & CASS_FLAG_TRACING) {
-      if (!response_body_->decode_trace_id(decoder)) return -1;
-    }
-
-    if (flags_ & CASS_FLAG_WARNING) {
-      if (!response_body_->decode_warnings(decoder)) return -1;
-    }
-
-    if (flags_ & CASS_FLAG_CUSTOM_PAYLOAD) {
-      if (!response_body_->decode_custom_payload(decoder)) return -1;
-    }
 
-    if (!response_body_->decode(decoder)) {
+    if (!response_body_->decode_body(ProtocolVersion(version_), flags_)) {
       is_body_error_ = true;
       return -1;
     }
@@ -23,6 +23,8 @@
 #include "hash_table.hpp"
 #include "macros.hpp"
 #include "ref_counted.hpp"
+#include "row_stream.hpp"
+#include "scoped_ptr.hpp"
 #include "utils.hpp"
 
 #include <uv.h>
@@ -46,7 +48,12 @@ public:
 
   const RefBuffer::Ptr& buffer() const { return buffer_; }
 
-  void set_buffer(size_t size) { buffer_ = RefBuffer::Ptr(RefBuffer::create(size)); }
+  size_t buffer_size() const { return buffer_size_; }
+
+  void set_buffer(size_t size) {
+    buffer_ = RefBuffer::Ptr(RefBuffer::create(size));
+    buffer_size_ = size;
+  }
 
   bool has_tracing_id() const;
 
@@ -62,11 +69,22 @@ public:
 
   bool decode_warnings(Decoder& decoder);
 
+  /**
+   * Decode the frame body stored in the response's buffer. This includes the
+   * tracing ID, warnings and custom payload if they're present.
+   *
+   * @param protocol_version The protocol version of the frame.
+   * @param flags The flags from the frame's header.
+   * @return true if the body was successfully decoded.
+   */
+  bool decode_body(ProtocolVersion protocol_version, uint8_t flags);
+
   virtual bool decode(Decoder& decoder) = 0;
 
 private:
   uint8_t opcode_;
   RefBuffer::Ptr buffer_;
+  size_t buffer_size_;
   CassUuid tracing_id_;
   CustomPayloadVec custom_payload_;
   WarningVec warnings_;
@@ -77,8 +95,9 @@ private:
 
 class ResponseMessage : public Allocated {
 public:
-  ResponseMessage()
-      : version_(0)
+  ResponseMessage(RowStreamResolver* resolver = NULL)
+      : resolver_(resolver)
+      , version_(0)
       , flags_(0)
       , stream_(0)
       , opcode_(0)
@@ -89,7 +108,9 @@ public:
       , header_buffer_pos_(header_buffer_)
       , is_body_ready_(false)
       , is_body_error_(false)
-      , body_buffer_pos_(NULL) {}
+      , body_buffer_pos_(NULL)
+      , first_byte_time_ns_(0)
+      , decoded_time_ns_(0) {}
 
   uint8_t flags() const { return flags_; }
 
@@ -101,12 +122,24 @@ public:
 
   bool is_body_ready() const { return is_body_ready_; }
 
+  // The size of the message including its header
+  size_t size() const { return header_size_ + length_; }
+
   ssize_t decode(const char* input, size_t size);
 
+  // The times the first byte of the message was read from the socket and the
+  // message was fully decoded.
+  uint64_t first_byte_time_ns() const { return first_byte_time_ns_; }
+  void set_first_byte_time_ns(uint64_t time_ns) { first_byte_time_ns_ = time_ns; }
+  uint64_t decoded_time_ns() const { return decoded_time_ns_; }
+  void set_decoded_time_ns(uint64_t time_ns) { decoded_time_ns_ = time_ns; }
+
 private:
   bool allocate_body(int8_t opcode);
+  void maybe_stream_rows();
 
 private:
+  RowStreamResolver* const resolver_;
   uint8_t version_;
   uint8_t flags_;
   int16_t stream_;
@@ -123,6 +156,9 @@ private:
   bool is_body_error_;
   Response::Ptr response_body_;
   char* body_buffer_pos_;
+  ScopedPtr<RowStream> row_stream_;
+  uint64_t first_byte_time_ns_;
+  uint64_t decoded_time_ns_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ResponseMessage);
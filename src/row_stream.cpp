@@ -0,0 +1,304 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "row_stream.hpp"
+
+#include "constants.hpp"
+#include "logger.hpp"
+#include "result_response.hpp"
+#include "row.hpp"
+#include "serialization.hpp"
+
+#include <cstring>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+/**
+ * A cursor used to determine if enough of the body has been received to decode
+ * a part of it. Unlike `Decoder` it doesn't log errors when there's not enough
+ * data because that's expected while the body is still arriving.
+ */
+class Cursor {
+public:
+  Cursor(const char* input, size_t size)
+      : pos_(input)
+      , end_(input + size) {}
+
+  const char* pos() const { return pos_; }
+
+  bool skip(size_t size) {
+    if (static_cast<size_t>(end_ - pos_) < size) return false;
+    pos_ += size;
+    return true;
+  }
+
+  bool read_int32(int32_t* output) {
+    if (static_cast<size_t>(end_ - pos_) < sizeof(int32_t)) return false;
+    pos_ = decode_int32(pos_, *output);
+    return true;
+  }
+
+  bool read_uint16(uint16_t* output) {
+    if (static_cast<size_t>(end_ - pos_) < sizeof(uint16_t)) return false;
+    pos_ = decode_uint16(pos_, *output);
+    return true;
+  }
+
+  bool skip_string() {
+    uint16_t size = 0;
+    return read_uint16(&size) && skip(size);
+  }
+
+  bool skip_bytes() {
+    int32_t size = 0;
+    if (!read_int32(&size)) return false;
+    return size < 0 || skip(size); // Negative sizes are null values
+  }
+
+  bool skip_type() {
+    uint16_t value_type = 0;
+    if (!read_uint16(&value_type)) return false;
+
+    switch (value_type) {
+      case CASS_VALUE_TYPE_CUSTOM:
+        return skip_string();
+
+      case CASS_VALUE_TYPE_LIST:
+      case CASS_VALUE_TYPE_SET:
+        return skip_type();
+
+      case CASS_VALUE_TYPE_MAP:
+        return skip_type() && skip_type();
+
+      case CASS_VALUE_TYPE_UDT: {
+        uint16_t field_count = 0;
+        if (!skip_string() || !skip_string() || !read_uint16(&field_count)) return false;
+        for (uint16_t i = 0; i < field_count; ++i) {
+          if (!skip_string() || !skip_type()) return false;
+        }
+        return true;
+      }
+
+      case CASS_VALUE_TYPE_TUPLE: {
+        uint16_t item_count = 0;
+        if (!read_uint16(&item_count)) return false;
+        for (uint16_t i = 0; i < item_count; ++i) {
+          if (!skip_type()) return false;
+        }
+        return true;
+      }
+
+      default:
+        return true;
+    }
+  }
+
+private:
+  const char* pos_;
+  const char* end_;
+};
+
+} // namespace
+
+RowStream::RowStream(ProtocolVersion protocol_version, uint8_t flags, int32_t length,
+                     ResultResponse* result, CassRowCallback callback, void* data)
+    : protocol_version_(protocol_version)
+    , flags_(flags)
+    , length_(length)
+    , received_(0)
+    , result_(result)
+    , callback_(callback)
+    , data_(data)
+    , state_(STATE_PREFIX)
+    , body_buffer_pos_(NULL)
+    , column_count_(0)
+    , rows_remaining_(0)
+    , row_count_(0) {}
+
+bool RowStream::decode(const char* input, size_t size) {
+  assert(size <= remaining());
+  received_ += size;
+
+  switch (state_) {
+    case STATE_PREFIX:
+      buffer_.insert(buffer_.end(), input, input + size);
+      return decode_prefix();
+
+    case STATE_ROWS:
+      buffer_.insert(buffer_.end(), input, input + size);
+      return decode_rows();
+
+    case STATE_BUFFERED:
+      memcpy(body_buffer_pos_, input, size);
+      body_buffer_pos_ += size;
+      return finish();
+  }
+
+  return false;
+}
+
+bool RowStream::decode_prefix() {
+  if (buffer_.empty()) return finish();
+
+  const char* begin = &buffer_[0];
+  Cursor cursor(begin, buffer_.size());
+
+  if (flags_ & CASS_FLAG_TRACING) {
+    if (!cursor.skip(sizeof(CassUuid))) return finish();
+  }
+
+  if (flags_ & CASS_FLAG_WARNING) {
+    uint16_t warning_count = 0;
+    if (!cursor.read_uint16(&warning_count)) return finish();
+    for (uint16_t i = 0; i < warning_count; ++i) {
+      if (!cursor.skip_string()) return finish();
+    }
+  }
+
+  if (flags_ & CASS_FLAG_CUSTOM_PAYLOAD) {
+    uint16_t item_count = 0;
+    if (!cursor.read_uint16(&item_count)) return finish();
+    for (uint16_t i = 0; i < item_count; ++i) {
+      if (!cursor.skip_string() || !cursor.skip_bytes()) return finish();
+    }
+  }
+
+  int32_t kind = 0;
+  if (!cursor.read_int32(&kind)) return finish();
+
+  if (kind != CASS_RESULT_KIND_ROWS) {
+    // Only rows are streamed, everything else is buffered and decoded normally
+    state_ = STATE_BUFFERED;
+    result_->set_buffer(length_);
+    memcpy(result_->data(), begin, buffer_.size());
+    body_buffer_pos_ = result_->data() + buffer_.size();
+    Vector<char>().swap(buffer_);
+    return finish();
+  }
+
+  // This needs to match the order used by `ResultResponse::decode_metadata()`
+  int32_t flags = 0;
+  int32_t column_count = 0;
+  if (!cursor.read_int32(&flags) || !cursor.read_int32(&column_count)) return finish();
+
+  if (flags & CASS_RESULT_FLAG_METADATA_CHANGED) {
+    if (!cursor.skip_string()) return finish();
+  }
+
+  if (flags & CASS_RESULT_FLAG_HAS_MORE_PAGES) {
+    if (!cursor.skip_bytes()) return finish();
+  }
+
+  if (!(flags & CASS_RESULT_FLAG_NO_METADATA)) {
+    bool global_table_spec = flags & CASS_RESULT_FLAG_GLOBAL_TABLESPEC;
+
+    if (global_table_spec) {
+      if (!cursor.skip_string() || !cursor.skip_string()) return finish();
+    }
+
+    for (int32_t i = 0; i < column_count; ++i) {
+      if (!global_table_spec) {
+        if (!cursor.skip_string() || !cursor.skip_string()) return finish();
+      }
+      if (!cursor.skip_string() || !cursor.skip_type()) return finish();
+    }
+  }
+
+  int32_t row_count = 0;
+  if (!cursor.read_int32(&row_count)) return finish();
+
+  if (column_count < 0 || row_count < 0) {
+    LOG_ERROR("Invalid column count %d or row count %d in streamed result", column_count,
+              row_count);
+    return false;
+  }
+
+  // Decode everything before the rows using the normal path, but with a row
+  // count of zero because the rows are passed to the row callback instead.
+  size_t prefix_size = cursor.pos() - begin;
+  result_->set_buffer(prefix_size);
+  memcpy(result_->data(), begin, prefix_size);
+  encode_int32(result_->data() + prefix_size - sizeof(int32_t), 0);
+  if (!result_->decode_body(protocol_version_, flags_)) return false;
+
+  if (row_count > 0 && column_count > 0 && !result_->metadata()) {
+    LOG_ERROR("Unable to stream rows without result metadata");
+    return false;
+  }
+
+  buffer_.erase(buffer_.begin(), buffer_.begin() + prefix_size);
+  column_count_ = column_count;
+  rows_remaining_ = row_count;
+  state_ = STATE_ROWS;
+
+  return decode_rows();
+}
+
+bool RowStream::decode_rows() {
+  const char* begin = buffer_.empty() ? NULL : &buffer_[0];
+  const char* pos = begin;
+  const char* end = begin + buffer_.size();
+
+  while (rows_remaining_ > 0) {
+    Cursor cursor(pos, end - pos);
+
+    bool is_row_complete = true;
+    for (int32_t i = 0; i < column_count_ && is_row_complete; ++i) {
+      is_row_complete = cursor.skip_bytes();
+    }
+    if (!is_row_complete) break;
+
+    // The row's values reference the buffer so they're only valid until the
+    // callback returns.
+    Decoder decoder(pos, cursor.pos() - pos, protocol_version_);
+    Row row(result_);
+    if (!decode_row(decoder, result_, row.values)) return false;
+    callback_(CassRow::to(&row), data_);
+
+    pos = cursor.pos();
+    rows_remaining_--;
+    row_count_++;
+  }
+
+  buffer_.erase(buffer_.begin(), buffer_.begin() + (pos - begin));
+
+  return finish();
+}
+
+bool RowStream::finish() {
+  if (!is_done()) return true;
+
+  switch (state_) {
+    case STATE_PREFIX:
+      LOG_ERROR("Streamed result ended before its metadata was complete");
+      return false;
+
+    case STATE_ROWS:
+      if (rows_remaining_ > 0 || !buffer_.empty()) {
+        LOG_ERROR("Streamed result has an invalid number of rows");
+        return false;
+      }
+      return true;
+
+    case STATE_BUFFERED:
+      return result_->decode_body(protocol_version_, flags_);
+  }
+
+  return false;
+}
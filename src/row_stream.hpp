@@ -0,0 +1,107 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_ROW_STREAM_HPP
+#define DATASTAX_INTERNAL_ROW_STREAM_HPP
+
+#include "allocated.hpp"
+#include "cassandra.h"
+#include "macros.hpp"
+#include "protocol.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class ResultResponse;
+
+/**
+ * An interface used by a response message to determine if the rows of a
+ * RESULT response should be streamed to a row callback.
+ */
+class RowStreamResolver {
+public:
+  virtual ~RowStreamResolver() {}
+
+  /**
+   * Resolve the row callback for a stream. This is called as soon as the
+   * header of a RESULT response is received.
+   *
+   * @param stream The stream of the response.
+   * @param callback The row callback for the request (output).
+   * @param data The user data for the row callback (output).
+   * @return true if the rows of the response should be streamed.
+   */
+  virtual bool resolve_row_callback(int16_t stream, CassRowCallback* callback, void** data) = 0;
+};
+
+/**
+ * Decodes the body of a RESULT response incrementally. The result's metadata
+ * (and everything before it) is decoded as soon as it's available and then
+ * each row is passed to the row callback as soon as its bytes have arrived.
+ * Only a partially received row is buffered so the memory used is bounded by
+ * the size of the largest row instead of the size of the page.
+ *
+ * The finished result contains the metadata and paging state, but no rows.
+ * Results that aren't ROWS are buffered and decoded normally.
+ */
+class RowStream : public Allocated {
+public:
+  RowStream(ProtocolVersion protocol_version, uint8_t flags, int32_t length,
+            ResultResponse* result, CassRowCallback callback, void* data);
+
+  /**
+   * Decode a chunk of the body.
+   *
+   * @param input The chunk of the body. This must not be more than `remaining()`.
+   * @param size The size of the chunk.
+   * @return false if the body is invalid.
+   */
+  bool decode(const char* input, size_t size);
+
+  size_t remaining() const { return length_ - received_; }
+  bool is_done() const { return received_ == length_; }
+
+  size_t row_count() const { return row_count_; }
+
+private:
+  enum State { STATE_PREFIX, STATE_ROWS, STATE_BUFFERED };
+
+  bool decode_prefix();
+  bool decode_rows();
+  bool finish();
+
+private:
+  const ProtocolVersion protocol_version_;
+  const uint8_t flags_;
+  const size_t length_;
+  size_t received_;
+  ResultResponse* const result_;
+  CassRowCallback callback_;
+  void* data_;
+  State state_;
+  Vector<char> buffer_;
+  char* body_buffer_pos_;
+  int32_t column_count_;
+  int32_t rows_remaining_;
+  size_t row_count_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RowStream);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -18,6 +18,7 @@
 
 #include "batch_request.hpp"
 #include "cluster_config.hpp"
+#include "connection.hpp"
 #include "constants.hpp"
 #include "execute_request.hpp"
 #include "external.hpp"
@@ -99,6 +100,17 @@ CassFuture* cass_session_execute_batch(CassSession* session, const CassBatch* ba
   return CassFuture::to(future.get());
 }
 
+CassFuture* cass_session_load_schema_keyspace(CassSession* session, const char* keyspace) {
+  return cass_session_load_schema_keyspace_n(session, keyspace, SAFE_STRLEN(keyspace));
+}
+
+CassFuture* cass_session_load_schema_keyspace_n(CassSession* session, const char* keyspace,
+                                                size_t keyspace_length) {
+  Future::Ptr future(session->load_schema_keyspace(String(keyspace, keyspace_length)));
+  future->inc_ref();
+  return CassFuture::to(future.get());
+}
+
 const CassSchemaMeta* cass_session_get_schema_meta(const CassSession* session) {
   return CassSchemaMeta::to(new Metadata::SchemaSnapshot(session->cluster()->schema_snapshot()));
 }
@@ -167,6 +179,111 @@ void cass_session_get_speculative_execution_metrics(const CassSession* session,
   metrics->percentage = internal_metrics->request_rates.speculative_request_percent();
 }
 
+const CassHistogramSnapshot* cass_session_get_request_latency_histogram(const CassSession* session,
+                                                                        cass_bool_t interval) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get request latency histogram before connecting session object");
+    return NULL;
+  }
+
+  return CassHistogramSnapshot::to(
+      internal_metrics->request_latencies.copy(interval == cass_true));
+}
+
+void cass_session_get_request_stage_metrics(const CassSession* session, CassRequestStage stage,
+                                            CassRequestStageMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get request stage metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassRequestStageMetrics));
+    return;
+  }
+
+  if (!internal_metrics->request_stage_latencies || stage < 0 ||
+      stage >= CASS_REQUEST_STAGE_LAST_ENTRY) {
+    memset(metrics, 0, sizeof(CassRequestStageMetrics));
+    return;
+  }
+
+  Metrics::Histogram::Snapshot stage_snapshot;
+  internal_metrics->request_stage_latencies->get(stage).get_snapshot(&stage_snapshot);
+
+  metrics->min = stage_snapshot.min;
+  metrics->max = stage_snapshot.max;
+  metrics->mean = stage_snapshot.mean;
+  metrics->stddev = stage_snapshot.stddev;
+  metrics->median = stage_snapshot.median;
+  metrics->percentile_75th = stage_snapshot.percentile_75th;
+  metrics->percentile_95th = stage_snapshot.percentile_95th;
+  metrics->percentile_98th = stage_snapshot.percentile_98th;
+  metrics->percentile_99th = stage_snapshot.percentile_99th;
+  metrics->percentile_999th = stage_snapshot.percentile_999th;
+}
+
+CassError cass_session_get_event_loop_metrics(const CassSession* session, size_t index,
+                                              CassEventLoopMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get event loop metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassEventLoopMetrics));
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+
+  Metrics::EventLoopGauges::Stats stats;
+  if (!internal_metrics->event_loops.get(index, &stats)) {
+    memset(metrics, 0, sizeof(CassEventLoopMetrics));
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+
+  metrics->utilization = stats.utilization;
+  metrics->lag = stats.lag_us;
+  metrics->callback_time = stats.callback_time_us;
+  return CASS_OK;
+}
+
+const CassHistogramSnapshot* cass_session_get_event_loop_lag_histogram(const CassSession* session,
+                                                                       cass_bool_t interval) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get event loop lag histogram before connecting session object");
+    return NULL;
+  }
+
+  return CassHistogramSnapshot::to(internal_metrics->event_loop_lag.copy(interval == cass_true));
+}
+
+size_t cass_session_get_connection_metrics(const CassSession* session,
+                                           CassConnectionMetrics* metrics, size_t metrics_count) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get connection metrics before connecting session object");
+    return 0;
+  }
+
+  ConnectionStats::Vec stats;
+  internal_metrics->connections.stats(&stats);
+
+  for (size_t i = 0; i < stats.size() && i < metrics_count; ++i) {
+    CassConnectionMetrics* output = &metrics[i];
+    output->host.address_length = stats[i].address.to_inet(output->host.address);
+    output->streams_in_use = stats[i].streams_in_use;
+    output->max_streams_in_use = stats[i].max_streams_in_use;
+    output->bytes_read = stats[i].bytes_read;
+    output->bytes_written = stats[i].bytes_written;
+    output->pending_writes = stats[i].pending_writes;
+    output->write_queue_size = stats[i].write_queue_size;
+    output->write_blocked_time = stats[i].write_blocked_time_ns / 1000;
+    output->heartbeat_rtt = stats[i].heartbeat_rtt_ns / 1000;
+  }
+  return stats.size();
+}
+
 CassUuid cass_session_get_client_id(CassSession* session) { return session->client_id(); }
 
 } // extern "C"
@@ -257,6 +374,7 @@ private:
         session_->cluster()->start_monitor_reporting(to_string(session_->client_id()),
                                                      to_string(session_->session_id()),
                                                      session_->config());
+        session_->prepare_cached_statements();
       }
       l.unlock(); // Unlock before destroying the object
       dec_ref();
@@ -285,15 +403,20 @@ Session::~Session() {
   uv_mutex_destroy(&mutex_);
 }
 
+Future::Ptr Session::load_schema_keyspace(const String& keyspace_name) {
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  Cluster::Ptr cluster(this->cluster());
+  if (!cluster) {
+    future->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
+  } else {
+    cluster->load_schema_keyspace(keyspace_name, future);
+  }
+  return future;
+}
+
 Future::Ptr Session::prepare(const char* statement, size_t length) {
   PrepareRequest::Ptr prepare(new PrepareRequest(String(statement, length)));
-
-  ResponseFuture::Ptr future(new ResponseFuture(cluster()->schema_snapshot()));
-  future->prepare_request = PrepareRequest::ConstPtr(prepare);
-
-  execute(RequestHandler::Ptr(new RequestHandler(prepare, future, metrics())));
-
-  return future;
+  return execute_prepare(prepare);
 }
 
 Future::Ptr Session::prepare(const Statement* statement) {
@@ -311,22 +434,21 @@ Future::Ptr Session::prepare(const Statement* statement) {
   // inherited by bound statements.
   prepare->set_settings(statement->settings());
 
-  ResponseFuture::Ptr future(new ResponseFuture(cluster()->schema_snapshot()));
-  future->prepare_request = PrepareRequest::ConstPtr(prepare);
-
-  execute(RequestHandler::Ptr(new RequestHandler(prepare, future, metrics())));
-
-  return future;
+  return execute_prepare(prepare);
 }
 
 Future::Ptr Session::execute(const Request::ConstPtr& request) {
   ResponseFuture::Ptr future(new ResponseFuture());
 
-  RequestHandler::Ptr request_handler(new RequestHandler(request, future, metrics()));
+  RequestHandler::Ptr request_handler(
+      new RequestHandler(request, future, metrics(), config().tracer()));
 
   if (request_handler->request()->opcode() == CQL_OPCODE_EXECUTE) {
     const ExecuteRequest* execute = static_cast<const ExecuteRequest*>(request_handler->request());
-    request_handler->set_prepared_metadata(cluster()->prepared(execute->prepared()->id()));
+    const Prepared::ConstPtr& prepared(execute->prepared());
+    PreparedMetadata::Entry::Ptr entry(cluster()->prepared(prepared->id(), prepared->id_hash()));
+    if (entry) entry->mark_used();
+    request_handler->set_prepared_metadata(entry);
   }
 
   execute(request_handler);
@@ -334,6 +456,70 @@ Future::Ptr Session::execute(const Request::ConstPtr& request) {
   return future;
 }
 
+Future::Ptr Session::execute_prepare(const PrepareRequest::Ptr& prepare) {
+  ResponseFuture::Ptr future(new ResponseFuture(cluster()->schema_snapshot()));
+  future->prepare_request = PrepareRequest::ConstPtr(prepare);
+
+  // Prepared IDs depend on the keyspace so only statements without a
+  // per-query keyspace are cached.
+  MetadataCache::Ptr cache(metadata_cache());
+  if (cache && prepare->keyspace().empty()) {
+    String keyspace;
+    {
+      ScopedMutex l(&mutex_);
+      keyspace = keyspace_;
+    }
+
+    // Only results that were prepared by the server since the last schema
+    // change are returned, so the result metadata is up-to-date.
+    ResultResponse::Ptr result(cache->prepared(keyspace, prepare->query()));
+    if (result) {
+      cluster()->prepared(result->prepared_id().to_string(),
+                          PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                              prepare->query(), result->quoted_keyspace(),
+                              result->result_metadata_id().to_string(),
+                              ResultResponse::ConstPtr(result))));
+      future->set_response(Address(), result);
+      return future;
+    }
+
+    cache->add_prepared(keyspace, prepare->query(), future);
+  }
+
+  execute(RequestHandler::Ptr(new RequestHandler(prepare, future, metrics(), config().tracer())));
+
+  return future;
+}
+
+void Session::prepare_cached_statements() {
+  MetadataCache::Ptr cache(metadata_cache());
+  if (!cache) return;
+
+  String keyspace;
+  {
+    ScopedMutex l(&mutex_);
+    keyspace = keyspace_;
+  }
+
+  // Statements loaded from the metadata cache file are prepared again in the
+  // background. This makes sure the result metadata matches the current schema
+  // before the cached results are used.
+  StringVec queries;
+  cache->unvalidated_prepared(keyspace, &queries);
+  for (StringVec::const_iterator it = queries.begin(), end = queries.end(); it != end; ++it) {
+    PrepareRequest::Ptr prepare(new PrepareRequest(*it));
+    ResponseFuture::Ptr future(new ResponseFuture(cluster()->schema_snapshot()));
+    future->prepare_request = PrepareRequest::ConstPtr(prepare);
+    cache->add_prepared(keyspace, *it, future);
+    execute(RequestHandler::Ptr(new RequestHandler(prepare, future, metrics(), config().tracer())));
+  }
+
+  if (!queries.empty()) {
+    LOG_DEBUG("Preparing %u statement(s) from the metadata cache",
+              static_cast<unsigned>(queries.size()));
+  }
+}
+
 void Session::execute(const RequestHandler::Ptr& request_handler) {
   if (state() != SESSION_STATE_CONNECTED) {
     request_handler->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
@@ -382,6 +568,18 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
     return;
   }
 
+  if (config().metrics_exporter_port() > 0) {
+    ScopedMutex l(&mutex_);
+    metrics_exporter_.reset(new MetricsExporter(metrics(), cluster()));
+    rc = metrics_exporter_->start(config().metrics_exporter_port());
+    if (rc != 0) {
+      // The exporter is optional so the session is still connected
+      LOG_ERROR("Unable to start metrics exporter on port %d: %s",
+                config().metrics_exporter_port(), uv_strerror(rc));
+      metrics_exporter_.reset();
+    }
+  }
+
   for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
     const Host::Ptr& host = it->second;
     config().host_listener()->on_host_added(host);
@@ -389,9 +587,14 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
         host); // If host is down it will be marked down later in the connection process
   }
 
+  if (metadata_cache()) {
+    metadata_cache()->validate_prepared(protocol_version);
+  }
+
   request_processors_.clear();
   request_processor_count_ = 0;
   is_closing_ = false;
+  keyspace_ = connect_keyspace();
   SessionInitializer::Ptr initializer(new SessionInitializer(this));
   initializer->initialize(connected_host, protocol_version, hosts, token_map, local_dc);
 }
@@ -401,6 +604,7 @@ void Session::on_close() {
   // first before sending the close notification.
   ScopedMutex l(&mutex_);
   is_closing_ = true;
+  metrics_exporter_.reset();
   if (request_processor_count_ > 0) {
     for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
                                                end = request_processors_.end();
@@ -495,6 +699,7 @@ void Session::on_pool_critical_error(const Address& address, Connector::Connecti
 void Session::on_keyspace_changed(const String& keyspace,
                                   const KeyspaceChangedHandler::Ptr& handler) {
   ScopedMutex l(&mutex_);
+  keyspace_ = keyspace;
   for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
                                              end = request_processors_.end();
        it != end; ++it) {
@@ -19,6 +19,7 @@
 
 #include "allocated.hpp"
 #include "metrics.hpp"
+#include "metrics_exporter.hpp"
 #include "mpmc_queue.hpp"
 #include "request_processor.hpp"
 #include "session_base.hpp"
@@ -44,9 +45,15 @@ public:
 
   Future::Ptr execute(const Request::ConstPtr& request);
 
+  Future::Ptr load_schema_keyspace(const String& keyspace_name);
+
 private:
   void execute(const RequestHandler::Ptr& request_handler);
 
+  Future::Ptr execute_prepare(const PrepareRequest::Ptr& prepare);
+
+  void prepare_cached_statements();
+
   void join();
 
 private:
@@ -102,10 +109,13 @@ private:
 
 private:
   ScopedPtr<RoundRobinEventLoopGroup> event_loop_group_;
+  ScopedPtr<MetricsExporter> metrics_exporter_;
   uv_mutex_t mutex_;
   RequestProcessor::Vec request_processors_;
   size_t request_processor_count_;
   bool is_closing_;
+  // The keyspace used by the request processors (changed by "USE" queries)
+  String keyspace_;
 };
 
 }}} // namespace datastax::internal::core
@@ -97,7 +97,14 @@ Future::Ptr SessionBase::connect(const Config& config, const String& keyspace) {
     random_.reset();
   }
 
-  metrics_.reset(new Metrics(config.thread_count_io() + 1));
+  metrics_.reset(new Metrics(config.thread_count_io() + 1, config.request_stage_timings()));
+
+  if (!config.metadata_cache_file().empty()) {
+    metadata_cache_.reset(new MetadataCache(config.metadata_cache_file()));
+    metadata_cache_->load();
+  } else {
+    metadata_cache_.reset();
+  }
 
   cluster_.reset();
   ClusterConnector::Ptr connector(
@@ -107,6 +114,7 @@ Future::Ptr SessionBase::connect(const Config& config, const String& keyspace) {
   ClusterSettings settings(config_);
   settings.control_connection_settings.connection_settings.client_id = to_string(client_id_);
   settings.disable_events_on_startup = true;
+  settings.control_connection_settings.metadata_cache = metadata_cache_;
 
   connector->with_listener(this)
       ->with_settings(settings)
@@ -171,6 +179,16 @@ void SessionBase::on_connect_failed(CassError code, const String& message) {
 void SessionBase::on_close() { notify_closed(); }
 
 void SessionBase::on_close(Cluster* cluster) {
+  MetadataCache::Ptr metadata_cache;
+  {
+    ScopedMutex l(&mutex_);
+    if (state_ == SESSION_STATE_CLOSING) metadata_cache = metadata_cache_;
+  }
+
+  // The file is written without holding the session's lock. The session stays
+  // in the closing state until it's written.
+  if (metadata_cache) metadata_cache->save();
+
   ScopedMutex l(&mutex_);
   if (state_ == SESSION_STATE_CLOSING) {
     state_ = SESSION_STATE_CLOSED;
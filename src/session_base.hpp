@@ -18,6 +18,7 @@
 #define DATASTAX_INTERNAL_SESSION_BASE_HPP
 
 #include "cluster_connector.hpp"
+#include "metadata_cache.hpp"
 #include "prepared.hpp"
 #include "schema_agreement_handler.hpp"
 #include "token_map.hpp"
@@ -79,6 +80,7 @@ public:
   Random* random() const { return random_.get(); }
   Metrics* metrics() const { return metrics_.get(); }
   State state() const { return state_; }
+  const MetadataCache::Ptr& metadata_cache() const { return metadata_cache_; }
 
 protected:
   /**
@@ -162,6 +164,7 @@ private:
   Future::Ptr close_future_;
   CassUuid client_id_;
   CassUuid session_id_;
+  MetadataCache::Ptr metadata_cache_;
 };
 
 } // namespace core
@@ -266,6 +266,7 @@ void SocketWriteBase::handle_write(uv_write_t* req, int status) {
   }
 
   socket->pending_writes_.remove(this);
+  socket->update_write_stats();
 
   if (socket->free_writes_.size() < socket->max_reusable_write_objects_) {
     clear();
@@ -280,7 +281,13 @@ void SocketWriteBase::handle_write(uv_write_t* req, int status) {
 Socket::Socket(const Address& address, size_t max_reusable_write_objects)
     : is_defunct_(false)
     , max_reusable_write_objects_(max_reusable_write_objects)
-    , address_(address) {
+    , address_(address)
+    , bytes_read_(0)
+    , bytes_written_(0)
+    , pending_write_count_(0)
+    , write_queue_size_(0)
+    , write_blocked_ns_(0)
+    , write_blocked_start_ns_(0) {
   tcp_.data = this;
 }
 
@@ -313,6 +320,7 @@ int32_t Socket::write(SocketRequest* request) {
     } else {
       pending_writes_.add_to_back(handler_->new_pending_write(this));
     }
+    pending_write_count_.store(pending_writes_.size(), MEMORY_ORDER_RELAXED);
   }
 
   return pending_writes_.back()->write(request);
@@ -329,7 +337,39 @@ int32_t Socket::write_and_flush(SocketRequest* request) {
 size_t Socket::flush() {
   if (pending_writes_.is_empty()) return 0;
 
-  return pending_writes_.back()->flush();
+  size_t total = pending_writes_.back()->flush();
+  if (total > 0) {
+    bytes_written_.fetch_add(total, MEMORY_ORDER_RELAXED);
+    update_write_stats();
+  }
+  return total;
+}
+
+uint64_t Socket::write_blocked_time_ns() const {
+  uint64_t blocked_ns = write_blocked_ns_.load(MEMORY_ORDER_RELAXED);
+  uint64_t start_ns = write_blocked_start_ns_.load(MEMORY_ORDER_RELAXED);
+  if (start_ns > 0) {
+    uint64_t now = uv_hrtime();
+    if (now > start_ns) blocked_ns += now - start_ns; // Include the current blocked period
+  }
+  return blocked_ns;
+}
+
+void Socket::update_write_stats() {
+  pending_write_count_.store(pending_writes_.size(), MEMORY_ORDER_RELAXED);
+
+  // libuv attempts to write immediately and only queues the bytes that the
+  // socket couldn't accept.
+  size_t queue_size = tcp_.write_queue_size;
+  write_queue_size_.store(queue_size, MEMORY_ORDER_RELAXED);
+
+  uint64_t start_ns = write_blocked_start_ns_.load(MEMORY_ORDER_RELAXED);
+  if (queue_size > 0 && start_ns == 0) {
+    write_blocked_start_ns_.store(uv_hrtime(), MEMORY_ORDER_RELAXED);
+  } else if (queue_size == 0 && start_ns > 0) {
+    write_blocked_ns_.fetch_add(uv_hrtime() - start_ns, MEMORY_ORDER_RELAXED);
+    write_blocked_start_ns_.store(0, MEMORY_ORDER_RELAXED);
+  }
 }
 
 bool Socket::is_closing() const {
@@ -364,6 +404,8 @@ void Socket::handle_read(ssize_t nread, const uv_buf_t* buf) {
       LOG_ERROR("Socket read error '%s'", uv_strerror(nread));
     }
     defunct();
+  } else {
+    bytes_read_.fetch_add(nread, MEMORY_ORDER_RELAXED);
   }
   handler_->on_read(this, nread, buf);
 }
@@ -381,6 +423,7 @@ void Socket::handle_close() {
     pending_write->on_close();
     delete pending_write;
   }
+  update_write_stats();
 
   if (handler_) {
     handler_->on_close();
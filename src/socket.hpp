@@ -18,6 +18,7 @@
 #define DATASTAX_INTERNAL_SOCKET_HPP
 
 #include "allocated.hpp"
+#include "atomic.hpp"
 #include "buffer.hpp"
 #include "constants.hpp"
 #include "list.hpp"
@@ -351,6 +352,47 @@ public:
 
   const Address& address() const { return address_; }
 
+  /**
+   * Get the total number of bytes read from the socket (thread-safe).
+   *
+   * @return The number of bytes read (encrypted bytes when using SSL).
+   */
+  uint64_t bytes_read() const { return bytes_read_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Get the total number of bytes flushed to the socket (thread-safe).
+   *
+   * @return The number of bytes written (encrypted bytes when using SSL).
+   */
+  uint64_t bytes_written() const { return bytes_written_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Get the number of coalesced writes that are waiting to be flushed or
+   * waiting for their flush to finish (thread-safe).
+   *
+   * @return The depth of the pending write queue.
+   */
+  size_t pending_write_count() const { return pending_write_count_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Get the number of flushed bytes that couldn't be written immediately
+   * because the socket wasn't writable (thread-safe).
+   *
+   * @return The number of bytes queued by libuv.
+   */
+  size_t write_queue_size() const { return write_queue_size_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Get the total time flushed bytes have been queued because the socket
+   * wasn't writable, e.g. the kernel's send buffer was full (thread-safe).
+   *
+   * @return The time the socket has been write-blocked (in nanoseconds).
+   */
+  uint64_t write_blocked_time_ns() const;
+
+private:
+  void update_write_stats();
+
 private:
   static void alloc_buffer(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf);
 
@@ -375,6 +417,13 @@ private:
   size_t max_reusable_write_objects_;
 
   Address address_;
+
+  Atomic<uint64_t> bytes_read_;
+  Atomic<uint64_t> bytes_written_;
+  Atomic<size_t> pending_write_count_;
+  Atomic<size_t> write_queue_size_;
+  Atomic<uint64_t> write_blocked_ns_;
+  Atomic<uint64_t> write_blocked_start_ns_;
 };
 
 }}} // namespace datastax::internal::core
@@ -103,6 +103,12 @@ CassError cass_statement_set_paging_state_token(CassStatement* statement, const
   return CASS_OK;
 }
 
+CassError cass_statement_set_row_callback(CassStatement* statement, CassRowCallback callback,
+                                          void* data) {
+  statement->set_row_callback(callback, data);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_retry_policy(CassStatement* statement, CassRetryPolicy* retry_policy) {
   statement->set_retry_policy(retry_policy);
   return CASS_OK;
@@ -262,7 +268,9 @@ Statement::Statement(const char* query, size_t query_length, size_t values_count
     , AbstractData(values_count)
     , query_or_id_(sizeof(int32_t) + query_length)
     , flags_(0)
-    , page_size_(-1) {
+    , page_size_(-1)
+    , row_callback_(NULL)
+    , row_callback_data_(NULL) {
   // <query> [long string]
   query_or_id_.encode_long_string(0, query, query_length);
 }
@@ -272,7 +280,9 @@ Statement::Statement(const Prepared* prepared)
     , AbstractData(prepared->result()->column_count())
     , query_or_id_(sizeof(uint16_t) + prepared->id().size())
     , flags_(0)
-    , page_size_(-1) {
+    , page_size_(-1)
+    , row_callback_(NULL)
+    , row_callback_data_(NULL) {
   // <id> [short bytes] (or [string])
   const String& id = prepared->id();
   query_or_id_.encode_string(0, id.data(), static_cast<uint16_t>(id.size()));
@@ -69,6 +69,26 @@ public:
 
   void set_paging_state(const String& paging_state) { paging_state_ = paging_state; }
 
+  CassRowCallback row_callback() const { return row_callback_; }
+
+  void* row_callback_data() const { return row_callback_data_; }
+
+  void set_row_callback(CassRowCallback callback, void* data) {
+    row_callback_ = callback;
+    row_callback_data_ = data;
+  }
+
+  /**
+   * Determine if the rows of a request's result are streamed to a row callback.
+   *
+   * @param request A request (only query and execute requests can have a row callback).
+   * @return true if the request is a statement with a row callback.
+   */
+  static bool has_row_callback(const Request* request) {
+    return (request->opcode() == CQL_OPCODE_QUERY || request->opcode() == CQL_OPCODE_EXECUTE) &&
+           static_cast<const Statement*>(request)->row_callback() != NULL;
+  }
+
   uint8_t kind() const {
     return opcode() == CQL_OPCODE_QUERY ? CASS_BATCH_KIND_QUERY : CASS_BATCH_KIND_PREPARED;
   }
@@ -97,6 +117,8 @@ private:
   int32_t flags_;
   int32_t page_size_;
   String paging_state_;
+  CassRowCallback row_callback_;
+  void* row_callback_data_;
   Vector<size_t> key_indices_;
 
 private:
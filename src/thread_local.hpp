@@ -0,0 +1,92 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_THREAD_LOCAL_HPP
+#define DATASTAX_INTERNAL_THREAD_LOCAL_HPP
+
+#include "macros.hpp"
+#include "scoped_lock.hpp"
+#include "vector.hpp"
+
+#include <assert.h>
+#include <uv.h>
+
+namespace datastax { namespace internal {
+
+/**
+ * A per-object, per-thread value. Values are owned by this object and are
+ * deleted when it's destroyed, not when their thread exits, so this is meant
+ * for a bounded number of long-lived threads.
+ *
+ * Thread-local keys are a limited resource. If a key can't be created then
+ * `is_valid()` is false and callers need to fall back to shared state.
+ */
+template <class T>
+class ThreadLocal {
+public:
+  ThreadLocal()
+      : is_valid_(uv_key_create(&key_) == 0) {
+    uv_mutex_init(&mutex_);
+  }
+
+  ~ThreadLocal() {
+    for (typename Vector<T*>::iterator it = values_.begin(), end = values_.end(); it != end; ++it) {
+      delete *it;
+    }
+    if (is_valid_) {
+      uv_key_delete(&key_);
+    }
+    uv_mutex_destroy(&mutex_);
+  }
+
+  bool is_valid() const { return is_valid_; }
+
+  /**
+   * Get the calling thread's value. This doesn't lock or write to any shared
+   * state.
+   *
+   * @return The value or NULL if the thread doesn't have a value yet.
+   */
+  T* get() const { return is_valid_ ? static_cast<T*>(uv_key_get(&key_)) : NULL; }
+
+  /**
+   * Set the calling thread's value. This should only be called once per thread.
+   *
+   * @param value A value to be owned by this object.
+   * @return The number of values set before this one, which can be used as a
+   * unique index for the calling thread.
+   */
+  size_t set(T* value) {
+    assert(is_valid_ && get() == NULL);
+    ScopedMutex l(&mutex_);
+    values_.push_back(value);
+    uv_key_set(&key_, value);
+    return values_.size() - 1;
+  }
+
+private:
+  bool is_valid_;
+  mutable uv_key_t key_;
+  uv_mutex_t mutex_;
+  Vector<T*> values_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ThreadLocal);
+};
+
+}} // namespace datastax::internal
+
+#endif
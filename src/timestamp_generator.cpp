@@ -19,6 +19,7 @@
 #include "external.hpp"
 #include "get_time.hpp"
 #include "logger.hpp"
+#include "utils.hpp"
 
 using namespace datastax::internal::core;
 
@@ -44,6 +45,12 @@ CassTimestampGen* cass_timestamp_gen_monotonic_new_with_settings(int64_t warning
   return CassTimestampGen::to(timestamp_gen);
 }
 
+CassTimestampGen* cass_timestamp_gen_batched_monotonic_new(int64_t block_size_us) {
+  TimestampGenerator* timestamp_gen = new BatchedMonotonicTimestampGenerator(block_size_us);
+  timestamp_gen->inc_ref();
+  return CassTimestampGen::to(timestamp_gen);
+}
+
 void cass_timestamp_gen_free(CassTimestampGen* timestamp_gen) { timestamp_gen->dec_ref(); }
 
 } // extern "C"
@@ -60,9 +67,7 @@ int64_t MonotonicTimestampGenerator::next() {
 
 // This is guaranteed to return a monotonic timestamp. If clock skew is detected
 // then this method will increment the last timestamp.
-int64_t MonotonicTimestampGenerator::compute_next(int64_t last) {
-  int64_t current = get_time_since_epoch_us();
-
+int64_t MonotonicTimestampGenerator::compute_next(int64_t last, int64_t current) {
   if (last >= current) { // There's clock skew
     // If we exceed our warning threshold then warn periodically that clock
     // skew has been detected.
@@ -87,3 +92,54 @@ int64_t MonotonicTimestampGenerator::compute_next(int64_t last) {
 
   return current;
 }
+
+int64_t BatchedMonotonicTimestampGenerator::next() {
+  if (!blocks_.is_valid()) {
+    return MonotonicTimestampGenerator::next();
+  }
+
+  Block* block = blocks_.get();
+  if (block == NULL) {
+    block = new Block();
+    blocks_.set(block);
+  }
+
+  int64_t current = get_time_since_epoch_us();
+  int64_t next = current > block->last ? current : block->last + 1;
+  if (next > block->end) {
+    reserve(block);
+    next = block->last + 1;
+  }
+  block->last = next;
+  return next;
+}
+
+// Reserve the next block of timestamps. Every block spans the whole block size
+// so the shared timestamp is only updated once per block. A block never starts
+// more than the block size past the current time: if the shared timestamp is
+// already a block ahead then the thread waits for the clock to catch up. This
+// keeps the shared timestamp less than two blocks ahead of the clock, so if
+// it's further ahead the clock went backwards and the start of the block is
+// computed the same way as a single timestamp to report the clock skew.
+void BatchedMonotonicTimestampGenerator::reserve(Block* block) {
+  while (true) {
+    int64_t last = last_.load();
+    int64_t current = get_time_since_epoch_us();
+    int64_t ahead = last - current;
+    int64_t start;
+    if (ahead < block_size_us_) {
+      start = ahead < 0 ? current : last + 1;
+    } else if (ahead < 2 * block_size_us_) {
+      thread_yield();
+      continue;
+    } else {
+      start = compute_next(last, current);
+    }
+    int64_t end = start + block_size_us_ - 1;
+    if (last_.compare_exchange_strong(last, end)) {
+      block->last = start - 1;
+      block->end = end;
+      return;
+    }
+  }
+}
@@ -17,12 +17,15 @@
 #ifndef DATASTAX_INTERNAL_TIMESTAMP_GENERATOR_HPP
 #define DATASTAX_INTERNAL_TIMESTAMP_GENERATOR_HPP
 
+#include "allocated.hpp"
 #include "atomic.hpp"
 #include "constants.hpp"
 #include "external.hpp"
+#include "get_time.hpp"
 #include "macros.hpp"
 #include "ref_counted.hpp"
 #include "request.hpp"
+#include "thread_local.hpp"
 
 #include <stdint.h>
 
@@ -32,7 +35,7 @@ class TimestampGenerator : public RefCounted<TimestampGenerator> {
 public:
   typedef SharedRefPtr<TimestampGenerator> Ptr;
 
-  enum Type { SERVER_SIDE, MONOTONIC };
+  enum Type { SERVER_SIDE, MONOTONIC, BATCHED_MONOTONIC };
 
   TimestampGenerator(Type type)
       : type_(type) {}
@@ -70,16 +73,65 @@ public:
 
   virtual int64_t next();
 
-private:
-  int64_t compute_next(int64_t last);
+protected:
+  MonotonicTimestampGenerator(Type type, int64_t warning_threshold_us,
+                              int64_t warning_interval_ms)
+      : TimestampGenerator(type)
+      , last_(0)
+      , last_warning_(0)
+      , warning_threshold_us_(warning_threshold_us)
+      , warning_interval_ms_(warning_interval_ms < 0 ? 0 : warning_interval_ms) {}
+
+  int64_t compute_next(int64_t last) { return compute_next(last, get_time_since_epoch_us()); }
+  int64_t compute_next(int64_t last, int64_t current);
 
   Atomic<int64_t> last_;
+
+private:
   Atomic<int64_t> last_warning_;
 
   const int64_t warning_threshold_us_;
   const int64_t warning_interval_ms_;
 };
 
+/**
+ * A monotonic timestamp generator that reserves blocks of timestamps for each
+ * thread so that the shared timestamp is only updated once per block instead
+ * of once per timestamp. Timestamps are monotonic within a thread, but a thread
+ * can generate a timestamp that's up to the block size behind a timestamp
+ * already generated by another thread. A block never starts more than the
+ * block size past the current time, so a thread that uses timestamps faster
+ * than the clock advances waits for the clock before reserving its next block.
+ */
+class BatchedMonotonicTimestampGenerator : public MonotonicTimestampGenerator {
+public:
+  BatchedMonotonicTimestampGenerator(int64_t block_size_us = 1000,
+                                     int64_t warning_threshold_us = 1000000,
+                                     int64_t warning_interval_ms = 1000)
+      : MonotonicTimestampGenerator(BATCHED_MONOTONIC, warning_threshold_us, warning_interval_ms)
+      , block_size_us_(block_size_us < 1 ? 1 : block_size_us) {}
+
+  virtual int64_t next();
+
+  int64_t block_size_us() const { return block_size_us_; }
+
+private:
+  struct Block : public Allocated {
+    Block()
+        : last(0)
+        , end(0) {}
+
+    int64_t last;
+    int64_t end; // Inclusive
+  };
+
+  void reserve(Block* block);
+
+private:
+  const int64_t block_size_us_;
+  ThreadLocal<Block> blocks_;
+};
+
 }}} // namespace datastax::internal::core
 
 EXTERNAL_TYPE(datastax::internal::core::TimestampGenerator, CassTimestampGen)
@@ -39,6 +39,7 @@ public:
   virtual void add_host(const Host::Ptr& host) = 0;
   virtual void update_host_and_build(const Host::Ptr& host) = 0;
   virtual void remove_host_and_build(const Host::Ptr& host) = 0;
+  virtual void remove_host(const Host::Ptr& host) = 0;
 
   virtual void add_keyspaces(const VersionNumber& cassandra_version,
                              const ResultResponse* result) = 0;
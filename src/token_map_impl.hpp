@@ -565,6 +565,7 @@ public:
   virtual void add_host(const Host::Ptr& host);
   virtual void update_host_and_build(const Host::Ptr& host);
   virtual void remove_host_and_build(const Host::Ptr& host);
+  virtual void remove_host(const Host::Ptr& host);
 
   virtual void add_keyspaces(const VersionNumber& cassandra_version, const ResultResponse* result);
   virtual void update_keyspaces_and_build(const VersionNumber& cassandra_version,
@@ -660,6 +661,13 @@ void TokenMapImpl<Partitioner>::remove_host_and_build(const Host::Ptr& host) {
       (double)(uv_hrtime() - start) / (1000.0 * 1000.0));
 }
 
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::remove_host(const Host::Ptr& host) {
+  if (hosts_.find(host) == hosts_.end()) return;
+  remove_host_tokens(host);
+  hosts_.erase(host);
+}
+
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::add_keyspaces(const VersionNumber& cassandra_version,
                                               const ResultResponse* result) {
@@ -17,6 +17,7 @@
 #include "utils.hpp"
 
 #include "constants.hpp"
+#include "get_time.hpp"
 
 #include <algorithm>
 #include <assert.h>
@@ -153,6 +154,11 @@ int32_t get_pid() {
 #endif
 }
 
+bool sample_one_in_n(unsigned n) {
+  uint64_t bits = get_time_monotonic_ns() * 0x9E3779B97F4A7C15ULL;
+  return (bits >> 32) % n == 0;
+}
+
 void thread_yield() {
 #if defined(WIN32) || defined(_WIN32)
   SwitchToThread();
@@ -108,6 +108,16 @@ inline size_t vint_size(int64_t value) {
 
 int32_t get_pid();
 
+/**
+ * Sample roughly one in every `n` calls using the mixed bits of the current
+ * time. Unlike a shared random number generator or counter, this doesn't
+ * write to any shared state so calls that aren't sampled are contention free.
+ *
+ * @param n The sample rate. Must be greater than zero.
+ * @return true if this call is sampled.
+ */
+bool sample_one_in_n(unsigned n);
+
 void set_thread_name(const String& thread_name);
 
 template <class C>
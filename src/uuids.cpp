@@ -30,6 +30,8 @@
 #define TIME_OFFSET_BETWEEN_UTC_AND_EPOCH 0x01B21DD213814000LL // Nanoseconds
 #define MIN_CLOCK_SEQ_AND_NODE 0x8080808080808080LL
 #define MAX_CLOCK_SEQ_AND_NODE 0x7f7f7f7f7f7f7f7fLL
+#define CLOCK_SEQ_MASK 0x0000000000003FFFLL
+#define CLOCK_SEQ_SHIFT 48
 
 using namespace datastax::internal;
 using namespace datastax::internal::core;
@@ -58,10 +60,18 @@ void cass_uuid_gen_time(CassUuidGen* uuid_gen, CassUuid* output) {
   uuid_gen->generate_time(output);
 }
 
+void cass_uuid_gen_time_batch(CassUuidGen* uuid_gen, CassUuid* outputs, size_t count) {
+  uuid_gen->generate_time(outputs, count);
+}
+
 void cass_uuid_gen_random(CassUuidGen* uuid_gen, CassUuid* output) {
   uuid_gen->generate_random(output);
 }
 
+void cass_uuid_gen_random_batch(CassUuidGen* uuid_gen, CassUuid* outputs, size_t count) {
+  uuid_gen->generate_random(outputs, count);
+}
+
 void cass_uuid_gen_from_time(CassUuidGen* uuid_gen, cass_uint64_t timestamp, CassUuid* output) {
   uuid_gen->from_time(timestamp, output);
 }
@@ -162,7 +172,8 @@ CassError cass_uuid_from_string_n(const char* str, size_t str_length, CassUuid*
 UuidGen::UuidGen()
     : clock_seq_and_node_(0)
     , last_timestamp_(0LL)
-    , ng_(get_random_seed(MT19937_64::DEFAULT_SEED)) {
+    , ng_(get_random_seed(MT19937_64::DEFAULT_SEED))
+    , thread_count_(0) {
   uv_mutex_init(&mutex_);
 
   Md5 md5;
@@ -223,16 +234,29 @@ UuidGen::UuidGen()
 UuidGen::UuidGen(uint64_t node)
     : clock_seq_and_node_(0)
     , last_timestamp_(0LL)
-    , ng_(get_random_seed(MT19937_64::DEFAULT_SEED)) {
+    , ng_(get_random_seed(MT19937_64::DEFAULT_SEED))
+    , thread_count_(0) {
   uv_mutex_init(&mutex_);
   set_clock_seq_and_node(node & 0x0000FFFFFFFFFFFFLL);
 }
 
 UuidGen::~UuidGen() { uv_mutex_destroy(&mutex_); }
 
-void UuidGen::generate_time(CassUuid* output) {
-  output->time_and_version = set_version(monotonic_timestamp(), 1);
-  output->clock_seq_and_node = clock_seq_and_node_;
+void UuidGen::generate_time(CassUuid* output) { generate_time(output, 1); }
+
+void UuidGen::generate_time(CassUuid* outputs, size_t count) {
+  ThreadState* state = thread_state();
+  if (state != NULL) {
+    for (size_t i = 0; i < count; ++i) {
+      outputs[i].time_and_version = set_version(state->monotonic_timestamp(), 1);
+      outputs[i].clock_seq_and_node = state->clock_seq_and_node;
+    }
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      outputs[i].time_and_version = set_version(monotonic_timestamp(), 1);
+      outputs[i].clock_seq_and_node = clock_seq_and_node_;
+    }
+  }
 }
 
 void UuidGen::from_time(uint64_t timestamp, CassUuid* output) {
@@ -240,20 +264,33 @@ void UuidGen::from_time(uint64_t timestamp, CassUuid* output) {
   output->clock_seq_and_node = clock_seq_and_node_;
 }
 
-void UuidGen::generate_random(CassUuid* output) {
-  ScopedMutex lock(&mutex_);
-  uint64_t time_and_version = ng_();
-  uint64_t clock_seq_and_node = ng_();
-  lock.unlock();
-
+static void set_random(uint64_t time_and_version, uint64_t clock_seq_and_node, CassUuid* output) {
   output->time_and_version = set_version(time_and_version, 4);
   output->clock_seq_and_node =
       (clock_seq_and_node & 0x3FFFFFFFFFFFFFFFLL) | 0x8000000000000000LL; // RFC4122 variant
 }
 
+void UuidGen::generate_random(CassUuid* output) { generate_random(output, 1); }
+
+void UuidGen::generate_random(CassUuid* outputs, size_t count) {
+  ThreadState* state = thread_state();
+  if (state != NULL) {
+    for (size_t i = 0; i < count; ++i) {
+      uint64_t time_and_version = state->ng();
+      set_random(time_and_version, state->ng(), &outputs[i]);
+    }
+  } else {
+    ScopedMutex lock(&mutex_);
+    for (size_t i = 0; i < count; ++i) {
+      uint64_t time_and_version = ng_();
+      set_random(time_and_version, ng_(), &outputs[i]);
+    }
+  }
+}
+
 void UuidGen::set_clock_seq_and_node(uint64_t node) {
   uint64_t clock_seq = ng_();
-  clock_seq_and_node_ |= (clock_seq & 0x0000000000003FFFLL) << 48;
+  clock_seq_and_node_ |= (clock_seq & CLOCK_SEQ_MASK) << CLOCK_SEQ_SHIFT;
   clock_seq_and_node_ |= 0x8000000000000000LL; // RFC4122 variant
   clock_seq_and_node_ |= node;
 }
@@ -279,3 +316,49 @@ uint64_t UuidGen::monotonic_timestamp() {
     }
   }
 }
+
+// Threads are assigned the clock sequences that follow the shared clock
+// sequence. Once they're used up, new threads use the shared state.
+UuidGen::ThreadState* UuidGen::thread_state() {
+  ThreadState* state = thread_states_.get();
+  if (state != NULL || !thread_states_.is_valid()) {
+    return state;
+  }
+
+  ScopedMutex l(&mutex_);
+  if (thread_count_ >= CLOCK_SEQ_MASK) {
+    return NULL;
+  }
+  uint64_t clock_seq = (clock_seq_and_node_ >> CLOCK_SEQ_SHIFT) + 1 + thread_count_++;
+  state = new ThreadState((clock_seq_and_node_ & ~(CLOCK_SEQ_MASK << CLOCK_SEQ_SHIFT)) |
+                          ((clock_seq & CLOCK_SEQ_MASK) << CLOCK_SEQ_SHIFT));
+  thread_states_.set(state);
+  return state;
+}
+
+// If a random seed can't be read then the time is used. The thread's clock
+// sequence is mixed in so that threads started at the same time still get
+// different seeds.
+UuidGen::ThreadState::ThreadState(uint64_t clock_seq_and_node)
+    : clock_seq_and_node(clock_seq_and_node)
+    , last_timestamp(0)
+    , ng(get_random_seed(uv_hrtime() ^ clock_seq_and_node)) {}
+
+// The same as the shared version, but without atomics. Timestamps have
+// millisecond precision, so if more than 10,000 UUIDs are generated in a
+// millisecond then this waits for the next millisecond instead of borrowing
+// timestamps from it. If the clock went backwards the last timestamp is
+// incremented.
+uint64_t UuidGen::ThreadState::monotonic_timestamp() {
+  while (true) {
+    uint64_t now = from_unix_timestamp(get_time_since_epoch_ms());
+    if (now > last_timestamp) {
+      last_timestamp = now;
+      return now;
+    }
+    uint64_t last_ms = to_milliseconds(last_timestamp);
+    if (to_milliseconds(now) < last_ms || to_milliseconds(last_timestamp + 1) == last_ms) {
+      return ++last_timestamp;
+    }
+  }
+}
@@ -22,6 +22,7 @@
 #include "cassandra.h"
 #include "external.hpp"
 #include "random.hpp"
+#include "thread_local.hpp"
 
 #include <assert.h>
 #include <string.h>
@@ -36,18 +37,41 @@ public:
   ~UuidGen();
 
   void generate_time(CassUuid* output);
+  void generate_time(CassUuid* outputs, size_t count);
   void from_time(uint64_t timestamp, CassUuid* output);
   void generate_random(CassUuid* output);
+  void generate_random(CassUuid* outputs, size_t count);
 
 private:
+  /**
+   * A thread's generator state. Each thread has its own clock sequence so that
+   * its time UUIDs are unique without coordinating timestamps with other
+   * threads, and its own random number generator.
+   */
+  struct ThreadState : public Allocated {
+    ThreadState(uint64_t clock_seq_and_node);
+
+    uint64_t monotonic_timestamp();
+
+    const uint64_t clock_seq_and_node;
+    uint64_t last_timestamp;
+    MT19937_64 ng;
+  };
+
   void set_clock_seq_and_node(uint64_t node);
   uint64_t monotonic_timestamp();
 
+  // Returns NULL if the thread has to use the shared state
+  ThreadState* thread_state();
+
   uint64_t clock_seq_and_node_;
   Atomic<uint64_t> last_timestamp_;
 
   uv_mutex_t mutex_;
   MT19937_64 ng_;
+
+  ThreadLocal<ThreadState> thread_states_;
+  size_t thread_count_;
 };
 
 }}} // namespace datastax::internal::core
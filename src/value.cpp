@@ -180,6 +180,29 @@ cass_bool_t cass_value_is_duration(const CassValue* value) {
   return static_cast<cass_bool_t>(is_valid(dummy, value->data_type()));
 }
 
+#define CASS_VALUE_GET_ARRAY(Name, Type, IsValidType)                                  \
+  CassError cass_value_get_##Name##_array(const CassValue* collection, Type* output,   \
+                                          size_t output_count) {                       \
+    if (collection == NULL || collection->is_null()) return CASS_ERROR_LIB_NULL_VALUE; \
+    if (collection->value_type() != CASS_VALUE_TYPE_LIST &&                            \
+        collection->value_type() != CASS_VALUE_TYPE_SET) {                             \
+      return CASS_ERROR_LIB_INVALID_VALUE_TYPE;                                        \
+    }                                                                                  \
+    if (!(IsValidType)) return CASS_ERROR_LIB_INVALID_VALUE_TYPE;                      \
+    return collection->decode_items(output, output_count);                             \
+  }
+
+CASS_VALUE_GET_ARRAY(int32, cass_int32_t,
+                     collection->primary_value_type() == CASS_VALUE_TYPE_INT)
+CASS_VALUE_GET_ARRAY(int64, cass_int64_t, is_int64_type(collection->primary_value_type()))
+CASS_VALUE_GET_ARRAY(float, cass_float_t,
+                     collection->primary_value_type() == CASS_VALUE_TYPE_FLOAT)
+CASS_VALUE_GET_ARRAY(double, cass_double_t,
+                     collection->primary_value_type() == CASS_VALUE_TYPE_DOUBLE)
+CASS_VALUE_GET_ARRAY(uuid, CassUuid, is_uuid_type(collection->primary_value_type()))
+
+#undef CASS_VALUE_GET_ARRAY
+
 size_t cass_value_item_count(const CassValue* collection) { return collection->count(); }
 
 CassValueType cass_value_primary_sub_type(const CassValue* collection) {
@@ -192,6 +215,30 @@ CassValueType cass_value_secondary_sub_type(const CassValue* collection) {
 
 } // extern "C"
 
+namespace {
+
+inline const char* decode_element(const char* input, cass_int32_t* output) {
+  return decode_int32(input, *output);
+}
+
+inline const char* decode_element(const char* input, cass_int64_t* output) {
+  return decode_int64(input, *output);
+}
+
+inline const char* decode_element(const char* input, cass_float_t* output) {
+  return decode_float(input, *output);
+}
+
+inline const char* decode_element(const char* input, cass_double_t* output) {
+  return decode_double(input, *output);
+}
+
+inline const char* decode_element(const char* input, CassUuid* output) {
+  return decode_uuid(input, output);
+}
+
+} // namespace
+
 Value::Value(const DataType::ConstPtr& data_type, Decoder decoder)
     : data_type_(data_type)
     , count_(0)
@@ -248,3 +295,27 @@ StringVec Value::as_stringlist() const {
   }
   return stringlist;
 }
+
+template <class T>
+CassError Value::decode_items(T* output, size_t output_count) const {
+  if (count_ <= 0) return CASS_OK;
+  size_t count = static_cast<size_t>(count_);
+  if (output_count < count) return CASS_ERROR_LIB_BAD_PARAMS;
+
+  // Elements are decoded straight from the collection's buffer instead of
+  // creating a value and a decoder per element like the collection iterator.
+  const char* input = decoder_.input_;
+  const char* end = input + decoder_.remaining_;
+  for (size_t i = 0; i < count; ++i) {
+    if (end - input < static_cast<ptrdiff_t>(sizeof(int32_t))) {
+      return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    }
+    int32_t size;
+    input = decode_int32(input, size);
+    if (size < 0) return CASS_ERROR_LIB_NULL_VALUE;
+    if (static_cast<size_t>(size) != sizeof(T)) return CASS_ERROR_LIB_INVALID_DATA;
+    if (end - input < static_cast<ptrdiff_t>(sizeof(T))) return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    input = decode_element(input, &output[i]);
+  }
+  return CASS_OK;
+}
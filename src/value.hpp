@@ -134,6 +134,17 @@ public:
   CassUuid as_uuid() const;
   StringVec as_stringlist() const;
 
+  /**
+   * Decode every element of a list or set of fixed width elements into an
+   * array. The element types must be validated by the caller.
+   *
+   * @param output An array with room for at least count() elements.
+   * @param output_count The number of elements in the output array.
+   * @return CASS_OK if successful, otherwise an error occurred.
+   */
+  template <class T>
+  CassError decode_items(T* output, size_t output_count) const;
+
 private:
   DataType::ConstPtr data_type_;
   int32_t count_;
@@ -0,0 +1,291 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "cassandra.h"
+#include "scoped_ptr.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <uv.h>
+
+#define MAX_ITERATIONS 1000000000ULL
+
+using datastax::internal::ScopedPtr;
+using datastax::internal::Vector;
+
+namespace benchmark {
+
+void State::pause_timing() {
+  if (is_running_) {
+    elapsed_ns_ += uv_hrtime() - start_ns_;
+    is_running_ = false;
+  }
+}
+
+void State::resume_timing() {
+  if (!is_running_) {
+    start_ns_ = uv_hrtime();
+    is_running_ = true;
+  }
+}
+
+namespace {
+
+typedef Vector<Benchmark*> BenchmarkVec;
+
+BenchmarkVec& benchmarks() {
+  static BenchmarkVec benchmarks;
+  return benchmarks;
+}
+
+struct Result {
+  String name;
+  String label;
+  uint64_t iterations;
+  double ns_per_iteration;
+  double items_per_second;
+  double bytes_per_second;
+};
+
+typedef Vector<Result> ResultVec;
+
+struct Options {
+  Options()
+      : min_time(0.5)
+      , is_json(false)
+      , list_only(false) {}
+
+  String filter;
+  double min_time;
+  bool is_json;
+  bool list_only;
+  String out;
+};
+
+bool parse_flag(const char* arg, const char* name, String* value) {
+  size_t length = strlen(name);
+  if (strncmp(arg, name, length) != 0) return false;
+  if (arg[length] == '=') {
+    *value = arg + length + 1;
+    return true;
+  }
+  if (arg[length] == '\0') {
+    value->clear();
+    return true;
+  }
+  return false;
+}
+
+bool parse_options(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    String value;
+    if (parse_flag(argv[i], "--benchmark_filter", &value)) {
+      options->filter = value;
+    } else if (parse_flag(argv[i], "--benchmark_min_time", &value)) {
+      options->min_time = atof(value.c_str());
+    } else if (parse_flag(argv[i], "--benchmark_format", &value)) {
+      if (value == "json") {
+        options->is_json = true;
+      } else if (value != "console") {
+        fprintf(stderr, "Invalid benchmark format '%s'\n", value.c_str());
+        return false;
+      }
+    } else if (parse_flag(argv[i], "--benchmark_out", &value)) {
+      options->out = value;
+    } else if (parse_flag(argv[i], "--benchmark_list_tests", &value)) {
+      options->list_only = true;
+    } else {
+      fprintf(stderr, "Unknown argument '%s'\n", argv[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+String full_name(const Benchmark* benchmark, size_t arg_index) {
+  if (benchmark->args().empty()) return benchmark->name();
+  char buf[32];
+  sprintf(buf, "/%lld", static_cast<long long>(benchmark->args()[arg_index]));
+  return benchmark->name() + buf;
+}
+
+// Run with an increasing number of iterations until the minimum time is
+// reached, then report the last run.
+Result run(const Benchmark* benchmark, size_t arg_index, double min_time) {
+  int64_t arg = benchmark->args().empty() ? 0 : benchmark->args()[arg_index];
+  uint64_t min_time_ns = static_cast<uint64_t>(min_time * 1e9);
+
+  uint64_t iterations = 1;
+  while (true) {
+    State state(iterations, arg);
+    benchmark->function()(state);
+
+    uint64_t elapsed_ns = state.elapsed_ns();
+    if (elapsed_ns >= min_time_ns || iterations >= MAX_ITERATIONS) {
+      Result result;
+      result.name = full_name(benchmark, arg_index);
+      result.label = state.label();
+      result.iterations = state.iterations();
+      double elapsed_s = elapsed_ns / 1e9;
+      result.ns_per_iteration = static_cast<double>(elapsed_ns) / state.iterations();
+      result.items_per_second = elapsed_s > 0 ? state.items_processed() / elapsed_s : 0;
+      result.bytes_per_second = elapsed_s > 0 ? state.bytes_processed() / elapsed_s : 0;
+      return result;
+    }
+
+    // Predict the number of iterations needed with some padding, but don't
+    // grow too quickly when the previous run was very short.
+    double multiplier = elapsed_ns > 0 ? (min_time_ns * 1.4) / elapsed_ns : 100.0;
+    if (multiplier > 100.0) multiplier = 100.0;
+    uint64_t next = static_cast<uint64_t>(iterations * multiplier);
+    iterations = next > iterations ? next : iterations + 1;
+    if (iterations > MAX_ITERATIONS) iterations = MAX_ITERATIONS;
+  }
+}
+
+void print_console(const Result& result) {
+  printf("%-48s %14.1f ns %12llu", result.name.c_str(), result.ns_per_iteration,
+         static_cast<unsigned long long>(result.iterations));
+  if (result.items_per_second > 0) {
+    printf(" %12.4g items/s", result.items_per_second);
+  }
+  if (result.bytes_per_second > 0) {
+    printf(" %12.4g bytes/s", result.bytes_per_second);
+  }
+  if (!result.label.empty()) {
+    printf(" %s", result.label.c_str());
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+String escape_json(const String& str) {
+  String escaped;
+  for (String::const_iterator it = str.begin(), end = str.end(); it != end; ++it) {
+    if (*it == '"' || *it == '\\') escaped.push_back('\\');
+    escaped.push_back(*it);
+  }
+  return escaped;
+}
+
+void write_json(FILE* file, const ResultVec& results) {
+  char date[64];
+  time_t now = time(NULL);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+  uv_cpu_info_t* cpu_infos;
+  int cpu_count = 0;
+  if (uv_cpu_info(&cpu_infos, &cpu_count) == 0) {
+    uv_free_cpu_info(cpu_infos, cpu_count);
+  }
+
+  fprintf(file, "{\n");
+  fprintf(file, "  \"context\": {\n");
+  fprintf(file, "    \"date\": \"%s\",\n", date);
+  fprintf(file, "    \"driver_version\": \"%d.%d.%d%s%s\",\n", CASS_VERSION_MAJOR,
+          CASS_VERSION_MINOR, CASS_VERSION_PATCH, strlen(CASS_VERSION_SUFFIX) > 0 ? "-" : "",
+          CASS_VERSION_SUFFIX);
+  fprintf(file, "    \"num_cpus\": %d,\n", cpu_count);
+#if defined(NDEBUG)
+  fprintf(file, "    \"library_build_type\": \"release\"\n");
+#else
+  fprintf(file, "    \"library_build_type\": \"debug\"\n");
+#endif
+  fprintf(file, "  },\n");
+  fprintf(file, "  \"benchmarks\": [");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result& result = results[i];
+    fprintf(file, "%s\n    {\n", i > 0 ? "," : "");
+    fprintf(file, "      \"name\": \"%s\",\n", escape_json(result.name).c_str());
+    if (!result.label.empty()) {
+      fprintf(file, "      \"label\": \"%s\",\n", escape_json(result.label).c_str());
+    }
+    fprintf(file, "      \"iterations\": %llu,\n",
+            static_cast<unsigned long long>(result.iterations));
+    fprintf(file, "      \"real_time\": %.3f,\n", result.ns_per_iteration);
+    fprintf(file, "      \"time_unit\": \"ns\"");
+    if (result.items_per_second > 0) {
+      fprintf(file, ",\n      \"items_per_second\": %.3f", result.items_per_second);
+    }
+    if (result.bytes_per_second > 0) {
+      fprintf(file, ",\n      \"bytes_per_second\": %.3f", result.bytes_per_second);
+    }
+    fprintf(file, "\n    }");
+  }
+  fprintf(file, "\n  ]\n}\n");
+}
+
+} // namespace
+
+Benchmark* register_benchmark(const char* name, Function function) {
+  Benchmark* benchmark = new Benchmark(name, function);
+  benchmarks().push_back(benchmark);
+  return benchmark;
+}
+
+int run_benchmarks(int argc, char** argv) {
+  Options options;
+  if (!parse_options(argc, argv, &options)) {
+    return 1;
+  }
+
+  ResultVec results;
+  for (BenchmarkVec::const_iterator it = benchmarks().begin(), end = benchmarks().end();
+       it != end; ++it) {
+    const Benchmark* benchmark = *it;
+    size_t arg_count = benchmark->args().empty() ? 1 : benchmark->args().size();
+    for (size_t i = 0; i < arg_count; ++i) {
+      String name(full_name(benchmark, i));
+      if (!options.filter.empty() && name.find(options.filter) == String::npos) continue;
+      if (options.list_only) {
+        printf("%s\n", name.c_str());
+        continue;
+      }
+      results.push_back(run(benchmark, i, options.min_time));
+      if (!options.is_json) {
+        print_console(results.back());
+      }
+    }
+  }
+
+  if (options.is_json) {
+    write_json(stdout, results);
+  }
+
+  if (!options.out.empty()) {
+    FILE* file = fopen(options.out.c_str(), "w");
+    if (file == NULL) {
+      fprintf(stderr, "Unable to open '%s' for writing\n", options.out.c_str());
+      return 1;
+    }
+    write_json(file, results);
+    fclose(file);
+  }
+
+  for (BenchmarkVec::iterator it = benchmarks().begin(), end = benchmarks().end(); it != end;
+       ++it) {
+    delete *it;
+  }
+  benchmarks().clear();
+
+  return 0;
+}
+
+} // namespace benchmark
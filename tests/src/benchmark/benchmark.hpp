@@ -0,0 +1,172 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef BENCHMARK_BENCHMARK_HPP
+#define BENCHMARK_BENCHMARK_HPP
+
+#include "string.hpp"
+#include "vector.hpp"
+
+#include <stdint.h>
+
+/**
+ * A minimal benchmark harness modeled after Google Benchmark's API.
+ *
+ * Benchmarks are registered with the `BENCHMARK()` macro and are run until
+ * they've taken at least the minimum benchmark time. Results can be printed
+ * to the console or written as JSON so that they can be tracked across
+ * releases.
+ *
+ * Example:
+ *
+ * static void BM_Example(benchmark::State& state) {
+ *   while (state.keep_running()) {
+ *     benchmark::do_not_optimize(work(state.arg()));
+ *   }
+ *   state.set_items_processed(state.iterations());
+ * }
+ * BENCHMARK(BM_Example)->arg(8)->arg(64);
+ */
+namespace benchmark {
+
+typedef datastax::String String;
+
+class State {
+public:
+  State(uint64_t max_iterations, int64_t arg)
+      : max_iterations_(max_iterations)
+      , iterations_(0)
+      , arg_(arg)
+      , start_ns_(0)
+      , elapsed_ns_(0)
+      , is_running_(false)
+      , items_processed_(0)
+      , bytes_processed_(0) {}
+
+  /**
+   * Returns true while the benchmark should continue. Timing starts on the
+   * first call and stops when this returns false.
+   */
+  bool keep_running() {
+    if (!is_running_ && iterations_ == 0) {
+      resume_timing();
+    }
+    if (iterations_ < max_iterations_) {
+      ++iterations_;
+      return true;
+    }
+    pause_timing();
+    return false;
+  }
+
+  /**
+   * Exclude setup done inside the benchmark loop from the measured time.
+   */
+  void pause_timing();
+  void resume_timing();
+
+  uint64_t iterations() const { return iterations_; }
+  uint64_t max_iterations() const { return max_iterations_; }
+  int64_t arg() const { return arg_; }
+  uint64_t elapsed_ns() const { return elapsed_ns_; }
+
+  void set_items_processed(uint64_t items) { items_processed_ = items; }
+  uint64_t items_processed() const { return items_processed_; }
+
+  void set_bytes_processed(uint64_t bytes) { bytes_processed_ = bytes; }
+  uint64_t bytes_processed() const { return bytes_processed_; }
+
+  void set_label(const String& label) { label_ = label; }
+  const String& label() const { return label_; }
+
+private:
+  const uint64_t max_iterations_;
+  uint64_t iterations_;
+  const int64_t arg_;
+  uint64_t start_ns_;
+  uint64_t elapsed_ns_;
+  bool is_running_;
+  uint64_t items_processed_;
+  uint64_t bytes_processed_;
+  String label_;
+};
+
+typedef void (*Function)(State& state);
+
+class Benchmark {
+public:
+  Benchmark(const char* name, Function function)
+      : name_(name)
+      , function_(function) {}
+
+  /**
+   * Run the benchmark once for each argument. Benchmarks without arguments
+   * are run once with an argument of 0.
+   */
+  Benchmark* arg(int64_t arg) {
+    args_.push_back(arg);
+    return this;
+  }
+
+  const String& name() const { return name_; }
+  Function function() const { return function_; }
+  const datastax::internal::Vector<int64_t>& args() const { return args_; }
+
+private:
+  String name_;
+  Function function_;
+  datastax::internal::Vector<int64_t> args_;
+};
+
+Benchmark* register_benchmark(const char* name, Function function);
+
+/**
+ * Run the registered benchmarks.
+ *
+ * Supported arguments:
+ *   --benchmark_filter=<substring>  Only run benchmarks containing the substring
+ *   --benchmark_min_time=<seconds>  Minimum time to run each benchmark (default: 0.5)
+ *   --benchmark_format=<console|json>  Output format (default: console)
+ *   --benchmark_out=<file>  Write JSON results to a file
+ *   --benchmark_list_tests  List the benchmarks without running them
+ *
+ * @return The process exit code.
+ */
+int run_benchmarks(int argc, char** argv);
+
+/**
+ * Prevent the compiler from optimizing away a value that's otherwise unused.
+ */
+template <class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  volatile const char* sink = reinterpret_cast<volatile const char*>(&value);
+  (void)*sink;
+#endif
+}
+
+} // namespace benchmark
+
+#define BENCHMARK_CONCAT_(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_(a, b)
+
+#define BENCHMARK(function)                                                                  \
+  static ::benchmark::Benchmark* BENCHMARK_CONCAT(benchmark_registration_, __LINE__) = \
+      ::benchmark::register_benchmark(#function, function)
+
+#endif
@@ -0,0 +1,46 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "data_type_parser.hpp"
+#include "metadata.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+static void BM_DataTypeCqlNameParser(benchmark::State& state) {
+  static const char* types[] = { "int",
+                                 "text",
+                                 "list<text>",
+                                 "map<text, frozen<list<int>>>",
+                                 "tuple<int, text, frozen<set<uuid>>>",
+                                 "frozen<map<text, frozen<map<int, list<bigint>>>>>" };
+  static const size_t num_types = sizeof(types) / sizeof(types[0]);
+
+  SimpleDataTypeCache cache;
+  KeyspaceMetadata keyspace("ks");
+  Vector<String> strings(types, types + num_types);
+
+  size_t index = 0;
+  while (state.keep_running()) {
+    benchmark::do_not_optimize(DataTypeCqlNameParser::parse(strings[index], cache, &keyspace));
+    index = (index + 1) % num_types;
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(BM_DataTypeCqlNameParser);
@@ -0,0 +1,34 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "metrics.hpp"
+
+using namespace datastax::internal::core;
+
+static void BM_HistogramRecordValue(benchmark::State& state) {
+  Metrics::ThreadState thread_state(1);
+  Metrics::Histogram histogram(&thread_state);
+
+  int64_t value = 1;
+  while (state.keep_running()) {
+    histogram.record_value(value);
+    value = value % 1000000 + 997;
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(BM_HistogramRecordValue);
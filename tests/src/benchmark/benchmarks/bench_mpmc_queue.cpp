@@ -0,0 +1,82 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "mpmc_queue.hpp"
+
+#include <uv.h>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+static void BM_MPMCQueueEnqueueDequeue(benchmark::State& state) {
+  MPMCQueue<int> queue(1024);
+  int value = 0;
+  while (state.keep_running()) {
+    queue.enqueue(value);
+    queue.dequeue(value);
+  }
+  benchmark::do_not_optimize(value);
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(BM_MPMCQueueEnqueueDequeue);
+
+namespace {
+
+struct ProducerArgs {
+  uv_thread_t thread;
+  MPMCQueue<int>* queue;
+  uint64_t count;
+};
+
+void producer(void* data) {
+  ProducerArgs* args = static_cast<ProducerArgs*>(data);
+  for (uint64_t i = 0; i < args->count;) {
+    if (args->queue->enqueue(static_cast<int>(i))) ++i;
+  }
+}
+
+} // namespace
+
+/**
+ * Dequeue on the benchmark thread while the given number of threads enqueue.
+ */
+static void BM_MPMCQueueContended(benchmark::State& state) {
+  const uint64_t num_producers = static_cast<uint64_t>(state.arg());
+  const uint64_t total = state.max_iterations();
+  MPMCQueue<int> queue(1024);
+
+  Vector<ProducerArgs> args(num_producers);
+  for (uint64_t i = 0; i < num_producers; ++i) {
+    args[i].queue = &queue;
+    args[i].count = total / num_producers + (i < total % num_producers ? 1 : 0);
+    uv_thread_create(&args[i].thread, producer, &args[i]);
+  }
+
+  int value = 0;
+  while (state.keep_running()) {
+    while (!queue.dequeue(value)) {
+    }
+  }
+  benchmark::do_not_optimize(value);
+
+  for (uint64_t i = 0; i < num_producers; ++i) {
+    uv_thread_join(&args[i].thread);
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(BM_MPMCQueueContended)->arg(1)->arg(4);
@@ -0,0 +1,34 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "murmur3.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+
+/**
+ * Hash a partition key of the given size.
+ */
+static void BM_MurmurHash3_x64_128(benchmark::State& state) {
+  const String key(static_cast<size_t>(state.arg()), 'k');
+  while (state.keep_running()) {
+    benchmark::do_not_optimize(MurmurHash3_x64_128(key.data(), static_cast<int>(key.size()), 0));
+  }
+  state.set_bytes_processed(state.iterations() * key.size());
+}
+BENCHMARK(BM_MurmurHash3_x64_128)->arg(8)->arg(64)->arg(1024);
@@ -0,0 +1,105 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "atomic.hpp"
+#include "prepared.hpp"
+
+#include <uv.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+#define NUM_ENTRIES 256
+
+namespace {
+
+void add_entries(PreparedMetadata* prepared_metadata, Vector<String>* ids) {
+  for (int i = 0; i < NUM_ENTRIES; ++i) {
+    OStringStream ss;
+    ss << "SELECT * FROM test WHERE k = " << i;
+    ids->push_back(ss.str());
+    prepared_metadata->set(ids->back(), PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                                            ss.str(), "", "", ResultResponse::ConstPtr())));
+  }
+}
+
+struct LookupArgs {
+  uv_thread_t thread;
+  const PreparedMetadata* prepared_metadata;
+  const Vector<String>* ids;
+  const Atomic<bool>* is_running;
+};
+
+void lookup(void* data) {
+  LookupArgs* args = static_cast<LookupArgs*>(data);
+  const Vector<String>& ids(*args->ids);
+  for (size_t i = 0; args->is_running->load(MEMORY_ORDER_RELAXED); ++i) {
+    const String& id(ids[i % ids.size()]);
+    benchmark::do_not_optimize(args->prepared_metadata->get(id, PreparedMetadata::hash_id(id)));
+  }
+}
+
+} // namespace
+
+static void BM_PreparedMetadataGet(benchmark::State& state) {
+  PreparedMetadata prepared_metadata;
+  Vector<String> ids;
+  add_entries(&prepared_metadata, &ids);
+
+  size_t i = 0;
+  while (state.keep_running()) {
+    const String& id(ids[i++ % ids.size()]);
+    benchmark::do_not_optimize(prepared_metadata.get(id, PreparedMetadata::hash_id(id)));
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(BM_PreparedMetadataGet);
+
+/**
+ * Look up entries on the benchmark thread while the given number of threads
+ * also look up entries.
+ */
+static void BM_PreparedMetadataGetContended(benchmark::State& state) {
+  const int num_threads = static_cast<int>(state.arg());
+  PreparedMetadata prepared_metadata;
+  Vector<String> ids;
+  add_entries(&prepared_metadata, &ids);
+
+  Atomic<bool> is_running(true);
+  Vector<LookupArgs> args(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    args[i].prepared_metadata = &prepared_metadata;
+    args[i].ids = &ids;
+    args[i].is_running = &is_running;
+    uv_thread_create(&args[i].thread, lookup, &args[i]);
+  }
+
+  size_t n = 0;
+  while (state.keep_running()) {
+    const String& id(ids[n++ % ids.size()]);
+    benchmark::do_not_optimize(prepared_metadata.get(id, PreparedMetadata::hash_id(id)));
+  }
+
+  is_running.store(false);
+  for (int i = 0; i < num_threads; ++i) {
+    uv_thread_join(&args[i].thread);
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(BM_PreparedMetadataGetContended)->arg(4)->arg(32);
@@ -0,0 +1,140 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "mockssandra.hpp"
+#include "query_request.hpp"
+#include "response.hpp"
+#include "result_iterator.hpp"
+#include "result_response.hpp"
+
+#define BENCHMARK_PROTOCOL_VERSION CASS_PROTOCOL_VERSION_V4
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+String rows_frame(int row_count) {
+  mockssandra::ResultSet::Builder builder("ks", "table");
+  builder.column("key", mockssandra::Type::text())
+      .column("id", mockssandra::Type::uuid())
+      .column("address", mockssandra::Type::inet())
+      .column("items", mockssandra::Type::list(mockssandra::Type::text()));
+
+  CassUuid uuid = { 0x0000112233445566LL, 0x0000112233445566LL };
+  Vector<String> items(4, "item");
+  for (int i = 0; i < row_count; ++i) {
+    OStringStream ss;
+    ss << "key" << i;
+    builder.row(mockssandra::Row::Builder()
+                    .text(ss.str())
+                    .uuid(uuid)
+                    .inet(Address("127.0.0.1", 9042))
+                    .collection(mockssandra::Collection::text(items))
+                    .build());
+  }
+  String body(builder.build().encode(BENCHMARK_PROTOCOL_VERSION));
+
+  String frame;
+  frame.push_back(static_cast<char>(0x80 | BENCHMARK_PROTOCOL_VERSION)); // Response version
+  frame.push_back(0);                                                    // Flags
+  frame.push_back(0);                                                    // Stream
+  frame.push_back(1);
+  frame.push_back(static_cast<char>(mockssandra::OPCODE_RESULT));
+  mockssandra::encode_int32(body.size(), &frame);
+  frame.append(body);
+  return frame;
+}
+
+ResultResponse::Ptr decode_frame(const String& frame) {
+  ResponseMessage message;
+  if (message.decode(frame.data(), frame.size()) != static_cast<ssize_t>(frame.size()) ||
+      !message.is_body_ready()) {
+    return ResultResponse::Ptr();
+  }
+  return ResultResponse::Ptr(message.response_body());
+}
+
+// Expose the protected value encoding
+class BenchmarkStatement : public QueryRequest {
+public:
+  BenchmarkStatement(size_t value_count)
+      : QueryRequest("INSERT INTO table (k, v) VALUES (?, ?)", value_count) {}
+
+  int32_t encode_values(BufferVec* bufs) const {
+    return Statement::encode_values(ProtocolVersion(BENCHMARK_PROTOCOL_VERSION), NULL, bufs);
+  }
+};
+
+} // namespace
+
+/**
+ * Decode a full RESULT frame, including the result metadata and the first row.
+ */
+static void BM_ResponseMessageDecode(benchmark::State& state) {
+  const String frame(rows_frame(static_cast<int>(state.arg())));
+  while (state.keep_running()) {
+    ResponseMessage message;
+    benchmark::do_not_optimize(message.decode(frame.data(), frame.size()));
+  }
+  state.set_bytes_processed(state.iterations() * frame.size());
+}
+BENCHMARK(BM_ResponseMessageDecode)->arg(1)->arg(100)->arg(1000);
+
+/**
+ * Decode every row of an already decoded result.
+ */
+static void BM_DecodeRow(benchmark::State& state) {
+  ResultResponse::Ptr result(decode_frame(rows_frame(static_cast<int>(state.arg()))));
+  if (!result) {
+    state.set_label("error: unable to decode result");
+    while (state.keep_running()) {
+    }
+    return;
+  }
+  while (state.keep_running()) {
+    ResultIterator iterator(result.get());
+    while (iterator.next()) {
+      benchmark::do_not_optimize(iterator.row());
+    }
+  }
+  state.set_items_processed(state.iterations() * result->row_count());
+}
+BENCHMARK(BM_DecodeRow)->arg(100)->arg(1000);
+
+static void BM_StatementEncodeValues(benchmark::State& state) {
+  size_t value_count = static_cast<size_t>(state.arg());
+  BenchmarkStatement statement(value_count);
+  for (size_t i = 0; i < value_count; ++i) {
+    if (i % 2 == 0) {
+      statement.set(i, static_cast<cass_int32_t>(i));
+    } else {
+      statement.set(i, CassString("abcdefghijklmnopqrstuvwxyz", 26));
+    }
+  }
+
+  BufferVec bufs;
+  bufs.reserve(value_count);
+  while (state.keep_running()) {
+    bufs.clear();
+    benchmark::do_not_optimize(statement.encode_values(&bufs));
+  }
+  state.set_items_processed(state.iterations() * value_count);
+}
+BENCHMARK(BM_StatementEncodeValues)->arg(2)->arg(16)->arg(128);
@@ -0,0 +1,39 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "stream_manager.hpp"
+
+using namespace datastax::internal::core;
+
+/**
+ * Acquire and release streams with the given number of streams already in use.
+ */
+static void BM_StreamManagerAcquireRelease(benchmark::State& state) {
+  StreamManager<int> streams;
+  for (int64_t i = 0; i < state.arg(); ++i) {
+    streams.acquire(static_cast<int>(i));
+  }
+
+  while (state.keep_running()) {
+    int stream = streams.acquire(0);
+    benchmark::do_not_optimize(stream);
+    streams.release(stream);
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(BM_StreamManagerAcquireRelease)->arg(0)->arg(1024)->arg(32000);
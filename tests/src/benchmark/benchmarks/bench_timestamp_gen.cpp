@@ -0,0 +1,87 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "atomic.hpp"
+#include "timestamp_generator.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+struct GenerateArgs {
+  uv_thread_t thread;
+  TimestampGenerator* gen;
+  const Atomic<bool>* is_running;
+};
+
+void generate(void* data) {
+  GenerateArgs* args = static_cast<GenerateArgs*>(data);
+  int64_t timestamp = 0;
+  while (args->is_running->load(MEMORY_ORDER_RELAXED)) {
+    timestamp = args->gen->next();
+  }
+  benchmark::do_not_optimize(timestamp);
+}
+
+/**
+ * Generate timestamps on the benchmark thread while the given number of
+ * threads also generate timestamps using the same generator.
+ */
+void generate_contended(benchmark::State& state, TimestampGenerator* gen) {
+  const int num_threads = static_cast<int>(state.arg());
+
+  Atomic<bool> is_running(true);
+  Vector<GenerateArgs> args(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    args[i].gen = gen;
+    args[i].is_running = &is_running;
+    uv_thread_create(&args[i].thread, generate, &args[i]);
+  }
+
+  int64_t timestamp = 0;
+  while (state.keep_running()) {
+    timestamp = gen->next();
+  }
+  benchmark::do_not_optimize(timestamp);
+
+  is_running.store(false);
+  for (int i = 0; i < num_threads; ++i) {
+    uv_thread_join(&args[i].thread);
+  }
+  state.set_items_processed(state.iterations());
+}
+
+} // namespace
+
+// Generating faster than one timestamp per microsecond runs the monotonic
+// generator ahead of the clock, whereas the batched generator waits for it.
+static void BM_TimestampGenMonotonicContended(benchmark::State& state) {
+  MonotonicTimestampGenerator gen(-1); // Disable clock skew warnings
+  generate_contended(state, &gen);
+}
+BENCHMARK(BM_TimestampGenMonotonicContended)->arg(0)->arg(4)->arg(32);
+
+static void BM_TimestampGenBatchedMonotonicContended(benchmark::State& state) {
+  BatchedMonotonicTimestampGenerator gen;
+  generate_contended(state, &gen);
+}
+BENCHMARK(BM_TimestampGenBatchedMonotonicContended)->arg(0)->arg(4)->arg(32);
@@ -0,0 +1,144 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "query_request.hpp"
+#include "request_handler.hpp"
+#include "round_robin_policy.hpp"
+#include "test_token_map_utils.hpp"
+#include "token_aware_policy.hpp"
+
+#include <stdio.h>
+
+#define NUM_DCS 3
+#define NUM_VNODES 256
+#define NUM_KEYS 1024
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+/**
+ * A cluster of hosts spread evenly over three data centers with 256 vnodes per
+ * host and a keyspace replicated three times in each data center.
+ */
+struct Cluster {
+  Cluster(size_t num_hosts) {
+    MT19937_64 rng;
+    for (size_t i = 0; i < num_hosts; ++i) {
+      char address[32];
+      sprintf(address, "127.0.%d.%d", static_cast<int>(i / 250), static_cast<int>(i % 250 + 1));
+      char dc[32];
+      sprintf(dc, "dc%d", static_cast<int>(i % NUM_DCS));
+      Host::Ptr host(create_host(Address(address, 9042), random_murmur3_tokens(rng, NUM_VNODES),
+                                 Murmur3Partitioner::name().to_string(), dc, "rack1"));
+      hosts[host->address()] = host;
+    }
+
+    for (int i = 0; i < NUM_KEYS; ++i) {
+      OStringStream ss;
+      ss << "key" << i;
+      keys.push_back(ss.str());
+    }
+  }
+
+  TokenMap::Ptr token_map() const {
+    TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+    add_keyspace(token_map.get());
+    for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+      token_map->add_host(it->second);
+    }
+    return token_map;
+  }
+
+  static void add_keyspace(TokenMap* token_map) {
+    ReplicationMap replication;
+    for (int i = 0; i < NUM_DCS; ++i) {
+      char dc[32];
+      sprintf(dc, "dc%d", i);
+      replication[dc] = "3";
+    }
+    add_keyspace_network_topology("ks", replication, token_map);
+  }
+
+  HostMap hosts;
+  Vector<String> keys;
+};
+
+} // namespace
+
+static void BM_TokenMapBuild(benchmark::State& state) {
+  Cluster cluster(static_cast<size_t>(state.arg()));
+  while (state.keep_running()) {
+    state.pause_timing();
+    TokenMap::Ptr token_map(cluster.token_map());
+    state.resume_timing();
+    token_map->build();
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(BM_TokenMapBuild)->arg(12)->arg(48);
+
+static void BM_TokenMapGetReplicas(benchmark::State& state) {
+  Cluster cluster(static_cast<size_t>(state.arg()));
+  TokenMap::Ptr token_map(cluster.token_map());
+  token_map->build();
+
+  size_t index = 0;
+  while (state.keep_running()) {
+    benchmark::do_not_optimize(token_map->get_replicas("ks", cluster.keys[index]));
+    index = (index + 1) % cluster.keys.size();
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(BM_TokenMapGetReplicas)->arg(12)->arg(48);
+
+/**
+ * Create a token aware query plan and iterate over all of its hosts.
+ */
+static void BM_TokenAwarePolicyQueryPlan(benchmark::State& state) {
+  Cluster cluster(static_cast<size_t>(state.arg()));
+  TokenMap::Ptr token_map(cluster.token_map());
+  token_map->build();
+
+  TokenAwarePolicy policy(new RoundRobinPolicy(), false);
+  policy.init(Host::Ptr(), cluster.hosts, NULL, "");
+
+  Vector<SharedRefPtr<RequestHandler> > request_handlers;
+  for (size_t i = 0; i < cluster.keys.size(); ++i) {
+    QueryRequest::Ptr request(new QueryRequest("", 1));
+    request->set(0, CassString(cluster.keys[i].data(), cluster.keys[i].size()));
+    request->add_key_index(0);
+    request_handlers.push_back(
+        SharedRefPtr<RequestHandler>(new RequestHandler(request, ResponseFuture::Ptr())));
+  }
+
+  size_t index = 0;
+  while (state.keep_running()) {
+    ScopedPtr<QueryPlan> query_plan(
+        policy.new_query_plan("ks", request_handlers[index].get(), token_map.get()));
+    Host::Ptr host;
+    while ((host = query_plan->compute_next())) {
+      benchmark::do_not_optimize(host);
+    }
+    index = (index + 1) % request_handlers.size();
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(BM_TokenAwarePolicyQueryPlan)->arg(12)->arg(48);
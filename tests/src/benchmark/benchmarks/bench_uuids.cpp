@@ -0,0 +1,199 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "get_time.hpp"
+#include "random.hpp"
+#include "scoped_lock.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+#define TIME_OFFSET_BETWEEN_UTC_AND_EPOCH 0x01B21DD213814000LL // Nanoseconds
+
+using namespace datastax::internal;
+
+namespace {
+
+/**
+ * The previous generator, which shares its state between all threads: time
+ * UUIDs update a single timestamp with a compare-and-swap loop and random
+ * UUIDs lock a single random number generator.
+ */
+class SharedUuidGen {
+public:
+  SharedUuidGen()
+      : clock_seq_and_node_(0x8000112233445566ULL)
+      , last_timestamp_(0)
+      , ng_(get_random_seed(MT19937_64::DEFAULT_SEED)) {
+    uv_mutex_init(&mutex_);
+  }
+
+  ~SharedUuidGen() { uv_mutex_destroy(&mutex_); }
+
+  void generate_time(CassUuid* output) {
+    output->time_and_version = set_version(monotonic_timestamp(), 1);
+    output->clock_seq_and_node = clock_seq_and_node_;
+  }
+
+  void generate_random(CassUuid* output) {
+    ScopedMutex lock(&mutex_);
+    uint64_t time_and_version = ng_();
+    uint64_t clock_seq_and_node = ng_();
+    lock.unlock();
+
+    output->time_and_version = set_version(time_and_version, 4);
+    output->clock_seq_and_node =
+        (clock_seq_and_node & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+  }
+
+private:
+  static uint64_t to_milliseconds(uint64_t timestamp) { return timestamp / 10000L; }
+
+  static uint64_t from_unix_timestamp(uint64_t timestamp) {
+    return (timestamp * 10000L) + TIME_OFFSET_BETWEEN_UTC_AND_EPOCH;
+  }
+
+  static uint64_t set_version(uint64_t timestamp, uint8_t version) {
+    return (timestamp & 0x0FFFFFFFFFFFFFFFULL) | (static_cast<uint64_t>(version) << 60);
+  }
+
+  uint64_t monotonic_timestamp() {
+    while (true) {
+      uint64_t now = from_unix_timestamp(get_time_since_epoch_ms());
+      uint64_t last = last_timestamp_.load();
+      if (now > last) {
+        if (last_timestamp_.compare_exchange_strong(last, now)) {
+          return now;
+        }
+      } else {
+        uint64_t last_ms = to_milliseconds(last);
+        if (to_milliseconds(now) < last_ms) {
+          return last_timestamp_.fetch_add(1);
+        }
+        uint64_t candidate = last + 1;
+        if (to_milliseconds(candidate) == last_ms &&
+            last_timestamp_.compare_exchange_strong(last, candidate)) {
+          return candidate;
+        }
+      }
+    }
+  }
+
+  const uint64_t clock_seq_and_node_;
+  Atomic<uint64_t> last_timestamp_;
+  uv_mutex_t mutex_;
+  MT19937_64 ng_;
+};
+
+struct Generator {
+  Generator(bool is_time, bool is_shared)
+      : uuid_gen(cass_uuid_gen_new())
+      , is_time(is_time)
+      , is_shared(is_shared) {}
+
+  ~Generator() { cass_uuid_gen_free(uuid_gen); }
+
+  void operator()(CassUuid* uuid) {
+    if (is_shared) {
+      if (is_time) {
+        shared_uuid_gen.generate_time(uuid);
+      } else {
+        shared_uuid_gen.generate_random(uuid);
+      }
+    } else {
+      if (is_time) {
+        cass_uuid_gen_time(uuid_gen, uuid);
+      } else {
+        cass_uuid_gen_random(uuid_gen, uuid);
+      }
+    }
+  }
+
+  CassUuidGen* uuid_gen;
+  SharedUuidGen shared_uuid_gen;
+  bool is_time;
+  bool is_shared;
+};
+
+struct GenerateArgs {
+  uv_thread_t thread;
+  Generator* generator;
+  const Atomic<bool>* is_running;
+};
+
+void generate(void* data) {
+  GenerateArgs* args = static_cast<GenerateArgs*>(data);
+  CassUuid uuid = { 0, 0 };
+  while (args->is_running->load(MEMORY_ORDER_RELAXED)) {
+    (*args->generator)(&uuid);
+  }
+  benchmark::do_not_optimize(uuid);
+}
+
+/**
+ * Generate UUIDs on the benchmark thread while the given number of threads
+ * also generate UUIDs using the same generator.
+ */
+void generate_contended(benchmark::State& state, bool is_time, bool is_shared) {
+  const int num_threads = static_cast<int>(state.arg());
+  Generator generator(is_time, is_shared);
+
+  Atomic<bool> is_running(true);
+  Vector<GenerateArgs> args(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    args[i].generator = &generator;
+    args[i].is_running = &is_running;
+    uv_thread_create(&args[i].thread, generate, &args[i]);
+  }
+
+  CassUuid uuid = { 0, 0 };
+  while (state.keep_running()) {
+    generator(&uuid);
+  }
+  benchmark::do_not_optimize(uuid);
+
+  is_running.store(false);
+  for (int i = 0; i < num_threads; ++i) {
+    uv_thread_join(&args[i].thread);
+  }
+  state.set_items_processed(state.iterations());
+}
+
+} // namespace
+
+static void BM_UuidGenTimeContended(benchmark::State& state) {
+  generate_contended(state, true, false);
+}
+BENCHMARK(BM_UuidGenTimeContended)->arg(0)->arg(4)->arg(32);
+
+static void BM_UuidGenTimeSharedContended(benchmark::State& state) {
+  generate_contended(state, true, true);
+}
+BENCHMARK(BM_UuidGenTimeSharedContended)->arg(0)->arg(4)->arg(32);
+
+static void BM_UuidGenRandomContended(benchmark::State& state) {
+  generate_contended(state, false, false);
+}
+BENCHMARK(BM_UuidGenRandomContended)->arg(0)->arg(4)->arg(32);
+
+static void BM_UuidGenRandomSharedContended(benchmark::State& state) {
+  generate_contended(state, false, true);
+}
+BENCHMARK(BM_UuidGenRandomSharedContended)->arg(0)->arg(4)->arg(32);
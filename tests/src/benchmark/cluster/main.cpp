@@ -0,0 +1,908 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+/**
+ * An end-to-end benchmark that drives a real `CassSession` against an
+ * in-process mockssandra cluster listening on loopback addresses
+ * (127.0.0.1, 127.0.0.2, ...). The server's latency is configurable so driver
+ * changes can be evaluated for throughput, latency and CPU cost without a real
+ * cluster.
+ */
+
+#include "cassandra.h"
+#include "mockssandra.hpp"
+#include "scoped_lock.hpp"
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <uv.h>
+
+#define READ_QUERY "SELECT k, v FROM bench.kv WHERE k = ?"
+#define WRITE_QUERY "INSERT INTO bench.kv (k, v) VALUES (?, ?)"
+#define SCAN_QUERY "SELECT k, v FROM bench.kv"
+
+#define READ_ID "read"
+#define WRITE_ID "write"
+
+#define NUM_KEYS 10000
+#define VALUE_SIZE 64
+
+using datastax::internal::OStringStream;
+using datastax::internal::ScopedMutex;
+using namespace mockssandra;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Settings
+//------------------------------------------------------------------------------
+
+enum Operation { OP_READ, OP_WRITE, OP_BATCH, OP_SCAN, OP_LAST_ENTRY };
+
+const char* operation_names[] = { "read", "write", "batch", "scan" };
+
+struct Settings {
+  Settings()
+      : nodes(3)
+      , server_threads(1)
+      , io_threads(1)
+      , connections_per_host(1)
+      , concurrency(128)
+      , duration_s(10)
+      , warmup_s(2)
+      , latency("constant:0")
+      , scenario("none")
+      , speculative_delay_ms(0)
+      , speculative_max_executions(0)
+      , is_latency_aware(false)
+      , batch_size(10)
+      , page_size(100)
+      , scan_rows(1000)
+      , is_json(false) {
+    weights[OP_READ] = 60;
+    weights[OP_WRITE] = 30;
+    weights[OP_BATCH] = 5;
+    weights[OP_SCAN] = 5;
+  }
+
+  unsigned nodes;
+  unsigned server_threads;
+  unsigned io_threads;
+  unsigned connections_per_host;
+  unsigned concurrency;
+  unsigned duration_s;
+  unsigned warmup_s;
+  String latency;
+  String scenario;
+  unsigned speculative_delay_ms;
+  unsigned speculative_max_executions;
+  bool is_latency_aware;
+  unsigned weights[OP_LAST_ENTRY];
+  unsigned batch_size;
+  unsigned page_size;
+  unsigned scan_rows;
+  bool is_json;
+};
+
+void usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "  --nodes=<n>                 Number of mock nodes (default: 3)\n"
+          "  --server-threads=<n>        Mock server event loop threads (default: 1)\n"
+          "  --io-threads=<n>            Driver I/O threads (default: 1)\n"
+          "  --connections=<n>           Driver connections per host (default: 1)\n"
+          "  --concurrency=<n>           Outstanding requests (default: 128)\n"
+          "  --duration=<s>              Measured run time in seconds (default: 10)\n"
+          "  --warmup=<s>                Unmeasured warm-up time in seconds (default: 2)\n"
+          "  --latency=<distribution>    Server latency in microseconds (default: constant:0)\n"
+          "                                constant:<us>\n"
+          "                                uniform:<min us>:<max us>\n"
+          "                                exponential:<mean us>\n"
+          "                                lognormal:<median us>:<sigma>\n"
+          "                              Delays are rounded up to whole milliseconds\n"
+          "  --scenario=<name>           Faults injected by the second node (default: none)\n"
+          "                                none         No faults\n"
+          "                                slow-node    Lognormal latency (5 ms median)\n"
+          "                                gc-pauses    1%% of requests take 50-200 ms\n"
+          "                                stalls       Stalls for 200 ms every 2 s\n"
+          "                                resets       0.1%% of requests reset the connection\n"
+          "                                overload     5%% of requests fail as overloaded\n"
+          "                                timeline     Healthy, slow-node, stalls, then\n"
+          "                                             overload for a quarter of the run each\n"
+          "                                all          Run each scenario in turn\n"
+          "  --speculative=<ms>[:<n>]    Enable speculative execution after a delay with\n"
+          "                              up to n executions (default: disabled, n = 2)\n"
+          "  --latency-aware             Enable latency-aware routing\n"
+          "  --mix=<r>:<w>:<b>:<s>       Weights of prepared reads, prepared writes,\n"
+          "                              batches and paged scans (default: 60:30:5:5).\n"
+          "                              Scan latencies are recorded per page.\n"
+          "  --batch-size=<n>            Statements per batch (default: 10)\n"
+          "  --page-size=<n>             Rows per page for scans (default: 100)\n"
+          "  --scan-rows=<n>             Rows returned by a full scan (default: 1000)\n"
+          "  --json                      Print results as JSON\n"
+          "  --help                      Print this message\n",
+          program);
+}
+
+bool parse_unsigned(const char* value, unsigned* output) {
+  char* end;
+  unsigned long result = strtoul(value, &end, 10);
+  if (*value == '\0' || *end != '\0') return false;
+  *output = static_cast<unsigned>(result);
+  return true;
+}
+
+bool parse_settings(int argc, char** argv, Settings* settings) {
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const char* value = strchr(arg, '=');
+    String name(arg, value ? value - arg : strlen(arg));
+    value = value ? value + 1 : "";
+
+    bool is_valid = true;
+    if (name == "--help") {
+      return false;
+    } else if (name == "--nodes") {
+      is_valid = parse_unsigned(value, &settings->nodes) && settings->nodes > 0;
+    } else if (name == "--server-threads") {
+      is_valid = parse_unsigned(value, &settings->server_threads) && settings->server_threads > 0;
+    } else if (name == "--io-threads") {
+      is_valid = parse_unsigned(value, &settings->io_threads) && settings->io_threads > 0;
+    } else if (name == "--connections") {
+      is_valid = parse_unsigned(value, &settings->connections_per_host);
+    } else if (name == "--concurrency") {
+      is_valid = parse_unsigned(value, &settings->concurrency) && settings->concurrency > 0;
+    } else if (name == "--duration") {
+      is_valid = parse_unsigned(value, &settings->duration_s) && settings->duration_s > 0;
+    } else if (name == "--warmup") {
+      is_valid = parse_unsigned(value, &settings->warmup_s);
+    } else if (name == "--latency") {
+      settings->latency = value;
+    } else if (name == "--scenario") {
+      settings->scenario = value;
+    } else if (name == "--speculative") {
+      int count = sscanf(value, "%u:%u", &settings->speculative_delay_ms,
+                         &settings->speculative_max_executions);
+      is_valid = count >= 1;
+      if (count == 1) settings->speculative_max_executions = 2;
+    } else if (name == "--latency-aware") {
+      settings->is_latency_aware = true;
+    } else if (name == "--mix") {
+      unsigned w[OP_LAST_ENTRY];
+      is_valid = sscanf(value, "%u:%u:%u:%u", &w[0], &w[1], &w[2], &w[3]) == OP_LAST_ENTRY &&
+                 w[0] + w[1] + w[2] + w[3] > 0;
+      if (is_valid) memcpy(settings->weights, w, sizeof(w));
+    } else if (name == "--batch-size") {
+      is_valid = parse_unsigned(value, &settings->batch_size) && settings->batch_size > 0;
+    } else if (name == "--page-size") {
+      is_valid = parse_unsigned(value, &settings->page_size) && settings->page_size > 0;
+    } else if (name == "--scan-rows") {
+      is_valid = parse_unsigned(value, &settings->scan_rows);
+    } else if (name == "--json") {
+      settings->is_json = true;
+    } else {
+      is_valid = false;
+    }
+
+    if (!is_valid) {
+      fprintf(stderr, "Invalid argument '%s'\n", arg);
+      return false;
+    }
+  }
+  return true;
+}
+
+Latency::Ptr parse_latency(const String& spec) {
+  unsigned long long a, b;
+  double sigma;
+  if (sscanf(spec.c_str(), "lognormal:%llu:%lf", &a, &sigma) == 2) {
+    return Latency::lognormal(a, sigma);
+  } else if (sscanf(spec.c_str(), "constant:%llu", &a) == 1) {
+    return Latency::constant(a);
+  } else if (sscanf(spec.c_str(), "uniform:%llu:%llu", &a, &b) == 2) {
+    return Latency::uniform(a, b);
+  } else if (sscanf(spec.c_str(), "exponential:%llu", &a) == 1) {
+    return Latency::exponential(a);
+  }
+  return Latency::Ptr();
+}
+
+//------------------------------------------------------------------------------
+// Server
+//------------------------------------------------------------------------------
+
+const char* scenario_names[] = { "none",   "slow-node", "gc-pauses", "stalls",
+                                 "resets", "overload",  "timeline",  NULL };
+
+/**
+ * Build a scenario where every node responds with the base latency and the
+ * second node misbehaves.
+ */
+Scenario::Ptr build_scenario(const String& name, const Latency::Ptr& latency,
+                             const Settings& settings) {
+  Scenario::Ptr scenario(new Scenario());
+  scenario->add(Scenario::Fault().latency(latency));
+
+  Address node("127.0.0.2", 9042);
+  if (name == "slow-node") {
+    scenario->add(Scenario::Fault().node(node).latency(Latency::lognormal(5000, 1.0)));
+  } else if (name == "gc-pauses") {
+    scenario->add(Scenario::Fault().node(node).latency(Latency::bimodal(
+        Latency::constant(0), Latency::uniform(50000, 200000), 0.01)));
+  } else if (name == "stalls") {
+    scenario->add(Scenario::Fault().node(node).stall(2000, 200));
+  } else if (name == "resets") {
+    scenario->add(Scenario::Fault().node(node).reset(0.001));
+  } else if (name == "overload") {
+    scenario->add(Scenario::Fault().node(node).overload(0.05));
+  } else if (name == "timeline") {
+    uint64_t quarter_ms = settings.duration_s * 1000 / 4;
+    scenario->add(Scenario::Fault()
+                      .node(node)
+                      .from(quarter_ms)
+                      .until(2 * quarter_ms)
+                      .latency(Latency::lognormal(5000, 1.0)));
+    scenario->add(
+        Scenario::Fault().node(node).from(2 * quarter_ms).until(3 * quarter_ms).stall(2000, 200));
+    scenario->add(Scenario::Fault().node(node).from(3 * quarter_ms).overload(0.05));
+  } else if (name != "none") {
+    return Scenario::Ptr();
+  }
+  return scenario;
+}
+
+void encode_kv_columns(int protocol_version, String* body) {
+  Column("k", Type::text()).encode(protocol_version, body);
+  Column("v", Type::text()).encode(protocol_version, body);
+}
+
+Row kv_row(int index) {
+  OStringStream ss;
+  ss << "key" << index;
+  return Row::Builder().text(ss.str()).text(String(VALUE_SIZE, 'v')).build();
+}
+
+/**
+ * Prepares the read and write queries. Both use the first variable as the
+ * partition key so that requests are routed using token awareness.
+ */
+struct Prepare : public Action {
+  virtual void on_run(Request* request) const {
+    String query;
+    PrepareParameters params;
+    if (!request->decode_prepare(&query, &params)) {
+      request->error(ERROR_PROTOCOL_ERROR, "Invalid prepare message");
+      return;
+    }
+
+    bool is_read = query == READ_QUERY;
+    if (!is_read && query != WRITE_QUERY) {
+      request->error(ERROR_INVALID_QUERY, "Unsupported query");
+      return;
+    }
+
+    String body;
+    encode_int32(RESULT_PREPARED, &body);
+    encode_string(is_read ? READ_ID : WRITE_ID, &body);
+
+    // Variables metadata
+    encode_int32(RESULT_FLAG_GLOBAL_TABLESPEC, &body);
+    encode_int32(is_read ? 1 : 2, &body);
+    if (request->version() >= 4) {
+      encode_int32(1, &body); // Partition key count
+      encode_int16(0, &body); // Partition key index
+    }
+    encode_string("bench", &body);
+    encode_string("kv", &body);
+    if (is_read) {
+      Column("k", Type::text()).encode(request->version(), &body);
+    } else {
+      encode_kv_columns(request->version(), &body);
+    }
+
+    // Result metadata
+    if (is_read) {
+      encode_int32(RESULT_FLAG_GLOBAL_TABLESPEC, &body);
+      encode_int32(2, &body);
+      encode_string("bench", &body);
+      encode_string("kv", &body);
+      encode_kv_columns(request->version(), &body);
+    } else {
+      encode_int32(RESULT_FLAG_NO_METADATA, &body);
+      encode_int32(0, &body);
+    }
+
+    request->write(OPCODE_RESULT, body);
+  }
+};
+
+struct Execute : public Action {
+  virtual void on_run(Request* request) const {
+    String id;
+    QueryParameters params;
+    if (!request->decode_execute(&id, &params)) {
+      request->error(ERROR_PROTOCOL_ERROR, "Invalid execute message");
+    } else if (id == READ_ID) {
+      request->write(OPCODE_RESULT, ResultSet::Builder("bench", "kv")
+                                        .column("k", Type::text())
+                                        .column("v", Type::text())
+                                        .row(kv_row(0))
+                                        .build()
+                                        .encode(request->version()));
+    } else if (id == WRITE_ID) {
+      String body;
+      encode_int32(RESULT_VOID, &body);
+      request->write(OPCODE_RESULT, body);
+    } else {
+      String body;
+      encode_int32(ERROR_UNPREPARED, &body);
+      encode_string("Unprepared", &body);
+      encode_string(id, &body);
+      request->write(OPCODE_ERROR, body);
+    }
+  }
+};
+
+/**
+ * Returns pages of the scan query. The paging state is the offset of the next
+ * row.
+ */
+struct Scan : public Action {
+  Scan(int row_count)
+      : row_count(row_count) {}
+
+  virtual void on_run(Request* request) const {
+    String query;
+    QueryParameters params;
+    if (!request->decode_query(&query, &params)) {
+      request->error(ERROR_PROTOCOL_ERROR, "Invalid query message");
+      return;
+    } else if (query != SCAN_QUERY) {
+      run_next(request);
+      return;
+    }
+
+    int offset = params.paging_state.empty() ? 0 : atoi(params.paging_state.c_str());
+    int page_size = (params.flags & QUERY_FLAG_PAGE_SIZE) && params.result_page_size > 0
+                        ? params.result_page_size
+                        : row_count;
+    int end = offset + page_size < row_count ? offset + page_size : row_count;
+
+    String body;
+    encode_int32(RESULT_ROWS, &body);
+    encode_int32(RESULT_FLAG_GLOBAL_TABLESPEC |
+                     (end < row_count ? static_cast<int32_t>(RESULT_FLAG_HAS_MORE_PAGES)
+                                      : static_cast<int32_t>(0)),
+                 &body);
+    encode_int32(2, &body);
+    if (end < row_count) {
+      OStringStream ss;
+      ss << end;
+      encode_bytes(ss.str(), &body);
+    }
+    encode_string("bench", &body);
+    encode_string("kv", &body);
+    encode_kv_columns(request->version(), &body);
+    encode_int32(end - offset, &body);
+    for (int i = offset; i < end; ++i) {
+      kv_row(i).encode(request->version(), &body);
+    }
+    request->write(OPCODE_RESULT, body);
+  }
+
+  const int row_count;
+};
+
+class BenchmarkCluster : public Cluster {
+public:
+  BenchmarkCluster(const RequestHandler* request_handler, size_t num_nodes, size_t num_threads)
+      : factory_(request_handler, this)
+      , event_loop_group_(num_threads) {
+    init(generator_, factory_, num_nodes, 0);
+  }
+
+  ~BenchmarkCluster() { stop_all(); }
+
+  int start_all() { return Cluster::start_all(&event_loop_group_); }
+
+private:
+  Ipv4AddressGenerator generator_;
+  ClientConnectionFactory factory_;
+  SimpleEventLoopGroup event_loop_group_;
+};
+
+//------------------------------------------------------------------------------
+// Client
+//------------------------------------------------------------------------------
+
+class Stats {
+public:
+  Stats()
+      : errors_(0)
+      , is_recording_(false) {
+    uv_mutex_init(&mutex_);
+    for (int i = 0; i <= OP_LAST_ENTRY; ++i) {
+      hdr_init(1, 60LL * 1000 * 1000, 3, &histograms_[i]); // Microseconds
+    }
+  }
+
+  ~Stats() {
+    for (int i = 0; i <= OP_LAST_ENTRY; ++i) {
+      free(histograms_[i]);
+    }
+    uv_mutex_destroy(&mutex_);
+  }
+
+  void start_recording() {
+    ScopedMutex l(&mutex_);
+    is_recording_ = true;
+  }
+
+  void stop_recording() {
+    ScopedMutex l(&mutex_);
+    is_recording_ = false;
+  }
+
+  void record(Operation op, uint64_t latency_ns, bool is_error) {
+    int64_t latency_us = static_cast<int64_t>(latency_ns / 1000);
+    ScopedMutex l(&mutex_);
+    if (!is_recording_) return;
+    if (is_error) {
+      errors_++;
+    } else {
+      hdr_record_value(histograms_[op], latency_us);
+      hdr_record_value(histograms_[OP_LAST_ENTRY], latency_us);
+    }
+  }
+
+  // Only valid once recording has stopped
+  hdr_histogram* histogram(int op) const { return histograms_[op]; }
+  uint64_t errors() const { return errors_; }
+
+private:
+  uv_mutex_t mutex_;
+  hdr_histogram* histograms_[OP_LAST_ENTRY + 1]; // The last histogram contains all operations
+  uint64_t errors_;
+  bool is_recording_;
+};
+
+class Client;
+
+/**
+ * A slot for a single outstanding request. When a request completes, the
+ * slot starts a new one until the benchmark is stopped.
+ */
+struct Slot {
+  Slot()
+      : client(NULL)
+      , rng_state(0)
+      , op(OP_READ)
+      , start_ns(0)
+      , statement(NULL) {}
+
+  uint64_t next_random() {
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 2685821657736338717ULL;
+  }
+
+  Client* client;
+  uint64_t rng_state;
+  Operation op;
+  uint64_t start_ns;
+  CassStatement* statement; // The current scan statement
+};
+
+class Client {
+public:
+  Client(const Settings& settings)
+      : settings_(settings)
+      , cluster_(cass_cluster_new())
+      , session_(cass_session_new())
+      , read_prepared_(NULL)
+      , write_prepared_(NULL)
+      , weight_total_(0)
+      , is_running_(false)
+      , outstanding_(0)
+      , slots_(settings.concurrency) {
+    uv_mutex_init(&mutex_);
+    uv_cond_init(&cond_);
+    for (int i = 0; i < OP_LAST_ENTRY; ++i) {
+      weight_total_ += settings.weights[i];
+    }
+    value_ = String(VALUE_SIZE, 'v');
+
+    cass_cluster_set_contact_points(cluster_, "127.0.0.1");
+    cass_cluster_set_protocol_version(cluster_, CASS_PROTOCOL_VERSION_V4);
+    cass_cluster_set_use_schema(cluster_, cass_false); // The mock cluster has no schema tables
+    cass_cluster_set_num_threads_io(cluster_, settings.io_threads);
+    if (settings.connections_per_host > 0) {
+      cass_cluster_set_core_connections_per_host(cluster_, settings.connections_per_host);
+    }
+    cass_cluster_set_queue_size_io(cluster_, settings.concurrency * 4 > 8192
+                                                 ? settings.concurrency * 4
+                                                 : 8192);
+    if (settings.speculative_delay_ms > 0) {
+      cass_cluster_set_constant_speculative_execution_policy(
+          cluster_, settings.speculative_delay_ms, settings.speculative_max_executions);
+    }
+    if (settings.is_latency_aware) {
+      cass_cluster_set_latency_aware_routing(cluster_, cass_true);
+    }
+  }
+
+  ~Client() {
+    if (read_prepared_) cass_prepared_free(read_prepared_);
+    if (write_prepared_) cass_prepared_free(write_prepared_);
+    cass_session_free(session_);
+    cass_cluster_free(cluster_);
+    uv_cond_destroy(&cond_);
+    uv_mutex_destroy(&mutex_);
+  }
+
+  bool connect() {
+    if (!wait(cass_session_connect(session_, cluster_), "connect")) return false;
+    read_prepared_ = prepare(READ_QUERY);
+    write_prepared_ = prepare(WRITE_QUERY);
+    return read_prepared_ != NULL && write_prepared_ != NULL;
+  }
+
+  void close() { wait(cass_session_close(session_), "close"); }
+
+  void start() {
+    ScopedMutex l(&mutex_);
+    is_running_ = true;
+    outstanding_ = slots_.size();
+    uint64_t seed = uv_hrtime();
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      Slot& slot = slots_[i];
+      slot.client = this;
+      slot.rng_state = seed + (i + 1) * 0x9E3779B97F4A7C15ULL;
+      l.unlock();
+      execute(&slot);
+      l.lock();
+    }
+  }
+
+  // Stop issuing requests and wait for outstanding requests to finish
+  void stop() {
+    ScopedMutex l(&mutex_);
+    is_running_ = false;
+    while (outstanding_ > 0) {
+      uv_cond_wait(&cond_, &mutex_);
+    }
+  }
+
+  Stats& stats() { return stats_; }
+
+private:
+  static bool check(CassFuture* future, const char* what) {
+    CassError rc = cass_future_error_code(future);
+    if (rc != CASS_OK) {
+      const char* message;
+      size_t message_length;
+      cass_future_error_message(future, &message, &message_length);
+      fprintf(stderr, "Unable to %s: %.*s\n", what, static_cast<int>(message_length), message);
+      return false;
+    }
+    return true;
+  }
+
+  static bool wait(CassFuture* future, const char* what) {
+    bool is_ok = check(future, what);
+    cass_future_free(future);
+    return is_ok;
+  }
+
+  const CassPrepared* prepare(const char* query) {
+    CassFuture* future = cass_session_prepare(session_, query);
+    const CassPrepared* prepared = check(future, "prepare") ? cass_future_get_prepared(future) : NULL;
+    cass_future_free(future);
+    return prepared;
+  }
+
+  Operation next_operation(Slot* slot) {
+    uint64_t r = slot->next_random() % weight_total_;
+    for (int i = 0; i < OP_LAST_ENTRY; ++i) {
+      if (r < settings_.weights[i]) return static_cast<Operation>(i);
+      r -= settings_.weights[i];
+    }
+    return OP_READ;
+  }
+
+  void bind_key(CassStatement* statement, Slot* slot) {
+    char key[32];
+    sprintf(key, "key%d", static_cast<int>(slot->next_random() % NUM_KEYS));
+    cass_statement_bind_string(statement, 0, key);
+  }
+
+  CassStatement* write_statement(Slot* slot) {
+    CassStatement* statement = cass_prepared_bind(write_prepared_);
+    cass_statement_set_is_idempotent(statement, cass_true);
+    bind_key(statement, slot);
+    cass_statement_bind_string_n(statement, 1, value_.data(), value_.size());
+    return statement;
+  }
+
+  void execute(Slot* slot) {
+    CassFuture* future = NULL;
+    if (slot->statement == NULL) {
+      slot->op = next_operation(slot);
+    }
+    slot->start_ns = uv_hrtime();
+
+    switch (slot->op) {
+      case OP_READ: {
+        CassStatement* statement = cass_prepared_bind(read_prepared_);
+        cass_statement_set_is_idempotent(statement, cass_true);
+        bind_key(statement, slot);
+        future = cass_session_execute(session_, statement);
+        cass_statement_free(statement);
+        break;
+      }
+      case OP_WRITE: {
+        CassStatement* statement = write_statement(slot);
+        future = cass_session_execute(session_, statement);
+        cass_statement_free(statement);
+        break;
+      }
+      case OP_BATCH: {
+        CassBatch* batch = cass_batch_new(CASS_BATCH_TYPE_UNLOGGED);
+        cass_batch_set_is_idempotent(batch, cass_true);
+        for (unsigned i = 0; i < settings_.batch_size; ++i) {
+          CassStatement* statement = write_statement(slot);
+          cass_batch_add_statement(batch, statement);
+          cass_statement_free(statement);
+        }
+        future = cass_session_execute_batch(session_, batch);
+        cass_batch_free(batch);
+        break;
+      }
+      default: {
+        if (slot->statement == NULL) {
+          slot->statement = cass_statement_new(SCAN_QUERY, 0);
+          cass_statement_set_paging_size(slot->statement, settings_.page_size);
+          cass_statement_set_is_idempotent(slot->statement, cass_true);
+        }
+        future = cass_session_execute(session_, slot->statement);
+        break;
+      }
+    }
+
+    cass_future_set_callback(future, on_result, slot);
+    cass_future_free(future);
+  }
+
+  static void on_result(CassFuture* future, void* data) {
+    Slot* slot = static_cast<Slot*>(data);
+    slot->client->handle_result(future, slot);
+  }
+
+  void handle_result(CassFuture* future, Slot* slot) {
+    uint64_t latency_ns = uv_hrtime() - slot->start_ns;
+    bool is_error = cass_future_error_code(future) != CASS_OK;
+    stats_.record(slot->op, latency_ns, is_error);
+
+    // Continue a scan with the next page
+    if (slot->statement != NULL) {
+      const CassResult* result = is_error ? NULL : cass_future_get_result(future);
+      if (result && cass_result_has_more_pages(result)) {
+        cass_statement_set_paging_state(slot->statement, result);
+      } else {
+        cass_statement_free(slot->statement);
+        slot->statement = NULL;
+      }
+      if (result) cass_result_free(result);
+    }
+
+    ScopedMutex l(&mutex_);
+    if (is_running_) {
+      l.unlock();
+      execute(slot);
+    } else {
+      if (slot->statement != NULL) {
+        cass_statement_free(slot->statement);
+        slot->statement = NULL;
+      }
+      if (--outstanding_ == 0) {
+        uv_cond_signal(&cond_);
+      }
+    }
+  }
+
+private:
+  const Settings& settings_;
+  CassCluster* cluster_;
+  CassSession* session_;
+  const CassPrepared* read_prepared_;
+  const CassPrepared* write_prepared_;
+  String value_;
+  uint64_t weight_total_;
+
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  bool is_running_;
+  size_t outstanding_;
+  Vector<Slot> slots_;
+
+  Stats stats_;
+};
+
+//------------------------------------------------------------------------------
+// Results
+//------------------------------------------------------------------------------
+
+uint64_t cpu_time_us() {
+  uv_rusage_t usage;
+  if (uv_getrusage(&usage) != 0) return 0;
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000ULL + usage.ru_utime.tv_usec +
+         usage.ru_stime.tv_usec;
+}
+
+void print_results(const Settings& settings, const String& scenario, const Stats& stats,
+                   double elapsed_s, uint64_t cpu_us) {
+  hdr_histogram* all = stats.histogram(OP_LAST_ENTRY);
+  int64_t total = all->total_count;
+  double throughput = total / elapsed_s;
+  double cpu_per_request_us = total > 0 ? static_cast<double>(cpu_us) / total : 0.0;
+
+  if (settings.is_json) {
+    printf("{\n");
+    printf("  \"settings\": {\n");
+    printf("    \"nodes\": %u,\n", settings.nodes);
+    printf("    \"io_threads\": %u,\n", settings.io_threads);
+    printf("    \"concurrency\": %u,\n", settings.concurrency);
+    printf("    \"duration_s\": %u,\n", settings.duration_s);
+    printf("    \"latency\": \"%s\",\n", settings.latency.c_str());
+    printf("    \"scenario\": \"%s\",\n", scenario.c_str());
+    printf("    \"speculative_delay_ms\": %u,\n", settings.speculative_delay_ms);
+    printf("    \"latency_aware\": %s,\n", settings.is_latency_aware ? "true" : "false");
+    printf("    \"mix\": \"%u:%u:%u:%u\"\n", settings.weights[0], settings.weights[1],
+           settings.weights[2], settings.weights[3]);
+    printf("  },\n");
+    printf("  \"requests\": %lld,\n", static_cast<long long>(total));
+    printf("  \"errors\": %llu,\n", static_cast<unsigned long long>(stats.errors()));
+    printf("  \"requests_per_second\": %.1f,\n", throughput);
+    printf("  \"cpu_us_per_request\": %.2f,\n", cpu_per_request_us);
+    printf("  \"operations\": {");
+    for (int i = 0; i <= OP_LAST_ENTRY; ++i) {
+      hdr_histogram* h = stats.histogram(i);
+      printf("%s\n    \"%s\": { \"count\": %lld, \"p50_us\": %lld, \"p99_us\": %lld, "
+             "\"p999_us\": %lld, \"max_us\": %lld }",
+             i > 0 ? "," : "", i < OP_LAST_ENTRY ? operation_names[i] : "all",
+             static_cast<long long>(h->total_count),
+             static_cast<long long>(hdr_value_at_percentile(h, 50.0)),
+             static_cast<long long>(hdr_value_at_percentile(h, 99.0)),
+             static_cast<long long>(hdr_value_at_percentile(h, 99.9)),
+             static_cast<long long>(hdr_max(h)));
+    }
+    printf("\n  }\n}");
+  } else {
+    printf("Scenario: %s\n", scenario.c_str());
+    printf("Requests: %lld (%llu errors) in %.1f s\n", static_cast<long long>(total),
+           static_cast<unsigned long long>(stats.errors()), elapsed_s);
+    printf("Throughput: %.1f requests/s\n", throughput);
+    printf("CPU: %.2f us/request (includes the in-process mock server)\n", cpu_per_request_us);
+    printf("%-8s %12s %10s %10s %10s %10s\n", "op", "count", "p50 us", "p99 us", "p999 us",
+           "max us");
+    for (int i = 0; i <= OP_LAST_ENTRY; ++i) {
+      hdr_histogram* h = stats.histogram(i);
+      printf("%-8s %12lld %10lld %10lld %10lld %10lld\n",
+             i < OP_LAST_ENTRY ? operation_names[i] : "all",
+             static_cast<long long>(h->total_count),
+             static_cast<long long>(hdr_value_at_percentile(h, 50.0)),
+             static_cast<long long>(hdr_value_at_percentile(h, 99.0)),
+             static_cast<long long>(hdr_value_at_percentile(h, 99.9)),
+             static_cast<long long>(hdr_max(h)));
+    }
+  }
+}
+
+/**
+ * Start a mock cluster with the scenario's faults and run the workload
+ * against it.
+ */
+bool run(const Settings& settings, const String& name, const Scenario::Ptr& scenario) {
+  SimpleRequestHandlerBuilder builder;
+  builder.with_supported_protocol_versions(1, 4);
+  builder.on(OPCODE_PREPARE).execute(new Prepare());
+  builder.on(OPCODE_EXECUTE).faults(scenario).execute(new Execute());
+  builder.on(OPCODE_BATCH).faults(scenario).void_result();
+  builder.on(OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .faults(scenario)
+      .execute(new Scan(settings.scan_rows))
+      .empty_rows_result(0);
+
+  BenchmarkCluster cluster(builder.build(), settings.nodes, settings.server_threads);
+  if (cluster.start_all() != 0) {
+    fprintf(stderr, "Unable to start the mock cluster\n");
+    return false;
+  }
+
+  Client client(settings);
+  if (!client.connect()) {
+    return false;
+  }
+
+  client.start();
+  uv_sleep(settings.warmup_s * 1000);
+
+  // The scenario's timeline starts with the measurement
+  scenario->start();
+  client.stats().start_recording();
+  uint64_t start_ns = uv_hrtime();
+  uint64_t start_cpu_us = cpu_time_us();
+  uv_sleep(settings.duration_s * 1000);
+  client.stats().stop_recording();
+  double elapsed_s = (uv_hrtime() - start_ns) / 1e9;
+  uint64_t cpu_us = cpu_time_us() - start_cpu_us;
+
+  client.stop();
+  print_results(settings, name, client.stats(), elapsed_s, cpu_us);
+  client.close();
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Settings settings;
+  if (!parse_settings(argc, argv, &settings)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  Latency::Ptr latency(parse_latency(settings.latency));
+  if (!latency) {
+    fprintf(stderr, "Invalid latency distribution '%s'\n", settings.latency.c_str());
+    usage(argv[0]);
+    return 1;
+  }
+
+  Vector<String> names;
+  if (settings.scenario == "all") {
+    for (const char** name = scenario_names; *name; ++name) {
+      names.push_back(*name);
+    }
+  } else if (build_scenario(settings.scenario, latency, settings)) {
+    names.push_back(settings.scenario);
+  } else {
+    fprintf(stderr, "Invalid scenario '%s'\n", settings.scenario.c_str());
+    usage(argv[0]);
+    return 1;
+  }
+
+  cass_log_set_level(CASS_LOG_ERROR);
+
+  bool is_array = settings.is_json && names.size() > 1;
+  if (is_array) printf("[\n");
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (i > 0) printf(settings.is_json ? ",\n" : "\n");
+    if (!run(settings, names[i], build_scenario(names[i], latency, settings))) {
+      return 1;
+    }
+  }
+  if (is_array) printf("\n]");
+  if (settings.is_json) printf("\n");
+
+  return 0;
+}
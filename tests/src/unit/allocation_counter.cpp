@@ -0,0 +1,125 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "allocation_counter.hpp"
+
+#include "atomic.hpp"
+#include "memory.hpp"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <uv.h>
+
+using datastax::internal::Atomic;
+using datastax::internal::MEMORY_ORDER_RELAXED;
+using datastax::internal::Memory;
+
+namespace {
+
+// The counting functions can still be called by libuv after a counter is
+// destroyed (it doesn't allow its allocator to be reset) so the state is
+// global instead of part of the counter.
+Atomic<bool> is_counting(false);
+Atomic<bool> is_all_threads(false);
+uv_thread_t counting_thread;
+
+Atomic<uint64_t> num_allocations(0);
+Atomic<uint64_t> num_reallocations(0);
+Atomic<uint64_t> num_frees(0);
+Atomic<uint64_t> num_bytes(0);
+
+CassMallocFunction underlying_malloc = NULL;
+CassReallocFunction underlying_realloc = NULL;
+CassFreeFunction underlying_free = NULL;
+
+bool should_count() {
+  if (!is_counting.load(MEMORY_ORDER_RELAXED)) return false;
+  if (is_all_threads.load(MEMORY_ORDER_RELAXED)) return true;
+  uv_thread_t self = uv_thread_self();
+  return uv_thread_equal(&self, &counting_thread) != 0;
+}
+
+void* counting_malloc(size_t size) {
+  if (should_count()) {
+    num_allocations.fetch_add(1, MEMORY_ORDER_RELAXED);
+    num_bytes.fetch_add(size, MEMORY_ORDER_RELAXED);
+  }
+  return underlying_malloc ? underlying_malloc(size) : ::malloc(size);
+}
+
+void* counting_realloc(void* ptr, size_t size) {
+  if (should_count()) {
+    if (ptr == NULL) {
+      num_allocations.fetch_add(1, MEMORY_ORDER_RELAXED);
+    } else {
+      num_reallocations.fetch_add(1, MEMORY_ORDER_RELAXED);
+    }
+    num_bytes.fetch_add(size, MEMORY_ORDER_RELAXED);
+  }
+  return underlying_realloc ? underlying_realloc(ptr, size) : ::realloc(ptr, size);
+}
+
+void counting_free(void* ptr) {
+  if (ptr != NULL && should_count()) {
+    num_frees.fetch_add(1, MEMORY_ORDER_RELAXED);
+  }
+  if (underlying_free) {
+    underlying_free(ptr);
+  } else {
+    ::free(ptr);
+  }
+}
+
+} // namespace
+
+AllocationCounter::AllocationCounter(Scope scope)
+    : previous_malloc_(Memory::malloc_func())
+    , previous_realloc_(Memory::realloc_func())
+    , previous_free_(Memory::free_func()) {
+  assert(!is_counting.load() && "Only one allocation counter can be active at a time");
+
+  if (previous_malloc_ != counting_malloc) {
+    underlying_malloc = previous_malloc_;
+    underlying_realloc = previous_realloc_;
+    underlying_free = previous_free_;
+  }
+
+  reset();
+  is_all_threads.store(scope == ALL_THREADS);
+  counting_thread = uv_thread_self();
+  Memory::set_functions(counting_malloc, counting_realloc, counting_free);
+  is_counting.store(true);
+}
+
+AllocationCounter::~AllocationCounter() {
+  is_counting.store(false);
+  Memory::set_functions(previous_malloc_, previous_realloc_, previous_free_);
+}
+
+void AllocationCounter::reset() {
+  num_allocations.store(0);
+  num_reallocations.store(0);
+  num_frees.store(0);
+  num_bytes.store(0);
+}
+
+uint64_t AllocationCounter::allocations() const { return num_allocations.load(); }
+
+uint64_t AllocationCounter::reallocations() const { return num_reallocations.load(); }
+
+uint64_t AllocationCounter::frees() const { return num_frees.load(); }
+
+uint64_t AllocationCounter::bytes() const { return num_bytes.load(); }
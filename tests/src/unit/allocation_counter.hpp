@@ -0,0 +1,93 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef UNIT_ALLOCATION_COUNTER_HPP
+#define UNIT_ALLOCATION_COUNTER_HPP
+
+#include "cassandra.h"
+#include "macros.hpp"
+
+#include <stdint.h>
+
+/**
+ * Counts the allocations made by the driver (through `Memory`) while in
+ * scope. Only one counter can be active at a time.
+ *
+ * Example:
+ *
+ * AllocationCounter counter;
+ * CassBatch* batch = cass_batch_new(CASS_BATCH_TYPE_LOGGED);
+ * cass_batch_free(batch);
+ * EXPECT_LE(counter.allocations(), 2u);
+ */
+class AllocationCounter {
+public:
+  /**
+   * Scope of the allocations that are counted.
+   */
+  enum Scope {
+    CURRENT_THREAD, // Only allocations made by the thread that created the counter
+    ALL_THREADS     // Allocations made by any thread e.g. the driver's I/O threads
+  };
+
+  /**
+   * Constructor. Installs the counting allocation functions; any previously
+   * installed functions are used to allocate memory.
+   *
+   * @param scope The allocations to count.
+   */
+  AllocationCounter(Scope scope = CURRENT_THREAD);
+
+  /**
+   * Destructor. Restores the previous allocation functions.
+   */
+  ~AllocationCounter();
+
+  /**
+   * Reset all counts to zero.
+   */
+  void reset();
+
+  /**
+   * Number of new allocations i.e. `malloc()` and `realloc()` of `NULL`.
+   */
+  uint64_t allocations() const;
+
+  /**
+   * Number of `realloc()` calls that resized an existing allocation.
+   */
+  uint64_t reallocations() const;
+
+  /**
+   * Number of `free()` calls.
+   */
+  uint64_t frees() const;
+
+  /**
+   * Total number of bytes requested by `malloc()` and `realloc()`.
+   */
+  uint64_t bytes() const;
+
+private:
+  CassMallocFunction previous_malloc_;
+  CassReallocFunction previous_realloc_;
+  CassFreeFunction previous_free_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(AllocationCounter);
+};
+
+#endif
@@ -17,6 +17,7 @@
 #include "mockssandra.hpp"
 
 #include <assert.h>
+#include <math.h>
 #include <stdio.h>
 
 #include "control_connection.hpp" // For host queries
@@ -852,6 +853,22 @@ const char* decode_string_map(const char* input, const char* end,
   return pos;
 }
 
+const char* decode_bytes_map(const char* input, const char* end,
+                             Vector<std::pair<String, String> >* output) {
+
+  uint16_t len = 0;
+  const char* pos = decode_uint16(input, end, &len);
+  output->reserve(len);
+  for (int i = 0; i < len; ++i) {
+    String key;
+    String value;
+    pos = decode_string(pos, end, &key);
+    pos = decode_bytes(pos, end, &value);
+    output->push_back(std::pair<String, String>(key, value));
+  }
+  return pos;
+}
+
 const char* decode_stringlist(const char* input, const char* end, Vector<String>* output) {
   uint16_t len = 0;
   const char* pos = decode_uint16(input, end, &len);
@@ -1270,6 +1287,184 @@ String ResultSet::encode(int protocol_version) const {
   return body;
 }
 
+namespace {
+
+class ConstantLatency : public Latency {
+public:
+  ConstantLatency(uint64_t latency_us)
+      : latency_us_(latency_us) {}
+
+protected:
+  virtual uint64_t sample_us(MT19937_64& rng) { return latency_us_; }
+
+private:
+  const uint64_t latency_us_;
+};
+
+class UniformLatency : public Latency {
+public:
+  UniformLatency(uint64_t min_us, uint64_t max_us)
+      : min_us_(min_us)
+      , max_us_(max_us < min_us ? min_us : max_us) {}
+
+protected:
+  virtual uint64_t sample_us(MT19937_64& rng) {
+    return min_us_ + static_cast<uint64_t>(next_double(rng) * (max_us_ - min_us_));
+  }
+
+private:
+  const uint64_t min_us_;
+  const uint64_t max_us_;
+};
+
+class ExponentialLatency : public Latency {
+public:
+  ExponentialLatency(uint64_t mean_us)
+      : mean_us_(mean_us) {}
+
+protected:
+  virtual uint64_t sample_us(MT19937_64& rng) {
+    return static_cast<uint64_t>(-log(1.0 - next_double(rng)) * mean_us_);
+  }
+
+private:
+  const uint64_t mean_us_;
+};
+
+class LognormalLatency : public Latency {
+public:
+  LognormalLatency(uint64_t median_us, double sigma)
+      : median_us_(median_us)
+      , sigma_(sigma) {}
+
+protected:
+  virtual uint64_t sample_us(MT19937_64& rng) {
+    // Box-Muller transform to get a standard normal value
+    double u1 = 1.0 - next_double(rng);
+    double u2 = next_double(rng);
+    double z = sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+    return static_cast<uint64_t>(median_us_ * exp(sigma_ * z));
+  }
+
+private:
+  const uint64_t median_us_;
+  const double sigma_;
+};
+
+class BimodalLatency : public Latency {
+public:
+  BimodalLatency(const Ptr& fast, const Ptr& slow, double slow_probability)
+      : fast_(fast)
+      , slow_(slow)
+      , slow_probability_(slow_probability) {}
+
+protected:
+  virtual uint64_t sample_us(MT19937_64& rng) {
+    return Latency::sample_us(next_double(rng) < slow_probability_ ? slow_ : fast_, rng);
+  }
+
+private:
+  const Ptr fast_;
+  const Ptr slow_;
+  const double slow_probability_;
+};
+
+} // namespace
+
+Latency::Latency()
+    : rng_(uv_hrtime()) {
+  uv_mutex_init(&mutex_);
+}
+
+Latency::~Latency() { uv_mutex_destroy(&mutex_); }
+
+uint64_t Latency::sample_us() {
+  ScopedMutex l(&mutex_);
+  return sample_us(rng_);
+}
+
+Latency::Ptr Latency::constant(uint64_t latency_us) {
+  return Ptr(new ConstantLatency(latency_us));
+}
+
+Latency::Ptr Latency::uniform(uint64_t min_us, uint64_t max_us) {
+  return Ptr(new UniformLatency(min_us, max_us));
+}
+
+Latency::Ptr Latency::exponential(uint64_t mean_us) { return Ptr(new ExponentialLatency(mean_us)); }
+
+Latency::Ptr Latency::lognormal(uint64_t median_us, double sigma) {
+  return Ptr(new LognormalLatency(median_us, sigma));
+}
+
+Latency::Ptr Latency::bimodal(const Ptr& fast, const Ptr& slow, double slow_probability) {
+  return Ptr(new BimodalLatency(fast, slow, slow_probability));
+}
+
+double Latency::next_double(MT19937_64& rng) {
+  return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0); // 2^53
+}
+
+Scenario::Scenario()
+    : start_ns_(uv_hrtime())
+    , rng_(start_ns_) {
+  uv_mutex_init(&mutex_);
+}
+
+Scenario::~Scenario() { uv_mutex_destroy(&mutex_); }
+
+Scenario& Scenario::add(const Fault& fault) {
+  ScopedMutex l(&mutex_);
+  faults_.push_back(fault);
+  return *this;
+}
+
+void Scenario::start() {
+  ScopedMutex l(&mutex_);
+  start_ns_ = uv_hrtime();
+}
+
+Scenario::Effect Scenario::inject(const Address& address, uint64_t* delay_us) {
+  uint64_t start_ns;
+  {
+    ScopedMutex l(&mutex_);
+    start_ns = start_ns_;
+  }
+  return inject(address, (uv_hrtime() - start_ns) / 1000, delay_us);
+}
+
+Scenario::Effect Scenario::inject(const Address& address, uint64_t elapsed_us,
+                                  uint64_t* delay_us) {
+  ScopedMutex l(&mutex_);
+  uint64_t elapsed_ms = elapsed_us / 1000;
+
+  *delay_us = 0;
+  for (Vector<Fault>::const_iterator it = faults_.begin(), end = faults_.end(); it != end; ++it) {
+    const Fault& fault = *it;
+    if (!fault.is_active(address, elapsed_ms)) continue;
+
+    if (fault.reset_probability_ > 0.0 &&
+        Latency::next_double(rng_) < fault.reset_probability_) {
+      return RESET;
+    }
+    if (fault.overload_probability_ > 0.0 &&
+        Latency::next_double(rng_) < fault.overload_probability_) {
+      return OVERLOAD;
+    }
+    if (fault.stall_period_ms_ > 0) {
+      uint64_t period_us = fault.stall_period_ms_ * 1000;
+      uint64_t offset_us = (elapsed_us - fault.start_ms_ * 1000) % period_us;
+      if (offset_us < fault.stall_duration_ms_ * 1000) {
+        *delay_us += fault.stall_duration_ms_ * 1000 - offset_us;
+      }
+    }
+    if (fault.latency_) {
+      *delay_us += fault.latency_->sample_us();
+    }
+  }
+  return RESPOND;
+}
+
 Action::Builder& Action::Builder::reset() {
   first_.reset();
   last_ = NULL;
@@ -1298,6 +1493,14 @@ Action::Builder& Action::Builder::nop() { return execute(new Nop()); }
 
 Action::Builder& Action::Builder::wait(uint64_t timeout) { return execute(new Wait(timeout)); }
 
+Action::Builder& Action::Builder::delay(const Latency::Ptr& latency) {
+  return execute(new Delay(latency));
+}
+
+Action::Builder& Action::Builder::faults(const Scenario::Ptr& scenario) {
+  return execute(new Faults(scenario));
+}
+
 Action::Builder& Action::Builder::close() { return execute(new Close()); }
 
 Action::Builder& Action::Builder::error(int32_t code, const String& message) {
@@ -1419,15 +1622,22 @@ Request::Request(int8_t version, int8_t flags, int16_t stream, int8_t opcode, co
     , stream_(stream)
     , opcode_(opcode)
     , body_(body)
+    , body_start_(0)
     , client_(client)
-    , timer_action_(NULL) {
-  (void)flags_; // TODO: Implement custom payload etc.
+    , timer_action_(NULL)
+    , delay_action_(NULL) {
+  if (flags_ & FLAG_CUSTOM_PAYLOAD) {
+    const char* pos = decode_bytes_map(body_.data(), end(), &custom_payload_);
+    body_start_ = pos - body_.data();
+  }
 }
 
 void Request::write(int8_t opcode, const String& body) { write(stream_, opcode, body); }
 
 void Request::write(int16_t stream, int8_t opcode, const String& body) {
-  client_->write(encode_header(version_, flags_, stream, opcode, body.size()) + body);
+  // Responses don't have a custom payload
+  int8_t flags = flags_ & ~FLAG_CUSTOM_PAYLOAD;
+  client_->write(encode_header(version_, flags, stream, opcode, body.size()) + body);
 }
 
 void Request::error(int32_t code, const String& message) {
@@ -1439,12 +1649,36 @@ void Request::error(int32_t code, const String& message) {
 
 void Request::wait(uint64_t timeout, const Action* action) {
   inc_ref();
+  client_->add_pending(this);
   timer_action_ = action;
-  timer_.start(client_->server()->loop(), timeout, bind_callback(&Request::on_timeout, this));
+  int rc =
+      timer_.start(client_->server()->loop(), timeout, bind_callback(&Request::on_timeout, this));
+  if (rc != 0) {
+    fprintf(stderr, "Unable to start wait timer: %s\n", uv_strerror(rc));
+    on_timeout(&timer_);
+  }
+}
+
+void Request::delay(uint64_t timeout_us, const Action* action) {
+  if (timeout_us == 0) {
+    action->run_next(this);
+    return;
+  }
+  inc_ref();
+  client_->add_pending(this);
+  delay_action_ = action;
+  client_->add_delayed(this, timeout_us);
 }
 
 void Request::close() { client_->close(); }
 
+void Request::cancel() {
+  timer_.stop();
+  client_->remove_delayed(this);
+  client_->remove_pending(this);
+  dec_ref();
+}
+
 bool Request::decode_startup(Options* options) {
   return decode_string_map(start(), end(), options) == end();
 }
@@ -1485,12 +1719,34 @@ const Host& Request::host(const Address& address) const {
 Hosts Request::hosts() const { return client_->cluster()->hosts(); }
 
 void Request::on_timeout(Timer* timer) {
+  client_->remove_pending(this);
   timer_action_->run_next(this);
   dec_ref();
 }
 
+void Request::on_delay() {
+  client_->remove_pending(this);
+  delay_action_->run_next(this);
+  dec_ref();
+}
+
 void SendError::on_run(Request* request) const { request->error(code, message); }
 
+void Faults::on_run(Request* request) const {
+  uint64_t delay_us;
+  switch (scenario->inject(request->client()->server()->address(), &delay_us)) {
+    case Scenario::RESET:
+      request->close();
+      break;
+    case Scenario::OVERLOAD:
+      request->error(ERROR_OVERLOADED, "Overloaded");
+      break;
+    default:
+      request->delay(delay_us, this);
+      break;
+  }
+}
+
 void SendReady::on_run(Request* request) const { request->write(OPCODE_READY, String()); }
 
 void SendAuthenticate::on_run(Request* request) const {
@@ -1956,6 +2212,7 @@ const RequestHandler* RequestHandler::Builder::build() {
   handler->actions_[OPCODE_EXECUTE].reset(actions_[OPCODE_EXECUTE].build());
   handler->actions_[OPCODE_REGISTER].reset(actions_[OPCODE_REGISTER].build());
   handler->actions_[OPCODE_AUTH_RESPONSE].reset(actions_[OPCODE_AUTH_RESPONSE].build());
+  handler->actions_[OPCODE_BATCH].reset(actions_[OPCODE_BATCH].build());
 
   return handler;
 }
@@ -2057,6 +2314,71 @@ void ProtocolHandler::decode_body(ClientConnection* client, const char* body, in
 
 void ClientConnection::on_read(const char* data, size_t len) { handler_.decode(this, data, len); }
 
+void ClientConnection::on_close() {
+  while (!pending_.is_empty()) {
+    pending_.front()->cancel();
+  }
+  delay_timer_.stop();
+}
+
+void ClientConnection::add_delayed(Request* request, uint64_t timeout_us) {
+  Delayed delayed;
+  delayed.deadline_ns = uv_hrtime() + timeout_us * 1000;
+  delayed.request = request;
+
+  // Requests with the same deadline are responded to in the order they arrived
+  DelayedVec::iterator it = delayed_.end();
+  while (it != delayed_.begin() && (it - 1)->deadline_ns <= delayed.deadline_ns) {
+    --it;
+  }
+  bool is_earliest = it == delayed_.end();
+  delayed_.insert(it, delayed);
+
+  if (is_earliest) {
+    if (delay_timer_.is_running()) {
+      delay_timer_.stop(); // A running timer can't be restarted
+    }
+    start_delay_timer();
+  }
+}
+
+void ClientConnection::remove_delayed(Request* request) {
+  for (DelayedVec::iterator it = delayed_.begin(), end = delayed_.end(); it != end; ++it) {
+    if (it->request == request) {
+      delayed_.erase(it);
+      break;
+    }
+  }
+}
+
+void ClientConnection::start_delay_timer() {
+  if (delayed_.empty()) return;
+
+  uint64_t now = uv_hrtime();
+  uint64_t deadline_ns = delayed_.back().deadline_ns;
+  uint64_t timeout_us = deadline_ns > now ? (deadline_ns - now + 999) / 1000 : 0;
+  int rc = delay_timer_.start(server()->loop(), timeout_us,
+                              bind_callback(&ClientConnection::on_delay, this));
+  if (rc != 0) {
+    fprintf(stderr, "Unable to start delay timer: %s\n", uv_strerror(rc));
+    while (!delayed_.empty()) { // Respond without the delay
+      Request* request = delayed_.back().request;
+      delayed_.pop_back();
+      request->on_delay();
+    }
+  }
+}
+
+void ClientConnection::on_delay(MicroTimer* timer) {
+  uint64_t now = uv_hrtime();
+  while (!delayed_.empty() && delayed_.back().deadline_ns <= now) {
+    Request* request = delayed_.back().request;
+    delayed_.pop_back();
+    request->on_delay();
+  }
+  start_delay_timer();
+}
+
 Event::Event(const String& event_body)
     : event_body_(event_body) {}
 
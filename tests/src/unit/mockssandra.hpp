@@ -29,6 +29,7 @@
 #include "event_loop.hpp"
 #include "list.hpp"
 #include "map.hpp"
+#include "micro_timer.hpp"
 #include "ref_counted.hpp"
 #include "scoped_ptr.hpp"
 #include "string.hpp"
@@ -55,6 +56,7 @@ using datastax::internal::Vector;
 using datastax::internal::core::Address;
 using datastax::internal::core::EventLoop;
 using datastax::internal::core::EventLoopGroup;
+using datastax::internal::core::MicroTimer;
 using datastax::internal::core::RoundRobinEventLoopGroup;
 using datastax::internal::core::Task;
 using datastax::internal::core::Timer;
@@ -338,6 +340,8 @@ enum {
 
 typedef std::pair<String, String> Option;
 typedef Vector<Option> Options;
+
+typedef Vector<std::pair<String, String> > CustomPayload;
 typedef std::pair<String, String> Credential;
 typedef Vector<Credential> Credentials;
 typedef Vector<String> EventTypes;
@@ -361,8 +365,10 @@ struct QueryParameters {
   String keyspace;
 };
 
+int32_t encode_int16(int16_t value, String* output);
 int32_t encode_int32(int32_t value, String* output);
 int32_t encode_string(const String& value, String* output);
+int32_t encode_bytes(const String& value, String* output);
 int32_t encode_string_map(const Map<String, Vector<String> >& value, String* output);
 
 class Type {
@@ -566,6 +572,183 @@ class ClientConnection;
 class Cluster;
 class Request;
 
+/**
+ * A distribution of server-side latencies. Samples are in microseconds and
+ * sampling is thread-safe so a distribution can be shared by nodes running on
+ * different event loops. Responses are delayed with microsecond precision.
+ */
+class Latency : public RefCounted<Latency> {
+public:
+  typedef SharedRefPtr<Latency> Ptr;
+
+  Latency();
+  virtual ~Latency();
+
+  uint64_t sample_us();
+
+  static Ptr constant(uint64_t latency_us);
+  static Ptr uniform(uint64_t min_us, uint64_t max_us);
+  static Ptr exponential(uint64_t mean_us);
+  static Ptr lognormal(uint64_t median_us, double sigma);
+
+  /**
+   * Samples from `slow` with the given probability and from `fast` otherwise
+   * e.g. a replica that's usually fast but is sometimes stuck in a GC pause.
+   */
+  static Ptr bimodal(const Ptr& fast, const Ptr& slow, double slow_probability);
+
+  // A uniformly distributed value in [0, 1)
+  static double next_double(MT19937_64& rng);
+
+protected:
+  // Sample another distribution using this distribution's generator
+  static uint64_t sample_us(const Ptr& latency, MT19937_64& rng) {
+    return latency->sample_us(rng);
+  }
+
+  virtual uint64_t sample_us(MT19937_64& rng) = 0;
+
+private:
+  uv_mutex_t mutex_;
+  MT19937_64 rng_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(Latency);
+};
+
+/**
+ * A script of faults injected by nodes over time. Each fault can be limited
+ * to a single node and to a window of time measured from when the scenario
+ * is started.
+ *
+ * Example:
+ *
+ * Scenario::Ptr scenario(new Scenario());
+ * scenario->add(Scenario::Fault()
+ *                   .node(Address("127.0.0.2", 9042))
+ *                   .from(5000)
+ *                   .until(10000)
+ *                   .latency(Latency::lognormal(2000, 1.0)));
+ * builder.on(OPCODE_EXECUTE).faults(scenario).void_result();
+ */
+class Scenario : public RefCounted<Scenario> {
+public:
+  typedef SharedRefPtr<Scenario> Ptr;
+
+  class Fault {
+  public:
+    Fault()
+        : start_ms_(0)
+        , end_ms_(CASS_UINT64_MAX)
+        , stall_period_ms_(0)
+        , stall_duration_ms_(0)
+        , reset_probability_(0.0)
+        , overload_probability_(0.0) {}
+
+    // Only inject the fault on a single node (default: all nodes)
+    Fault& node(const Address& address) {
+      address_ = address;
+      return *this;
+    }
+
+    // Only inject the fault in the window [start_ms, end_ms)
+    Fault& from(uint64_t start_ms) {
+      start_ms_ = start_ms;
+      return *this;
+    }
+
+    Fault& until(uint64_t end_ms) {
+      end_ms_ = end_ms;
+      return *this;
+    }
+
+    // Delay responses by a sample from the distribution
+    Fault& latency(const Latency::Ptr& latency) {
+      latency_ = latency;
+      return *this;
+    }
+
+    // Hold all responses for the first `duration_ms` of every `period_ms`
+    Fault& stall(uint64_t period_ms, uint64_t duration_ms) {
+      stall_period_ms_ = period_ms;
+      stall_duration_ms_ = duration_ms;
+      return *this;
+    }
+
+    // Close the connection instead of responding
+    Fault& reset(double probability) {
+      reset_probability_ = probability;
+      return *this;
+    }
+
+    // Respond with an overloaded error
+    Fault& overload(double probability) {
+      overload_probability_ = probability;
+      return *this;
+    }
+
+  private:
+    friend class Scenario;
+
+    bool is_active(const Address& address, uint64_t elapsed_ms) const {
+      return (!address_.is_valid() || address_ == address) && elapsed_ms >= start_ms_ &&
+             elapsed_ms < end_ms_;
+    }
+
+  private:
+    Address address_;
+    uint64_t start_ms_;
+    uint64_t end_ms_;
+    Latency::Ptr latency_;
+    uint64_t stall_period_ms_;
+    uint64_t stall_duration_ms_;
+    double reset_probability_;
+    double overload_probability_;
+  };
+
+  enum Effect { RESPOND, RESET, OVERLOAD };
+
+  Scenario();
+  ~Scenario();
+
+  Scenario& add(const Fault& fault);
+
+  /**
+   * Restart the scenario's clock. The clock starts when the scenario is
+   * created.
+   */
+  void start();
+
+  /**
+   * Determine the fault to inject for a request handled by a node.
+   *
+   * @param address The node's address.
+   * @param delay_us The time to delay the response if responding.
+   * @return The effect of the active faults.
+   */
+  Effect inject(const Address& address, uint64_t* delay_us);
+
+  /**
+   * Determine the fault to inject for a request handled by a node at a given
+   * time since the scenario was started.
+   *
+   * @param address The node's address.
+   * @param elapsed_us The time since the scenario was started.
+   * @param delay_us The time to delay the response if responding.
+   * @return The effect of the active faults.
+   */
+  Effect inject(const Address& address, uint64_t elapsed_us, uint64_t* delay_us);
+
+private:
+  uv_mutex_t mutex_;
+  Vector<Fault> faults_;
+  uint64_t start_ns_;
+  MT19937_64 rng_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(Scenario);
+};
+
 typedef std::pair<String, ResultSet> Match;
 typedef Vector<Match> Matches;
 
@@ -586,6 +769,8 @@ struct Action {
 
     Builder& nop();
     Builder& wait(uint64_t timeout);
+    Builder& delay(const Latency::Ptr& latency);
+    Builder& faults(const Scenario::Ptr& scenario);
     Builder& close();
     Builder& error(int32_t code, const String& message);
     Builder& invalid_protocol();
@@ -696,6 +881,7 @@ public:
   int8_t version() const { return version_; }
   int16_t stream() const { return stream_; }
   int8_t opcode() const { return opcode_; }
+  const CustomPayload& custom_payload() const { return custom_payload_; }
 
   ClientConnection* client() const { return client_; }
 
@@ -703,8 +889,12 @@ public:
   void write(int16_t stream, int8_t opcode, const String& body);
   void error(int32_t code, const String& message);
   void wait(uint64_t timeout, const Action* action);
+  void delay(uint64_t timeout_us, const Action* action);
   void close();
 
+  // Stop a pending wait or delay without running the rest of its actions
+  void cancel();
+
   bool decode_startup(Options* options);
   bool decode_credentials(Credentials* creds);
   bool decode_auth_response(String* token);
@@ -718,9 +908,12 @@ public:
   Hosts hosts() const;
 
 private:
+  friend class ClientConnection;
+
   void on_timeout(Timer* timer);
+  void on_delay();
 
-  const char* start() { return body_.data(); }
+  const char* start() { return body_.data() + body_start_; }
   const char* end() { return body_.data() + body_.size(); }
 
 private:
@@ -729,9 +922,12 @@ private:
   const int16_t stream_;
   const int8_t opcode_;
   const String body_;
+  size_t body_start_;
+  CustomPayload custom_payload_;
   ClientConnection* const client_;
   Timer timer_;
   const Action* timer_action_;
+  const Action* delay_action_;
 };
 
 struct Nop : public Action {
@@ -747,6 +943,24 @@ struct Wait : public Action {
   const uint64_t timeout;
 };
 
+struct Delay : public Action {
+  Delay(const Latency::Ptr& latency)
+      : latency(latency) {}
+
+  virtual void on_run(Request* request) const { request->delay(latency->sample_us(), this); }
+
+  const Latency::Ptr latency;
+};
+
+struct Faults : public Action {
+  Faults(const Scenario::Ptr& scenario)
+      : scenario(scenario) {}
+
+  virtual void on_run(Request* request) const;
+
+  const Scenario::Ptr scenario;
+};
+
 struct Close : public Action {
   virtual void on_run(Request* request) const { request->close(); }
 };
@@ -1009,9 +1223,19 @@ public:
       , is_registered_for_events_(false) {}
 
   virtual void on_read(const char* data, size_t len);
+  virtual void on_close();
 
   const Cluster* cluster() const { return cluster_; }
 
+  // Track requests waiting on a timer so they're canceled if the connection closes
+  void add_pending(Request* request) { pending_.add_to_back(request); }
+  void remove_pending(Request* request) { pending_.remove(request); }
+
+  // Delayed requests share a single timer with microsecond precision. A timer
+  // per request would only have millisecond precision.
+  void add_delayed(Request* request, uint64_t timeout_us);
+  void remove_delayed(Request* request);
+
   int protocol_version() const { return protocol_version_; }
   void set_protocol_version(int protocol_version) { protocol_version_ = protocol_version; }
 
@@ -1023,6 +1247,17 @@ public:
   const String& keyspace() const { return keyspace_; }
   void set_keyspace(const String& keyspace) { keyspace_ = keyspace; }
 
+private:
+  struct Delayed {
+    uint64_t deadline_ns;
+    Request* request;
+  };
+
+  typedef Vector<Delayed> DelayedVec;
+
+  void start_delay_timer();
+  void on_delay(MicroTimer* timer);
+
 private:
   ProtocolHandler handler_;
   String keyspace_;
@@ -1030,6 +1265,9 @@ private:
   int protocol_version_;
   bool is_registered_for_events_;
   Options options_;
+  List<Request> pending_;
+  DelayedVec delayed_; // Ordered by deadline with the earliest last
+  MicroTimer delay_timer_;
 };
 
 class CloseConnection : public ClientConnection {
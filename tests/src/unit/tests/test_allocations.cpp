@@ -0,0 +1,197 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "unit.hpp"
+
+#include "allocation_counter.hpp"
+#include "response.hpp"
+#include "result_response.hpp"
+
+#define INSERT_QUERY "INSERT INTO ks.table (key, value) VALUES (?, ?)"
+#define INSERT_ID "insert"
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+/**
+ * Allocation budgets for common API calls. The budgets are the allocations
+ * counted on the calling thread with a little headroom for differences between
+ * platforms and standard libraries. Lower them when an allocation is removed
+ * so that regressions are caught.
+ */
+class AllocationsUnitTest : public Unit {
+public:
+  /**
+   * Prepares an insert statement with two text variables.
+   */
+  class PrepareInsert : public mockssandra::Action {
+  public:
+    void on_run(mockssandra::Request* request) const {
+      using namespace mockssandra;
+      String body;
+      encode_int32(RESULT_PREPARED, &body);
+      encode_string(INSERT_ID, &body);
+      // Variable metadata
+      encode_int32(RESULT_FLAG_GLOBAL_TABLESPEC, &body);
+      encode_int32(2, &body); // Column count
+      encode_int32(0, &body); // Primary key count
+      encode_string("ks", &body);
+      encode_string("table", &body);
+      Column("key", Type::text()).encode(request->version(), &body);
+      Column("value", Type::text()).encode(request->version(), &body);
+      // Result metadata
+      encode_int32(RESULT_FLAG_NO_METADATA, &body);
+      encode_int32(0, &body); // Column count
+      request->write(OPCODE_RESULT, body);
+    }
+  };
+
+  static const mockssandra::RequestHandler* prepared() {
+    mockssandra::SimpleRequestHandlerBuilder builder;
+    builder.on(mockssandra::OPCODE_PREPARE).execute(new PrepareInsert());
+    builder.on(mockssandra::OPCODE_EXECUTE).void_result();
+    return builder.build();
+  }
+
+  static String rows_frame(int row_count) {
+    mockssandra::ResultSet::Builder builder("ks", "table");
+    builder.column("key", mockssandra::Type::text()).column("value", mockssandra::Type::text());
+    for (int i = 0; i < row_count; ++i) {
+      OStringStream ss;
+      ss << "key" << i;
+      builder.row(mockssandra::Row::Builder().text(ss.str()).text("value").build());
+    }
+    String body(builder.build().encode(CASS_PROTOCOL_VERSION_V4));
+
+    String frame;
+    frame.push_back(static_cast<char>(0x80 | CASS_PROTOCOL_VERSION_V4)); // Response version
+    frame.push_back(0);                                                  // Flags
+    frame.push_back(0);                                                  // Stream
+    frame.push_back(1);
+    frame.push_back(static_cast<char>(mockssandra::OPCODE_RESULT));
+    mockssandra::encode_int32(body.size(), &frame);
+    frame.append(body);
+    return frame;
+  }
+
+  /**
+   * Bind and execute the prepared insert and wait for its result.
+   *
+   * @return The number of allocations counted for the second execution; the
+   * first execution warms up the driver.
+   */
+  uint64_t execute_prepared() {
+    mockssandra::SimpleCluster cluster(prepared());
+    EXPECT_EQ(cluster.start_all(), 0);
+
+    CassCluster* cass_cluster = cass_cluster_new();
+    cass_cluster_set_contact_points(cass_cluster, "127.0.0.1");
+    CassSession* session = cass_session_new();
+
+    CassFuture* connect_future = cass_session_connect(session, cass_cluster);
+    EXPECT_EQ(cass_future_error_code(connect_future), CASS_OK);
+    cass_future_free(connect_future);
+
+    CassFuture* prepare_future = cass_session_prepare(session, INSERT_QUERY);
+    EXPECT_EQ(cass_future_error_code(prepare_future), CASS_OK);
+    const CassPrepared* prepared = cass_future_get_prepared(prepare_future);
+    cass_future_free(prepare_future);
+
+    uint64_t allocations = 0;
+    for (int i = 0; prepared && i < 2; ++i) {
+      AllocationCounter counter;
+      CassStatement* statement = cass_prepared_bind(prepared);
+      cass_statement_bind_string(statement, 0, "key");
+      cass_statement_bind_string(statement, 1, "value");
+      CassFuture* future = cass_session_execute(session, statement);
+      cass_statement_free(statement);
+      EXPECT_EQ(cass_future_error_code(future), CASS_OK);
+      cass_future_free(future);
+      allocations = counter.allocations();
+      record(counter);
+    }
+
+    if (prepared) cass_prepared_free(prepared);
+    CassFuture* close_future = cass_session_close(session);
+    cass_future_wait(close_future);
+    cass_future_free(close_future);
+    cass_session_free(session);
+    cass_cluster_free(cass_cluster);
+    return allocations;
+  }
+
+  void record(const AllocationCounter& counter) {
+    RecordProperty("allocations", static_cast<int>(counter.allocations()));
+    RecordProperty("bytes", static_cast<int>(counter.bytes()));
+  }
+};
+
+
+/**
+ * Allocations made by the application's thread to bind and execute a prepared
+ * statement. Allocations made by the I/O thread aren't counted because the
+ * mock server's allocations would be counted too.
+ */
+TEST_F(AllocationsUnitTest, ExecutePrepared) { EXPECT_LE(execute_prepared(), 5u); }
+
+TEST_F(AllocationsUnitTest, ReadRows) {
+  const String frame(rows_frame(100));
+
+  AllocationCounter counter;
+  {
+    ResponseMessage message;
+    ASSERT_EQ(message.decode(frame.data(), frame.size()), static_cast<ssize_t>(frame.size()));
+    ResultResponse::Ptr response(message.response_body());
+    ASSERT_TRUE(response);
+
+    const CassResult* result = CassResult::to(response.get());
+    CassIterator* rows = cass_iterator_from_result(result);
+    size_t row_count = 0;
+    while (cass_iterator_next(rows)) {
+      const CassRow* row = cass_iterator_get_row(rows);
+      const char* key;
+      size_t key_length;
+      const char* value;
+      size_t value_length;
+      EXPECT_EQ(cass_value_get_string(cass_row_get_column(row, 0), &key, &key_length), CASS_OK);
+      EXPECT_EQ(cass_value_get_string(cass_row_get_column(row, 1), &value, &value_length),
+                CASS_OK);
+      row_count++;
+    }
+    cass_iterator_free(rows);
+    EXPECT_EQ(row_count, 100u);
+  }
+  record(counter);
+
+  EXPECT_LE(counter.allocations(), 8u);
+}
+
+TEST_F(AllocationsUnitTest, BuildBatch) {
+  AllocationCounter counter;
+  CassBatch* batch = cass_batch_new(CASS_BATCH_TYPE_UNLOGGED);
+  for (int i = 0; i < 10; ++i) {
+    CassStatement* statement = cass_statement_new(INSERT_QUERY, 2);
+    cass_statement_bind_string(statement, 0, "key");
+    cass_statement_bind_string(statement, 1, "value");
+    cass_batch_add_statement(batch, statement);
+    cass_statement_free(statement);
+  }
+  cass_batch_free(batch);
+  record(counter);
+
+  EXPECT_EQ(counter.allocations(), counter.frees());
+  EXPECT_LE(counter.allocations(), 40u);
+}
@@ -241,6 +241,35 @@ public:
     mockssandra::Cluster& simple_cluster_;
   };
 
+  class DebounceListener : public Listener {
+  public:
+    typedef SharedRefPtr<DebounceListener> Ptr;
+
+    DebounceListener(const Future::Ptr& close_future, mockssandra::Cluster& simple_cluster)
+        : Listener(close_future)
+        , token_map_update_count_(0)
+        , simple_cluster_(simple_cluster) {}
+
+    int token_map_update_count() const { return token_map_update_count_.load(); }
+
+    virtual void on_reconnect(Cluster* cluster) {
+      for (int i = 0; i < 10; ++i) {
+        OStringStream ss;
+        ss << "keyspace" << i;
+        simple_cluster_.event(mockssandra::SchemaChangeEvent::keyspace(
+            mockssandra::SchemaChangeEvent::UPDATED, ss.str()));
+      }
+    }
+
+    virtual void on_token_map_updated(const TokenMap::Ptr& token_map) {
+      token_map_update_count_.fetch_add(1);
+    }
+
+  private:
+    Atomic<int> token_map_update_count_;
+    mockssandra::Cluster& simple_cluster_;
+  };
+
   class ClusterUnitTestReconnectionPolicy : public ReconnectionPolicy {
   public:
     typedef SharedRefPtr<ClusterUnitTestReconnectionPolicy> Ptr;
@@ -321,6 +350,28 @@ public:
     String local_dc_;
   };
 
+  /**
+   * Fails the schema queries for a single keyspace with a server error.
+   */
+  class FailKeyspaceQuery : public mockssandra::Action {
+  public:
+    FailKeyspaceQuery(const String& keyspace_name)
+        : where_clause_("keyspace_name IN ('" + keyspace_name + "')") {}
+
+    void on_run(mockssandra::Request* request) const {
+      String query;
+      mockssandra::QueryParameters params;
+      if (request->decode_query(&query, &params) && query.find(where_clause_) != String::npos) {
+        request->error(mockssandra::ERROR_SERVER_ERROR, "Unable to read schema");
+      } else {
+        run_next(request);
+      }
+    }
+
+  private:
+    String where_clause_;
+  };
+
   static void on_connection_connected(ClusterConnector* connector, Future* future) {
     if (connector->is_ok()) {
       future->set();
@@ -952,6 +1003,42 @@ TEST_F(ClusterUnitTest, DisableEventsOnStartup) {
   ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME));
 }
 
+TEST_F(ClusterUnitTest, EventDebounce) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  AddressVec contact_points;
+  contact_points.push_back(Address("127.0.0.1", 9042));
+
+  Future::Ptr connect_future(new Future());
+  ClusterConnector::Ptr connector(
+      new ClusterConnector(contact_points, PROTOCOL_VERSION,
+                           bind_callback(on_connection_reconnect, connect_future.get())));
+
+  ClusterSettings settings;
+  settings.control_connection_settings.event_debounce_window_ms = 200;
+  settings.control_connection_settings.event_debounce_max_delay_ms = 1000;
+
+  Future::Ptr close_future(new Future());
+  DebounceListener::Ptr listener(new DebounceListener(close_future, cluster));
+
+  connector->with_listener(listener.get())->with_settings(settings)->connect(event_loop());
+
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+  ASSERT_FALSE(connect_future->error());
+
+  for (int i = 0; i < 200 && listener->token_map_update_count() == 0; ++i) {
+    test::Utils::msleep(10);
+  }
+  test::Utils::msleep(200); // Make sure there are no more updates
+
+  // The keyspace events are coalesced and the token map is rebuilt once
+  EXPECT_EQ(1, listener->token_map_update_count());
+
+  connect_future->cluster()->close();
+  ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME));
+}
+
 TEST_F(ClusterUnitTest, ReconnectionPolicy) {
   mockssandra::SimpleCluster mock_cluster(simple());
   ASSERT_EQ(mock_cluster.start_all(), 0);
@@ -1067,3 +1154,58 @@ TEST_F(ClusterUnitTest, HostIsResolvedAndPortIsAssignedDuringConnection) {
   ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
   EXPECT_FALSE(connect_future->error());
 }
+
+TEST_F(ClusterUnitTest, LazySchemaConcurrentLoads) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .execute(new FailKeyspaceQuery("broken"))
+      .system_local()
+      .system_peers()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  AddressVec contact_points;
+  contact_points.push_back(Address("127.0.0.1", 9042));
+
+  Future::Ptr connect_future(new Future());
+  ClusterConnector::Ptr connector(
+      new ClusterConnector(contact_points, PROTOCOL_VERSION,
+                           bind_callback(on_connection_reconnect, connect_future.get())));
+
+  ClusterSettings settings;
+  settings.control_connection_settings.use_schema = true;
+  settings.control_connection_settings.use_lazy_schema = true;
+  connector->with_settings(settings)->connect(event_loop());
+
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+  ASSERT_FALSE(connect_future->error());
+  const Cluster::Ptr& connected_cluster = connect_future->cluster();
+
+  // Concurrent loads of the same keyspace complete together
+  core::Future::Ptr load_futures[3];
+  for (int i = 0; i < 3; ++i) {
+    load_futures[i] = core::Future::Ptr(new core::Future(core::Future::FUTURE_TYPE_GENERIC));
+    connected_cluster->load_schema_keyspace("keyspace1", load_futures[i]);
+  }
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(load_futures[i]->wait_for(WAIT_FOR_TIME));
+    EXPECT_FALSE(load_futures[i]->error());
+  }
+
+  // A failed load fails all the waiting futures and isn't recorded as loaded
+  core::Future::Ptr failed_futures[2];
+  for (int i = 0; i < 2; ++i) {
+    failed_futures[i] = core::Future::Ptr(new core::Future(core::Future::FUTURE_TYPE_GENERIC));
+    connected_cluster->load_schema_keyspace("broken", failed_futures[i]);
+  }
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_TRUE(failed_futures[i]->wait_for(WAIT_FOR_TIME));
+    EXPECT_TRUE(failed_futures[i]->error());
+  }
+
+  core::Future::Ptr retry_future(new core::Future(core::Future::FUTURE_TYPE_GENERIC));
+  connected_cluster->load_schema_keyspace("broken", retry_future);
+  ASSERT_TRUE(retry_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_TRUE(retry_future->error());
+}
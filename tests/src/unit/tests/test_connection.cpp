@@ -135,6 +135,32 @@ TEST_F(ConnectionUnitTest, Simple) {
   EXPECT_EQ(state.status, STATUS_SUCCESS);
 }
 
+TEST_F(ConnectionUnitTest, Stats) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  State state;
+  Host::Ptr host(new Host(Address("127.0.0.1", PORT)));
+  Connector::Ptr connector(
+      new Connector(host, PROTOCOL_VERSION, bind_callback(on_connection_connected, &state)));
+
+  connector->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(state.status, STATUS_SUCCESS);
+  ASSERT_TRUE(static_cast<bool>(state.connection));
+
+  ConnectionStats stats(state.connection->stats());
+  EXPECT_EQ(Address("127.0.0.1", PORT), stats.address);
+  EXPECT_EQ(0u, stats.streams_in_use);
+  EXPECT_GE(stats.max_streams_in_use, 1u);
+  EXPECT_GT(stats.bytes_read, 0u);
+  EXPECT_GT(stats.bytes_written, 0u);
+  EXPECT_EQ(0u, stats.pending_writes);
+  EXPECT_EQ(0u, stats.write_queue_size);
+}
+
 TEST_F(ConnectionUnitTest, Keyspace) {
   mockssandra::SimpleRequestHandlerBuilder builder;
   builder.on(mockssandra::OPCODE_QUERY).use_keyspace("foo").validate_query().void_result();
@@ -25,6 +25,7 @@
 
 using namespace datastax::internal;
 using namespace datastax::internal::core;
+using datastax::StringVec;
 
 using mockssandra::SchemaChangeEvent;
 using mockssandra::StatusChangeEvent;
@@ -265,6 +266,100 @@ public:
     ControlConnection::Ptr connection_;
   };
 
+  /**
+   * Records every query received by the server before passing it along to the
+   * next action. The queries are only checked after the control connection is
+   * closed.
+   */
+  class RecordQuery : public mockssandra::Action {
+  public:
+    RecordQuery(StringVec* queries)
+        : queries_(queries) {}
+
+    void on_run(mockssandra::Request* request) const {
+      String query;
+      mockssandra::QueryParameters params;
+      if (request->decode_query(&query, &params)) {
+        queries_->push_back(query);
+      }
+      run_next(request);
+    }
+
+  private:
+    StringVec* queries_;
+  };
+
+  static const mockssandra::RequestHandler* recording_request_handler(StringVec* queries) {
+    mockssandra::SimpleRequestHandlerBuilder builder;
+    builder.on(mockssandra::OPCODE_QUERY)
+        .execute(new RecordQuery(queries))
+        .system_local()
+        .system_peers()
+        .empty_rows_result(1);
+    return builder.build();
+  }
+
+  static bool contains(const StringVec& queries, const String& query) {
+    return std::find(queries.begin(), queries.end(), query) != queries.end();
+  }
+
+  struct LazySchemaListener : public RecordingControlConnectionListener {
+    LazySchemaListener()
+        : load_count(0)
+        , load_error_code(CASS_OK) {}
+
+    virtual void on_load_keyspace_schema(const String& keyspace_name, CassError error_code,
+                                         const String& error_message) {
+      load_count++;
+      loaded_keyspace_name = keyspace_name;
+      load_error_code = error_code;
+      connection->close();
+    }
+
+    ControlConnection::Ptr connection;
+    int load_count;
+    String loaded_keyspace_name;
+    CassError load_error_code;
+  };
+
+  static void on_connection_load_keyspace(ControlConnector* connector,
+                                          LazySchemaListener* listener) {
+    if (!connector->is_ok()) return;
+    listener->connection = connector->release_connection();
+    listener->connection->load_keyspace_schema("keyspace1");
+  }
+
+  struct DebounceListener : public RecordingControlConnectionListener {
+    DebounceListener(mockssandra::SimpleCluster* cluster)
+        : cluster(cluster)
+        , batch_count(0) {}
+
+    virtual void on_refresh_batch_end() {
+      batch_count++;
+      connection->close();
+    }
+
+    mockssandra::SimpleCluster* cluster;
+    ControlConnection::Ptr connection;
+    int batch_count;
+  };
+
+  static void on_connection_debounce(ControlConnector* connector, DebounceListener* listener) {
+    if (!connector->is_ok()) return;
+    listener->connection = connector->release_connection();
+    mockssandra::SimpleCluster* cluster = listener->cluster;
+    cluster->event(SchemaChangeEvent::keyspace(SchemaChangeEvent::UPDATED, "keyspace1"));
+    cluster->event(SchemaChangeEvent::keyspace(SchemaChangeEvent::UPDATED, "keyspace2"));
+    cluster->event(SchemaChangeEvent::keyspace(SchemaChangeEvent::UPDATED, "keyspace1"));
+    cluster->event(SchemaChangeEvent::table(SchemaChangeEvent::UPDATED, "keyspace1", "table1"));
+    cluster->event(SchemaChangeEvent::table(SchemaChangeEvent::UPDATED, "keyspace1", "table2"));
+    cluster->event(SchemaChangeEvent::table(SchemaChangeEvent::UPDATED, "keyspace1", "table1"));
+    cluster->event(SchemaChangeEvent::user_type(SchemaChangeEvent::UPDATED, "keyspace1", "type1"));
+    cluster->event(SchemaChangeEvent::table(SchemaChangeEvent::UPDATED, "keyspace2", "table1"));
+    cluster->event(SchemaChangeEvent::table(SchemaChangeEvent::DROPPED, "keyspace2", "table1"));
+    cluster->event(SchemaChangeEvent::user_type(SchemaChangeEvent::UPDATED, "key'space", "ty'pe"));
+  }
+
   static void on_connection_event(ControlConnector* connector, EventListener* listener) {
     listener->trigger_events(connector->release_connection());
   }
@@ -537,6 +632,119 @@ TEST_F(ControlConnectionUnitTest, SchemaChangeEvents) {
   EXPECT_EQ("aggregate1(varchar)", event12.target_name);
 }
 
+TEST_F(ControlConnectionUnitTest, SchemaKeyspaceFilter) {
+  StringVec queries;
+  mockssandra::SimpleCluster cluster(recording_request_handler(&queries));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  ControlConnectionSettings settings;
+  settings.use_schema = true;
+  settings.schema_keyspaces.push_back("keyspace1");
+  settings.schema_keyspaces.push_back("it's");
+
+  bool is_connected = false;
+  ControlConnector::Ptr connector(
+      new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                           bind_callback(on_connection_connected, &is_connected)));
+  connector->with_settings(settings)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  ASSERT_TRUE(is_connected);
+  EXPECT_TRUE(contains(queries, SELECT_KEYSPACES_30));
+  EXPECT_TRUE(
+      contains(queries, SELECT_TABLES_30 " WHERE keyspace_name IN ('keyspace1','it''s')"));
+  EXPECT_TRUE(
+      contains(queries, SELECT_AGGREGATES_30 " WHERE keyspace_name IN ('keyspace1','it''s')"));
+  EXPECT_FALSE(contains(queries, SELECT_TABLES_30));
+}
+
+TEST_F(ControlConnectionUnitTest, LazySchema) {
+  StringVec queries;
+  mockssandra::SimpleCluster cluster(recording_request_handler(&queries));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  ControlConnectionSettings settings;
+  settings.use_schema = true;
+  settings.use_lazy_schema = true;
+
+  LazySchemaListener listener;
+  ControlConnector::Ptr connector(
+      new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                           bind_callback(on_connection_load_keyspace, &listener)));
+  connector->with_settings(settings)->with_listener(&listener)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(1, listener.load_count);
+  EXPECT_EQ("keyspace1", listener.loaded_keyspace_name);
+  EXPECT_EQ(CASS_OK, listener.load_error_code);
+
+  // Only the keyspaces are queried when connecting
+  EXPECT_TRUE(contains(queries, SELECT_KEYSPACES_30));
+  EXPECT_FALSE(contains(queries, SELECT_TABLES_30));
+
+  EXPECT_TRUE(contains(queries, SELECT_KEYSPACES_30 " WHERE keyspace_name IN ('keyspace1')"));
+  EXPECT_TRUE(contains(queries, SELECT_TABLES_30 " WHERE keyspace_name IN ('keyspace1')"));
+
+  const RecordedEvent& event = listener.find_event(RecordedEvent::TABLE_UPDATED);
+  EXPECT_EQ(RecordedEvent::TABLE_UPDATED, event.type);
+  EXPECT_EQ("keyspace1", event.keyspace_name);
+  EXPECT_TRUE(event.result);
+}
+
+TEST_F(ControlConnectionUnitTest, EventDebounce) {
+  StringVec queries;
+  mockssandra::SimpleCluster cluster(recording_request_handler(&queries));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  ControlConnectionSettings settings;
+  settings.event_debounce_window_ms = 200;
+  settings.event_debounce_max_delay_ms = 1000;
+
+  DebounceListener listener(&cluster);
+  ControlConnector::Ptr connector(
+      new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                           bind_callback(on_connection_debounce, &listener)));
+  connector->with_settings(settings)->with_listener(&listener)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(1, listener.batch_count);
+
+  // The keyspaces are refreshed using a single query
+  EXPECT_TRUE(contains(queries,
+                       SELECT_KEYSPACES_30 " WHERE keyspace_name IN ('keyspace1','keyspace2')"));
+
+  // Multiple tables in a keyspace refresh all the keyspace's tables
+  EXPECT_TRUE(contains(queries, SELECT_TABLES_30 " WHERE keyspace_name='keyspace1'"));
+  EXPECT_TRUE(contains(queries, SELECT_COLUMNS_30 " WHERE keyspace_name='keyspace1'"));
+
+  // A single type is refreshed by name
+  EXPECT_TRUE(contains(queries, SELECT_USERTYPES_30
+                       " WHERE keyspace_name='keyspace1' AND type_name='type1'"));
+
+  // Names are quoted
+  EXPECT_TRUE(contains(queries, SELECT_USERTYPES_30
+                       " WHERE keyspace_name='key''space' AND type_name='ty''pe'"));
+
+  // The dropped table doesn't need to be refreshed
+  EXPECT_FALSE(contains(queries, SELECT_TABLES_30
+                        " WHERE keyspace_name='keyspace2' AND table_name='table1'"));
+
+  size_t keyspace_updates = 0;
+  size_t table_updates = 0;
+  for (RecordedEventVec::const_iterator it = listener.events().begin(),
+                                        end = listener.events().end();
+       it != end; ++it) {
+    if (it->type == RecordedEvent::KEYSPACE_UPDATED) keyspace_updates++;
+    if (it->type == RecordedEvent::TABLE_UPDATED) table_updates++;
+  }
+  EXPECT_EQ(1u, keyspace_updates);
+  EXPECT_EQ(1u, table_updates);
+  EXPECT_EQ(RecordedEvent::TABLE_DROPPED, listener.find_event(RecordedEvent::TABLE_DROPPED).type);
+}
+
 TEST_F(ControlConnectionUnitTest, EventDuringStartup) {
   Address address("127.0.0.1", PORT);
 
@@ -114,13 +114,30 @@ TEST(FutureUnitTest, CallbackAlreadyAssigned) {
 
 TEST(FutureUnitTest, CallbackAfterFutureIsSet) {
   bool is_future_callback_called = false;
-  Future future(Future::FUTURE_TYPE_GENERIC);
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
 
   ASSERT_FALSE(is_future_callback_called);
-  future.set();
-  ASSERT_TRUE(future.ready());
+  future->set();
+  ASSERT_TRUE(future->ready());
   ASSERT_FALSE(is_future_callback_called);
 
-  ASSERT_TRUE(future.set_callback(&on_future_callback, &is_future_callback_called));
+  ASSERT_TRUE(future->set_callback(&on_future_callback, &is_future_callback_called));
+  ASSERT_TRUE(is_future_callback_called);
+}
+
+void on_future_callback_free(CassFuture* future, void* data) {
+  bool* is_future_callback_called = static_cast<bool*>(data);
+  *is_future_callback_called = true;
+  cass_future_free(future);
+}
+
+TEST(FutureUnitTest, CallbackAfterFutureIsSetFreesFuture) {
+  bool is_future_callback_called = false;
+  Future* future = new Future(Future::FUTURE_TYPE_GENERIC);
+  future->inc_ref(); // The application's reference
+  future->set();
+
+  // The callback releases the last reference while it's running
+  ASSERT_TRUE(future->set_callback(&on_future_callback_free, &is_future_callback_called));
   ASSERT_TRUE(is_future_callback_called);
 }
@@ -16,13 +16,17 @@
 
 #include "unit.hpp"
 
+#include "query_request.hpp"
 #include "session.hpp"
 
 using datastax::String;
+using datastax::internal::Logger;
 using datastax::internal::get_time_monotonic_ns;
 using datastax::internal::core::Address;
 using datastax::internal::core::Config;
 using datastax::internal::core::Future;
+using datastax::internal::core::QueryRequest;
+using datastax::internal::core::Request;
 using datastax::internal::core::Session;
 using datastax::internal::core::StringMultimap;
 using mockssandra::Options;
@@ -42,6 +46,8 @@ public:
     return session_.connect(temp);
   }
 
+  Future::Ptr execute(const Request::ConstPtr& request) { return session_.execute(request); }
+
   bool wait_for_logger(int expected_count) {
     // Wait for about 60 seconds
     for (int i = 0; i < 600 && logging_criteria_count() < expected_count; ++i) {
@@ -116,3 +122,90 @@ TEST_F(LoggingUnitTest, ConnectionPoolSeverityReduced) {
       CASS_LOG_WARN);
   EXPECT_TRUE(wait_for_logger(1));
 }
+
+/**
+ * Verify that queued log messages are passed to the callback by the logging thread and that
+ * messages that don't fit in the queue are dropped and counted.
+ */
+TEST_F(LoggingUnitTest, AsyncQueue) {
+  add_logging_critera("Queued log message", CASS_LOG_ERROR);
+
+  Logger::set_queue_size(16);
+  for (int i = 0; i < 100; ++i) {
+    LOG_ERROR("Queued log message %d", i);
+  }
+  uint64_t dropped_count = Logger::dropped_count();
+  Logger::cleanup(); // Flush the queue
+
+  EXPECT_GT(logging_criteria_count(), 0);
+  EXPECT_EQ(100, logging_criteria_count() + static_cast<int>(dropped_count));
+  EXPECT_EQ(0u, Logger::dropped_count());
+}
+
+/**
+ * Verify that the number of messages logged by a log statement is limited and that the number of
+ * suppressed messages is logged once the limit resets.
+ */
+TEST_F(LoggingUnitTest, RateLimit) {
+  add_logging_critera("Rate limited log message", CASS_LOG_ERROR);
+  add_logging_critera("Suppressed 95 message(s) from this log statement", CASS_LOG_ERROR);
+
+  Logger::set_rate_limit(5);
+  Logger::RateLimiter rate_limiter;
+  uint64_t now = get_time_monotonic_ns();
+  for (int i = 0; i < 101; ++i) {
+    if (i == 100) {
+      now += 1100000000ULL; // The limit resets after a second
+    }
+    if (rate_limiter.allow_at(now, CASS_LOG_ERROR, __FILE__, __LINE__, __FUNCTION__)) {
+      Logger::log(CASS_LOG_ERROR, __FILE__, __LINE__, __FUNCTION__, "Rate limited log message %d",
+                  i);
+    }
+  }
+  Logger::set_rate_limit(0);
+
+  EXPECT_EQ(7, logging_criteria_count()); // 5 + 1 after the reset + 1 suppressed message
+}
+
+/**
+ * Verify that each log statement is rate limited separately.
+ */
+TEST_F(LoggingUnitTest, RateLimitPerStatement) {
+  add_logging_critera("First rate limited statement", CASS_LOG_ERROR);
+  add_logging_critera("Second rate limited statement", CASS_LOG_ERROR);
+
+  Logger::set_rate_limit(5);
+  for (int i = 0; i < 100; ++i) {
+    LOG_ERROR("First rate limited statement %d", i);
+    LOG_ERROR("Second rate limited statement %d", i);
+  }
+  Logger::set_rate_limit(0);
+
+  EXPECT_EQ(10, logging_criteria_count());
+}
+
+/**
+ * Verify that the trace messages of sampled requests are logged when the log level is lower than
+ * CASS_LOG_TRACE.
+ */
+TEST_F(LoggingUnitTest, SampledRequestTrace) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Future::Ptr connect_future = connect_async();
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+
+  Logger::set_log_level(CASS_LOG_WARN);
+  add_logging_critera("[Request ", CASS_LOG_TRACE);
+
+  Future::Ptr future = execute(Request::ConstPtr(new QueryRequest("blah", 0)));
+  EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME));
+  EXPECT_EQ(0, logging_criteria_count()); // Sampling is disabled
+
+  Logger::set_trace_sample_rate(1); // Sample every request
+  future = execute(Request::ConstPtr(new QueryRequest("blah", 0)));
+  EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME));
+  Logger::set_trace_sample_rate(0);
+
+  EXPECT_GT(logging_criteria_count(), 0);
+}
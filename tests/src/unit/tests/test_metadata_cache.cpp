@@ -0,0 +1,334 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "loop_test.hpp"
+
+#include "control_connector.hpp"
+#include "metadata_cache.hpp"
+#include "prepared.hpp"
+#include "session.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+using datastax::StringVec;
+using datastax::internal::OStringStream;
+using datastax::internal::core::Config;
+using datastax::internal::core::ControlConnectionSchema;
+using datastax::internal::core::ControlConnectionSettings;
+using datastax::internal::core::ControlConnector;
+using datastax::internal::core::Future;
+using datastax::internal::core::Host;
+using datastax::internal::core::MetadataCache;
+using datastax::internal::core::ResponseFuture;
+using datastax::internal::core::ResultResponse;
+using datastax::internal::core::Session;
+using datastax::internal::core::VersionNumber;
+using datastax::internal::core::schema_metadata_scope;
+
+#define CACHE_FILE "metadata_cache_unit_test.bin"
+#define PREPARED_QUERY "SELECT * FROM cached"
+
+class MetadataCacheUnitTest : public LoopTest {
+public:
+  virtual void SetUp() {
+    LoopTest::SetUp();
+    remove(CACHE_FILE);
+  }
+
+  virtual void TearDown() {
+    LoopTest::TearDown();
+    remove(CACHE_FILE);
+  }
+
+  static ResultResponse::Ptr rows_result(int row_count) {
+    mockssandra::ResultSet::Builder builder("system_schema", "keyspaces");
+    builder.column("keyspace_name", mockssandra::Type::text());
+    for (int i = 0; i < row_count; ++i) {
+      OStringStream ss;
+      ss << "keyspace" << i;
+      builder.row(mockssandra::Row::Builder().text(ss.str()).build());
+    }
+    String body(builder.build().encode(PROTOCOL_VERSION));
+
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(body.size());
+    memcpy(result->data(), body.data(), body.size());
+    EXPECT_TRUE(result->decode_body(PROTOCOL_VERSION, 0));
+    return result;
+  }
+
+  static ResultResponse::Ptr prepared_result() {
+    String body;
+    mockssandra::encode_int32(mockssandra::RESULT_PREPARED, &body);
+    mockssandra::encode_string(PREPARED_QUERY, &body); // Prepared ID
+    mockssandra::encode_int32(0, &body);               // Flags
+    mockssandra::encode_int32(0, &body);               // Column count
+    mockssandra::encode_int32(0, &body);               // Primary key count
+    mockssandra::encode_int32(0, &body);               // Result metadata flags
+    mockssandra::encode_int32(0, &body);               // Result metadata column count
+
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(body.size());
+    memcpy(result->data(), body.data(), body.size());
+    EXPECT_TRUE(result->decode_body(PROTOCOL_VERSION, 0));
+    return result;
+  }
+
+  /**
+   * Action that records the queries it receives.
+   */
+  class RecordQuery : public mockssandra::Action {
+  public:
+    RecordQuery(StringVec* queries)
+        : queries_(queries) {}
+
+    void on_run(mockssandra::Request* request) const {
+      String query;
+      mockssandra::QueryParameters params;
+      if (request->decode_query(&query, &params)) {
+        queries_->push_back(query);
+      }
+      run_next(request);
+    }
+
+  private:
+    StringVec* queries_;
+  };
+
+  /**
+   * Action that prepares any query. The prepared ID is the query.
+   */
+  class PrepareQuery : public mockssandra::Action {
+  public:
+    PrepareQuery(Atomic<int>* prepare_count)
+        : prepare_count_(prepare_count) {}
+
+    void on_run(mockssandra::Request* request) const {
+      String query;
+      mockssandra::PrepareParameters params;
+      if (!request->decode_prepare(&query, &params)) {
+        request->error(mockssandra::ERROR_PROTOCOL_ERROR, "Invalid prepare message");
+      } else {
+        prepare_count_->fetch_add(1);
+        String body;
+        mockssandra::encode_int32(mockssandra::RESULT_PREPARED, &body);
+        mockssandra::encode_string(query, &body); // Prepared ID
+        mockssandra::encode_int32(0, &body);      // Flags
+        mockssandra::encode_int32(0, &body);      // Column count
+        mockssandra::encode_int32(0, &body);      // Primary key count
+        mockssandra::encode_int32(0, &body);      // Result metadata flags
+        mockssandra::encode_int32(0, &body);      // Result metadata column count
+        request->write(mockssandra::OPCODE_RESULT, body);
+      }
+    }
+
+  private:
+    Atomic<int>* const prepare_count_;
+  };
+
+  static const mockssandra::RequestHandler* recording_request_handler(StringVec* queries) {
+    mockssandra::SimpleRequestHandlerBuilder builder;
+    builder.on(mockssandra::OPCODE_QUERY)
+        .execute(new RecordQuery(queries))
+        .system_local()
+        .system_peers()
+        .empty_rows_result(1);
+    return builder.build();
+  }
+
+  struct ConnectResult {
+    ControlConnectionSchema schema;
+    VersionNumber server_version;
+  };
+
+  static void on_connection_connected(ControlConnector* connector, ConnectResult* result) {
+    ASSERT_TRUE(connector->is_ok());
+    result->schema = connector->schema();
+    result->server_version = connector->server_version();
+  }
+
+  static void connect(Session* session) {
+    Config config;
+    config.contact_points().push_back(Address("127.0.0.1", 9042));
+    config.set_metadata_cache_file(CACHE_FILE);
+    Future::Ptr connect_future(session->connect(config));
+    ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME))
+        << "Timed out waiting for session to connect";
+    ASSERT_FALSE(connect_future->error()) << cass_error_desc(connect_future->error()->code) << ": "
+                                          << connect_future->error()->message;
+  }
+
+  static void close(Session* session) {
+    Future::Ptr close_future(session->close());
+    ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting for session to close";
+  }
+
+  static String prepare(Session* session) {
+    Future::Ptr future(session->prepare(PREPARED_QUERY, strlen(PREPARED_QUERY)));
+    EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to prepare query";
+    if (future->error()) {
+      ADD_FAILURE() << cass_error_desc(future->error()->code) << ": " << future->error()->message;
+      return String();
+    }
+    ResultResponse::Ptr result(static_cast<ResponseFuture*>(future.get())->response());
+    return result->prepared_id().to_string();
+  }
+};
+
+TEST_F(MetadataCacheUnitTest, SaveAndLoad) {
+  ControlConnectionSchema schema;
+  schema.keyspaces = rows_result(3);
+  schema.tables = rows_result(2);
+
+  VersionNumber server_version(3, 11, 4);
+  {
+    MetadataCache::Ptr cache(new MetadataCache(CACHE_FILE));
+    EXPECT_FALSE(cache->load()); // Missing file
+    cache->set_schema(PROTOCOL_VERSION, server_version, VersionNumber(), "all", schema);
+    ASSERT_TRUE(cache->save());
+  }
+
+  MetadataCache::Ptr cache(new MetadataCache(CACHE_FILE));
+  ASSERT_TRUE(cache->load());
+
+  ControlConnectionSchema cached;
+  ASSERT_TRUE(cache->schema(PROTOCOL_VERSION, server_version, VersionNumber(), "all", &cached));
+  EXPECT_TRUE(cached.is_cached);
+  ASSERT_TRUE(cached.keyspaces);
+  EXPECT_EQ(3, cached.keyspaces->row_count());
+  ASSERT_TRUE(cached.tables);
+  EXPECT_EQ(2, cached.tables->row_count());
+  EXPECT_FALSE(cached.views);
+
+  // The cluster or settings don't match
+  EXPECT_FALSE(cache->schema(CASS_PROTOCOL_VERSION_V3, server_version, VersionNumber(), "all",
+                             &cached));
+  EXPECT_FALSE(
+      cache->schema(PROTOCOL_VERSION, VersionNumber(4, 0, 0), VersionNumber(), "all", &cached));
+  EXPECT_FALSE(cache->schema(PROTOCOL_VERSION, server_version, VersionNumber(), "none", &cached));
+}
+
+TEST_F(MetadataCacheUnitTest, InvalidFile) {
+  FILE* file = fopen(CACHE_FILE, "wb");
+  ASSERT_TRUE(file != NULL);
+  const char contents[] = "CASSMETA invalid";
+  fwrite(contents, 1, sizeof(contents), file);
+  fclose(file);
+
+  MetadataCache::Ptr cache(new MetadataCache(CACHE_FILE));
+  EXPECT_FALSE(cache->load());
+
+  ControlConnectionSchema schema;
+  EXPECT_FALSE(cache->schema(PROTOCOL_VERSION, VersionNumber(3, 11, 4), VersionNumber(), "all",
+                             &schema));
+}
+
+TEST_F(MetadataCacheUnitTest, CachedSchema) {
+  StringVec queries;
+  mockssandra::SimpleCluster cluster(recording_request_handler(&queries));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  ControlConnectionSettings settings;
+  MetadataCache::Ptr cache(new MetadataCache(CACHE_FILE));
+
+  { // Populate the cache from the cluster
+    ConnectResult result;
+    ControlConnector::Ptr connector(
+        new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                             bind_callback(on_connection_connected, &result)));
+    connector->with_settings(settings)->connect(loop());
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    ASSERT_TRUE(result.schema.keyspaces);
+    EXPECT_FALSE(result.schema.is_cached);
+    cache->set_schema(PROTOCOL_VERSION, result.server_version, VersionNumber(),
+                      schema_metadata_scope(settings), result.schema);
+  }
+
+  queries.clear();
+  settings.metadata_cache = cache;
+
+  ConnectResult result;
+  ControlConnector::Ptr connector(
+      new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                           bind_callback(on_connection_connected, &result)));
+  connector->with_settings(settings)->connect(loop());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_TRUE(result.schema.is_cached);
+  EXPECT_TRUE(result.schema.keyspaces);
+  for (StringVec::const_iterator it = queries.begin(), end = queries.end(); it != end; ++it) {
+    EXPECT_EQ(String::npos, it->find("system_schema")) << "Unexpected schema query: " << *it;
+  }
+}
+
+TEST_F(MetadataCacheUnitTest, CachedPrepared) {
+  Atomic<int> prepare_count(0);
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_PREPARE).execute(new PrepareQuery(&prepare_count));
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  {
+    Session session;
+    connect(&session);
+    EXPECT_EQ(PREPARED_QUERY, prepare(&session));
+    EXPECT_EQ(1, prepare_count.load());
+    close(&session);
+  }
+
+  MetadataCache::Ptr cache(new MetadataCache(CACHE_FILE));
+  ASSERT_TRUE(cache->load());
+  EXPECT_EQ(1u, cache->prepared_count());
+
+  {
+    Session session;
+    connect(&session);
+
+    // The cached statement is prepared again in the background before it's used
+    for (int i = 0; i < 100 && !session.metadata_cache()->prepared("", PREPARED_QUERY); ++i) {
+      test::Utils::msleep(10);
+    }
+    EXPECT_EQ(2, prepare_count.load());
+
+    EXPECT_EQ(PREPARED_QUERY, prepare(&session)); // Returned from the cache
+    EXPECT_EQ(2, prepare_count.load());
+    close(&session);
+  }
+}
+
+TEST_F(MetadataCacheUnitTest, InvalidatePrepared) {
+  MetadataCache::Ptr cache(new MetadataCache(CACHE_FILE));
+  cache->validate_prepared(PROTOCOL_VERSION);
+
+  ResponseFuture::Ptr future(new ResponseFuture());
+  cache->add_prepared("", PREPARED_QUERY, future);
+  EXPECT_FALSE(cache->prepared("", PREPARED_QUERY)); // Not finished
+
+  future->set_response(Address("127.0.0.1", 9042), prepared_result());
+  EXPECT_TRUE(cache->prepared("", PREPARED_QUERY));
+
+  StringVec queries;
+  cache->unvalidated_prepared("", &queries);
+  EXPECT_TRUE(queries.empty());
+
+  cache->invalidate_prepared();
+  EXPECT_FALSE(cache->prepared("", PREPARED_QUERY));
+  cache->unvalidated_prepared("", &queries);
+  ASSERT_EQ(1u, queries.size());
+  EXPECT_EQ(PREPARED_QUERY, queries[0]);
+}
@@ -16,15 +16,24 @@
 
 #include <gtest/gtest.h>
 
+#include "driver_config.hpp"
 #include "metrics.hpp"
+#include "scoped_ptr.hpp"
 
 #include "test_utils.hpp"
 
 #include <uv.h>
 
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
 #define NUM_THREADS 2
 #define NUM_ITERATIONS 100
 
+using datastax::String;
+using datastax::internal::ScopedPtr;
+using datastax::internal::core::HistogramSnapshot;
 using datastax::internal::core::Metrics;
 
 struct CounterThreadArgs {
@@ -144,6 +153,127 @@ TEST(MetricsUnitTest, HistogramEmpty) {
   EXPECT_EQ(snapshot.percentile_999th, 0);
 }
 
+TEST(MetricsUnitTest, HistogramInterval) {
+  Metrics::ThreadState thread_state(1);
+  Metrics::Histogram histogram(&thread_state);
+
+  for (uint64_t i = 1; i <= 100; ++i) {
+    histogram.record_value(i);
+  }
+
+  Metrics::Histogram::Snapshot snapshot;
+  histogram.get_interval_snapshot(&snapshot);
+  EXPECT_EQ(snapshot.min, 1);
+  EXPECT_EQ(snapshot.max, 100);
+
+  for (uint64_t i = 1000; i <= 2000; ++i) {
+    histogram.record_value(i);
+  }
+
+  // Only the values recorded since the previous interval
+  histogram.get_interval_snapshot(&snapshot);
+  EXPECT_EQ(snapshot.min, 1000);
+  EXPECT_EQ(snapshot.max, 2000);
+
+  // The cumulative histogram still has all the values
+  histogram.get_snapshot(&snapshot);
+  EXPECT_EQ(snapshot.min, 1);
+  EXPECT_EQ(snapshot.max, 2000);
+
+  ScopedPtr<HistogramSnapshot> copy(histogram.copy(true));
+  EXPECT_EQ(copy->total_count(), 0);
+  EXPECT_EQ(copy->value_at_percentile(99.0), 0);
+
+  histogram.record_value(42);
+  copy.reset(histogram.copy(true));
+  EXPECT_EQ(copy->total_count(), 1);
+  EXPECT_EQ(copy->min(), 42);
+  EXPECT_EQ(copy->max(), 42);
+
+  copy.reset(histogram.copy(false));
+  EXPECT_EQ(copy->total_count(), 1102);
+  EXPECT_EQ(copy->min(), 1);
+  EXPECT_EQ(copy->max(), 2000);
+}
+
+TEST(MetricsUnitTest, HistogramIntervalCopyFirst) {
+  Metrics::ThreadState thread_state(1);
+  Metrics::Histogram histogram(&thread_state);
+
+  histogram.record_value(1);
+  histogram.record_value(2);
+
+  // The first interval starts when the histogram is created
+  ScopedPtr<HistogramSnapshot> copy(histogram.copy(true));
+  EXPECT_EQ(copy->total_count(), 2);
+  EXPECT_EQ(copy->min(), 1);
+  EXPECT_EQ(copy->max(), 2);
+
+  histogram.record_value(3);
+  copy.reset(histogram.copy(true));
+  EXPECT_EQ(copy->total_count(), 1);
+  EXPECT_EQ(copy->min(), 3);
+}
+
+#ifdef HAVE_ZLIB
+static String decode_base64(const String& input) {
+  static const String alphabet("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+  String output;
+  uint32_t bits = 0;
+  int num_bits = 0;
+  for (size_t i = 0; i < input.size() && input[i] != '='; ++i) {
+    bits = (bits << 6) | static_cast<uint32_t>(alphabet.find(input[i]));
+    num_bits += 6;
+    if (num_bits >= 8) {
+      num_bits -= 8;
+      output.push_back(static_cast<char>((bits >> num_bits) & 0xFF));
+    }
+  }
+  return output;
+}
+
+static int32_t decode_int32(const String& input, size_t offset) {
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(input.data()) + offset;
+  return (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+}
+
+TEST(MetricsUnitTest, HistogramSnapshotEncode) {
+  Metrics::ThreadState thread_state(1);
+  Metrics::Histogram histogram(&thread_state);
+
+  histogram.record_value(1);
+  histogram.record_value(1);
+  histogram.record_value(3);
+
+  ScopedPtr<HistogramSnapshot> snapshot(histogram.copy(false));
+  const String compressed(decode_base64(snapshot->encoded()));
+  ASSERT_GT(compressed.size(), 8u);
+  EXPECT_EQ(0x1c849314, decode_int32(compressed, 0));
+  EXPECT_EQ(compressed.size() - 8, static_cast<size_t>(decode_int32(compressed, 4)));
+
+  String encoded(1024, '\0');
+  uLongf encoded_length = encoded.size();
+  ASSERT_EQ(Z_OK, uncompress(reinterpret_cast<Bytef*>(&encoded[0]), &encoded_length,
+                             reinterpret_cast<const Bytef*>(compressed.data() + 8),
+                             compressed.size() - 8));
+  encoded.resize(encoded_length);
+
+  // Header: cookie, payload length, normalizing offset, significant figures,
+  // lowest value, highest value and conversion ratio.
+  ASSERT_EQ(40u + 4u, encoded.size());
+  EXPECT_EQ(0x1c849313, decode_int32(encoded, 0));
+  EXPECT_EQ(4, decode_int32(encoded, 4));
+  EXPECT_EQ(3, decode_int32(encoded, 12));
+
+  // Zig-zag encoded counts for the values 0 to 3: a single zero count isn't
+  // run-length encoded.
+  EXPECT_EQ(0, encoded[40]);
+  EXPECT_EQ(4, encoded[41]); // Two 1s
+  EXPECT_EQ(0, encoded[42]);
+  EXPECT_EQ(2, encoded[43]); // One 3
+}
+#endif
+
 TEST(MetricsUnitTest, HistogramWithThreads) {
   HistogramThreadArgs args[NUM_THREADS];
 
@@ -174,6 +304,34 @@ TEST(MetricsUnitTest, HistogramWithThreads) {
   EXPECT_EQ(snapshot.mean, snapshot.median);
 }
 
+TEST(MetricsUnitTest, EventLoopGauges) {
+  Metrics::ThreadState thread_state(2);
+  Metrics::EventLoopGauges gauges(&thread_state);
+
+  Metrics::EventLoopGauges::Stats stats;
+  EXPECT_FALSE(gauges.get(0, &stats));
+
+  stats.utilization = 0.25;
+  stats.lag_us = 100;
+  stats.callback_time_us = 10;
+  gauges.set(stats);
+
+  // Only the loops that reported their stats are visible
+  Metrics::EventLoopGauges::Stats result;
+  ASSERT_TRUE(gauges.get(0, &result));
+  EXPECT_EQ(0.25, result.utilization);
+  EXPECT_EQ(100u, result.lag_us);
+  EXPECT_EQ(10u, result.callback_time_us);
+  EXPECT_FALSE(gauges.get(1, &result));
+
+  // The stats are replaced by the next update from the same thread
+  stats.utilization = 0.5;
+  gauges.set(stats);
+  ASSERT_TRUE(gauges.get(0, &result));
+  EXPECT_EQ(0.5, result.utilization);
+  EXPECT_FALSE(gauges.get(1, &result));
+}
+
 TEST(MetricsUnitTest, Meter) {
   Metrics::ThreadState thread_state(1);
   Metrics::Meter meter(&thread_state);
@@ -0,0 +1,183 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "loop_test.hpp"
+
+#include "http_client.hpp"
+#include "metrics_exporter.hpp"
+
+#define METRICS_EXPORTER_PORT 9464
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class MetricsExporterUnitTest : public LoopTest {
+public:
+  struct Response {
+    Response()
+        : is_done(false)
+        , status_code(0) {}
+    bool is_done;
+    unsigned status_code;
+    String content_type;
+    String body;
+  };
+
+  Response scrape(const String& path) {
+    Response response;
+    HttpClient::Ptr client(new HttpClient(Address("127.0.0.1", METRICS_EXPORTER_PORT), path,
+                                          bind_callback(on_response, &response)));
+    client->request(loop());
+    run_loop();
+    EXPECT_TRUE(response.is_done);
+    return response;
+  }
+
+  static bool contains(const String& body, const String& line) {
+    return body.find(line + "\n") != String::npos;
+  }
+
+private:
+  static void on_response(HttpClient* client, Response* response) {
+    response->is_done = true;
+    response->status_code = client->status_code();
+    response->content_type = client->content_type();
+    response->body = client->response_body();
+  }
+};
+
+TEST_F(MetricsExporterUnitTest, Scrape) {
+  Metrics metrics(1, true);
+  metrics.record_request(3000);     // 3 us
+  metrics.record_request(1500000);  // 1.5 ms
+  metrics.record_request(40000000); // 40 ms
+  metrics.total_connections.inc();
+  metrics.request_timeouts.inc();
+  metrics.record_event_loop(5000000, 0.5, 2000000); // 5 ms lag, 2 ms of callbacks
+
+  MetricsExporter exporter(&metrics, Cluster::Ptr());
+  ASSERT_EQ(0, exporter.start(METRICS_EXPORTER_PORT));
+
+  Response response(scrape("/metrics"));
+  EXPECT_EQ(200u, response.status_code);
+  EXPECT_EQ(CASS_METRICS_EXPORTER_CONTENT_TYPE, response.content_type);
+
+  const String& body = response.body;
+  EXPECT_TRUE(contains(body, "# TYPE cassandra_request_latency_seconds histogram"));
+  EXPECT_TRUE(contains(body, "# UNIT cassandra_request_latency_seconds seconds"));
+  EXPECT_TRUE(contains(body, "cassandra_request_latency_seconds_bucket{le=\"0.000002\"} 0"));
+  EXPECT_TRUE(contains(body, "cassandra_request_latency_seconds_bucket{le=\"0.000004\"} 1"));
+  EXPECT_TRUE(contains(body, "cassandra_request_latency_seconds_bucket{le=\"0.002048\"} 2"));
+  EXPECT_TRUE(contains(body, "cassandra_request_latency_seconds_bucket{le=\"0.065536\"} 3"));
+  EXPECT_TRUE(contains(body, "cassandra_request_latency_seconds_bucket{le=\"+Inf\"} 3"));
+  EXPECT_TRUE(contains(body, "cassandra_request_latency_seconds_count 3"));
+  EXPECT_TRUE(
+      contains(body, "cassandra_request_stage_latency_seconds_count{stage=\"network\"} 0"));
+  EXPECT_TRUE(contains(body, "cassandra_requests_total 3"));
+  EXPECT_TRUE(contains(body, "cassandra_connections 1"));
+  EXPECT_TRUE(contains(body, "cassandra_request_timeouts_total 1"));
+  EXPECT_TRUE(contains(body, "cassandra_event_loop_lag_seconds_count 1"));
+  EXPECT_TRUE(contains(body, "cassandra_event_loop_utilization{loop=\"0\"} 0.5"));
+  EXPECT_TRUE(contains(body, "cassandra_event_loop_callback_seconds{loop=\"0\"} 0.002"));
+  EXPECT_EQ(body.size() - 6, body.rfind("# EOF\n"));
+
+  // Histograms are cumulative between scrapes
+  metrics.record_request(3000);
+  EXPECT_TRUE(contains(scrape("/metrics").body, "cassandra_request_latency_seconds_count 4"));
+
+  exporter.stop();
+}
+
+TEST_F(MetricsExporterUnitTest, ScrapeWithoutRequestStages) {
+  Metrics metrics(1);
+  MetricsExporter exporter(&metrics, Cluster::Ptr());
+  ASSERT_EQ(0, exporter.start(METRICS_EXPORTER_PORT));
+
+  const String body(scrape("/metrics").body);
+  EXPECT_TRUE(contains(body, "cassandra_request_latency_seconds_count 0"));
+  EXPECT_EQ(String::npos, body.find("cassandra_request_stage_latency_seconds"));
+
+  exporter.stop();
+}
+
+TEST_F(MetricsExporterUnitTest, NotFound) {
+  Metrics metrics(1);
+  MetricsExporter exporter(&metrics, Cluster::Ptr());
+  ASSERT_EQ(0, exporter.start(METRICS_EXPORTER_PORT));
+
+  EXPECT_EQ(404u, scrape("/").status_code);
+  EXPECT_EQ(200u, scrape("/metrics?name[]=cassandra_requests").status_code);
+}
+
+TEST_F(MetricsExporterUnitTest, PortInUse) {
+  Metrics metrics(1);
+  MetricsExporter exporter1(&metrics, Cluster::Ptr());
+  ASSERT_EQ(0, exporter1.start(METRICS_EXPORTER_PORT));
+
+  MetricsExporter exporter2(&metrics, Cluster::Ptr());
+  EXPECT_EQ(UV_EADDRINUSE, exporter2.start(METRICS_EXPORTER_PORT));
+}
+
+TEST_F(MetricsExporterUnitTest, Session) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  CassCluster* cass_cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cass_cluster, "127.0.0.1");
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_cluster_set_metrics_exporter_port(cass_cluster, 65536));
+  EXPECT_EQ(CASS_OK, cass_cluster_set_metrics_exporter_port(cass_cluster, METRICS_EXPORTER_PORT));
+  CassSession* session = cass_session_new();
+
+  CassFuture* connect_future = cass_session_connect(session, cass_cluster);
+  EXPECT_EQ(CASS_OK, cass_future_error_code(connect_future));
+  cass_future_free(connect_future);
+
+  CassStatement* statement = cass_statement_new("SELECT * FROM table", 0);
+  CassFuture* future = cass_session_execute(session, statement);
+  EXPECT_EQ(CASS_OK, cass_future_error_code(future));
+  cass_future_free(future);
+  cass_statement_free(statement);
+
+  const String body(scrape("/metrics").body);
+  EXPECT_TRUE(contains(body, "cassandra_connections 1"));
+  EXPECT_TRUE(contains(body, "cassandra_host_pool_up{host=\"127.0.0.1\"} 1"));
+  EXPECT_TRUE(contains(body, "cassandra_host_inflight_requests{host=\"127.0.0.1\"} 0"));
+  EXPECT_TRUE(contains(
+      body, "cassandra_connection_streams_in_use{host=\"127.0.0.1\",connection=\"0\"} 0"));
+
+  CassConnectionMetrics connections[4];
+  size_t connection_count = cass_session_get_connection_metrics(session, connections, 4);
+  ASSERT_EQ(1u, connection_count); // The control connection isn't included
+  for (size_t i = 0; i < connection_count; ++i) {
+    EXPECT_EQ(4, connections[i].host.address_length);
+    EXPECT_GT(connections[i].bytes_read, 0u);
+    EXPECT_GT(connections[i].bytes_written, 0u);
+    EXPECT_GE(connections[i].max_streams_in_use, 1u);
+  }
+
+  CassFuture* close_future = cass_session_close(session);
+  cass_future_wait(close_future);
+  cass_future_free(close_future);
+
+  // The endpoint is stopped when the session is closed
+  Response response(scrape("/metrics"));
+  EXPECT_EQ(0u, response.status_code);
+
+  cass_session_free(session);
+  cass_cluster_free(cass_cluster);
+}
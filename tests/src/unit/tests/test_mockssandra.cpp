@@ -0,0 +1,210 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cassandra.h"
+#include "mockssandra.hpp"
+
+#include <algorithm>
+
+#define NUM_SAMPLES 100000
+
+using mockssandra::Latency;
+using mockssandra::Scenario;
+
+static const Address NODE1("127.0.0.1", 9042);
+static const Address NODE2("127.0.0.2", 9042);
+
+static double sample_mean(const Latency::Ptr& latency) {
+  double sum = 0.0;
+  for (int i = 0; i < NUM_SAMPLES; ++i) {
+    sum += latency->sample_us();
+  }
+  return sum / NUM_SAMPLES;
+}
+
+static uint64_t sample_median(const Latency::Ptr& latency) {
+  Vector<uint64_t> samples;
+  for (int i = 0; i < NUM_SAMPLES; ++i) {
+    samples.push_back(latency->sample_us());
+  }
+  std::nth_element(samples.begin(), samples.begin() + NUM_SAMPLES / 2, samples.end());
+  return samples[NUM_SAMPLES / 2];
+}
+
+TEST(MockssandraUnitTest, LatencyConstant) {
+  Latency::Ptr latency(Latency::constant(250));
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(250u, latency->sample_us());
+  }
+}
+
+TEST(MockssandraUnitTest, LatencyUniform) {
+  Latency::Ptr latency(Latency::uniform(100, 200));
+  for (int i = 0; i < NUM_SAMPLES; ++i) {
+    uint64_t sample = latency->sample_us();
+    EXPECT_GE(sample, 100u);
+    EXPECT_LT(sample, 200u);
+  }
+  EXPECT_NEAR(150.0, sample_mean(latency), 2.0);
+}
+
+TEST(MockssandraUnitTest, LatencyExponential) {
+  EXPECT_NEAR(1000.0, sample_mean(Latency::exponential(1000)), 30.0);
+}
+
+TEST(MockssandraUnitTest, LatencyLognormal) {
+  uint64_t median = sample_median(Latency::lognormal(2000, 1.0));
+  EXPECT_GE(median, 1900u);
+  EXPECT_LE(median, 2100u);
+}
+
+TEST(MockssandraUnitTest, LatencyBimodal) {
+  Latency::Ptr fast(Latency::constant(100));
+  Latency::Ptr slow(Latency::constant(10000));
+
+  EXPECT_EQ(100.0, sample_mean(Latency::bimodal(fast, slow, 0.0)));
+  EXPECT_EQ(10000.0, sample_mean(Latency::bimodal(fast, slow, 1.0)));
+
+  // 10% of the samples are slow: 0.9 * 100 + 0.1 * 10000
+  EXPECT_NEAR(1090.0, sample_mean(Latency::bimodal(fast, slow, 0.1)), 100.0);
+}
+
+TEST(MockssandraUnitTest, ScenarioNoFaults) {
+  Scenario scenario;
+  uint64_t delay_us = 1;
+  EXPECT_EQ(Scenario::RESPOND, scenario.inject(NODE1, 0, &delay_us));
+  EXPECT_EQ(0u, delay_us);
+}
+
+TEST(MockssandraUnitTest, ScenarioWindow) {
+  Scenario scenario;
+  scenario.add(Scenario::Fault().from(1000).until(2000).latency(Latency::constant(500)));
+
+  uint64_t delay_us;
+  scenario.inject(NODE1, 999999, &delay_us);
+  EXPECT_EQ(0u, delay_us);
+  scenario.inject(NODE1, 1000000, &delay_us);
+  EXPECT_EQ(500u, delay_us);
+  scenario.inject(NODE1, 1999999, &delay_us);
+  EXPECT_EQ(500u, delay_us);
+  scenario.inject(NODE1, 2000000, &delay_us);
+  EXPECT_EQ(0u, delay_us);
+}
+
+TEST(MockssandraUnitTest, ScenarioNode) {
+  Scenario scenario;
+  scenario.add(Scenario::Fault().node(NODE2).latency(Latency::constant(500)));
+
+  uint64_t delay_us;
+  scenario.inject(NODE1, 0, &delay_us);
+  EXPECT_EQ(0u, delay_us);
+  scenario.inject(NODE2, 0, &delay_us);
+  EXPECT_EQ(500u, delay_us);
+}
+
+TEST(MockssandraUnitTest, ScenarioStall) {
+  Scenario scenario;
+  // Stall for the first 20 ms of every 100 ms, starting at 1 second
+  scenario.add(Scenario::Fault().from(1000).stall(100, 20));
+
+  uint64_t delay_us;
+  scenario.inject(NODE1, 999000, &delay_us);
+  EXPECT_EQ(0u, delay_us);
+
+  // Responses are held until the end of the stall
+  scenario.inject(NODE1, 1000000, &delay_us);
+  EXPECT_EQ(20000u, delay_us);
+  scenario.inject(NODE1, 1005500, &delay_us);
+  EXPECT_EQ(14500u, delay_us);
+  scenario.inject(NODE1, 1019999, &delay_us);
+  EXPECT_EQ(1u, delay_us);
+
+  // The rest of the period isn't stalled
+  scenario.inject(NODE1, 1020000, &delay_us);
+  EXPECT_EQ(0u, delay_us);
+  scenario.inject(NODE1, 1099999, &delay_us);
+  EXPECT_EQ(0u, delay_us);
+
+  // The next period
+  scenario.inject(NODE1, 1110000, &delay_us);
+  EXPECT_EQ(10000u, delay_us);
+}
+
+TEST(MockssandraUnitTest, ScenarioFaultsAreCombined) {
+  Scenario scenario;
+  scenario.add(Scenario::Fault().stall(100, 20));
+  scenario.add(Scenario::Fault().latency(Latency::constant(500)));
+  scenario.add(Scenario::Fault().node(NODE2).latency(Latency::constant(1000)));
+
+  uint64_t delay_us;
+  scenario.inject(NODE1, 5000, &delay_us);
+  EXPECT_EQ(15500u, delay_us);
+  scenario.inject(NODE2, 5000, &delay_us);
+  EXPECT_EQ(16500u, delay_us);
+  scenario.inject(NODE2, 50000, &delay_us);
+  EXPECT_EQ(1500u, delay_us);
+}
+
+TEST(MockssandraUnitTest, ScenarioResetAndOverload) {
+  Scenario scenario;
+  scenario.add(Scenario::Fault().node(NODE1).until(1000).reset(1.0));
+  scenario.add(Scenario::Fault().overload(1.0));
+
+  uint64_t delay_us;
+  EXPECT_EQ(Scenario::RESET, scenario.inject(NODE1, 0, &delay_us));
+  EXPECT_EQ(Scenario::OVERLOAD, scenario.inject(NODE2, 0, &delay_us));
+  EXPECT_EQ(Scenario::OVERLOAD, scenario.inject(NODE1, 1000000, &delay_us));
+}
+
+TEST(MockssandraUnitTest, DelayWithMicrosecondPrecision) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .delay(Latency::constant(200))
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  CassCluster* cass_cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cass_cluster, "127.0.0.1");
+  CassSession* session = cass_session_new();
+
+  CassFuture* connect_future = cass_session_connect(session, cass_cluster);
+  ASSERT_EQ(CASS_OK, cass_future_error_code(connect_future));
+  cass_future_free(connect_future);
+
+  Vector<uint64_t> latencies;
+  for (int i = 0; i < 21; ++i) {
+    CassStatement* statement = cass_statement_new("SELECT * FROM table", 0);
+    uint64_t start = uv_hrtime();
+    CassFuture* future = cass_session_execute(session, statement);
+    EXPECT_EQ(CASS_OK, cass_future_error_code(future));
+    latencies.push_back((uv_hrtime() - start) / 1000);
+    cass_future_free(future);
+    cass_statement_free(statement);
+  }
+
+  cass_session_free(session);
+  cass_cluster_free(cass_cluster);
+
+  // The delay isn't rounded up to a millisecond
+  std::sort(latencies.begin(), latencies.end());
+  EXPECT_GE(latencies.front(), 200u);
+  EXPECT_LT(latencies[latencies.size() / 2], 1000u);
+}
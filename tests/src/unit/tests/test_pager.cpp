@@ -0,0 +1,233 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "loop_test.hpp"
+
+#include "pager.hpp"
+#include "query_request.hpp"
+#include "session.hpp"
+
+#include <stdlib.h>
+
+using namespace mockssandra;
+using datastax::internal::OStringStream;
+using datastax::internal::core::Config;
+using datastax::internal::core::Future;
+using datastax::internal::core::Pager;
+using datastax::internal::core::QueryRequest;
+using datastax::internal::core::ResponseFuture;
+using datastax::internal::core::ResultResponse;
+using datastax::internal::core::Session;
+using datastax::internal::core::Statement;
+
+#define PAGED_QUERY "SELECT * FROM paged"
+
+class PagerUnitTest : public LoopTest {
+public:
+  /**
+   * Action that returns `num_pages` pages. The paging state is the index of the
+   * next page and each page's row count is its index plus one (so that the order of
+   * the pages can be verified).
+   */
+  class PagedQuery : public Action {
+  public:
+    PagedQuery(int num_pages, Atomic<int>* request_count)
+        : num_pages_(num_pages)
+        , request_count_(request_count) {}
+
+    void on_run(Request* request) const {
+      String query;
+      QueryParameters params;
+      if (!request->decode_query(&query, &params)) {
+        request->error(ERROR_PROTOCOL_ERROR, "Invalid query message");
+      } else if (query != PAGED_QUERY) {
+        run_next(request);
+      } else {
+        request_count_->fetch_add(1);
+        int page = params.paging_state.empty() ? 0 : atoi(params.paging_state.c_str());
+        bool has_more_pages = page + 1 < num_pages_;
+        int32_t flags = 0;
+        if (has_more_pages) flags |= RESULT_FLAG_HAS_MORE_PAGES;
+        String body;
+        encode_int32(RESULT_ROWS, &body); // Result kind
+        encode_int32(flags, &body);       // Flags
+        encode_int32(0, &body);           // Column count
+        if (has_more_pages) {
+          OStringStream ss;
+          ss << page + 1;
+          String paging_state(ss.str());
+          encode_int32(paging_state.size(), &body);
+          body.append(paging_state);
+        }
+        encode_int32(page + 1, &body); // Row count
+        request->write(OPCODE_RESULT, body);
+      }
+    }
+
+  private:
+    const int num_pages_;
+    Atomic<int>* const request_count_;
+  };
+
+  const RequestHandler* paged_request_handler(int num_pages, Atomic<int>* request_count) {
+    mockssandra::SimpleRequestHandlerBuilder builder;
+    builder.on(OPCODE_QUERY)
+        .system_local()
+        .system_peers()
+        .execute(new PagedQuery(num_pages, request_count))
+        .empty_rows_result(1);
+    return builder.build();
+  }
+
+  static void connect(Session* session) {
+    Config config;
+    config.contact_points().push_back(Address("127.0.0.1", 9042));
+    Future::Ptr connect_future(session->connect(config));
+    ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME))
+        << "Timed out waiting for session to connect";
+    ASSERT_FALSE(connect_future->error()) << cass_error_desc(connect_future->error()->code) << ": "
+                                          << connect_future->error()->message;
+  }
+
+  static void close(Session* session) {
+    Future::Ptr close_future(session->close());
+    ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting for session to close";
+  }
+
+  static Statement::Ptr paged_statement() {
+    Statement::Ptr statement(new QueryRequest(PAGED_QUERY));
+    statement->set_page_size(1);
+    return statement;
+  }
+
+  static int32_t next_page_row_count(const Pager::Ptr& pager) {
+    ResponseFuture::Ptr future(pager->next_page());
+    EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting for page";
+    if (future->error()) {
+      ADD_FAILURE() << cass_error_desc(future->error()->code) << ": " << future->error()->message;
+      return -1;
+    }
+    ResultResponse::Ptr result(future->response());
+    return result->row_count();
+  }
+
+  static bool wait_for_request_count(const Atomic<int>& request_count, int expected) {
+    for (int i = 0; i < 200 && request_count.load() < expected; ++i) {
+      test::Utils::msleep(10);
+    }
+    return request_count.load() == expected;
+  }
+};
+
+TEST_F(PagerUnitTest, AllPages) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleCluster cluster(paged_request_handler(5, &request_count));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  Pager::Ptr pager(new Pager(&session, paged_statement()));
+  for (int i = 1; i <= 5; ++i) {
+    EXPECT_TRUE(pager->has_more_pages());
+    EXPECT_EQ(i, next_page_row_count(pager));
+  }
+  EXPECT_FALSE(pager->has_more_pages());
+  EXPECT_EQ(5, request_count.load());
+
+  ResponseFuture::Ptr future(pager->next_page());
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME));
+  ASSERT_TRUE(future->error());
+  EXPECT_EQ(CASS_ERROR_LIB_NO_PAGING_STATE, future->error()->code);
+
+  close(&session);
+}
+
+TEST_F(PagerUnitTest, PrefetchDepth) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleCluster cluster(paged_request_handler(10, &request_count));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  Pager::Ptr pager(new Pager(&session, paged_statement()));
+  pager->set_prefetch_depth(3);
+
+  EXPECT_EQ(1, next_page_row_count(pager));
+  EXPECT_TRUE(wait_for_request_count(request_count, 4)); // The first page and 3 prefetched
+  test::Utils::msleep(50);
+  EXPECT_EQ(4, request_count.load());
+  EXPECT_EQ(3u, pager->buffered_page_count());
+  EXPECT_GT(pager->buffered_bytes(), 0u);
+
+  EXPECT_EQ(2, next_page_row_count(pager));
+  EXPECT_TRUE(wait_for_request_count(request_count, 5));
+
+  close(&session);
+}
+
+TEST_F(PagerUnitTest, PrefetchDisabled) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleCluster cluster(paged_request_handler(10, &request_count));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  Pager::Ptr pager(new Pager(&session, paged_statement()));
+  pager->set_prefetch_depth(0);
+
+  EXPECT_EQ(1, next_page_row_count(pager));
+  EXPECT_EQ(2, next_page_row_count(pager));
+  test::Utils::msleep(50);
+  EXPECT_EQ(2, request_count.load());
+  EXPECT_EQ(0u, pager->buffered_page_count());
+
+  close(&session);
+}
+
+TEST_F(PagerUnitTest, PrefetchMaxBytes) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleCluster cluster(paged_request_handler(10, &request_count));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  Pager::Ptr pager(new Pager(&session, paged_statement()));
+  pager->set_prefetch_depth(5);
+  pager->set_prefetch_max_bytes(1); // Any buffered page exceeds the budget
+
+  EXPECT_EQ(1, next_page_row_count(pager));
+  EXPECT_TRUE(wait_for_request_count(request_count, 2));
+  test::Utils::msleep(50);
+  EXPECT_EQ(2, request_count.load());
+  EXPECT_EQ(1u, pager->buffered_page_count());
+
+  close(&session);
+}
+
+TEST_F(PagerUnitTest, NotConnected) {
+  Session session;
+
+  Pager::Ptr pager(new Pager(&session, paged_statement()));
+  ResponseFuture::Ptr future(pager->next_page());
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME));
+  ASSERT_TRUE(future->error());
+  EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, future->error()->code);
+  EXPECT_FALSE(pager->has_more_pages());
+}
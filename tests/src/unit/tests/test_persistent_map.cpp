@@ -0,0 +1,143 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "map.hpp"
+#include "persistent_map.hpp"
+#include "string.hpp"
+
+#include <stdlib.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+typedef PersistentMap<int, String> IntMap;
+
+static String to_string(int i) {
+  OStringStream ss;
+  ss << i;
+  return ss.str();
+}
+
+static void expect_equal(const Map<int, String>& expected, const IntMap& map) {
+  ASSERT_EQ(expected.size(), map.size());
+  Map<int, String>::const_iterator expected_it = expected.begin();
+  for (IntMap::const_iterator it = map.begin(), end = map.end(); it != end; ++it) {
+    ASSERT_TRUE(expected_it != expected.end());
+    EXPECT_EQ(expected_it->first, it->first);
+    EXPECT_EQ(expected_it->second, it->second);
+    ++expected_it;
+  }
+  EXPECT_TRUE(expected_it == expected.end());
+}
+
+TEST(PersistentMapUnitTest, Simple) {
+  IntMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+
+  map.set(2, "b");
+  map.set(1, "a");
+  map.set(3, "c");
+  EXPECT_EQ(3u, map.size());
+
+  ASSERT_TRUE(map.find(2) != map.end());
+  EXPECT_EQ("b", map.find(2)->second);
+  EXPECT_TRUE(map.find(4) == map.end());
+
+  // Iteration continues from a found entry
+  IntMap::const_iterator it = map.find(1);
+  ++it;
+  ASSERT_TRUE(it != map.end());
+  EXPECT_EQ(2, it->first);
+
+  map.set(2, "B"); // Replace
+  EXPECT_EQ(3u, map.size());
+  EXPECT_EQ("B", map.find(2)->second);
+
+  *map.find_mutable(3) = "C";
+  EXPECT_EQ("C", map.find(3)->second);
+  EXPECT_TRUE(map.find_mutable(4) == NULL);
+
+  map[4] = "d";
+  EXPECT_EQ(4u, map.size());
+
+  EXPECT_TRUE(map.erase(1));
+  EXPECT_FALSE(map.erase(1));
+  EXPECT_EQ(3u, map.size());
+  EXPECT_EQ(2, map.begin()->first);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+}
+
+TEST(PersistentMapUnitTest, Random) {
+  Map<int, String> expected;
+  IntMap map;
+
+  srand(42);
+  for (int i = 0; i < 10000; ++i) {
+    int key = rand() % 1000;
+    if (rand() % 3 == 0) {
+      EXPECT_EQ(expected.erase(key) > 0, map.erase(key));
+    } else {
+      expected[key] = to_string(i);
+      map.set(key, to_string(i));
+    }
+  }
+
+  expect_equal(expected, map);
+}
+
+TEST(PersistentMapUnitTest, StructuralSharing) {
+  IntMap map;
+  for (int i = 0; i < 1000; ++i) {
+    map.set(i, to_string(i));
+  }
+
+  // Copies share the whole tree
+  IntMap copy(map);
+  EXPECT_EQ(&map.find(500)->second, &copy.find(500)->second);
+
+  // Modifying a copy only copies the path to the modified entry
+  *copy.find_mutable(500) = "modified";
+  copy.erase(10);
+  copy.set(1000, "1000");
+
+  EXPECT_EQ("500", map.find(500)->second);
+  EXPECT_EQ("modified", copy.find(500)->second);
+  EXPECT_TRUE(map.find(10) != map.end());
+  EXPECT_TRUE(copy.find(10) == copy.end());
+  EXPECT_TRUE(map.find(1000) == map.end());
+  EXPECT_EQ(1000u, map.size());
+  EXPECT_EQ(1000u, copy.size());
+
+  int shared = 0;
+  for (int i = 0; i < 1000; ++i) {
+    if (i == 10) continue;
+    if (&map.find(i)->second == &copy.find(i)->second) shared++;
+  }
+  EXPECT_GT(shared, 900);
+
+  Map<int, String> expected;
+  for (int i = 0; i < 1000; ++i) {
+    expected[i] = to_string(i);
+  }
+  expect_equal(expected, map);
+}
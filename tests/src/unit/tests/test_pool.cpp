@@ -15,6 +15,7 @@
 
 #include "connection_pool_manager_initializer.hpp"
 #include "constants.hpp"
+#include "metrics.hpp"
 #include "ssl.hpp"
 
 #define NUM_NODES 3u
@@ -388,6 +389,14 @@ public:
     ConnectionPoolManager::Ptr manager = initializer->release_manager();
     status->set_manager(manager);
   }
+
+  static void on_pool_warm_up(ConnectionPoolManagerInitializer* initializer,
+                              RequestStatusWithManager* status) {
+    ConnectionPoolManager::Ptr manager = initializer->release_manager();
+    status->set_manager(manager);
+    // Only the first pool is ready, the others are still connecting
+    EXPECT_EQ(1u, manager->available().size());
+  }
 };
 
 std::ostream& operator<<(std::ostream& os, const Vector<PoolUnitTest::RequestState::Enum>& states) {
@@ -442,6 +451,34 @@ TEST_F(PoolUnitTest, Simple) {
   EXPECT_EQ(status.count(RequestStatus::SUCCESS), NUM_NODES) << status.results();
 }
 
+TEST_F(PoolUnitTest, Metrics) {
+  mockssandra::SimpleCluster cluster(simple(), NUM_NODES);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Metrics metrics(1);
+  ConnectionStats::Vec stats;
+
+  {
+    RequestStatusWithManager status(loop());
+
+    ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+        PROTOCOL_VERSION, bind_callback(on_pool_connected, &status)));
+
+    initializer->with_metrics(&metrics)->initialize(loop(), hosts());
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    EXPECT_EQ(status.count(RequestStatus::SUCCESS), NUM_NODES) << status.results();
+
+    // The pooled connections are tracked by the metrics, not by their hosts
+    metrics.connections.stats(&stats);
+    EXPECT_EQ(NUM_NODES * CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST, stats.size());
+  } // Close the pools
+
+  stats.clear();
+  metrics.connections.stats(&stats);
+  EXPECT_TRUE(stats.empty());
+}
+
 TEST_F(PoolUnitTest, Keyspace) {
   mockssandra::SimpleRequestHandlerBuilder builder;
 
@@ -645,6 +682,81 @@ TEST_F(PoolUnitTest, Reconnect) {
       << reconnect_listener_status.results();
 }
 
+TEST_F(PoolUnitTest, WarmUpMaxConcurrentConnects) {
+  mockssandra::SimpleCluster cluster(simple(), NUM_NODES);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  RequestStatusWithManager status(loop());
+
+  ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+      PROTOCOL_VERSION, bind_callback(on_pool_connected, &status)));
+
+  ConnectionPoolSettings settings;
+  settings.warm_up_max_concurrent_connects = 1;
+
+  initializer->with_settings(settings)->initialize(loop(), hosts());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(status.count(RequestStatus::SUCCESS), NUM_NODES) << status.results();
+}
+
+TEST_F(PoolUnitTest, WarmUpReadyRatio) {
+  mockssandra::SimpleCluster cluster(simple(), NUM_NODES);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  ListenerStatus listener_status(loop());
+  ScopedPtr<Listener> listener(new Listener(&listener_status));
+  RequestStatusWithManager request_status(loop(), 0);
+
+  ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+      PROTOCOL_VERSION, bind_callback(on_pool_warm_up, &request_status)));
+
+  ConnectionPoolSettings settings;
+  settings.warm_up_max_concurrent_connects = 1;
+  settings.warm_up_ready_ratio = 0.1;
+
+  initializer->with_settings(settings)->with_listener(listener.get())->initialize(loop(), hosts());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  // The remaining pools are connected by the manager
+  EXPECT_EQ(listener_status.count(ListenerStatus::UP), NUM_NODES) << listener_status.results();
+  ConnectionPoolManager::Ptr manager(request_status.manager());
+  ASSERT_TRUE(manager);
+  EXPECT_EQ(NUM_NODES, manager->available().size());
+}
+
+TEST_F(PoolUnitTest, WarmUpLocalDc) {
+  mockssandra::SimpleCluster cluster(simple(), NUM_NODES);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  ListenerStatus listener_status(loop());
+  ScopedPtr<Listener> listener(new Listener(&listener_status));
+  RequestStatusWithManager request_status(loop(), 0);
+
+  ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+      PROTOCOL_VERSION, bind_callback(on_pool_warm_up, &request_status)));
+
+  // Only the local host is required to be ready
+  HostMap hosts(this->hosts());
+  Host::Ptr local_host(hosts.begin()->second);
+  local_host->set_rack_and_dc("rack1", "dc1");
+
+  ConnectionPoolSettings settings;
+  settings.warm_up_max_concurrent_connects = 1;
+  settings.warm_up_ready_ratio = 1.0;
+
+  initializer->with_settings(settings)
+      ->with_listener(listener.get())
+      ->with_local_dc("dc1")
+      ->initialize(loop(), hosts);
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(listener_status.count(ListenerStatus::UP), NUM_NODES) << listener_status.results();
+  ConnectionPoolManager::Ptr manager(request_status.manager());
+  ASSERT_TRUE(manager);
+  EXPECT_TRUE(manager->has_connections(local_host->address()));
+}
+
 TEST_F(PoolUnitTest, Timeout) {
   mockssandra::RequestHandler::Builder builder;
   builder.on(mockssandra::OPCODE_STARTUP).no_result(); // Don't return a response
@@ -15,6 +15,7 @@
 
 #include "execute_request.hpp"
 #include "md5.hpp"
+#include "prepare_host_handler.hpp"
 #include "prepared.hpp"
 #include "session.hpp"
 #include "set.hpp"
@@ -22,11 +23,15 @@
 
 using namespace mockssandra;
 using datastax::internal::ScopedMutex;
+using datastax::internal::OStringStream;
 using datastax::internal::Set;
 using datastax::internal::core::Config;
+using datastax::internal::core::ConnectionSettings;
 using datastax::internal::core::ExecuteRequest;
 using datastax::internal::core::Future;
+using datastax::internal::core::PrepareHostHandler;
 using datastax::internal::core::Prepared;
+using datastax::internal::core::PreparedMetadata;
 using datastax::internal::core::ResponseFuture;
 using datastax::internal::core::ResultResponse;
 using datastax::internal::core::Session;
@@ -50,9 +55,15 @@ public:
       ScopedMutex l(&mutex_);
       String id = generate_id(query);
       statements_.insert(to_key(address, id));
+      queries_.push_back(query);
       return id;
     }
 
+    Vector<String> queries() const {
+      ScopedMutex l(&mutex_);
+      return queries_;
+    }
+
     bool contains_id(const Address& address, const String& id) const {
       ScopedMutex l(&mutex_);
       return statements_.count(to_key(address, id)) > 0;
@@ -78,6 +89,7 @@ public:
   private:
     mutable uv_mutex_t mutex_;
     Set<String> statements_;
+    Vector<String> queries_;
   };
 
   /**
@@ -180,6 +192,33 @@ public:
         << cass_error_desc(close_future->error()->code) << ": " << close_future->error()->message;
   }
 
+  struct PrepareHostStatus {
+    PrepareHostStatus(const PrepareStatements* statements)
+        : statements(statements)
+        , is_done(false)
+        , is_prepared(false) {}
+
+    const PrepareStatements* statements;
+    bool is_done;
+    bool is_prepared;
+  };
+
+  static void on_prepare_host(const PrepareHostHandler* handler, PrepareHostStatus* status) {
+    status->is_done = true;
+    status->is_prepared = status->statements->contains_query(handler->host()->address(),
+                                                             PREPARED_QUERY);
+  }
+
+  static datastax::internal::core::Host::Ptr host() {
+    return datastax::internal::core::Host::Ptr(
+        new datastax::internal::core::Host(Address("127.0.0.1", 9042)));
+  }
+
+  static PreparedMetadata::Entry::Ptr entry(const String& query) {
+    return PreparedMetadata::Entry::Ptr(
+        new PreparedMetadata::Entry(query, "", "", ResultResponse::ConstPtr()));
+  }
+
   static Prepared::ConstPtr prepare(Session* session, const String& query) {
     ResponseFuture::Ptr future = session->prepare(query.c_str(), query.length());
 
@@ -289,3 +328,158 @@ TEST_F(PreparedUnitTest, PreparedOnUpWithCaseSensitiveKeyspace) {
 
   close(&session);
 }
+
+/**
+ * Verify that the most recently used statements are prepared first on a host that comes up.
+ */
+TEST_F(PreparedUnitTest, PrepareHostMostRecentlyUsedFirst) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  PreparedMetadata::Entry::Vec entries;
+  for (int i = 0; i < 5; ++i) {
+    OStringStream ss;
+    ss << PREPARED_QUERY << i;
+    entries.push_back(entry(ss.str()));
+    test::Utils::msleep(1);
+  }
+  entries[2]->mark_used();
+
+  PrepareHostStatus status(&statements);
+  PrepareHostHandler::Ptr handler(new PrepareHostHandler(
+      host(), entries, bind_callback(on_prepare_host, &status), PROTOCOL_VERSION, 1));
+  handler->prepare(loop(), ConnectionSettings());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_TRUE(status.is_done);
+
+  Vector<String> queries(statements.queries());
+  ASSERT_EQ(5u, queries.size());
+  EXPECT_EQ(entries[2]->query(), queries[0]);
+  EXPECT_EQ(entries[4]->query(), queries[1]);
+  EXPECT_EQ(entries[3]->query(), queries[2]);
+  EXPECT_EQ(entries[1]->query(), queries[3]);
+  EXPECT_EQ(entries[0]->query(), queries[4]);
+}
+
+/**
+ * Verify that a host is made available when the deadline expires and that its statements continue
+ * to be prepared in the background.
+ */
+TEST_F(PreparedUnitTest, PrepareHostDeadline) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).wait(500).execute(new PrepareQuery(&statements));
+
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  PreparedMetadata::Entry::Vec entries;
+  entries.push_back(entry(PREPARED_QUERY));
+
+  PrepareHostStatus status(&statements);
+  PrepareHostHandler::Ptr handler(new PrepareHostHandler(
+      host(), entries, bind_callback(on_prepare_host, &status), PROTOCOL_VERSION, 1, 50));
+  handler->prepare(loop(), ConnectionSettings());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_TRUE(status.is_done);
+  EXPECT_FALSE(status.is_prepared); // The deadline expired before the statement was prepared
+  EXPECT_TRUE(statements.contains_query(Address("127.0.0.1", 9042), PREPARED_QUERY));
+}
+
+#define NUM_CONTENTION_THREADS 32
+#define NUM_CONTENTION_ENTRIES 256
+#define NUM_CONTENTION_LOOKUPS 100000
+
+struct PreparedMetadataThreadArgs {
+  uv_thread_t thread;
+  const PreparedMetadata* prepared_metadata;
+  const Vector<String>* ids;
+  int found;
+};
+
+void prepared_metadata_thread(void* data) {
+  PreparedMetadataThreadArgs* args = static_cast<PreparedMetadataThreadArgs*>(data);
+  const Vector<String>& ids(*args->ids);
+  for (int i = 0; i < NUM_CONTENTION_LOOKUPS; ++i) {
+    const String& id(ids[i % ids.size()]);
+    if (args->prepared_metadata->get(id, PreparedMetadata::hash_id(id))) {
+      args->found++;
+    }
+  }
+}
+
+/**
+ * Verify that prepared metadata lookups from many threads find every entry while new entries are
+ * being added.
+ */
+TEST(PreparedMetadataUnitTest, Contention) {
+  PreparedMetadata prepared_metadata;
+
+  Vector<String> ids;
+  for (int i = 0; i < NUM_CONTENTION_ENTRIES; ++i) {
+    OStringStream ss;
+    ss << PREPARED_QUERY << i;
+    ids.push_back(ss.str());
+    prepared_metadata.set(ids.back(), PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                                          ss.str(), "", "", ResultResponse::ConstPtr())));
+  }
+
+  PreparedMetadataThreadArgs args[NUM_CONTENTION_THREADS];
+
+  for (int i = 0; i < NUM_CONTENTION_THREADS; ++i) {
+    args[i].prepared_metadata = &prepared_metadata;
+    args[i].ids = &ids;
+    args[i].found = 0;
+    uv_thread_create(&args[i].thread, prepared_metadata_thread, &args[i]);
+  }
+
+  // Add entries while the lookups are running
+  for (int i = 0; i < NUM_CONTENTION_ENTRIES; ++i) {
+    OStringStream ss;
+    ss << "INSERT INTO test (k) VALUES (" << i << ")";
+    prepared_metadata.set(ss.str(), PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                                        ss.str(), "", "", ResultResponse::ConstPtr())));
+  }
+
+  for (int i = 0; i < NUM_CONTENTION_THREADS; ++i) {
+    uv_thread_join(&args[i].thread);
+  }
+
+  for (int i = 0; i < NUM_CONTENTION_THREADS; ++i) {
+    EXPECT_EQ(NUM_CONTENTION_LOOKUPS, args[i].found);
+  }
+  EXPECT_EQ(2u * NUM_CONTENTION_ENTRIES, prepared_metadata.copy().size());
+}
+
+void prepared_metadata_lookup_thread(void* data) {
+  const PreparedMetadata* prepared_metadata = static_cast<const PreparedMetadata*>(data);
+  EXPECT_TRUE(prepared_metadata->get(PREPARED_QUERY));
+}
+
+/**
+ * Verify that a replaced entry isn't kept alive by the snapshot of a thread that looked it up and
+ * then exited.
+ */
+TEST(PreparedMetadataUnitTest, ReleaseThreadSnapshots) {
+  PreparedMetadata prepared_metadata;
+
+  PreparedMetadata::Entry::Ptr entry(
+      new PreparedMetadata::Entry(PREPARED_QUERY, "", "", ResultResponse::ConstPtr()));
+  prepared_metadata.set(PREPARED_QUERY, entry);
+
+  uv_thread_t thread;
+  uv_thread_create(&thread, prepared_metadata_lookup_thread, &prepared_metadata);
+  uv_thread_join(&thread);
+
+  prepared_metadata.set(PREPARED_QUERY, PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                                            PREPARED_QUERY, "", "", ResultResponse::ConstPtr())));
+  EXPECT_EQ(1, entry->ref_count()); // Only the test's reference is left
+}
@@ -0,0 +1,253 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "loop_test.hpp"
+
+#include "query_request.hpp"
+#include "response.hpp"
+#include "result_response.hpp"
+#include "row_stream.hpp"
+#include "session.hpp"
+
+using namespace mockssandra;
+using datastax::internal::OStringStream;
+using datastax::internal::core::Config;
+using datastax::internal::core::Future;
+using datastax::internal::core::QueryRequest;
+using datastax::internal::core::ResponseFuture;
+using datastax::internal::core::ResponseMessage;
+using datastax::internal::core::ResultResponse;
+using datastax::internal::core::RowStreamResolver;
+using datastax::internal::core::Session;
+using datastax::internal::core::Statement;
+
+#define STREAMED_QUERY "SELECT * FROM streamed"
+
+class RowStreamUnitTest : public LoopTest {
+public:
+  /**
+   * The rows passed to the row callback. Each row is "<text>:<list item count>".
+   */
+  typedef Vector<String> RowVec;
+
+  static void on_row(const CassRow* row, void* data) {
+    RowVec* rows = static_cast<RowVec*>(data);
+    const char* text;
+    size_t text_length;
+    EXPECT_EQ(CASS_OK, cass_value_get_string(cass_row_get_column(row, 0), &text, &text_length));
+    OStringStream ss;
+    ss << String(text, text_length) << ":" << cass_value_item_count(cass_row_get_column(row, 1));
+    rows->push_back(ss.str());
+  }
+
+  class Resolver : public RowStreamResolver {
+  public:
+    Resolver(RowVec* rows, bool is_enabled = true)
+        : rows_(rows)
+        , is_enabled_(is_enabled) {}
+
+    virtual bool resolve_row_callback(int16_t stream, CassRowCallback* callback, void** data) {
+      if (!is_enabled_) return false;
+      *callback = on_row;
+      *data = rows_;
+      return true;
+    }
+
+  private:
+    RowVec* rows_;
+    bool is_enabled_;
+  };
+
+  static ResultSet result_set(int row_count) {
+    ResultSet::Builder builder("ks", "streamed");
+    builder.column("key", Type::text()).column("items", Type::list(Type::text()));
+    for (int i = 0; i < row_count; ++i) {
+      OStringStream ss;
+      ss << "row" << i;
+      Vector<String> items(i % 3, "item");
+      builder.row(Row::Builder().text(ss.str()).collection(Collection::text(items)).build());
+    }
+    return builder.build();
+  }
+
+  static String frame(const String& body, uint8_t flags = 0) {
+    String frame;
+    frame.push_back(static_cast<char>(0x80 | PROTOCOL_VERSION)); // Response version
+    frame.push_back(static_cast<char>(flags));
+    frame.push_back(0); // Stream
+    frame.push_back(1);
+    frame.push_back(static_cast<char>(OPCODE_RESULT));
+    encode_int32(body.size(), &frame);
+    frame.append(body);
+    return frame;
+  }
+
+  static bool decode_frame(const String& frame, size_t chunk_size, ResponseMessage* message) {
+    for (size_t pos = 0; pos < frame.size();) {
+      size_t size = std::min(chunk_size, frame.size() - pos);
+      ssize_t consumed = message->decode(frame.data() + pos, size);
+      if (consumed <= 0) return false;
+      pos += consumed;
+    }
+    return message->is_body_ready();
+  }
+
+  static void connect(Session* session) {
+    Config config;
+    config.contact_points().push_back(Address("127.0.0.1", 9042));
+    Future::Ptr connect_future(session->connect(config));
+    ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME))
+        << "Timed out waiting for session to connect";
+    ASSERT_FALSE(connect_future->error()) << cass_error_desc(connect_future->error()->code) << ": "
+                                          << connect_future->error()->message;
+  }
+
+  static void close(Session* session) {
+    Future::Ptr close_future(session->close());
+    ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting for session to close";
+  }
+
+  class StreamedQuery : public Action {
+  public:
+    StreamedQuery(int row_count)
+        : row_count_(row_count) {}
+
+    void on_run(Request* request) const {
+      String query;
+      QueryParameters params;
+      if (!request->decode_query(&query, &params)) {
+        request->error(ERROR_PROTOCOL_ERROR, "Invalid query message");
+      } else if (query != STREAMED_QUERY) {
+        run_next(request);
+      } else {
+        request->write(OPCODE_RESULT, result_set(row_count_).encode(PROTOCOL_VERSION));
+      }
+    }
+
+  private:
+    const int row_count_;
+  };
+};
+
+TEST_F(RowStreamUnitTest, Chunked) {
+  const String body(result_set(10).encode(PROTOCOL_VERSION));
+
+  size_t chunk_sizes[] = { 1, 2, 3, 7, 64, 4096 };
+  for (size_t i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); ++i) {
+    RowVec rows;
+    Resolver resolver(&rows);
+    ResponseMessage message(&resolver);
+    ASSERT_TRUE(decode_frame(frame(body), chunk_sizes[i], &message))
+        << "Unable to decode with chunk size " << chunk_sizes[i];
+
+    ASSERT_EQ(10u, rows.size());
+    for (int j = 0; j < 10; ++j) {
+      OStringStream ss;
+      ss << "row" << j << ":" << j % 3;
+      EXPECT_EQ(ss.str(), rows[j]);
+    }
+
+    ResultResponse::Ptr result(message.response_body());
+    EXPECT_EQ(CASS_RESULT_KIND_ROWS, result->kind());
+    EXPECT_EQ(0, result->row_count());
+    EXPECT_EQ(2, result->column_count());
+    EXPECT_LT(result->buffer_size(), body.size()); // Rows aren't buffered
+  }
+}
+
+TEST_F(RowStreamUnitTest, TracingAndWarnings) {
+  String body;
+  body.append(16, 'x'); // Tracing ID
+  body.push_back(0);    // Warnings
+  body.push_back(1);
+  encode_string("warning", &body);
+  body.append(result_set(3).encode(PROTOCOL_VERSION));
+
+  RowVec rows;
+  Resolver resolver(&rows);
+  ResponseMessage message(&resolver);
+  ASSERT_TRUE(decode_frame(frame(body, CASS_FLAG_TRACING | CASS_FLAG_WARNING), 5, &message));
+
+  EXPECT_EQ(3u, rows.size());
+  ResultResponse::Ptr result(message.response_body());
+  EXPECT_TRUE(result->has_tracing_id());
+  ASSERT_EQ(1u, result->warnings().size());
+  EXPECT_EQ("warning", result->warnings()[0].to_string());
+}
+
+TEST_F(RowStreamUnitTest, NotResolved) {
+  RowVec rows;
+  Resolver resolver(&rows, false);
+  ResponseMessage message(&resolver);
+  ASSERT_TRUE(decode_frame(frame(result_set(10).encode(PROTOCOL_VERSION)), 3, &message));
+
+  EXPECT_TRUE(rows.empty());
+  ResultResponse::Ptr result(message.response_body());
+  EXPECT_EQ(10, result->row_count());
+}
+
+TEST_F(RowStreamUnitTest, NotRows) {
+  String body;
+  encode_int32(RESULT_VOID, &body);
+
+  RowVec rows;
+  Resolver resolver(&rows);
+  ResponseMessage message(&resolver);
+  ASSERT_TRUE(decode_frame(frame(body), 1, &message));
+
+  EXPECT_TRUE(rows.empty());
+  ResultResponse::Ptr result(message.response_body());
+  EXPECT_EQ(CASS_RESULT_KIND_VOID, result->kind());
+}
+
+TEST_F(RowStreamUnitTest, Truncated) {
+  String body(result_set(2).encode(PROTOCOL_VERSION));
+  body.resize(body.size() - 1);
+
+  RowVec rows;
+  Resolver resolver(&rows);
+  ResponseMessage message(&resolver);
+  EXPECT_FALSE(decode_frame(frame(body), 4096, &message));
+}
+
+TEST_F(RowStreamUnitTest, Session) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .execute(new StreamedQuery(100))
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  RowVec rows;
+  Statement::Ptr statement(new QueryRequest(STREAMED_QUERY));
+  statement->set_row_callback(on_row, &rows);
+
+  Future::Ptr future(session.execute(datastax::internal::core::Request::ConstPtr(statement)));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting for query";
+  ASSERT_FALSE(future->error());
+
+  ResultResponse::Ptr result(static_cast<ResponseFuture*>(future.get())->response());
+  EXPECT_EQ(0, result->row_count());
+  ASSERT_EQ(100u, rows.size());
+  EXPECT_EQ("row99:0", rows.back());
+
+  close(&session);
+}
@@ -0,0 +1,237 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "allocation_counter.hpp"
+#include "metadata.hpp"
+#include "mockssandra.hpp"
+#include "result_response.hpp"
+#include "unit.hpp"
+
+#include <string.h>
+
+using datastax::internal::OStringStream;
+using datastax::internal::core::ColumnMetadata;
+using datastax::internal::core::KeyspaceMetadata;
+using datastax::internal::core::Metadata;
+using datastax::internal::core::ResultResponse;
+using datastax::internal::core::TableMetadata;
+using datastax::internal::core::VersionNumber;
+
+#define KEYSPACE_COUNT 10
+#define TABLE_COUNT 4000
+#define COLUMN_COUNT 8
+#define COLUMN_BYTES_BUDGET 1536 // Bytes allocated per column
+
+class SchemaMetadataUnitTest : public testing::Test {
+public:
+  static ResultResponse::Ptr decode_result(const mockssandra::ResultSet& result_set) {
+    String body(result_set.encode(PROTOCOL_VERSION));
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(body.size());
+    memcpy(result->data(), body.data(), body.size());
+    EXPECT_TRUE(result->decode_body(PROTOCOL_VERSION, 0));
+    return result;
+  }
+
+  static String keyspace_name(int i) {
+    OStringStream ss;
+    ss << "keyspace" << i % KEYSPACE_COUNT;
+    return ss.str();
+  }
+
+  static String table_name(int i) {
+    OStringStream ss;
+    ss << "table" << i;
+    return ss.str();
+  }
+
+  static ResultResponse::Ptr keyspaces_result() {
+    mockssandra::ResultSet::Builder builder("system_schema", "keyspaces");
+    builder.column("keyspace_name", mockssandra::Type::text())
+        .column("durable_writes", mockssandra::Type::text());
+    for (int i = 0; i < KEYSPACE_COUNT; ++i) {
+      builder.row(mockssandra::Row::Builder().text(keyspace_name(i)).text("true").build());
+    }
+    return decode_result(builder.build());
+  }
+
+  static ResultResponse::Ptr tables_result(int table_count = TABLE_COUNT) {
+    const char* text_columns[] = { "caching",
+                                   "comment",
+                                   "compaction",
+                                   "compression",
+                                   "crc_check_chance",
+                                   "extensions",
+                                   "gc_grace_seconds",
+                                   "max_index_interval",
+                                   "min_index_interval",
+                                   "read_repair_chance",
+                                   "speculative_retry",
+                                   NULL };
+
+    mockssandra::ResultSet::Builder builder("system_schema", "tables");
+    builder.column("keyspace_name", mockssandra::Type::text())
+        .column("table_name", mockssandra::Type::text())
+        .column("id", mockssandra::Type::uuid())
+        .column("flags", mockssandra::Type::list(mockssandra::Type::text()));
+    for (const char** name = text_columns; *name != NULL; ++name) {
+      builder.column(*name, mockssandra::Type::text());
+    }
+
+    CassUuid id = { 0, 0 };
+    Vector<String> flags(1, "compound");
+    for (int i = 0; i < table_count; ++i) {
+      mockssandra::Row::Builder row;
+      row.text(keyspace_name(i))
+          .text(table_name(i))
+          .uuid(id)
+          .collection(mockssandra::Collection::text(flags));
+      for (const char** name = text_columns; *name != NULL; ++name) {
+        row.text("{'keys': 'ALL', 'rows_per_partition': 'NONE'}");
+      }
+      builder.row(row.build());
+    }
+    return decode_result(builder.build());
+  }
+
+  static ResultResponse::Ptr columns_result(int table_count = TABLE_COUNT) {
+    const char* types[] = { "text", "int", "list<text>", "map<text, int>" };
+
+    mockssandra::ResultSet::Builder builder("system_schema", "columns");
+    builder.column("keyspace_name", mockssandra::Type::text())
+        .column("table_name", mockssandra::Type::text())
+        .column("column_name", mockssandra::Type::text())
+        .column("clustering_order", mockssandra::Type::text())
+        .column("kind", mockssandra::Type::text())
+        .column("type", mockssandra::Type::text());
+    for (int i = 0; i < table_count; ++i) {
+      for (int j = 0; j < COLUMN_COUNT; ++j) {
+        OStringStream ss;
+        ss << "column" << j;
+        builder.row(mockssandra::Row::Builder()
+                        .text(keyspace_name(i))
+                        .text(table_name(i))
+                        .text(ss.str())
+                        .text("none")
+                        .text(j == 0 ? "partition_key" : "regular")
+                        .text(types[j % 4])
+                        .build());
+      }
+    }
+    return decode_result(builder.build());
+  }
+};
+
+TEST_F(SchemaMetadataUnitTest, Compact) {
+  ResultResponse::Ptr keyspaces(keyspaces_result());
+  ResultResponse::Ptr tables(tables_result());
+  ResultResponse::Ptr columns(columns_result());
+
+  int keyspaces_ref_count = keyspaces->buffer()->ref_count();
+  int tables_ref_count = tables->buffer()->ref_count();
+  int columns_ref_count = columns->buffer()->ref_count();
+
+  uint64_t schema_bytes = 0;
+  {
+    AllocationCounter counter;
+    {
+      Metadata metadata;
+      metadata.clear_and_update_back(VersionNumber(3, 11, 4));
+      metadata.update_keyspaces(keyspaces.get(), false);
+      metadata.update_tables(tables.get());
+      metadata.update_columns(columns.get());
+      metadata.swap_to_back_and_update_front();
+      schema_bytes = counter.bytes();
+
+      // The schema metadata doesn't keep the system table results alive
+      EXPECT_EQ(keyspaces_ref_count, keyspaces->buffer()->ref_count());
+      EXPECT_EQ(tables_ref_count, tables->buffer()->ref_count());
+      EXPECT_EQ(columns_ref_count, columns->buffer()->ref_count());
+
+      Metadata::SchemaSnapshot snapshot(metadata.schema_snapshot());
+      const KeyspaceMetadata* keyspace = snapshot.get_keyspace(keyspace_name(0));
+      ASSERT_TRUE(keyspace != NULL);
+      const TableMetadata* table0 = keyspace->get_table(table_name(0));
+      const TableMetadata* table1 = keyspace->get_table(table_name(KEYSPACE_COUNT));
+      ASSERT_TRUE(table0 != NULL && table1 != NULL);
+
+      EXPECT_EQ("{'keys': 'ALL', 'rows_per_partition': 'NONE'}",
+                table0->get_string_field("comment"));
+      EXPECT_EQ(table_name(0), table0->get_string_field("table_name"));
+      EXPECT_TRUE(table0->get_field("unknown") == NULL);
+
+      // Columns with the same type share the same data type instance
+      const ColumnMetadata* column0 = table0->get_column("column2");
+      const ColumnMetadata* column1 = table1->get_column("column2");
+      ASSERT_TRUE(column0 != NULL && column1 != NULL);
+      EXPECT_EQ(CASS_VALUE_TYPE_LIST, column0->data_type()->value_type());
+      EXPECT_EQ(column0->data_type().get(), column1->data_type().get());
+    }
+  }
+
+  // Includes the temporary allocations made while building the metadata
+  EXPECT_LE(schema_bytes, static_cast<uint64_t>(TABLE_COUNT * COLUMN_COUNT * COLUMN_BYTES_BUDGET));
+}
+
+TEST_F(SchemaMetadataUnitTest, StructuralSharing) {
+  Metadata metadata;
+  metadata.clear_and_update_back(VersionNumber(3, 11, 4));
+  metadata.update_keyspaces(keyspaces_result().get(), false);
+  metadata.update_tables(tables_result().get());
+  metadata.update_columns(columns_result().get());
+  metadata.swap_to_back_and_update_front();
+
+  Metadata::SchemaSnapshot before(metadata.schema_snapshot());
+
+  // Update a single table
+  metadata.update_tables(tables_result(1).get());
+  metadata.update_columns(columns_result(1).get());
+
+  Metadata::SchemaSnapshot after(metadata.schema_snapshot());
+
+  // Only the keyspaces on the path to the updated keyspace are copied
+  int shared_keyspaces = 0;
+  for (int i = 0; i < KEYSPACE_COUNT; ++i) {
+    if (before.get_keyspace(keyspace_name(i)) == after.get_keyspace(keyspace_name(i))) {
+      shared_keyspaces++;
+    }
+  }
+  EXPECT_GE(shared_keyspaces, KEYSPACE_COUNT / 2);
+
+  const KeyspaceMetadata* keyspace_before = before.get_keyspace(keyspace_name(0));
+  const KeyspaceMetadata* keyspace_after = after.get_keyspace(keyspace_name(0));
+  ASSERT_TRUE(keyspace_before != NULL && keyspace_after != NULL);
+  EXPECT_NE(keyspace_before, keyspace_after);
+
+  // The other tables in the keyspace are shared
+  int shared_tables = 0;
+  for (int i = KEYSPACE_COUNT; i < TABLE_COUNT; i += KEYSPACE_COUNT) {
+    if (keyspace_before->get_table(table_name(i)) == keyspace_after->get_table(table_name(i))) {
+      shared_tables++;
+    }
+  }
+  EXPECT_EQ(TABLE_COUNT / KEYSPACE_COUNT - 1, shared_tables);
+
+  // The previous snapshot still has the previous version of the table
+  const TableMetadata* table_before = keyspace_before->get_table(table_name(0));
+  const TableMetadata* table_after = keyspace_after->get_table(table_name(0));
+  ASSERT_TRUE(table_before != NULL && table_after != NULL);
+  EXPECT_NE(table_before, table_after);
+  EXPECT_EQ(static_cast<size_t>(COLUMN_COUNT), table_before->columns().size());
+  EXPECT_EQ(static_cast<size_t>(COLUMN_COUNT), table_after->columns().size());
+}
@@ -273,6 +273,60 @@ public:
       request->write(mockssandra::OPCODE_SUPPORTED, body);
     }
   };
+
+  // Only succeeds if the request has the expected trace context
+  class ExpectTraceContext : public mockssandra::Action {
+  public:
+    virtual void on_run(mockssandra::Request* request) const {
+      const mockssandra::CustomPayload& payload = request->custom_payload();
+      for (size_t i = 0; i < payload.size(); ++i) {
+        if (payload[i].first == "traceparent" && payload[i].second == "00-trace-span-01") {
+          String body;
+          mockssandra::encode_int32(mockssandra::RESULT_VOID, &body);
+          request->write(mockssandra::OPCODE_RESULT, body);
+          return;
+        }
+      }
+      request->error(mockssandra::ERROR_INVALID_QUERY, "Missing trace context");
+    }
+  };
+
+  struct Spans {
+    Spans()
+        : request_starts(0)
+        , attempt_starts(0) {}
+
+    int request_starts;
+    int attempt_starts;
+    Vector<CassSpanAttributes> ended;
+  };
+
+  static void* on_span_start(void* parent, const CassSpanAttributes* attributes, void* data) {
+    Spans* spans = static_cast<Spans*>(data);
+    if (attributes->kind == CASS_SPAN_KIND_REQUEST) {
+      EXPECT_TRUE(parent == NULL);
+      spans->request_starts++;
+    } else {
+      EXPECT_TRUE(parent == &spans->request_starts);
+      spans->attempt_starts++;
+      return &spans->attempt_starts;
+    }
+    return &spans->request_starts;
+  }
+
+  static void on_span_end(void* span, const CassSpanAttributes* attributes, void* data) {
+    Spans* spans = static_cast<Spans*>(data);
+    CassSpanAttributes copy(*attributes);
+    copy.keyspace = NULL; // Only valid during the callback
+    copy.statement = NULL;
+    spans->ended.push_back(copy);
+  }
+
+  static size_t on_span_context(void* span, char* context, size_t context_size, void* data) {
+    const char trace_context[] = "00-trace-span-01";
+    memcpy(context, trace_context, sizeof(trace_context) - 1);
+    return sizeof(trace_context) - 1;
+  }
 };
 
 TEST_F(SessionUnitTest, ExecuteQueryNotConnected) {
@@ -347,6 +401,252 @@ TEST_F(SessionUnitTest, ExecuteQueryReusingSession) {
   }
 }
 
+TEST_F(SessionUnitTest, ExecuteQueryWithWarmUp) {
+  mockssandra::SimpleCluster cluster(simple(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.set_warm_up(1, 0.5, 1000);
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+  for (int i = 0; i < 10; ++i) {
+    query(&session);
+  }
+  close(&session);
+}
+
+static void on_timings_callback(CassFuture* future, void* data) {
+  bool* is_called = static_cast<bool*>(data);
+  *is_called = true;
+}
+
+TEST_F(SessionUnitTest, ExecuteQueryRequestTimings) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.set_request_stage_timings(true);
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  QueryRequest::Ptr request(new QueryRequest("blah", 0));
+  ResponseFuture::Ptr future(
+      static_cast<ResponseFuture*>(session.execute(Request::ConstPtr(request)).get()));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+  ASSERT_FALSE(future->error());
+
+  // The future is already set so the callback runs on this thread
+  bool is_called = false;
+  ASSERT_TRUE(future->set_callback(on_timings_callback, &is_called));
+  ASSERT_TRUE(is_called);
+
+  RequestTimings timings(future->timings());
+  EXPECT_GT(timings.enqueued_ns, 0u);
+  EXPECT_GE(timings.dequeued_ns, timings.enqueued_ns);
+  EXPECT_GE(timings.query_plan_ns, timings.dequeued_ns);
+  EXPECT_GE(timings.written_ns, timings.query_plan_ns);
+  EXPECT_GE(timings.first_byte_ns, timings.written_ns);
+  EXPECT_GE(timings.decoded_ns, timings.first_byte_ns);
+  EXPECT_GE(timings.future_set_ns, timings.decoded_ns);
+  EXPECT_GE(timings.callback_start_ns, timings.future_set_ns);
+  EXPECT_GE(timings.callback_end_ns, timings.callback_start_ns);
+
+  for (int i = 0; i < CASS_REQUEST_STAGE_LAST_ENTRY; ++i) {
+    uint64_t elapsed_ns;
+    EXPECT_TRUE(timings.elapsed(static_cast<CassRequestStage>(i), &elapsed_ns));
+  }
+
+  close(&session);
+
+  // The network stage includes a round trip to the server so it's never zero
+  CassRequestStageMetrics metrics;
+  cass_session_get_request_stage_metrics(CassSession::to(&session), CASS_REQUEST_STAGE_NETWORK,
+                                         &metrics);
+  EXPECT_GT(metrics.max, 0u);
+
+  // The callback was set after the request completed, but it's still recorded
+  const Metrics::Histogram& callback_latencies =
+      session.metrics()->request_stage_latencies->get(CASS_REQUEST_STAGE_CALLBACK);
+  int64_t count;
+  double sum;
+  Metrics::Histogram::Bucket buckets[Metrics::Histogram::BUCKET_COUNT];
+  callback_latencies.get_buckets(buckets, &count, &sum);
+  EXPECT_EQ(1, count);
+}
+
+TEST_F(SessionUnitTest, ExecuteQueryRequestTimingsDisabled) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  QueryRequest::Ptr request(new QueryRequest("blah", 0));
+  ResponseFuture::Ptr future(
+      static_cast<ResponseFuture*>(session.execute(Request::ConstPtr(request)).get()));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+  ASSERT_FALSE(future->error());
+
+  // Only the callback stage is timed by default
+  RequestTimings timings(future->timings());
+  for (int i = 0; i < CASS_REQUEST_STAGE_CALLBACK; ++i) {
+    uint64_t elapsed_ns;
+    EXPECT_FALSE(timings.elapsed(static_cast<CassRequestStage>(i), &elapsed_ns));
+  }
+
+  close(&session);
+
+  EXPECT_FALSE(session.metrics()->request_stage_latencies);
+  CassRequestStageMetrics metrics;
+  cass_session_get_request_stage_metrics(CassSession::to(&session), CASS_REQUEST_STAGE_NETWORK,
+                                         &metrics);
+  EXPECT_EQ(0u, metrics.max);
+}
+
+TEST_F(SessionUnitTest, ExecuteQueryTracer) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .execute(new ExpectTraceContext());
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Spans spans;
+  CassTracerCallbacks callbacks = { on_span_start, on_span_end, on_span_context };
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_tracer(RequestTracer::Ptr(new RequestTracer(callbacks, 1, &spans)));
+
+  Session session;
+  connect(config, &session);
+
+  QueryRequest::Ptr request(new QueryRequest("SELECT * FROM blah", 0));
+  Future::Ptr future = session.execute(Request::ConstPtr(request));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+  ASSERT_FALSE(future->error()) << cass_error_desc(future->error()->code) << ": "
+                                << future->error()->message;
+
+  close(&session);
+
+  EXPECT_EQ(spans.request_starts, 1);
+  EXPECT_EQ(spans.attempt_starts, 1);
+  ASSERT_EQ(spans.ended.size(), 2u);
+
+  const CassSpanAttributes& attempt = spans.ended[0];
+  EXPECT_EQ(attempt.kind, CASS_SPAN_KIND_ATTEMPT);
+  EXPECT_EQ(attempt.attempt, 1);
+  EXPECT_EQ(attempt.is_speculative, cass_false);
+  EXPECT_GE(attempt.stream, 0);
+  EXPECT_EQ(attempt.host.address_length, 4);
+  EXPECT_GT(attempt.request_bytes, 0u);
+  EXPECT_GT(attempt.response_bytes, 0u);
+  EXPECT_EQ(attempt.error, CASS_OK);
+
+  const CassSpanAttributes& request_span = spans.ended[1];
+  EXPECT_EQ(request_span.kind, CASS_SPAN_KIND_REQUEST);
+  EXPECT_EQ(request_span.attempt, 1);
+  EXPECT_EQ(request_span.statement_length, strlen("SELECT * FROM blah"));
+  EXPECT_EQ(request_span.error, CASS_OK);
+}
+
+struct BlockedCallbacks {
+  BlockedCallbacks()
+      : count(0)
+      , max_elapsed_us(0) {}
+  int count;
+  uint64_t max_elapsed_us;
+};
+
+static void on_blocking_callback(CassFuture* future, void* data) { test::Utils::msleep(150); }
+
+static void on_blocked_callback_warning(cass_uint64_t elapsed_us, void* data) {
+  BlockedCallbacks* blocked = static_cast<BlockedCallbacks*>(data);
+  blocked->count++;
+  blocked->max_elapsed_us = std::max(blocked->max_elapsed_us, elapsed_us);
+}
+
+TEST_F(SessionUnitTest, ExecuteQueryBlockingCallback) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .wait(100) // Make sure the callback is set before the response is received
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  BlockedCallbacks blocked;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_blocked_callback_warning(10000, on_blocked_callback_warning, &blocked);
+
+  Session session;
+  connect(config, &session);
+
+  QueryRequest::Ptr request(new QueryRequest("SELECT * FROM blah", 0));
+  Future::Ptr future = session.execute(Request::ConstPtr(request));
+  ASSERT_TRUE(future->set_callback(on_blocking_callback, NULL));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+  test::Utils::msleep(2 * CASS_DEFAULT_EVENT_LOOP_PROBE_INTERVAL_MS); // Let the probe run again
+
+  close(&session);
+
+  // The warning is invoked on the I/O thread after the callback returns
+  EXPECT_EQ(1, blocked.count);
+  EXPECT_GE(blocked.max_elapsed_us, 150000u);
+
+  CassEventLoopMetrics metrics;
+  ASSERT_EQ(CASS_OK, cass_session_get_event_loop_metrics(CassSession::to(&session), 0, &metrics));
+  EXPECT_GE(metrics.utilization, 0.0);
+  EXPECT_LE(metrics.utilization, 1.0);
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_session_get_event_loop_metrics(CassSession::to(&session), 1, &metrics));
+
+  // The callback blocked the I/O thread for longer than the probe interval so
+  // at least one probe ran late.
+  const CassHistogramSnapshot* lag =
+      cass_session_get_event_loop_lag_histogram(CassSession::to(&session), cass_false);
+  ASSERT_TRUE(lag != NULL);
+  EXPECT_GT(cass_histogram_snapshot_total_count(lag), 0);
+  EXPECT_GE(cass_histogram_snapshot_max(lag), 40000);
+  cass_histogram_snapshot_free(lag);
+}
+
+TEST_F(SessionUnitTest, EventLoopProbeDisabled) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_event_loop_probe_interval_ms(0);
+
+  Session session;
+  connect(config, &session);
+
+  QueryRequest::Ptr request(new QueryRequest("SELECT * FROM blah", 0));
+  Future::Ptr future = session.execute(Request::ConstPtr(request));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+  test::Utils::msleep(2 * CASS_DEFAULT_EVENT_LOOP_PROBE_INTERVAL_MS);
+
+  CassEventLoopMetrics metrics;
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_session_get_event_loop_metrics(CassSession::to(&session), 0, &metrics));
+
+  const CassHistogramSnapshot* lag =
+      cass_session_get_event_loop_lag_histogram(CassSession::to(&session), cass_false);
+  ASSERT_TRUE(lag != NULL);
+  EXPECT_EQ(0, cass_histogram_snapshot_total_count(lag));
+  cass_histogram_snapshot_free(lag);
+
+  close(&session);
+}
+
 TEST_F(SessionUnitTest, ExecuteQueryReusingSessionUsingSsl) {
   mockssandra::SimpleCluster cluster(simple());
   SslContext::Ptr ssl_context = use_ssl(&cluster).socket_settings.ssl_context;
@@ -19,7 +19,11 @@
 #include "get_time.hpp"
 #include "timestamp_generator.hpp"
 
+#include <algorithm>
 #include <utility>
+#include <uv.h>
+
+#define NUM_CONTENTION_THREADS 32
 
 using namespace datastax;
 using namespace datastax::internal;
@@ -33,6 +37,19 @@ static void clock_skew_log_callback(const CassLogMessage* message, void* data) {
   }
 }
 
+struct TimestampGenThreadArgs {
+  uv_thread_t thread;
+  TimestampGenerator* gen;
+  Vector<int64_t> timestamps;
+};
+
+static void timestamp_gen_thread(void* data) {
+  TimestampGenThreadArgs* args = static_cast<TimestampGenThreadArgs*>(data);
+  for (size_t i = 0; i < args->timestamps.size(); ++i) {
+    args->timestamps[i] = args->gen->next();
+  }
+}
+
 class TimestampGenUnitTest : public Unit {
 public:
   int run_monotonic_timestamp_gen(uint64_t warning_threshold_us, uint64_t warning_interval_ms,
@@ -111,3 +128,88 @@ TEST_F(TimestampGenUnitTest, MonotonicWarningInterval) {
   // it had a shorter interval.
   EXPECT_GT(warn_count_100ms, warn_count_1000ms);
 }
+
+TEST_F(TimestampGenUnitTest, BatchedMonotonic) {
+  BatchedMonotonicTimestampGenerator gen(100);
+
+  int64_t prev = gen.next();
+  for (int i = 0; i < 1000; ++i) {
+    int64_t now = gen.next();
+    // Verify that timestamps are alway increasing
+    EXPECT_GT(now, prev);
+    prev = now;
+  }
+}
+
+TEST_F(TimestampGenUnitTest, BatchedMonotonicSkew) {
+  BatchedMonotonicTimestampGenerator gen(1000);
+
+  // The first thread's block is reserved before the second thread's block so
+  // the second thread's timestamps are ahead, but by no more than a block.
+  int64_t first = gen.next();
+  TimestampGenThreadArgs args;
+  args.gen = &gen;
+  args.timestamps.resize(1);
+  uv_thread_create(&args.thread, timestamp_gen_thread, &args);
+  uv_thread_join(&args.thread);
+  int64_t second = gen.next();
+
+  EXPECT_GT(args.timestamps[0], first);
+  EXPECT_GT(second, first);
+  if (second < args.timestamps[0]) {
+    EXPECT_LE(args.timestamps[0] - second, gen.block_size_us());
+  }
+}
+
+/**
+ * Verify that blocks reserved concurrently by many threads don't move timestamps
+ * more than a block ahead of the clock. Threads wait for the clock instead of
+ * reserving blocks further ahead.
+ */
+TEST_F(TimestampGenUnitTest, BatchedMonotonicSkewManyThreads) {
+  BatchedMonotonicTimestampGenerator gen(1000);
+
+  TimestampGenThreadArgs args[NUM_CONTENTION_THREADS];
+  for (int i = 0; i < NUM_CONTENTION_THREADS; ++i) {
+    args[i].gen = &gen;
+    args[i].timestamps.resize(1);
+    uv_thread_create(&args[i].thread, timestamp_gen_thread, &args[i]);
+  }
+  for (int i = 0; i < NUM_CONTENTION_THREADS; ++i) {
+    uv_thread_join(&args[i].thread);
+  }
+
+  Vector<int64_t> timestamps;
+  for (int i = 0; i < NUM_CONTENTION_THREADS; ++i) {
+    timestamps.push_back(args[i].timestamps[0]);
+  }
+  std::sort(timestamps.begin(), timestamps.end());
+  EXPECT_TRUE(std::adjacent_find(timestamps.begin(), timestamps.end()) == timestamps.end());
+
+  int64_t next = gen.next();
+  EXPECT_LE(next - get_time_since_epoch_us(), gen.block_size_us());
+}
+
+/**
+ * Verify that a thread that uses up its blocks faster than the clock advances
+ * waits for the clock instead of moving timestamps ahead of it, and that this
+ * isn't reported as clock skew.
+ */
+TEST_F(TimestampGenUnitTest, BatchedMonotonicWaitsForClock) {
+  int warn_count = 0;
+  Logger::set_log_level(CASS_LOG_WARN);
+  Logger::set_callback(clock_skew_log_callback, &warn_count);
+
+  BatchedMonotonicTimestampGenerator gen(100, 0);
+
+  int64_t prev = gen.next();
+  for (int i = 0; i < 10000; ++i) {
+    int64_t now = gen.next();
+    EXPECT_GT(now, prev);
+    prev = now;
+  }
+  // A block never starts more than a block ahead of the clock, so none of its
+  // timestamps are two blocks ahead.
+  EXPECT_LT(prev - get_time_since_epoch_us(), 2 * gen.block_size_us());
+  EXPECT_EQ(0, warn_count);
+}
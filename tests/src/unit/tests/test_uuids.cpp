@@ -19,10 +19,16 @@
 #include "cassandra.h"
 #include "get_time.hpp"
 #include "scoped_ptr.hpp"
+#include "vector.hpp"
 
 #include <algorithm>
 #include <ctype.h>
 #include <string.h>
+#include <uv.h>
+
+#define NUM_CONCURRENT_THREADS 8
+#define NUM_CONCURRENT_BATCHES 100
+#define CONCURRENT_BATCH_SIZE 100
 
 using namespace datastax;
 using namespace datastax::internal;
@@ -32,6 +38,69 @@ inline bool operator!=(const CassUuid& u1, const CassUuid& u2) {
          u1.time_and_version != u2.time_and_version;
 }
 
+inline bool operator==(const CassUuid& u1, const CassUuid& u2) { return !(u1 != u2); }
+
+inline bool operator<(const CassUuid& u1, const CassUuid& u2) {
+  return u1.time_and_version < u2.time_and_version ||
+         (u1.time_and_version == u2.time_and_version &&
+          u1.clock_seq_and_node < u2.clock_seq_and_node);
+}
+
+struct UuidThreadArgs {
+  uv_thread_t thread;
+  CassUuidGen* uuid_gen;
+  bool is_time;
+  Vector<CassUuid> uuids;
+};
+
+static void uuid_thread(void* data) {
+  UuidThreadArgs* args = static_cast<UuidThreadArgs*>(data);
+  for (int i = 0; i < NUM_CONCURRENT_BATCHES; ++i) {
+    CassUuid* batch = &args->uuids[i * CONCURRENT_BATCH_SIZE];
+    if (args->is_time) {
+      cass_uuid_gen_time_batch(args->uuid_gen, batch, CONCURRENT_BATCH_SIZE);
+    } else {
+      cass_uuid_gen_random_batch(args->uuid_gen, batch, CONCURRENT_BATCH_SIZE);
+    }
+  }
+}
+
+/**
+ * Generate UUIDs from many threads. Every UUID is verified to be unique and
+ * time UUIDs are verified to be monotonic within each thread.
+ */
+static void generate_concurrent(bool is_time) {
+  CassUuidGen* uuid_gen = cass_uuid_gen_new();
+  UuidThreadArgs args[NUM_CONCURRENT_THREADS];
+
+  for (int i = 0; i < NUM_CONCURRENT_THREADS; ++i) {
+    args[i].uuid_gen = uuid_gen;
+    args[i].is_time = is_time;
+    args[i].uuids.resize(NUM_CONCURRENT_BATCHES * CONCURRENT_BATCH_SIZE);
+    uv_thread_create(&args[i].thread, uuid_thread, &args[i]);
+  }
+  for (int i = 0; i < NUM_CONCURRENT_THREADS; ++i) {
+    uv_thread_join(&args[i].thread);
+  }
+
+  Vector<CassUuid> all;
+  for (int i = 0; i < NUM_CONCURRENT_THREADS; ++i) {
+    const Vector<CassUuid>& uuids = args[i].uuids;
+    for (size_t j = 0; j < uuids.size(); ++j) {
+      EXPECT_EQ(cass_uuid_version(uuids[j]), is_time ? 1 : 4);
+      if (is_time && j > 0) {
+        EXPECT_LE(cass_uuid_timestamp(uuids[j - 1]), cass_uuid_timestamp(uuids[j]));
+        EXPECT_EQ(uuids[j - 1].clock_seq_and_node, uuids[j].clock_seq_and_node);
+      }
+    }
+    all.insert(all.end(), uuids.begin(), uuids.end());
+  }
+  std::sort(all.begin(), all.end());
+  EXPECT_TRUE(std::adjacent_find(all.begin(), all.end()) == all.end());
+
+  cass_uuid_gen_free(uuid_gen);
+}
+
 TEST(UuidUnitTest, V1) {
   CassUuidGen* uuid_gen = cass_uuid_gen_new();
 
@@ -128,6 +197,70 @@ TEST(UuidUnitTest, V4) {
   cass_uuid_gen_free(uuid_gen);
 }
 
+TEST(UuidUnitTest, V1Batch) {
+  CassUuidGen* uuid_gen = cass_uuid_gen_new_with_node(0x0000112233445566LL);
+
+  CassUuid uuids[1000];
+  cass_uuid_gen_time_batch(uuid_gen, uuids, 1000);
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(cass_uuid_version(uuids[i]), 1);
+    EXPECT_EQ(0x0000112233445566ULL, uuids[i].clock_seq_and_node & 0x0000FFFFFFFFFFFFULL);
+    if (i > 0) {
+      EXPECT_NE(uuids[i], uuids[i - 1]);
+    }
+  }
+
+  cass_uuid_gen_free(uuid_gen);
+}
+
+/**
+ * Verify that generating more than 10,000 UUIDs in a millisecond waits for the clock instead of
+ * generating UUIDs ahead of it.
+ */
+TEST(UuidUnitTest, V1BatchWaitsForClock) {
+  CassUuidGen* uuid_gen = cass_uuid_gen_new();
+
+  const size_t count = 100000;
+  Vector<CassUuid> uuids(count);
+  cass_uuid_gen_time_batch(uuid_gen, &uuids[0], count);
+  EXPECT_LE(cass_uuid_timestamp(uuids[count - 1]), get_time_since_epoch_ms());
+
+  for (size_t i = 1; i < count; ++i) {
+    EXPECT_GT(uuids[i].time_and_version, uuids[i - 1].time_and_version);
+  }
+
+  cass_uuid_gen_free(uuid_gen);
+}
+
+TEST(UuidUnitTest, V4Batch) {
+  CassUuidGen* uuid_gen = cass_uuid_gen_new();
+
+  CassUuid uuids[1000];
+  cass_uuid_gen_random_batch(uuid_gen, uuids, 1000);
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(cass_uuid_version(uuids[i]), 4);
+    if (i > 0) {
+      EXPECT_NE(uuids[i], uuids[i - 1]);
+    }
+  }
+
+  cass_uuid_gen_free(uuid_gen);
+}
+
+/**
+ * Verify that time UUIDs generated concurrently by many threads are unique. Each
+ * thread uses its own clock sequence so its timestamps are only monotonic with
+ * respect to its own UUIDs.
+ */
+TEST(UuidUnitTest, V1Concurrent) { generate_concurrent(true); }
+
+/**
+ * Verify that random UUIDs generated concurrently by many threads are unique.
+ */
+TEST(UuidUnitTest, V4Concurrent) { generate_concurrent(false); }
+
 TEST(UuidUnitTest, FromString) {
   CassUuid uuid;
   const String expected = "c3b54ca0-7b01-11e4-aea6-c30dd51eaa64";
@@ -18,11 +18,13 @@
 
 #include "buffer.hpp"
 #include "cassandra.h"
+#include "collection.hpp"
 #include "string.hpp"
 #include "value.hpp"
 
 #include <time.h>
 
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 using namespace datastax;
 
@@ -188,3 +190,83 @@ TEST(ValueUnitTest, NullElementInCollectionSet) {
   EXPECT_EQ(cass_true, cass_value_is_null(element));
   cass_iterator_free(it);
 }
+
+TEST(ValueUnitTest, CollectionArray) {
+  cass_int64_t values[100];
+  for (int i = 0; i < 100; ++i) {
+    values[i] = 1000000000000LL * i - i;
+  }
+
+  DataType::ConstPtr element_data_type(new DataType(CASS_VALUE_TYPE_TIMESTAMP));
+  CollectionType::ConstPtr data_type = CollectionType::list(element_data_type, false);
+  SharedRefPtr<Collection> collection(new Collection(data_type, 101));
+  EXPECT_EQ(CASS_OK, collection->append(static_cast<cass_int64_t>(-1)));
+  EXPECT_EQ(CASS_OK, cass_collection_append_int64_array(CassCollection::to(collection.get()),
+                                                        values, 100));
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE,
+            cass_collection_append_double_array(CassCollection::to(collection.get()),
+                                                reinterpret_cast<cass_double_t*>(values), 1));
+  EXPECT_EQ(101u, collection->item_count());
+
+  // Bulk appended elements are encoded the same as individual elements
+  Buffer encoded(collection->encode());
+  EXPECT_EQ(sizeof(int32_t) + 101 * (sizeof(int32_t) + sizeof(int64_t)), encoded.size());
+  Decoder decoder(encoded.data() + sizeof(int32_t), encoded.size() - sizeof(int32_t));
+  Value value(data_type, 101, decoder);
+
+  cass_int64_t output[101];
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_value_get_int64_array(CassValue::to(&value), output, 100));
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE,
+            cass_value_get_int32_array(CassValue::to(&value),
+                                       reinterpret_cast<cass_int32_t*>(output), 202));
+  ASSERT_EQ(CASS_OK, cass_value_get_int64_array(CassValue::to(&value), output, 101));
+  EXPECT_EQ(-1, output[0]);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(values[i], output[i + 1]);
+  }
+
+  CassIterator* it = cass_iterator_from_collection(CassValue::to(&value));
+  EXPECT_EQ(cass_true, cass_iterator_next(it));
+  EXPECT_EQ(cass_true, cass_iterator_next(it));
+  cass_int64_t element_value;
+  EXPECT_EQ(CASS_OK, cass_value_get_int64(cass_iterator_get_value(it), &element_value));
+  EXPECT_EQ(values[0], element_value);
+  cass_iterator_free(it);
+}
+
+TEST(ValueUnitTest, CollectionArrayMap) {
+  const CassUuid values[4] = { { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 } };
+  SharedRefPtr<Collection> collection(new Collection(CASS_COLLECTION_TYPE_MAP, 2));
+  EXPECT_EQ(CASS_OK, collection->append(values, 4));
+  EXPECT_EQ(4u, collection->item_count());
+
+  Buffer encoded(collection->encode());
+  int32_t count = 0;
+  decode_int32(encoded.data(), count);
+  EXPECT_EQ(2, count);
+
+  // Only lists and sets can be decoded into an array
+  DataType::ConstPtr uuid_data_type(new DataType(CASS_VALUE_TYPE_UUID));
+  Value value(CollectionType::map(uuid_data_type, uuid_data_type, false), 2,
+              Decoder(encoded.data() + sizeof(int32_t), encoded.size() - sizeof(int32_t)));
+  CassUuid output[4];
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE,
+            cass_value_get_uuid_array(CassValue::to(&value), output, 4));
+}
+
+TEST(ValueUnitTest, NullElementInCollectionArray) {
+  const char input[12] = {
+    0,  0,  0,  4,  0, 0, 0, 2, // Size (int32_t) and contents of element 1
+    -1, -1, -1, -1,             // Element 2 is NULL
+  };
+  DataType::ConstPtr element_data_type(new DataType(CASS_VALUE_TYPE_INT));
+  CollectionType::ConstPtr data_type = CollectionType::list(element_data_type, false);
+  Value value(data_type, 2, Decoder(input, 12));
+  cass_int32_t output[2];
+  EXPECT_EQ(CASS_ERROR_LIB_NULL_VALUE,
+            cass_value_get_int32_array(CassValue::to(&value), output, 2));
+  Value truncated_value(data_type, 3, Decoder(input, 8));
+  EXPECT_EQ(CASS_ERROR_LIB_NOT_ENOUGH_DATA,
+            cass_value_get_int32_array(CassValue::to(&truncated_value), output, 3));
+}